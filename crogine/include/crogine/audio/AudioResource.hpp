@@ -86,6 +86,36 @@ namespace cro
         */
         const AudioSource& get(std::int32_t id) const;
 
+        /*!
+        \brief Statistics of the decoded audio cache
+        \see setCacheBudget()
+        */
+        struct CacheStats final
+        {
+            std::size_t residentBytes = 0; //!< size of the decoded audio currently held by the cache
+            std::size_t budget = 0;
+            std::size_t fileCount = 0; //!< number of decoded files held by the cache
+            std::uint64_t hits = 0;
+            std::uint64_t misses = 0;
+            float decodeTime = 0.f; //!< total time in seconds spent decoding files
+        };
+
+        /*!
+        \brief Sets the memory budget of the decoded audio cache.
+        Non-streaming audio files are fully decoded when they are loaded. The
+        decoded data is kept in a cache shared by all AudioResources so that
+        loading the same file again, for example when a Scene is recreated,
+        doesn't require decoding it a second time. When the cache exceeds this
+        size, in bytes, the least recently used files are removed. Setting this
+        to zero disables the cache. Defaults to 64MB.
+        */
+        static void setCacheBudget(std::size_t bytes);
+
+        /*!
+        \brief Returns the current statistics of the decoded audio cache
+        */
+        static CacheStats getCacheStats();
+
     private:
 
         std::unique_ptr<AudioSource> m_fallback;
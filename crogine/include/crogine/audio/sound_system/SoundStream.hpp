@@ -151,7 +151,7 @@ namespace cro
         \brief Request a new chunk of audio data from the stream
 
         This must be implemented by derived classes to provide the audio
-        data to the stream. It is called continuously by the stream thread.
+        data to the stream. It is called continuously by the audio streaming thread.
 
         Returning false from this function will stop the current playback,
         else return true to continue playing. When returning true the
@@ -195,7 +195,9 @@ namespace cro
         static constexpr std::size_t BufferCount = 3;
         static constexpr std::size_t BufferRetries = 2;
 
-        std::thread m_thread;
+        std::int32_t m_streamTask; //handle of the update task in the stream scheduler
+        bool m_buffersCreated;
+        bool m_requestStop;
         mutable std::recursive_mutex m_mutex;
         Status m_startState;
         bool m_isStreaming;
@@ -209,7 +211,9 @@ namespace cro
         std::int32_t m_processingInterval;
         std::array<std::int64_t, BufferCount> m_bufferSeeks = {};
 
-        void threadFunc(); //called by stream's thread
+        std::int32_t updateStream(); //called by the stream scheduler, returns the delay in ms until the next update, or -1 when finished
+
+        void finishStream();
 
         [[nodiscard]] bool fillAndPushBuffer(std::uint32_t bufferID, bool loopImmediate = false); //returns true if the stream requests to stop
 
@@ -217,9 +221,9 @@ namespace cro
 
         void clearQueue();
 
-        void launchThread(Status initialState);
+        void launchStream(Status initialState);
 
-        void waitThread();
+        void waitStream();
 
     };
 }
\ No newline at end of file
@@ -63,6 +63,14 @@ namespace cro
             return static_cast<float>(m_current - m_start) / static_cast<float>(m_frequency);
         }
 
+        /*!
+        \brief Returns the time in seconds since the last restart, without restarting the timer.
+        */
+        double elapsed() const
+        {
+            return static_cast<double>(SDL_GetPerformanceCounter() - m_current) / static_cast<double>(m_frequency);
+        }
+
     private:
         Uint64 m_start = 0;
         Uint64 m_current = 0;
@@ -52,10 +52,15 @@ namespace cro
 {
     class String;
 
+    class App;
+
     /*!
     \brief Class to allowing messages to be logged to a combination
     of one or more destinations such as the console, log file or
-    output window in Visual Studio
+    output window in Visual Studio.
+    Logging is thread safe. Messages are queued and written out by
+    a background thread, so the log file is not necessarily up to
+    date until flush() is called.
     */
     class CRO_EXPORT_API Logger final
     {
@@ -88,11 +93,18 @@ namespace cro
         */
         static std::ostream& log(Type type = Type::Info);
 
-    private:
-        static std::list<std::string> m_buffer;
-        static std::string m_output;
+        /*!
+        \brief Blocks until all queued messages have been written,
+        and the log file flushed to disk.
+        This is called automatically should the App crash, but may be
+        useful before anything else which might end the process.
+        */
+        static void flush();
 
-        static void updateOutString(std::size_t maxBuffer);
+    private:
+        friend class App;
+        static void setLogDirectory(const std::string&);
+        static void updateConsole();
     };
 
     namespace Detail
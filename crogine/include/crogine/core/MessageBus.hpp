@@ -32,6 +32,7 @@ source distribution.
 #include <crogine/core/Message.hpp>
 
 #include <vector>
+#include <atomic>
 
 namespace cro
 {   
@@ -76,29 +77,43 @@ namespace cro
         ATTEMPING TO PLACE LARGE OBJECTS DIRECTLY ON THE MESSAGE BUS IS ASKING FOR TROUBLE
         Custom message types should have a unique 32 bit integer ID which can be used
         to identify the message type when reading messages. Message data has a maximum
-        size of 128 bytes.
+        size of 128 bytes. Posting messages is thread safe, although messages are
+        always read back on the main thread.
         \param id Unique ID for this message type
         \returns Pointer to an empty message of given type.
         */
         template <typename T>
         T* post(Message::ID id)
         {
-            if (!m_enabled) return static_cast<T*>((void*)m_pendingBuffer.data());
+            if (!m_enabled) return static_cast<T*>((void*)m_pendingPages[0].buffer.data());
 
             const auto dataSize = sizeof(T);
             static const auto msgSize = sizeof(Message);
             CRO_ASSERT(dataSize < 128, "message size exceeds 128 bytes"); //limit custom data to 128 bytes
-            CRO_ASSERT(m_pendingBuffer.size() - (m_inPointer - m_pendingBuffer.data()) > (dataSize + msgSize), "buffer overflow " + std::to_string(m_pendingCount)); //make sure we have enough room in the buffer
-            //CRO_WARNING(m_pendingBuffer.size() - (m_inPointer - m_pendingBuffer.data()) < 128, "Messagebus buffer is heavily contended!");
 
-            Message* msg = new (m_inPointer)Message();
-            m_inPointer += msgSize;
+            //systems may post from worker threads
+            while (m_postLock.test_and_set(std::memory_order_acquire)) {}
+
+            //if there's no more room on this page move to the next one
+            if (PageSize - m_pendingPages[m_inPage].used < (dataSize + msgSize))
+            {
+                nextPage();
+            }
+
+            auto& page = m_pendingPages[m_inPage];
+            char* inPointer = page.buffer.data() + page.used;
+
+            Message* msg = new (inPointer)Message();
+            inPointer += msgSize;
             msg->id = id;
             msg->m_dataSize = dataSize;
-            msg->m_data = new (m_inPointer)T();
-            m_inPointer += dataSize;
+            msg->m_data = new (inPointer)T();
+            page.used += (dataSize + msgSize);
 
             m_pendingCount++;
+            m_pendingBytes += (dataSize + msgSize);
+
+            m_postLock.clear(std::memory_order_release);
             return static_cast<T*>(msg->m_data);
         }
 
@@ -113,6 +128,18 @@ namespace cro
         */
         std::size_t pendingMessageCount() const;
 
+        struct Stats final
+        {
+            std::size_t postCount = 0; //!< number of messages posted during the last frame
+            std::size_t byteCount = 0; //!< number of bytes posted during the last frame
+            std::size_t pageCount = 0; //!< number of buffer pages currently allocated
+        };
+
+        /*!
+        \brief Returns the message statistics of the last complete frame
+        */
+        const Stats& getStats() const { return m_stats; }
+
         /*!
         \brief Disables the message bus.
         Used internally by crogine
@@ -121,13 +148,31 @@ namespace cro
 
     private:
 
-        std::vector<char> m_currentBuffer;
-        std::vector<char> m_pendingBuffer;
-        char* m_inPointer;
-        char* m_outPointer;
+        //max msg size is 128 bytes, so 128 messages
+        //will fit in a page. Pages are chained together
+        //if more than a page's worth of messages are
+        //posted in a single frame.
+        static constexpr std::size_t PageSize = 16384u;
+        struct Page final
+        {
+            std::vector<char> buffer = std::vector<char>(PageSize);
+            std::size_t used = 0;
+        };
+
+        std::vector<Page> m_currentPages;
+        std::vector<Page> m_pendingPages;
+        std::size_t m_inPage;
+        std::size_t m_outPage;
+        std::size_t m_outOffset;
         std::size_t m_currentCount;
         std::size_t m_pendingCount;
+        std::size_t m_pendingBytes;
+
+        Stats m_stats;
+        std::atomic_flag m_postLock = ATOMIC_FLAG_INIT;
 
         bool m_enabled;
+
+        void nextPage();
     };
 }
\ No newline at end of file
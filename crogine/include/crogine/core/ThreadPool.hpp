@@ -0,0 +1,189 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/Config.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cro
+{
+    /*!
+    \brief Work stealing thread pool.
+    Each worker thread has its own queue of jobs. Jobs are distributed
+    between the queues when they are pushed, and idle workers steal jobs
+    from the other queues when their own queue is empty. The thread which
+    calls wait() also helps process any outstanding jobs until all of them
+    are complete, which makes the pool suitable for fork/join style work
+    such as updating a batch of independent systems or entities.
+
+    Rather than creating a new pool, which may oversubscribe the CPU, prefer
+    pushing jobs to the shared pool returned by getShared(), using a JobGroup
+    to wait for only the jobs you pushed.
+    */
+    class CRO_EXPORT_API ThreadPool final
+    {
+    public:
+        /*!
+        \brief Tracks a set of jobs pushed to a ThreadPool so that they
+        can be waited on independently of any other work in the pool.
+        If a job throws an exception it is caught and rethrown from
+        wait() once all the other jobs in the group have completed.
+        A JobGroup must outlive any jobs pushed with it.
+        */
+        class CRO_EXPORT_API JobGroup final
+        {
+        public:
+            JobGroup() = default;
+            ~JobGroup();
+
+            JobGroup(const JobGroup&) = delete;
+            JobGroup(JobGroup&&) = delete;
+            JobGroup& operator = (const JobGroup&) = delete;
+            JobGroup& operator = (JobGroup&&) = delete;
+
+            /*!
+            \brief Returns true if all the jobs pushed with this group have completed
+            */
+            bool done() const { return m_pendingCount == 0; }
+
+        private:
+            std::atomic<std::size_t> m_pendingCount = 0; //jobs not yet completed
+            std::atomic<std::size_t> m_queuedCount = 0; //jobs waiting to be started
+
+            std::mutex m_exceptionMutex;
+            std::exception_ptr m_exception;
+
+            friend class ThreadPool;
+        };
+
+        /*!
+        \brief Constructor.
+        \param threadCount Number of worker threads to create. If this
+        is zero then one less than the number of hardware threads is used
+        (with a minimum of one) as the calling thread is expected to help
+        out when calling wait().
+        */
+        explicit ThreadPool(std::size_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool& operator = (const ThreadPool&) = delete;
+        ThreadPool& operator = (ThreadPool&&) = delete;
+
+        /*!
+        \brief Returns the number of worker threads in the pool
+        */
+        std::size_t getThreadCount() const { return m_threads.size(); }
+
+        /*!
+        \brief Adds a job to the pool's default JobGroup to be executed
+        by the next available thread.
+        */
+        void push(std::function<void()> job);
+
+        /*!
+        \brief Adds a job belonging to the given JobGroup to be executed
+        by the next available thread.
+        */
+        void push(std::function<void()> job, JobGroup& group);
+
+        /*!
+        \brief Blocks until all the jobs which have been pushed to the
+        default JobGroup are complete.
+        \see wait(JobGroup&)
+        */
+        void wait();
+
+        /*!
+        \brief Blocks until all the jobs in the given group are complete.
+        The calling thread executes queued jobs from the group while it
+        waits, so it is safe to call this from inside another job. If any
+        of the jobs threw an exception the first one is rethrown here.
+        */
+        void wait(JobGroup& group);
+
+        /*!
+        \brief Returns the index of the thread calling this function.
+        Worker threads are numbered from 1, any other thread (usually
+        the main thread) returns 0. Useful for indexing per-thread data.
+        Note that the index is only unique within a single pool.
+        */
+        static std::size_t getThreadIndex();
+
+        /*!
+        \brief Returns a pool shared by the whole process.
+        The pool is created on first use with the default number of
+        threads, and is used internally by crogine for all of its
+        multithreaded work, such as system processing, skeletal animation
+        and image decoding.
+        */
+        static ThreadPool& getShared();
+
+    private:
+        struct Job final
+        {
+            std::function<void()> func;
+            JobGroup* group = nullptr;
+        };
+
+        struct Queue final
+        {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+        //queue 0 is used by the waiting thread
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        std::vector<std::thread> m_threads;
+
+        std::atomic_bool m_running;
+        std::atomic<std::size_t> m_queuedCount; //jobs waiting to be started
+        std::atomic<std::size_t> m_pendingCount; //jobs not yet completed
+        std::atomic<std::size_t> m_nextQueue;
+
+        std::mutex m_mutex;
+        std::condition_variable m_workCondition;
+        std::condition_variable m_doneCondition;
+
+        JobGroup m_defaultGroup;
+
+        bool tryRun(std::size_t queueIndex, const JobGroup* filter);
+        void threadFunc(std::size_t index);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/detail/Assert.hpp>
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+namespace cro::Detail
+{
+    /*!
+    \brief Linear storage for lists which are rebuilt every frame, such as draw lists.
+    Clearing the arena resets it without releasing its memory, so once it
+    has grown to the size required by a typical frame no further allocations
+    are made. The number of times the storage had to grow is counted so that
+    it can be reported with DrawListStats.
+    */
+    template <typename T>
+    class FrameArena final
+    {
+    public:
+        using iterator = typename std::vector<T>::iterator;
+        using const_iterator = typename std::vector<T>::const_iterator;
+
+        /*!
+        \brief Resets the arena to empty, retaining the allocated memory
+        */
+        void clear() { m_data.clear(); }
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (m_data.size() == m_data.capacity())
+            {
+                m_allocationCount++;
+            }
+            return m_data.emplace_back(std::forward<Args>(args)...);
+        }
+
+        void push_back(const T& t) { emplace_back(t); }
+
+        std::size_t size() const { return m_data.size(); }
+        bool empty() const { return m_data.empty(); }
+
+        T& operator [](std::size_t i) { return m_data[i]; }
+        const T& operator [](std::size_t i) const { return m_data[i]; }
+
+        iterator begin() { return m_data.begin(); }
+        iterator end() { return m_data.end(); }
+        const_iterator begin() const { return m_data.begin(); }
+        const_iterator end() const { return m_data.end(); }
+
+        /*!
+        \brief Returns the number of times the arena has allocated since it was created
+        */
+        std::uint32_t getAllocationCount() const { return m_allocationCount; }
+
+        /*!
+        \brief Returns the number of bytes currently reserved by the arena
+        */
+        std::size_t getReservedBytes() const { return m_data.capacity() * sizeof(T); }
+
+    private:
+        std::vector<T> m_data;
+        std::uint32_t m_allocationCount = 0;
+    };
+
+    /*!
+    \brief Fixed capacity list stored in place, used for
+    small bounded sets such as the sub-mesh indices of a model
+    */
+    template <typename T, std::size_t SIZE>
+    class FixedList final
+    {
+    public:
+        void push_back(T t)
+        {
+            CRO_ASSERT(m_size < SIZE, "List is full!");
+            m_data[m_size++] = t;
+        }
+
+        void clear() { m_size = 0; }
+
+        std::size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        const T& operator [](std::size_t i) const { return m_data[i]; }
+
+        const T* begin() const { return m_data.data(); }
+        const T* end() const { return m_data.data() + m_size; }
+
+    private:
+        std::array<T, SIZE> m_data = {};
+        std::size_t m_size = 0;
+    };
+}
@@ -60,8 +60,12 @@ namespace cro::Detail::ModelBinary
         //of the SkeletonHeader in bytes. If 0 no skeleton is defined
         std::uint32_t skeletonOffset = 0;
 
+        //version 3 and above: a combination of CompactFlags
+        //describing how the vertex and index data are stored.
+        //If this is 0 the data is stored as in version 2
+        std::uint32_t vertexEncoding = 0;
+
         //reserved for future expansion
-        std::uint32_t reserved0 = 0;
         std::uint32_t reserved1 = 0;
         std::uint32_t reserved2 = 0;
         std::uint32_t reserved3 = 0;
@@ -81,6 +85,21 @@ namespace cro::Detail::ModelBinary
     };
 
 
+    //version 3 files may store mesh data in a compact form,
+    //indicated by Header::vertexEncoding. The skeleton data is
+    //the same as version 2
+    enum CompactFlags : std::uint32_t
+    {
+        CompactColour       = 0x1, //4 x std::uint8_t normalised RGBA
+        CompactNormal       = 0x2, //2 x std::int16_t normalised, octahedral encoding
+        CompactTangent      = 0x4, //2 x std::int16_t normalised, octahedral encoding, then 1 x std::int16_t sign
+        CompactUV0          = 0x8, //2 x half float
+        CompactUV1          = 0x10, //2 x half float
+        CompactBlendIndices = 0x20, //4 x std::uint8_t
+        CompactBlendWeights = 0x40, //4 x std::uint16_t normalised
+        CompactIndices      = 0x80 //index arrays are std::uint16_t
+    };
+
     //appears at Header::meshOffset bytes from beginning of the file
     struct CRO_EXPORT_API MeshHeader final
     {
@@ -112,6 +131,12 @@ namespace cro::Detail::ModelBinary
         BlendWeights, 4 float, should sum as close as possible to 1
 
     Vertex data is interleaved in the above order
+
+    In version 3 files any of the components flagged in Header::vertexEncoding
+    are stored as described by CompactFlags. Position data is always float. As
+    the compact vertices are tightly packed the vertex data is a byte array of
+    vertexCount * CompactVertex::getVertexSize(). If CompactIndices is set the
+    index arrays are std::uint16_t rather than std::uint32_t.
     */
 
 
@@ -273,7 +298,16 @@ namespace cro::Detail::ModelBinary
         }
     };
 
-    CRO_EXPORT_API bool write(cro::Entity, const std::string&, bool includeSkeleton = true);
+    /*!
+    \brief Writes the Model and/or Skeleton data of the given entity to a model binary file
+    \param entity The entity to write. Must have a Model or Skeleton component.
+    \param path The path of the file to write
+    \param includeSkeleton Set to true to include the skeleton and vertex blend data
+    \param compact Set to true to write a version 3 file with quantised vertex
+    attributes and 16 bit indices where possible. This roughly halves the size
+    of the mesh data at the cost of some precision.
+    */
+    CRO_EXPORT_API bool write(cro::Entity entity, const std::string& path, bool includeSkeleton = true, bool compact = false);
 
     /*!
     \brief Reads vertex positions and index arrays from a binary file at the given path
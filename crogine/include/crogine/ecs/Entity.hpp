@@ -34,7 +34,7 @@ source distribution.
 #include <crogine/detail/Assert.hpp>
 #include <crogine/Config.hpp>
 
-#include <crogine/ecs/ComponentPool.hpp>
+#include <crogine/ecs/SparsePool.hpp>
 #include <crogine/ecs/Component.hpp>
 
 #include <bitset>
@@ -242,6 +242,15 @@ namespace cro
         template <typename T>
         T& getComponent(Entity);
 
+        /*!
+        \brief Calls the given function for every component of the given type.
+        Components which inherit SparseStorage are visited in the order in which
+        they are packed in memory, else components are visited in order of entity ID.
+        \param fn A function with the signature void(Entity, T&)
+        */
+        template <typename T, typename Fn>
+        void forEachComponent(Fn&& fn);
+
         /*!
         \brief Returns a reference to the component mask of the given Entity.
         Component masks are used to identify whether an Entity has a particular component
@@ -291,7 +300,7 @@ namespace cro
         ComponentManager& m_componentManager;
 
         template <typename T>
-        Detail::ComponentPool<T>& getPool();
+        Detail::PoolType<T>& getPool();
     };
 
 #include "Entity.inl"
@@ -34,12 +34,19 @@ void EntityManager::addComponent(Entity entity, T component)
     auto entID = entity.getIndex();
 
     auto& pool = getPool<T>();
-    if (entID >= pool.size())
+    if constexpr (Detail::IsSparse<T>)
     {
-        pool.resize(std::min(static_cast<std::uint32_t>(Detail::MinFreeIDs), entID + 128));
+        pool.insert(entID, std::move(component));
     }
+    else
+    {
+        if (entID >= pool.size())
+        {
+            pool.resize(std::min(static_cast<std::uint32_t>(Detail::MinFreeIDs), entID + 128));
+        }
 
-    pool[entID] = std::move(component);
+        pool[entID] = std::move(component);
+    }
     m_componentMasks[entID].set(componentID);
 }
 
@@ -83,21 +90,53 @@ T& EntityManager::getComponent(Entity entity)
 
 
     CRO_ASSERT(componentID < m_componentPools.size(), "Component index out of range");
-    auto* pool = (dynamic_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get()));
+    auto* pool = (dynamic_cast<Detail::PoolType<T>*>(m_componentPools[componentID].get()));
 
-    CRO_ASSERT(entityID < pool->size(), "Entity index out of range");
+    if constexpr (Detail::IsSparse<T>)
+    {
+        CRO_ASSERT(pool->contains(entityID), "Entity index out of range");
+    }
+    else
+    {
+        CRO_ASSERT(entityID < pool->size(), "Entity index out of range");
+    }
     return pool->at(entityID);
 }
 
+template <typename T, typename Fn>
+void EntityManager::forEachComponent(Fn&& fn)
+{
+    auto& pool = getPool<T>();
+    if constexpr (Detail::IsSparse<T>)
+    {
+        pool.forEach([&](std::uint32_t entityID, T& component)
+            {
+                fn(getEntity(entityID), component);
+            });
+    }
+    else
+    {
+        const auto componentID = m_componentManager.getID<T>();
+        const auto count = std::min(pool.size(), m_generations.size());
+        for (auto i = 0u; i < count; ++i)
+        {
+            if (m_componentMasks[i].test(componentID))
+            {
+                fn(getEntity(i), pool[i]);
+            }
+        }
+    }
+}
+
 template <typename T>
-Detail::ComponentPool<T>& EntityManager::getPool()
+Detail::PoolType<T>& EntityManager::getPool()
 {
     const auto componentID = m_componentManager.getID<T>();
 
     if (!m_componentPools[componentID])
     {
-        m_componentPools[componentID] = std::make_unique<Detail::ComponentPool<T>>(m_initialPoolSize);
+        m_componentPools[componentID] = std::make_unique<Detail::PoolType<T>>(m_initialPoolSize);
     }
 
-    return *(dynamic_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get()));
+    return *(dynamic_cast<Detail::PoolType<T>*>(m_componentPools[componentID].get()));
 }
\ No newline at end of file
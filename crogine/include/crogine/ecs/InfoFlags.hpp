@@ -39,4 +39,5 @@ namespace cro
 
 	static constexpr std::uint32_t INFO_FLAG_SYSTEMS_ACTIVE = 0x1; //<! displays a window that prints active systems in the Scene
 	static constexpr std::uint32_t INFO_FLAG_SYSTEM_TIME    = 0x2; //<! displays a window containing timing information about System updates
+	static constexpr std::uint32_t INFO_FLAG_MESSAGE_BUS    = 0x4; //<! displays a window containing per-frame MessageBus and dispatch counts
 }
\ No newline at end of file
@@ -34,11 +34,26 @@ source distribution.
 #include <crogine/graphics/Rectangle.hpp>
 
 #include <array>
+#include <cstdint>
+#include <cstddef>
 
 namespace cro
 {
     class Entity;
     class RenderTarget;
+
+    /*!
+    \brief Memory usage of the draw lists belonging to a Renderable system.
+    Draw lists are stored in arenas which are reset each frame, so
+    the allocation count should stop increasing once a scene has
+    been running for a few frames.
+    */
+    struct CRO_EXPORT_API DrawListStats final
+    {
+        std::uint32_t allocations = 0; //!< number of times draw list storage has grown since the system was created
+        std::size_t reservedBytes = 0; //!< memory currently reserved by the draw lists
+    };
+
     /*!
     \brief Renderable interface for systems which draw parts of the scene.
     Systems which implement this will be drawn by any scene to which they are added,
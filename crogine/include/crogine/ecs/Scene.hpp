@@ -122,6 +122,19 @@ namespace cro
         */
         std::size_t getEntityCount() const { return m_entityManager.getEntityCount(); }
 
+        /*!
+        \brief Calls the given function for each component of type T in the Scene.
+        Components which inherit SparseStorage are packed in memory and are
+        visited linearly, which is faster than iterating over a System's entity
+        list and calling getComponent() for each entity. Note that this includes
+        components belonging to entities which were created this frame and have
+        not yet been added to any Systems.
+        \param fn A function with the signature void(Entity, T&)
+        \see SparseStorage
+        */
+        template <typename T, typename Fn>
+        void forEachComponent(Fn&& fn) { m_entityManager.forEachComponent<T>(std::forward<Fn>(fn)); }
+
 
         /*!
         \brief Creates a new system of the given type.
@@ -154,6 +167,16 @@ namespace cro
         template <typename T>
         void setSystemActive(bool active);
 
+        /*!
+        \brief Enables or disables processing systems in parallel.
+        Systems which declare the component types they read and write
+        can be processed at the same time as other non-conflicting
+        systems. Disabling this processes all systems on the main thread
+        in the order in which they were added. Enabled by default.
+        \see System::declareRead()
+        */
+        void setMultithreaded(bool enabled) { m_systemManager.setMultithreaded(enabled); }
+
 
         /*!
         \brief Adds a Director to the Scene.
@@ -0,0 +1,269 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/Config.hpp>
+#include <crogine/ecs/ComponentPool.hpp>
+
+#include <array>
+#include <memory>
+#include <new>
+#include <limits>
+#include <type_traits>
+
+namespace cro
+{
+    /*!
+    \brief Components which inherit this are stored in a SparsePool
+    rather than the default ComponentPool.
+    Sparse storage doesn't reserve space for every possible entity, and
+    components are packed into fixed size pages which are never moved,
+    so references to components remain valid until the component is
+    removed. Components stored this way can be iterated linearly with
+    Scene::forEachComponent(). Transform, Model, Sprite and Drawable2D
+    all use sparse storage.
+    */
+    struct CRO_EXPORT_API SparseStorage {};
+
+    namespace Detail
+    {
+        /*!
+        \brief Sparse set storage for components.
+        Components are packed into pages of PageSize, indexed by a sparse
+        array of entity IDs. Slots freed by removing a component are re-used
+        by the next component added, so the packed array stays mostly dense
+        without having to move existing components.
+        */
+        template <class T>
+        class SparsePool final : public Pool
+        {
+        public:
+            static constexpr std::size_t PageSize = 256;
+
+            explicit SparsePool(std::size_t = 0) {}
+            ~SparsePool() { clear(); }
+
+            SparsePool(const SparsePool&) = delete;
+            SparsePool(SparsePool&&) = delete;
+            SparsePool& operator = (const SparsePool&) = delete;
+            SparsePool& operator = (SparsePool&&) = delete;
+
+            bool empty() const { return m_count == 0; }
+
+            /*!
+            \brief Returns the number of components currently in the pool
+            */
+            std::size_t size() const { return m_count; }
+
+            /*!
+            \brief Returns the number of slots allocated in the pool
+            */
+            std::size_t capacity() const { return m_pages.size() * PageSize; }
+
+            bool contains(std::size_t entityIndex) const
+            {
+                return entityIndex < m_sparse.size() && m_sparse[entityIndex] != NullSlot;
+            }
+
+            /*!
+            \brief Inserts the given component for the given entity index.
+            If the entity already has a component it is replaced.
+            */
+            T& insert(std::size_t entityIndex, T&& component)
+            {
+                if (contains(entityIndex))
+                {
+                    auto& c = at(entityIndex);
+                    c = std::move(component);
+                    return c;
+                }
+
+                if (entityIndex >= m_sparse.size())
+                {
+                    m_sparse.resize(entityIndex + 1, NullSlot);
+                }
+
+                std::uint32_t slot = 0;
+                if (!m_freeSlots.empty())
+                {
+                    slot = m_freeSlots.back();
+                    m_freeSlots.pop_back();
+                }
+                else
+                {
+                    slot = static_cast<std::uint32_t>(m_slotCount++);
+                    if (slot == capacity())
+                    {
+                        m_pages.emplace_back(std::make_unique<Page>());
+                    }
+                }
+
+                auto& page = *m_pages[slot / PageSize];
+                auto* ptr = new (page.get(slot % PageSize)) T(std::move(component));
+                page.owners[slot % PageSize] = static_cast<std::uint32_t>(entityIndex);
+
+                m_sparse[entityIndex] = slot;
+                m_count++;
+
+                return *ptr;
+            }
+
+            /*!
+            \brief Returns the component belonging to the given entity index.
+            The entity is expected to have the component. If it doesn't, debug
+            builds assert, and release builds return a default constructed
+            component shared by all missing entities, as ComponentPool does,
+            rather than reading an unused slot.
+            */
+            T& at(std::size_t entityIndex)
+            {
+                CRO_ASSERT(contains(entityIndex), "Component does not exist");
+                if (!contains(entityIndex))
+                {
+                    return getFallback();
+                }
+                const auto slot = m_sparse[entityIndex];
+                return *std::launder(m_pages[slot / PageSize]->get(slot % PageSize));
+            }
+
+            const T& at(std::size_t entityIndex) const
+            {
+                CRO_ASSERT(contains(entityIndex), "Component does not exist");
+                if (!contains(entityIndex))
+                {
+                    return getFallback();
+                }
+                const auto slot = m_sparse[entityIndex];
+                return *std::launder(m_pages[slot / PageSize]->get(slot % PageSize));
+            }
+
+            T& operator [] (std::size_t entityIndex) { return at(entityIndex); }
+            const T& operator [] (std::size_t entityIndex) const { return at(entityIndex); }
+
+            /*!
+            \brief Removes the component belonging to the given entity index, if it exists
+            */
+            void reset(std::size_t entityIndex) override
+            {
+                if (contains(entityIndex))
+                {
+                    const auto slot = m_sparse[entityIndex];
+                    auto& page = *m_pages[slot / PageSize];
+                    std::launder(page.get(slot % PageSize))->~T();
+                    page.owners[slot % PageSize] = NullSlot;
+
+                    m_sparse[entityIndex] = NullSlot;
+                    m_freeSlots.push_back(slot);
+                    m_count--;
+                }
+            }
+
+            void clear() override
+            {
+                for (auto i = 0u; i < m_slotCount; ++i)
+                {
+                    auto& page = *m_pages[i / PageSize];
+                    if (page.owners[i % PageSize] != NullSlot)
+                    {
+                        std::launder(page.get(i % PageSize))->~T();
+                    }
+                }
+                m_pages.clear();
+                m_sparse.clear();
+                m_freeSlots.clear();
+                m_slotCount = 0;
+                m_count = 0;
+            }
+
+            /*!
+            \brief Calls the given function for each component in the pool,
+            in the order in which they are stored.
+            \param fn A function with the signature void(std::uint32_t entityIndex, T&)
+            */
+            template <typename Fn>
+            void forEach(Fn&& fn)
+            {
+                for (auto i = 0u; i < m_pages.size(); ++i)
+                {
+                    auto& page = *m_pages[i];
+                    const auto count = std::min(PageSize, m_slotCount - (i * PageSize));
+                    for (auto j = 0u; j < count; ++j)
+                    {
+                        if (page.owners[j] != NullSlot)
+                        {
+                            fn(page.owners[j], *std::launder(page.get(j)));
+                        }
+                    }
+                }
+            }
+
+        private:
+            static constexpr std::uint32_t NullSlot = std::numeric_limits<std::uint32_t>::max();
+
+            //component storage is left uninitialised, slots
+            //are only read once a component is constructed in them
+            struct Page final
+            {
+                Page() { owners.fill(NullSlot); }
+                alignas(T) unsigned char data[sizeof(T) * PageSize];
+                std::array<std::uint32_t, PageSize> owners;
+
+                T* get(std::size_t idx) { return reinterpret_cast<T*>(data + (idx * sizeof(T))); }
+                const T* get(std::size_t idx) const { return reinterpret_cast<const T*>(data + (idx * sizeof(T))); }
+            };
+
+            std::vector<std::unique_ptr<Page>> m_pages;
+            std::vector<std::uint32_t> m_sparse; //indexed by entity ID
+            std::vector<std::uint32_t> m_freeSlots;
+            std::size_t m_slotCount = 0; //high water mark of used slots
+            std::size_t m_count = 0;
+
+            //only created if a missing component is requested
+            mutable std::unique_ptr<T> m_fallback;
+            T& getFallback() const
+            {
+                if (!m_fallback)
+                {
+                    m_fallback = std::make_unique<T>();
+                }
+                return *m_fallback;
+            }
+        };
+
+        template <class T>
+        inline constexpr bool IsSparse = std::is_base_of_v<SparseStorage, T>;
+
+        /*!
+        \brief Selects the pool type used by the EntityManager for a given component
+        */
+        template <class T>
+        using PoolType = std::conditional_t<IsSparse<T>, SparsePool<T>, ComponentPool<T>>;
+    }
+}
@@ -34,10 +34,12 @@ source distribution.
 #include <crogine/ecs/Component.hpp>
 #include <crogine/core/MessageBus.hpp>
 #include <crogine/core/HiResTimer.hpp>
+#include <crogine/core/ThreadPool.hpp>
 #include <crogine/gui/GuiClient.hpp>
 
 #include <vector>
 #include <typeindex>
+#include <unordered_map>
 
 namespace cro
 {
@@ -84,10 +86,33 @@ namespace cro
         void addEntity(Entity);
 
         /*!
-        \brief Removes an entity from the list to process
+        \brief Adds all the given entities to the list to process
+        */
+        void addEntities(const std::vector<Entity>&);
+
+        /*!
+        \brief Removes an entity from the list to process.
+        Entities are looked up by index so this doesn't need to search
+        the entity list, although the remaining entities are shuffled down
+        to maintain the order in which they were added. To remove many entities
+        at once prefer removeEntities()
         */
         void removeEntity(Entity);
 
+        /*!
+        \brief Removes all the given entities from the list to process.
+        Any entities in the list which don't belong to this system are ignored.
+        The entity list is compacted once, in a single pass, regardless of the
+        number of entities removed, and the existing order of the remaining
+        entities is preserved.
+        */
+        void removeEntities(const std::vector<Entity>&);
+
+        /*!
+        \brief Returns true if the given entity is in this system's list of entities
+        */
+        bool hasEntity(Entity) const;
+
         /*!
         \brief Returns the component mask used to mask entities with corresponding
         components for this system to process
@@ -119,6 +144,46 @@ namespace cro
         template <typename T>
         void requireComponent();
 
+        /*!
+        \brief Declares that this system reads components of the given type
+        in process().
+        Systems which declare all of the component types they access with
+        declareRead() and declareWrite() may be processed in parallel with
+        other systems which don't write to the same component types. Systems
+        which declare nothing are always processed alone, on the main thread,
+        in the order in which they were added. Systems declaring component
+        access must not use OpenGL, or create or destroy entities, from
+        process(), although posting messages is safe.
+        */
+        template <typename T>
+        void declareRead();
+
+        /*!
+        \brief Declares that this system writes to components of the given type
+        in process().
+        \see declareRead()
+        */
+        template <typename T>
+        void declareWrite();
+
+        /*!
+        \brief Subscribes this system to messages of the given ID.
+        By default systems receive every message posted on the MessageBus.
+        Once a system has subscribed to one or more message IDs handleMessage()
+        is only called for messages with those IDs, which saves the SystemManager
+        dispatching messages to systems which would otherwise ignore them.
+        This should be called from the system's constructor.
+        */
+        void subscribe(Message::ID);
+
+        /*!
+        \brief Marks this system as not handling any messages.
+        Systems which don't override handleMessage() should call this from
+        their constructor so that the SystemManager can skip them entirely
+        when dispatching messages.
+        */
+        void ignoreMessages();
+
         /*!
         \brief Optional callback performed when an entity is added
         */
@@ -158,6 +223,13 @@ namespace cro
         ComponentMask m_componentMask;
         std::vector<Entity> m_entities;
 
+        //indexed by entity ID, this stores the position of
+        //the entity in m_entities, allowing constant time lookup
+        std::vector<std::uint32_t> m_entityIndices;
+        std::vector<std::uint8_t> m_removalFlags;
+        std::vector<Entity> m_removedEntities;
+        std::uint32_t findEntity(Entity) const;
+
         Scene* m_scene;
         std::size_t m_updateIndex; //ensures when the system is active that it is updated in the order in which is was added to the manager
 
@@ -168,7 +240,20 @@ namespace cro
         //list of types populated by requireComponent then processed by SystemManager
         //when the system is created
         std::vector<std::type_index> m_pendingTypes;
+        std::vector<std::type_index> m_pendingReadTypes;
+        std::vector<std::type_index> m_pendingWriteTypes;
         void processTypes(ComponentManager&);
+
+        //declared component access used to schedule parallel processing
+        bool m_declaresAccess;
+        ComponentMask m_readMask;
+        ComponentMask m_writeMask;
+        bool conflicts(const System&) const;
+
+        //if this is false the system receives all messages
+        bool m_filterMessages;
+        std::vector<Message::ID> m_subscriptions;
+        bool subscribed(Message::ID) const;
     };
 
     class CRO_EXPORT_API SystemManager final : public cro::GuiClient
@@ -227,20 +312,41 @@ namespace cro
         */
         void addToSystems(Entity);
 
+        /*!
+        \brief Submits a list of entities to all available systems
+        */
+        void addToSystems(const std::vector<Entity>&);
+
         /*!
         \brief Removes the given Entity from any systems to which it may belong
         */
         void removeFromSystems(Entity);
 
         /*!
-        \brief Forwards messages to all systems
+        \brief Removes all the given entities from any systems to which they may belong
+        */
+        void removeFromSystems(const std::vector<Entity>&);
+
+        /*!
+        \brief Forwards messages to all systems which are subscribed to the message ID
+        \see System::subscribe()
         */
         void forwardMessage(const cro::Message&);
 
         /*!
-        \brief Runs a simulation step by calling process() on each system
+        \brief Runs a simulation step by calling process() on each system.
+        Systems which declare their component access and don't conflict
+        with each other are processed in parallel on a thread pool.
+        \see System::declareRead()
         */
         void process(float);
+
+        /*!
+        \brief Enables or disables processing systems on multiple threads.
+        When disabled all systems are processed on the calling thread in
+        the order in which they were added. Enabled by default.
+        */
+        void setMultithreaded(bool enabled) { m_multithreaded = enabled; }
     private:
         Scene& m_scene;
         std::vector<std::unique_ptr<System>> m_systems;
@@ -255,11 +361,33 @@ namespace cro
         {
             const System* system = nullptr;
             float elapsed = 0.f;
-            SystemSample(const System* s, float e)
-                : system(s), elapsed(e) {}
+            std::size_t thread = 0;
+            SystemSample() = default;
+            SystemSample(const System* s, float e, std::size_t t)
+                : system(s), elapsed(e), thread(t) {}
         };
         std::vector<SystemSample> m_systemSamples;
 
+        //each stage contains indices into m_activeSystems
+        //of systems which can be processed in parallel
+        std::vector<std::vector<std::size_t>> m_schedule;
+        bool m_scheduleDirty;
+        bool m_multithreaded;
+        ThreadPool::JobGroup m_jobGroup;
+        void buildSchedule();
+        void processSystem(std::size_t, float, bool);
+
+        //maps message IDs to the systems which handle them.
+        //lists are built the first time a message ID is
+        //seen, and cleared when systems are added or removed
+        std::unordered_map<Message::ID, std::vector<System*>> m_subscribers;
+        std::size_t m_dispatchCount;
+        std::size_t m_lastDispatchCount;
+        std::size_t m_forwardCount;
+        std::size_t m_lastForwardCount;
+
+        const std::vector<System*>& getSubscribers(Message::ID);
+
         template <typename T>
         void removeFromActive();
     };
@@ -33,6 +33,20 @@ void System::requireComponent()
 	m_pendingTypes.push_back(typeid(T));
 }
 
+template <typename T>
+void System::declareRead()
+{
+	m_pendingReadTypes.push_back(typeid(T));
+	m_declaresAccess = true;
+}
+
+template <typename T>
+void System::declareWrite()
+{
+	m_pendingWriteTypes.push_back(typeid(T));
+	m_declaresAccess = true;
+}
+
 template <typename T>
 T* System::postMessage(cro::Message::ID id) const
 {
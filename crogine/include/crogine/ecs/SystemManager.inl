@@ -46,11 +46,13 @@ T& SystemManager::addSystem(Args&&... args)
 
     auto& system = m_systems.emplace_back(std::make_unique<T>(std::forward<Args>(args)...));
     system->setScene(m_scene);
+    m_subscribers.clear();
     system->processTypes(m_componentManager);
 
     system->m_updateIndex = m_activeSystems.size();
     m_activeSystems.push_back(system.get());
     system->m_active = true;
+    m_scheduleDirty = true;
 
     return *(static_cast<T*>(system.get()));
 }
@@ -64,6 +66,7 @@ void SystemManager::removeSystem()
     {
         return sys->getType() == type;
     }), std::end(m_systems));
+    m_subscribers.clear();
 
     removeFromActive<T>();
 }
@@ -100,6 +103,7 @@ void SystemManager::setSystemActive(bool active)
                     {
                         return a->m_updateIndex < b->m_updateIndex;
                     });
+                m_scheduleDirty = true;
             }
         }
     }
@@ -162,4 +166,5 @@ void SystemManager::removeFromActive()
         {
             return sys->getType() == type;
         }), std::end(m_activeSystems));
+    m_scheduleDirty = true;
 }
\ No newline at end of file
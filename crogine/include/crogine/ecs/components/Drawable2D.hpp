@@ -30,6 +30,7 @@ source distribution.
 #pragma once
 
 #include <crogine/Config.hpp>
+#include <crogine/ecs/SparsePool.hpp>
 #include <crogine/graphics/Vertex2D.hpp>
 #include <crogine/graphics/MaterialData.hpp>
 #include <crogine/graphics/Rectangle.hpp>
@@ -59,7 +60,7 @@ namespace cro
     values first. This use useful for rendering tile maps with a top
     down perspective for example.
     */
-    class CRO_EXPORT_API Drawable2D final
+    class CRO_EXPORT_API Drawable2D final : public SparseStorage
     {
     public:
         Drawable2D();
@@ -412,6 +413,7 @@ namespace cro
         }
 
         friend class RenderSystem2D;
+        friend class TextSystem;
 
         void applyShader();
     };
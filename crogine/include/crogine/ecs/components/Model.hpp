@@ -30,6 +30,7 @@ source distribution.
 #pragma once
 
 #include <crogine/Config.hpp>
+#include <crogine/ecs/SparsePool.hpp>
 #include <crogine/detail/Types.hpp>
 #include <crogine/graphics/MeshData.hpp>
 #include <crogine/graphics/MaterialData.hpp>
@@ -41,7 +42,7 @@ source distribution.
 
 namespace cro
 {
-    class CRO_EXPORT_API Model final
+    class CRO_EXPORT_API Model final : public SparseStorage
     {
     public:
         Model();
@@ -309,6 +310,7 @@ namespace cro
         //used with BalancedTree if active in frustum culling
         std::int32_t m_treeID = -1;
         glm::vec3 m_lastWorldPosition = glm::vec3(0.f);
+        std::uint32_t m_lastTransformChange = 0;
 
         friend class ModelRenderer;
         friend class ShadowMapRenderer;
@@ -39,6 +39,7 @@ source distribution.
 #include <crogine/detail/glm/vec3.hpp>
 
 #include <array>
+#include <vector>
 
 namespace cro
 {
@@ -64,6 +65,72 @@ namespace cro
         float acceleration = 1.f;
     };
 
+    namespace Detail
+    {
+        /*!
+        \brief Structure of arrays storage for the particles of an emitter.
+        Each channel is stored contiguously so that the ParticleSystem can
+        update several particles at once with SIMD instructions. Capacity
+        is always rounded up to a multiple of 4 so that updates may safely
+        read and write the padding at the end of each channel.
+        Used internally by the ParticleSystem.
+        */
+        class CRO_EXPORT_API ParticleStore final
+        {
+        public:
+            enum Channel
+            {
+                PositionX, PositionY, PositionZ,
+                VelocityX, VelocityY, VelocityZ,
+                GravityX, GravityY, GravityZ,
+                Red, Green, Blue, Alpha,
+                Lifetime, InverseMaxLifetime,
+                FrameTime, Rotation, Scale, Acceleration,
+
+                Count
+            };
+
+            /*!
+            \brief Resizes the store to hold at least the given number of particles.
+            Existing particle data is invalidated.
+            */
+            void resize(std::size_t size);
+
+            /*!
+            \brief Returns the number of particles which can be stored.
+            */
+            std::size_t capacity() const { return m_capacity; }
+
+            /*!
+            \brief Returns a pointer to the first element of the given channel
+            */
+            float* get(Channel channel) { return m_floatData.data() + (channel * m_capacity); }
+            const float* get(Channel channel) const { return m_floatData.data() + (channel * m_capacity); }
+
+            std::uint32_t* getFrameIDs() { return m_frameIDs.data(); }
+            const std::uint32_t* getFrameIDs() const { return m_frameIDs.data(); }
+
+            std::uint32_t* getLoopCounts() { return m_loopCounts.data(); }
+            const std::uint32_t* getLoopCounts() const { return m_loopCounts.data(); }
+
+            /*!
+            \brief Writes the given Particle to the given index
+            */
+            void set(std::size_t index, const Particle& particle);
+
+            /*!
+            \brief Copies the particle at index src over the particle at index dst
+            */
+            void move(std::size_t dst, std::size_t src);
+
+        private:
+            std::size_t m_capacity = 0;
+            std::vector<float> m_floatData;
+            std::vector<std::uint32_t> m_frameIDs;
+            std::vector<std::uint32_t> m_loopCounts;
+        };
+    }
+
     /*!
     \brief Encapsulates settings used by an emitter to
     initialise particles it creates
@@ -168,8 +235,7 @@ namespace cro
         std::uint32_t m_vbo;
         std::uint32_t m_vao; //< used on desktop
         
-        //std::array<Particle, MaxParticles> m_particles;
-        std::vector<Particle> m_particles;
+        Detail::ParticleStore m_particles;
         std::size_t m_nextFreeParticle;
 
         bool m_running;
@@ -181,6 +247,7 @@ namespace cro
         float m_emissionTimestamp;
 
         bool m_pendingUpdate;
+        bool m_vertexDataDirty; //< vertex data is uploaded at draw time so process() needn't touch GL
         std::uint64_t m_renderFlags;
 
         std::int32_t m_releaseCount;
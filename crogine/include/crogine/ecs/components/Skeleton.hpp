@@ -411,7 +411,8 @@ namespace cro
         std::vector<Joint> m_frames; //indexed by steps of frameSize
         std::vector<glm::mat4> m_currentFrame; //current interpolated output
         std::vector<glm::mat4> m_invBindPose;
-        std::vector<glm::mat4> m_bindPose;
+        std::vector<glm::mat4> m_bindPose; //cached inverse of the inverse bind pose
+        std::vector<std::uint32_t> m_jointOrder; //joint indices sorted so parents always come before their children
         glm::mat4 m_rootTransform = glm::mat4(1.f);
 
         std::vector<SkeletalAnim> m_animations;
@@ -428,5 +429,6 @@ namespace cro
         friend struct Detail::ModelBinary::SkeletonHeaderV2;
 
         void buildKeyframe(std::size_t frame);
+        void buildJointOrder(const std::vector<Joint>&);
     };
 }
\ No newline at end of file
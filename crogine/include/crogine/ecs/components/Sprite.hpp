@@ -30,6 +30,7 @@ source distribution.
 #pragma once
 
 #include <crogine/Config.hpp>
+#include <crogine/ecs/SparsePool.hpp>
 #include <crogine/graphics/Rectangle.hpp>
 #include <crogine/graphics/Colour.hpp>
 #include <crogine/graphics/MaterialData.hpp>
@@ -63,7 +64,7 @@ namespace cro
 
     \see SpriteSheet, SpriteAnimation
     */
-    class CRO_EXPORT_API Sprite final
+    class CRO_EXPORT_API Sprite final : public SparseStorage
     {
     public:
         /*!
@@ -37,6 +37,7 @@ source distribution.
 #include <crogine/detail/glm/mat4x4.hpp>
 #include <crogine/detail/glm/gtc/quaternion.hpp>
 
+#include <atomic>
 #include <vector>
 #include <functional>
 
@@ -47,9 +48,15 @@ namespace cro
     struct Attachment;
 
     /*!
-    \brief A three dimensional transform component
+    \brief A three dimensional transform component.
+    Transforms are kept in sparse storage so that they are never moved
+    in memory once added to an entity, which keeps the parent and child
+    pointers of a hierarchy valid as the scene grows.
+    The local and world matrices are evaluated lazily, and it is safe for
+    multiple threads to read them at once provided that no thread is
+    modifying the transform, or any of its parents, at the same time.
     */
-    class CRO_EXPORT_API Transform final
+    class CRO_EXPORT_API Transform final : public SparseStorage
     {
     public:
         enum
@@ -239,7 +246,9 @@ namespace cro
 
         /*!
         \brief Returns a matrix representing the world space Transform.
-        This is the local transform multiplied by all parenting transforms
+        This is the local transform multiplied by all parenting transforms.
+        The result is cached, and is only recalculated when this transform
+        or one of its parents has been modified since the last call.
         */
         glm::mat4 getWorldTransform() const;
 
@@ -283,7 +292,16 @@ namespace cro
         \brief Returns true if this transform is marked for an update
         next time getWorldTransform() or getLocalTransform() are called
         */
-        bool getDirty() const { return m_dirtyFlags != 0; }
+        bool getDirty() const { return m_dirtyFlags.load() != 0; }
+
+        /*!
+        \brief Returns a value which is incremented each time this transform,
+        or any of its parents, is modified. Unlike getDirty() this is not
+        reset when the world transform is rebuilt, so systems can store the
+        value and compare it later to see if the transform has changed since
+        they last read it.
+        */
+        std::uint32_t getChangeCount() const { return m_changeCount; }
 
         /*!
         \brief Adds a callback which is executed when the transform is updated.
@@ -305,6 +323,7 @@ namespace cro
         glm::vec3 m_scale;
         glm::quat m_rotation;
         mutable glm::mat4 m_transform;
+        mutable glm::mat4 m_worldTransform;
 
         Transform* m_parent;
         std::vector<Transform*> m_children = {};
@@ -316,12 +335,22 @@ namespace cro
 
         enum Flags
         {
-            Parent = 0x1,
+            Parent = 0x1, //world transform needs rebuilding
             Child = 0x2,
-            Tx = 0x4,
+            Tx = 0x4, //local transform needs rebuilding
             All = Parent | Child | Tx
         };
-        mutable std::uint8_t m_dirtyFlags;
+        mutable std::atomic<std::uint8_t> m_dirtyFlags;
+
+        //guards the lazily evaluated matrices so that a
+        //transform may be read from multiple threads
+        mutable std::atomic_flag m_cacheLock = ATOMIC_FLAG_INIT;
+        std::uint32_t m_changeCount;
+
+        //flags the local transform as dirty and pushes the
+        //change down to the world transform of all children
+        void markDirty();
+        void markWorldDirty();
 
         std::vector<std::function<void()>> m_callbacks;
 
@@ -330,6 +359,7 @@ namespace cro
         //this is a fudge to allow transforms to read
         //skeletal attachment points
         glm::mat4 m_attachmentTransform;
+        void setAttachmentTransform(const glm::mat4&);
         friend class SkeletalAnimator;
         friend struct Attachment;
     };
@@ -31,6 +31,7 @@ source distribution.
 
 #include <crogine/ecs/System.hpp>
 
+#include <array>
 #include <functional>
 
 namespace cro
@@ -49,6 +50,17 @@ namespace cro
     /*
     \brief The command system is used to execute commands which are
     targeted at specific IDs
+    Entities are sorted into buckets, one for each bit of their CommandTarget
+    ID, so that commands only visit the entities which they target. Changes
+    to a CommandTarget ID are picked up at the start of each call to process(),
+    or immediately after a command is executed on the entity.
+
+    If a command modifies the CommandTarget ID of an entity other than the one
+    on which it is executed, that entity immediately stops receiving commands
+    for any flags which were removed, but only starts receiving commands for
+    any flags which were added from the start of the next frame. Entities are
+    not re-sorted after every command as doing so means visiting every entity
+    each time, which is what the buckets exist to avoid.
     */
     class CRO_EXPORT_API CommandSystem final : public cro::System
     {
@@ -69,9 +81,28 @@ namespace cro
         */
         void process(float) override;
 
+        /*!
+        \brief Returns the number of commands which have been sent
+        in excess of the initial queue capacity since the system
+        was created. The queue grows to accommodate these, rather
+        than dropping commands, but a non-zero value indicates
+        that memory was allocated while queuing commands.
+        */
+        std::size_t getOverflowCount() const { return m_overflowCount; }
+
     private:
         std::vector<Command> m_commands;
         std::vector<Command> m_commandBuffer;
-        std::size_t m_count;
+        std::size_t m_overflowCount;
+
+        std::array<std::vector<Entity>, 32u> m_buckets;
+        std::vector<std::uint32_t> m_bucketIDs; //ID with which an entity was last sorted, indexed by entity
+        std::vector<Entity> m_changedTargets;
+
+        void updateBuckets(Entity, std::uint32_t newID);
+        void executeCommand(const Command&, float);
+
+        void onEntityAdded(Entity) override;
+        void onEntityRemoved(Entity) override;
     };
 }
\ No newline at end of file
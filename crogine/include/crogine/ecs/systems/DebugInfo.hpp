@@ -33,6 +33,11 @@ source distribution.
 
 namespace cro
 {
+    /*!
+    \brief Prints the positions of entities with a Transform component
+    to the Console stats window, along with the draw list memory usage
+    of any 3D render systems in the Scene.
+    */
     class CRO_EXPORT_API DebugInfo final : public System
     {
     public:
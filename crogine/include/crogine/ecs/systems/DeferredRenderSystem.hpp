@@ -33,6 +33,8 @@ source distribution.
 #include <crogine/ecs/System.hpp>
 #include <crogine/ecs/Renderable.hpp>
 #include <crogine/graphics/Shader.hpp>
+#include <crogine/graphics/MeshData.hpp>
+#include <crogine/detail/FrameArena.hpp>
 
 #include <vector>
 
@@ -77,19 +79,24 @@ namespace cro
         */
         void setEnvironmentMap(const EnvironmentMap&);
 
+        /*!
+        \brief Returns the allocation count and memory usage of the draw lists of all cameras
+        */
+        DrawListStats getDrawListStats() const;
+
     private:
 
         struct SortData final
         {
             Entity entity; //model entity
-            std::vector<std::int32_t> materialIDs; //index into the model sub-mesh array
+            Detail::FixedList<std::uint8_t, Mesh::IndexData::MaxBuffers> materialIDs; //index into the model sub-mesh array
             float distanceFromCamera = 0.f; //sort criteria
         };
 
         struct VisibleList final
         {
-            std::vector<SortData> deferred;
-            std::vector<SortData> forward;
+            Detail::FrameArena<SortData> deferred;
+            Detail::FrameArena<SortData> forward;
         };
 
         //one for each camera we encounter
@@ -35,6 +35,7 @@ source distribution.
 #include <crogine/graphics/Colour.hpp>
 #include <crogine/graphics/RenderTexture.hpp>
 #include <crogine/graphics/Shader.hpp>
+#include <crogine/graphics/Spatial.hpp>
 #include <crogine/detail/glm/vec2.hpp>
 
 #ifdef CRO_DEBUG_
@@ -156,5 +157,9 @@ namespace cro
         std::array<std::int32_t, UniformID::Count> m_uniformIDs = {};
         std::array<TextureID, BufferID::Count> m_bufferIDs = {};
         std::vector<std::vector<Entity>> m_drawLists;
+
+        SphereBatch m_cullBatch;
+        std::vector<Entity> m_cullEntities;
+        std::vector<std::uint32_t> m_cullResults;
     };
 }
\ No newline at end of file
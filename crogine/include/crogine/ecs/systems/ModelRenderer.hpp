@@ -36,6 +36,7 @@ source distribution.
 #include <crogine/ecs/components/Model.hpp>
 #include <crogine/graphics/MaterialData.hpp>
 #include <crogine/detail/BalancedTree.hpp>
+#include <crogine/detail/FrameArena.hpp>
 #include <crogine/detail/SDLResource.hpp>
 
 #include <vector>
@@ -46,14 +47,17 @@ namespace cro
     struct Camera;
 
     //don't export this, used internally.
+    //one entry is created per visible submesh, the key packs the
+    //blend class, shader, texture set and quantised depth so that
+    //sorting the list also groups draws which share render state
     struct SortData final
     {
-        std::int64_t flags = 0;
-        std::vector<std::int32_t> matIDs;
+        std::uint64_t key = 0;
+        std::int32_t matID = 0;
     };
 
     using MaterialPair = std::pair<Entity, SortData>;
-    using MaterialList = std::vector<MaterialPair>;
+    using MaterialList = Detail::FrameArena<MaterialPair>;
 
 
     /*!
@@ -85,6 +89,7 @@ namespace cro
 
         /*!
         \brief Returns the size of the draw list of the given camera for the given pass
+        Each visible submesh occupies one entry in the draw list.
         Camera indices can be retrieved with Camera::getDrawlistIndex(). For example
         \begincode
             std::size_t visible = scene.getSystem<cro::ModelRenderer>()->getVisibleCount(camera.getDrawlistIndex(), cro::Camera::Pass::Final);
@@ -94,6 +99,53 @@ namespace cro
         */
         std::size_t getVisibleCount(std::size_t cameraIndex, std::int32_t passIndex = 0) const;
 
+        /*!
+        \brief Render statistics, accumulated across all cameras
+        which were rendered since the last call to process()
+        */
+        struct RenderStats final
+        {
+            std::uint32_t programBinds = 0; //!< number of calls to glUseProgram
+            std::uint32_t uniformUploads = 0; //!< number of glUniform* calls
+            std::uint32_t drawCalls = 0; //!< number of submeshes drawn
+        };
+
+        /*!
+        \brief Returns the RenderStats for the current frame
+        */
+        const RenderStats& getRenderStats() const { return m_renderStats; }
+
+        /*!
+        \brief Returns the allocation count and memory usage of the draw lists of all cameras
+        */
+        DrawListStats getDrawListStats() const;
+
+        /*!
+        \brief Enables or disables frustum culling with a bounding volume hierarchy.
+        By default every Model is tested against the frustum of each camera pass,
+        every frame. When enabled Models are stored in a dynamic AABB tree which
+        is only updated when a Model's Transform or bounds change, and only the
+        branches of the tree which intersect a frustum are visited. This is
+        usually faster for scenes containing large numbers of static Models.
+        Disabled by default.
+        */
+        void setTreeCullingEnabled(bool enabled);
+
+        /*!
+        \brief Returns true if tree culling is enabled
+        */
+        bool getTreeCullingEnabled() const { return m_useTreeQueries; }
+
+        /*!
+        \brief Creates a sort key for a submesh from its material and its distance from the camera.
+        Opaque materials are sorted by blend mode, shader and texture set, then front to back.
+        Transparent materials are always sorted after opaque materials and back to front, with
+        shader and texture set used only to break ties between draws at the same depth.
+        \param material The material with which the submesh will be drawn
+        \param distance The distance of the submesh from the camera, along the camera's forward vector
+        */
+        static std::uint64_t createSortKey(const Material::Data& material, float distance);
+
         struct VertexShaderID final
         {
             enum
@@ -136,13 +188,24 @@ namespace cro
         std::vector<DrawList> m_drawLists;
 
         Mesh::IndexData::Pass m_pass;
+        RenderStats m_renderStats;
 
-        /*Detail::BalancedTree m_tree;
-        bool m_useTreeQueries;*/
+        Detail::BalancedTree m_tree;
+        bool m_useTreeQueries;
+        bool m_treeRefitPending; //set each frame by process()
+
+        //reused each frame by the default path to batch cull spheres
+        SphereBatch m_cullBatch;
+        std::vector<Entity> m_cullEntities;
+        std::vector<std::uint32_t> m_cullResults;
 
         void updateDrawListDefault(Entity);
         void updateDrawListBalancedTree(Entity);
-        //std::vector<Entity> queryTree(Box) const;
+
+        void addToTree(Entity);
+        void updateTreeNode(Entity);
+        void addToDrawList(Entity, const Model&, const Sphere&, const Camera&, glm::vec3, std::int32_t, std::uint32_t);
+        static Sphere getWorldSphere(Entity, const Model&);
 
         friend class DeferredRenderSystem;
         //these funcs are shared with above system - should probably be free funcs somewhere?
@@ -33,6 +33,7 @@ source distribution.
 #include <crogine/ecs/Renderable.hpp>
 
 #include <crogine/graphics/Shader.hpp>
+#include <crogine/graphics/Spatial.hpp>
 #include <crogine/graphics/Texture.hpp>
 
 #include <crogine/gui/GuiClient.hpp>
@@ -42,6 +43,8 @@ source distribution.
 
 namespace cro
 {
+    class ParticleEmitter;
+
     /*!
     \brief Particle system.
     Updates and renders all particle emitters in the scene.
@@ -79,10 +82,17 @@ namespace cro
 
         std::vector<Entity> m_potentiallyVisible; //entities which are in front of at least one camera
 
+        //emitter bounds gathered for each pass and culled in one batch
+        SphereBatch m_cullBatch;
+        std::vector<Entity> m_cullEntities;
+        std::vector<std::uint32_t> m_cullResults;
+
+        void updateVertexData(ParticleEmitter&);
+
         void onEntityAdded(Entity) override;
         void onEntityRemoved(Entity) override;
 
-        std::vector<float> m_dataBuffer;
+        std::vector<float> m_dataBuffer; //< used on mobile, desktop writes directly to the mapped VBO
         std::vector<std::uint32_t> m_vboIDs;
         std::vector<std::uint32_t> m_vaoIDs; //< used on desktop
         std::size_t m_nextBuffer;
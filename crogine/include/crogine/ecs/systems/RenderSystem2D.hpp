@@ -31,14 +31,25 @@ source distribution.
 
 #include <crogine/ecs/System.hpp>
 #include <crogine/ecs/Renderable.hpp>
+#include <crogine/ecs/components/Camera.hpp>
 #include <crogine/graphics/MaterialData.hpp>
 #include <crogine/graphics/Shader.hpp>
+#include <crogine/graphics/Vertex2D.hpp>
 #include <crogine/detail/QuadTree.hpp>
 #include <crogine/detail/glm/vec2.hpp>
 #include <crogine/detail/glm/matrix.hpp>
 
+#include <array>
+#include <memory>
+
 namespace cro
 {
+    class Drawable2D;
+    namespace Detail
+    {
+        class SpriteBatcher;
+    }
+
     /*!
     \brief Used to decide by which criteria 2D drawables are sorted.
     Drawables are sorted by the given axis of their transform in the
@@ -120,6 +131,44 @@ namespace cro
         */
         static const std::string& getDefaultVertexShader();
 
+        /*!
+        \brief Enables or disables automatic batching of drawables.
+        When enabled, consecutive drawables (in sort order) which share
+        the same texture, blend mode, facing and cropping area are
+        transformed on the CPU and drawn with a single draw call from
+        a vertex buffer shared by the whole system. Only drawables using
+        the default shaders with no bound uniforms, and with a primitive
+        type of GL_TRIANGLES, GL_TRIANGLE_STRIP or GL_TRIANGLE_FAN are
+        batched - all other drawables are drawn individually as usual.
+        This is most effective with large numbers of small drawables
+        such as Sprite and Text components used in menus. Note that
+        batched geometry is not clipped by the near and far planes
+        of the camera. Disabled by default.
+        */
+        void setBatchingEnabled(bool enabled) { m_batchingEnabled = enabled; }
+
+        /*!
+        \brief Returns whether or not batching is enabled
+        \see setBatchingEnabled()
+        */
+        bool getBatchingEnabled() const { return m_batchingEnabled; }
+
+        /*!
+        \brief Render statistics, accumulated across all cameras
+        which were rendered since the last call to process()
+        */
+        struct RenderStats final
+        {
+            std::uint32_t drawables = 0; //!< number of drawables rendered
+            std::uint32_t batches = 0; //!< number of draw calls made from the shared vertex buffer
+            std::uint32_t drawCalls = 0; //!< total number of draw calls, batched or otherwise
+        };
+
+        /*!
+        \brief Returns the RenderStats for the current frame
+        */
+        const RenderStats& getRenderStats() const { return m_renderStats; }
+
     private:
 
         Shader m_colouredShader;
@@ -129,8 +178,37 @@ namespace cro
         bool m_needsSort;
         std::vector<std::vector<Entity>> m_drawLists;
 
+        bool m_batchingEnabled;
+        RenderStats m_renderStats;
+        std::unique_ptr<Detail::SpriteBatcher> m_batcher;
+
+        //ring buffer of vertex data shared by all batched drawables
+        struct VertexArena final
+        {
+            std::uint32_t vbo = 0;
+            std::array<std::uint32_t, 2u> vao = {}; //coloured, textured. Only used on desktop
+            std::size_t capacity = 0; //in vertices
+            std::size_t offset = 0;
+        }m_vertexArena;
+
+        //uniform locations of the default shaders, coloured, textured
+        struct DefaultUniforms final
+        {
+            std::int32_t world = -1;
+            std::int32_t viewProjection = -1;
+            std::int32_t texture = -1;
+        };
+        std::array<DefaultUniforms, 2u> m_defaultUniforms = {};
+
         void applyBlendMode(Material::BlendMode);
         glm::ivec2 mapCoordsToPixel(glm::vec2, const glm::mat4& viewProjMat, IntRect) const;
+        IntRect getScissor(const Drawable2D&, const glm::mat4& viewProjMat, IntRect viewport, glm::uvec2 targetSize) const;
+
+        bool isBatchable(const Drawable2D&) const;
+        void renderBatched(const std::vector<Entity>&, const Camera::Pass&, IntRect viewport, glm::uvec2 targetSize, std::uint32_t& lastProgram);
+        void drawEntity(Entity, const Camera::Pass&, IntRect viewport, glm::uvec2 targetSize, std::uint32_t& lastProgram);
+        std::size_t uploadArena(const std::vector<Vertex2D>&);
+        void applyArenaAttributes(const Shader&);
 
         void onEntityAdded(Entity) override;
         void onEntityRemoved(Entity) override;
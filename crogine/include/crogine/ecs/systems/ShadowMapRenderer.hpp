@@ -34,6 +34,8 @@ source distribution.
 #include <crogine/ecs/Renderable.hpp>
 #include <crogine/graphics/RenderTexture.hpp>
 #include <crogine/graphics/DepthTexture.hpp>
+#include <crogine/graphics/Spatial.hpp>
+#include <crogine/detail/FrameArena.hpp>
 
 namespace cro
 {
@@ -123,6 +125,11 @@ namespace cro
         void updateDrawList(Entity) override;
         void render(Entity, const RenderTarget&) override {};
 
+        /*!
+        \brief Returns the allocation count and memory usage of the shadow cascade draw lists
+        */
+        DrawListStats getDrawListStats() const;
+
     private:
         std::uint32_t m_interval;
         
@@ -136,7 +143,15 @@ namespace cro
             float distance = 0.f;
         };
         //for each camera, for each camera cascade, a vector of entities
-        std::vector<std::vector<std::vector<Drawable>>> m_drawLists;
+        std::vector<std::vector<Detail::FrameArena<Drawable>>> m_drawLists;
+
+        std::vector<glm::vec3> m_lightPositions;
+        std::vector<Frustum> m_cascadeFrustums;
+
+        //world space casters, shared by all cascades of a camera
+        SphereBatch m_cullBatch;
+        std::vector<Entity> m_cullEntities;
+        std::vector<std::uint32_t> m_cullResults;
 
         void render();
 
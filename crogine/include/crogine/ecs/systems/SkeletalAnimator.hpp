@@ -29,16 +29,22 @@ source distribution.
 
 #pragma once
 
+#include <crogine/core/Message.hpp>
+#include <crogine/core/ThreadPool.hpp>
 #include <crogine/ecs/System.hpp>
 #include <crogine/ecs/components/Skeleton.hpp>
 #include <crogine/graphics/MeshData.hpp>
 
+#include <unordered_map>
 #include <vector>
 
 namespace cro
 {
     /*!
-    \brief System used to update any models which have a skeleton component
+    \brief System used to update any models which have a skeleton component.
+    Skeletons attached to another skeleton via an Attachment are updated
+    after the skeleton to which they are attached, so that they follow its
+    pose from the current frame.
     */
     class CRO_EXPORT_API SkeletalAnimator : public System
     {
@@ -52,11 +58,22 @@ namespace cro
 
         float getPlaybackRate() const;
 
-    private:
-        mutable std::vector<glm::mat4> m_mixBuffer; //holds temporary output during animation blending
-        
-        void onEntityAdded(Entity) override;
+        /*!
+        \brief Enables or disables updating skeletons on multiple threads.
+        When enabled, and there are enough skeletons to make it worthwhile,
+        skeletons are split into batches which are updated on the shared
+        ThreadPool. Animation events and attachment updates are always
+        applied on the calling thread in update order, so the output is
+        identical to updating on a single thread. Enabled by default.
+        */
+        void setMultithreaded(bool enabled) { m_multithreaded = enabled; }
+
+        /*!
+        \brief Returns true if multithreaded updates are enabled
+        */
+        bool getMultithreaded() const { return m_multithreaded; }
 
+    private:
         struct AnimationContext final
         {
             bool useInterpolation = false;
@@ -64,13 +81,39 @@ namespace cro
             float dt = 1.f / 60.f;
             bool writeOutput = true; //if false the result of interpolation isn't output to the current frame
         };
+        std::vector<AnimationContext> m_contexts; //one for each entity, created before updating
+
+        //entity indices sorted so that attached skeletons come after their parents.
+        //each level is updated in turn, skeletons within a level may be updated in parallel
+        std::vector<std::size_t> m_updateOrder;
+        std::vector<std::size_t> m_levelEnds;
+        std::vector<std::size_t> m_depths;
+        std::unordered_map<Entity::ID, std::size_t> m_entityIndices;
+
+        //each batch of entities has its own working data
+        //so that batches can be updated on different threads
+        struct Batch final
+        {
+            std::vector<glm::mat4> mixBuffer; //holds temporary output during animation blending
+            std::vector<Message::SkeletalAnimationEvent> events; //deferred until all batches are done
+        };
+        std::vector<Batch> m_batches;
+
+        bool m_multithreaded;
+        ThreadPool::JobGroup m_jobGroup;
+
+        void onEntityAdded(Entity) override;
+
+        void buildUpdateOrder();
+
+        void processBatch(Batch&, std::size_t start, std::size_t end);
 
-        void updateAnimation(SkeletalAnim& anim, Skeleton& skeleton, Entity entity, const AnimationContext& ctx) const;
+        void updateAnimation(SkeletalAnim& anim, Skeleton& skeleton, Entity entity, const AnimationContext& ctx, Batch&) const;
 
         //interpolates frames within a single animation (move this to anim struct?)
-        void interpolateAnimation(SkeletalAnim& source, std::size_t targetFrame, float time, Skeleton& skeleton, bool) const;
+        void interpolateAnimation(SkeletalAnim& source, std::size_t targetFrame, float time, Skeleton& skeleton, bool, std::vector<glm::mat4>& mixBuffer) const;
 
-        void blendAnimations(const SkeletalAnim&, const SkeletalAnim&, float time, Skeleton&) const;
+        void blendAnimations(const SkeletalAnim&, const SkeletalAnim&, float time, Skeleton&, std::vector<glm::mat4>& mixBuffer) const;
 
         void updateBoundsFromCurrentFrame(Skeleton& dest, const Mesh::Data&) const;
     };
@@ -30,6 +30,7 @@ source distribution.
 #pragma once
 
 #include <crogine/ecs/System.hpp>
+#include <crogine/graphics/Shader.hpp>
 
 namespace cro
 {
@@ -41,6 +42,8 @@ namespace cro
     is treated individually - for batching of text geometry a
     custom System can be defined which will combine multiple
     text instances into a single Drawable2D component.
+    Text using a Font in SDF mode is assigned a distance field
+    shader, unless a custom shader has been set on the Drawable2D.
 
     \see System, Text, RenderSystem2D
     */
@@ -57,6 +60,8 @@ namespace cro
 
     private:
 
+        Shader m_sdfShader;
+
         //mechanism for marking fonts with updated pages
         //as read. This is double buffered to save iterating
         //over twice in the same update loop
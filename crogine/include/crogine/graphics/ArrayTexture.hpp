@@ -32,6 +32,7 @@ source distribution.
 #include <crogine/Config.hpp>
 #include <crogine/core/Log.hpp>
 #include <crogine/graphics/ImageArray.hpp>
+#include <crogine/graphics/CompressedImage.hpp>
 #include <crogine/graphics/MaterialData.hpp>
 #include <crogine/detail/OpenGL.hpp>
 #include <crogine/detail/glm/vec2.hpp>
@@ -188,6 +189,30 @@ namespace cro
             //bind tex and upload
             return updateTexture(data.data(), layer);
         }
+
+        /*!
+        \brief Inserts the base level of a block compressed image.
+        Array textures are stored as RGBA8 so the image is decompressed
+        on the CPU before uploading. Only available for U8 textures.
+        */
+        bool insertLayer(const cro::CompressedImage& image, std::uint32_t layer)
+        {
+            static_assert(std::is_same<T, std::uint8_t>::value, "Compressed images require U8 array textures");
+
+            if (!image.canDecompress())
+            {
+                LogE << __FILE__ << " compressed image format cannot be decompressed" << std::endl;
+                return false;
+            }
+
+            if (image.getSize() != getSize())
+            {
+                LogE << __FILE__ << " compressed image incorrect dimensions" << std::endl;
+                return false;
+            }
+
+            return insertLayer(image.decompress(), layer);
+        }
     private:
 
         std::uint32_t m_handle = 0;
@@ -0,0 +1,185 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/Config.hpp>
+
+#include <crogine/detail/glm/vec2.hpp>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace cro
+{
+    /*!
+    \brief CPU side representation of a block compressed image.
+    CompressedImages are loaded from KTX2 or DDS containers and contain
+    a base image in one of the supported Formats, and optionally a
+    precomputed mip chain. They can be uploaded directly to the GPU via
+    Texture::loadFromCompressedImage(), which also falls back to
+    decompress() on hardware which doesn't support the format.
+
+    KTX2 files must contain a single 2D image with no supercompression.
+    sRGB formats are treated as their linear equivalents. DDS files may
+    use either the legacy FourCC or the DX10 header, but not arrays or
+    cube maps.
+    */
+    class CRO_EXPORT_API CompressedImage final
+    {
+    public:
+        enum class Format
+        {
+            None,
+            BC1, //!< DXT1 RGB with optional 1 bit alpha
+            BC2, //!< DXT3 RGBA with explicit alpha
+            BC3, //!< DXT5 RGBA with interpolated alpha
+            BC4, //!< RGTC1 single channel (red)
+            BC5, //!< RGTC2 two channel (red, green)
+            BC7, //!< BPTC RGBA. This is not supported by decompress()
+            ETC2_RGB, //!< ETC2 RGB, including ETC1
+            ETC2_RGBA //!< ETC2 RGB with EAC alpha
+        };
+
+        CompressedImage() = default;
+
+        /*!
+        \brief Attempts to load a *.ktx2 or *.dds file.
+        \param path Path to the file. This is an absolute path
+        so on macOS MUST include getResourcePath() if loading from a bundle.
+        \param flipOnLoad Set to true to reorder the rows so that the first
+        row is the bottom of the image, as Texture expects. Only BC1-BC5
+        images can be flipped in compressed form. Other formats are flipped
+        by decompress(), so Texture decodes them on the CPU unless they
+        are stored bottom up, eg with the KTX2 orientation 'ru'. BC7 can't
+        be decoded so must be stored bottom up.
+        \returns true on success, else false. Images larger than 16384
+        texels in either dimension are rejected.
+        */
+        bool loadFromFile(const std::string& path, bool flipOnLoad = false);
+
+        /*!
+        \brief Attempts to load a *.ktx2 or *.dds file from memory.
+        \see loadFromFile()
+        */
+        bool loadFromMemory(const std::uint8_t* data, std::size_t size, bool flipOnLoad = false);
+
+        /*!
+        \brief Returns the block compression format of the image,
+        or Format::None if nothing is loaded.
+        */
+        Format getFormat() const { return m_format; }
+
+        /*!
+        \brief Returns the size of the base level in pixels
+        */
+        glm::uvec2 getSize() const;
+
+        /*!
+        \brief Returns the number of mip levels in the image,
+        including the base level
+        */
+        std::size_t getLevelCount() const { return m_levels.size(); }
+
+        /*!
+        \brief Returns the size of the given level in pixels
+        */
+        glm::uvec2 getLevelSize(std::size_t level) const;
+
+        /*!
+        \brief Returns a pointer to the compressed data of the given level
+        */
+        const std::uint8_t* getLevelData(std::size_t level) const;
+
+        /*!
+        \brief Returns the size of the compressed data of the given level in bytes
+        */
+        std::size_t getLevelByteCount(std::size_t level) const;
+
+        /*!
+        \brief Returns true if the image data is ordered bottom
+        row first, either because flipOnLoad was requested or
+        because the file was stored that way.
+        */
+        bool isBottomUp() const { return m_bottomUp; }
+
+        /*!
+        \brief Returns true if flipOnLoad was requested but the blocks
+        couldn't be reordered. The compressed data is still stored top
+        down, and only decompress() returns the image flipped.
+        */
+        bool needsRowFlip() const { return m_flipRows; }
+
+        /*!
+        \brief Returns true if the format can be decoded on the CPU
+        */
+        bool canDecompress() const;
+
+        /*!
+        \brief Decodes the given level to RGBA8 pixels.
+        \returns A vector of getLevelSize().x * getLevelSize().y * 4
+        bytes, or an empty vector if the format can't be decoded.
+        If flipOnLoad was requested but the blocks couldn't be
+        flipped, the decoded rows are flipped instead.
+        */
+        std::vector<std::uint8_t> decompress(std::size_t level = 0) const;
+
+        /*!
+        \brief Returns the size in bytes of a 4x4 block of the given format
+        */
+        static std::size_t getBlockSize(Format);
+
+        /*!
+        \brief Returns true if the path has a file extension
+        which can be loaded as a CompressedImage
+        */
+        static bool isCompressedFile(const std::string& path);
+
+    private:
+        struct Level final
+        {
+            glm::uvec2 size = glm::uvec2(0u);
+            std::size_t offset = 0;
+            std::size_t byteCount = 0;
+        };
+
+        Format m_format = Format::None;
+        std::vector<std::uint8_t> m_data;
+        std::vector<Level> m_levels;
+        bool m_bottomUp = false;
+        bool m_flipRows = false;
+
+        bool parseKTX2(const std::uint8_t*, std::size_t);
+        bool parseDDS(const std::uint8_t*, std::size_t);
+        bool addLevel(const std::uint8_t*, std::size_t, std::size_t, glm::uvec2);
+        bool flipBlocks();
+        void reset();
+    };
+}
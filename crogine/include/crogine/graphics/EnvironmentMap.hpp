@@ -58,6 +58,10 @@ namespace cro
     as a parameter to the load function.
 
     EnvironmentMaps load their data from radiance *.hdr files.
+    Processing the file is expensive, so the results are cached
+    in the user's preference directory and reused next time the
+    same file is loaded. A cache can also be created offline with
+    createCache() and shipped alongside the *.hdr file.
     For visual feedback an environment map can be set as a Scene's
     skybox, using Scene::setCubemap()
 
@@ -93,6 +97,20 @@ namespace cro
         */
         bool loadFromFile(const std::string& path);
 
+        /*!
+        \brief Processes a radiance *.hdr file on the CPU and writes the
+        results to a cache file, without requiring an OpenGL context.
+        When the cache is written alongside the *.hdr file, eg sky.hdr
+        and sky.cenv, loadFromFile() will use it instead of processing
+        the *.hdr file at run time. This is slow, and intended for
+        use in tools or at build time.
+        \param path Path to the *.hdr file to process
+        \param cachePath Path to write the cache file to. If this is
+        empty the file is written alongside the *.hdr file.
+        \returns true on success, else false
+        */
+        static bool createCache(const std::string& path, const std::string& cachePath = "");
+
         /*!
         \brief Returns the texture ID for the skybox cubemap.
         This can be bound to material properties for shaders which have
@@ -144,6 +162,10 @@ namespace cro
         void renderIrradianceMap(std::uint32_t fbo, std::uint32_t rbo, Shader&);
         void renderPrefilterMap(std::uint32_t fbo, std::uint32_t rbo, Shader&);
         void renderBRDFMap(std::uint32_t fbo, std::uint32_t rbo, Shader&);
+        bool createBRDFMap();
+
+        bool loadFromCache(const std::string& path, std::uint64_t sourceHash);
+        void writeCache(const std::string& path, std::uint64_t sourceHash) const;
 
         std::uint32_t m_cubeVBO;
         std::uint32_t m_cubeVAO;
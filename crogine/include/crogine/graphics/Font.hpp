@@ -189,8 +189,9 @@ namespace cro
 
         /*!
         \brief Returns a reference to the texture used by the font.
-        Note that different character sizes use different textures, and that
-        when a texture is resized internally its GL handle my change
+        Note that different character sizes use different textures, unless
+        the font is in SDF mode, and that when a texture is resized
+        internally its GL handle my change
         */
         const Texture& getTexture(std::uint32_t charSize) const;
 
@@ -210,9 +211,47 @@ namespace cro
         */
         void setSmooth(bool smooth);
 
+        /*!
+        \brief Enables or disables signed distance field mode.
+        When enabled glyphs are rasterised once at a fixed size into
+        a single distance field atlas, which is shared by all character
+        sizes. Text using the font is drawn with a distance field shader
+        so it remains sharp when scaled. Colour glyphs such as emojis
+        are reduced to their alpha channel in this mode.
+        This should be set before the font is used by any text, as
+        glyphs already loaded in another mode are not rebuilt.
+        The default value is false.
+        */
+        void setSDF(bool sdf);
+
+        /*!
+        \brief Returns true if signed distance field mode is enabled
+        */
+        bool isSDF() const;
+
+        /*!
+        \brief Atlas usage information returned by getAtlasStats()
+        */
+        struct AtlasStats final
+        {
+            std::size_t pageCount = 0; //!< number of atlas textures
+            std::size_t textureBytes = 0; //!< memory used by the atlas textures
+            std::size_t glyphCount = 0; //!< glyphs stored in all pages
+            std::size_t glyphMisses = 0; //!< number of glyphs which needed rasterising
+            float rasteriseTime = 0.f; //!< total time in milliseconds spent rasterising glyphs
+        };
+
+        /*!
+        \brief Returns the current atlas memory usage and the
+        accumulated cost of glyph cache misses
+        */
+        AtlasStats getAtlasStats() const;
+
     private:
 
         bool m_useSmoothing;
+        bool m_useSDF;
+        mutable AtlasStats m_atlasStats;
 
         struct Row final
         {
@@ -247,7 +286,9 @@ namespace cro
 
         const FontData& getFontData(std::uint32_t cp) const;
 
-        Glyph loadGlyph(std::uint32_t cp, std::uint32_t charSize, bool bold, float outlineThickness) const;
+        std::uint32_t getPageKey(std::uint32_t charSize) const;
+        const Glyph& findGlyph(std::uint32_t pageKey, std::uint32_t cp, std::uint32_t charSize, bool bold, float outlineThickness) const;
+        Glyph loadGlyph(Page&, std::uint32_t cp, std::uint32_t charSize, bool bold, float outlineThickness) const;
         FloatRect getGlyphRect(Page&, std::uint32_t w, std::uint32_t h) const;
         bool setCurrentCharacterSize(std::uint32_t) const;
 
@@ -100,17 +100,30 @@ namespace cro
             static const std::size_t MaxBuffers = 32;
         };
 
+        /*!
+        \brief Describes how an attribute is stored in a vertex buffer
+        which contains packed vertex data, such as those created from
+        compact model binaries.
+        */
+        struct CRO_EXPORT_API AttributeFormat final
+        {
+            std::uint32_t type = 0; //!< GLenum type of each component, eg GL_SHORT. 0 is the same as GL_FLOAT
+            bool normalised = false; //!< true if integer values are normalised when read by a shader
+        };
+
         /*!
         \brief Struct of mesh data used by Model components
         */
         struct CRO_EXPORT_API Data final
         {
             std::size_t vertexCount = 0;
-            std::size_t vertexSize = 0; //!< size of a single vertex *in bytes*
+            std::size_t vertexSize = 0; //!< size of a single vertex *in bytes* when stored as floats, eg by readVertexData()
+            std::size_t packedVertexSize = 0; //!< size of a single vertex in the vbo in bytes if it contains packed attributes, else 0
             std::uint32_t vbo = 0;
             std::uint32_t primitiveType = 0;
             std::array<std::size_t, Mesh::Attribute::Total> attributes{}; //!< size of attribute if it exists
             std::uint32_t attributeFlags = 0; //!< bitmask of VertexProperty flags indicating the current properties of the vertex data.
+            std::array<AttributeFormat, Mesh::Attribute::Total> attributeFormats{}; //!< format of each attribute if the vertex data is packed
 
             //index arrays
             std::size_t submeshCount = 0;
@@ -122,7 +135,28 @@ namespace cro
         };
 
         /*!
-        \brief Utility to read back vertex data and index data
+        \brief Returns the size in bytes of a single vertex in the vbo of the given mesh data
+        */
+        std::size_t CRO_EXPORT_API getVertexStride(const Data& meshData);
+
+        /*!
+        \brief Returns the size in bytes of the given attribute in the vbo
+        of the given mesh data, including any padding of packed attributes.
+        */
+        std::size_t CRO_EXPORT_API getAttributeSize(const Data& meshData, std::int32_t attribute);
+
+        /*!
+        \brief Replaces the contents of the mesh vbo with the given vertex data.
+        The vertex data is expected in the float layout returned by readVertexData()
+        and contain meshData.vertexCount vertices. If the vbo contains packed
+        attributes the data is packed before it is uploaded.
+        */
+        void CRO_EXPORT_API writeVertexData(const Data& meshData, const std::vector<float>& vertexData);
+
+        /*!
+        \brief Utility to read back vertex data and index data.
+        Vertex data is always returned as floats, with a stride of
+        Data::vertexSize, even if the vbo contains packed attributes.
         */
         void CRO_EXPORT_API readVertexData(const Data& meshData, std::vector<float>& destVerts, std::vector<std::vector<std::uint8_t>>& destIndices);
         void CRO_EXPORT_API readVertexData(const Data& meshData, std::vector<float>& destVerts, std::vector<std::vector<std::uint16_t>>& destIndices);
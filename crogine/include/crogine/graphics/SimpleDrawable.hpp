@@ -153,6 +153,15 @@ namespace cro
         \brief Returns a pointer to the active texture if there is one
         */
         const Texture* getTexture() const { return m_texture; }
+
+        /*!
+        \brief Swaps the built-in texture shader for a signed
+        distance field shader, for example when drawing text with
+        a Font in SDF mode. Custom shaders are not replaced.
+        \param enabled If false and the SDF shader is active the
+        default texture shader is restored.
+        */
+        void setSDFShader(bool enabled);
         
         /*!
         \brief Sets the OpenGL primitive type with which to
@@ -34,6 +34,8 @@ source distribution.
 #include <crogine/detail/glm/vec4.hpp>
 
 #include <array>
+#include <vector>
+#include <cstdint>
 
 namespace cro
 {
@@ -52,6 +54,26 @@ namespace cro
         bool contains(glm::vec3) const;
     };
 
+    /*!
+    \brief Structure of arrays containing a set of spheres to be
+    culled in a single pass with Spatial::intersects(Frustum, SphereBatch)
+    Storage is retained between calls to clear() so that a batch reused
+    each frame will stop allocating once it has grown to its working size.
+    */
+    struct CRO_EXPORT_API SphereBatch final
+    {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+        std::vector<float> radius;
+
+        void clear();
+        void reserve(std::size_t count);
+        void push_back(const Sphere&);
+        std::size_t size() const { return radius.size(); }
+        bool empty() const { return radius.empty(); }
+    };
+
     enum class Planar
     {
         Intersection, Front, Back
@@ -83,5 +105,27 @@ namespace cro
         \return cro::Box containing the AABB of the newly updated frustum
         */
         cro::Box CRO_EXPORT_API updateFrustum(std::array<Plane, 6u>& frustum, glm::mat4 viewProj);
+
+        /*!
+        \brief Tests every sphere in the given batch against the given frustum.
+        Spheres are tested several at a time using SSE/AVX or NEON where available.
+        \param frustum Frustum to test against. Planes are expected to be
+        normalised and facing inwards, as created by updateFrustum()
+        \param spheres SphereBatch containing the spheres to test
+        \param visibility Resized to hold one bit per sphere, packed 32 to
+        an element. Bit n is set if sphere n is not entirely behind any plane,
+        ie (visibility[n / 32] & (1 << (n % 32))) != 0
+        \returns The number of visible spheres
+        */
+        std::size_t CRO_EXPORT_API intersects(const Frustum& frustum, const SphereBatch& spheres, std::vector<std::uint32_t>& visibility);
+
+        /*!
+        \brief Returns true if the bit for the given index is set in a
+        visibility mask created by intersects(Frustum, SphereBatch)
+        */
+        inline bool isVisible(const std::vector<std::uint32_t>& visibility, std::size_t index)
+        {
+            return (visibility[index / 32] & (1u << (index % 32))) != 0;
+        }
     }
 }
\ No newline at end of file
@@ -75,6 +75,18 @@ namespace cro
 
     Be Aware: binary files are little endian (intel) by default.
 
+    Version 3 files store the vertex data in a compact form. These
+    are marked by the top bit (0x80) of the flags byte, which is
+    followed by the index array count as above, then a std::uint32_t
+    containing a combination of ModelBinary::CompactFlags. The
+    remaining header is the same, and its size includes the extra
+    std::uint32_t. Attributes flagged as compact are stored in the
+    same packed layout used on the GPU - colour as 3 x std::uint8_t
+    normalised, normal, tangent and bitangent as 3 x std::int16_t
+    normalised and UVs as 2 x half float. Each attribute is padded
+    with zeros to a multiple of 4 bytes. If CompactIndices is set
+    the index arrays are std::uint16_t rather than std::uint32_t.
+
     */
 
     class CRO_EXPORT_API StaticMeshBuilder final : public MeshBuilder
@@ -91,6 +103,18 @@ namespace cro
         */
         std::size_t getUID() const override { return m_uid; }
 
+        /*!
+        \brief Writes the given mesh data to a *.cmf file.
+        The mesh must have the vertex layout of a static mesh, for
+        example one loaded with a StaticMeshBuilder.
+        \param meshData The mesh data to write
+        \param path Path of the file to write
+        \param compact Set to true to write a version 3 file with quantised
+        vertex data and 16 bit indices where possible.
+        \returns true on success
+        */
+        static bool write(const Mesh::Data& meshData, const std::string& path, bool compact = false);
+
     private:
         std::string m_path;
         std::size_t m_uid;
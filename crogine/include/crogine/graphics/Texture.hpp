@@ -42,6 +42,7 @@ namespace cro
 {
     class Image;
     class Colour;
+    class CompressedImage;
 
     /*!
     \brief Generic texture wrapper for OpenGL RGB or RGBA textures.
@@ -75,6 +76,7 @@ namespace cro
 
         /*!
         \brief Attempts to load the file in the given file path.
+        *.ktx2 and *.dds files are loaded via loadFromCompressedImage()
         \param path Path to file to load. The image file should have pow2 dimensions on mobile platforms
         \param createMipMaps Set true to automatically create mipmap levels for this texture
         \returns true on success, else false
@@ -90,6 +92,24 @@ namespace cro
         */
         bool loadFromImage(const Image& image, bool createMipmaps = false);
 
+        /*!
+        \brief Attempts to create the texture from a block compressed image.
+        The compressed data is uploaded as-is if the current context supports
+        the image format, else the image is decompressed to RGBA on the CPU.
+        Images which were loaded with flipOnLoad but couldn't be flipped in
+        compressed form are also decompressed, so that they appear the right
+        way up. BC7 images in this state are rejected.
+        Any mip levels stored in the image are uploaded with it.
+        Compressed textures can't be modified with update().
+        \param image A CompressedImage containing the data to upload
+        \param createMipMaps Set to true to generate mip maps if the image
+        contains only a single level. This is ignored if the data is uploaded
+        in compressed form.
+        \returns true on success, else false
+        \see CompressedImage
+        */
+        bool loadFromCompressedImage(const CompressedImage& image, bool createMipMaps = false);
+
         /*!
         \brief Updates the pixel data for the texture.
         Ensure the texture is valid by calling create() or successfully calling loadFromFile()
@@ -205,6 +225,7 @@ namespace cro
         bool m_smooth;
         bool m_repeated;
         bool m_hasMipMaps;
+        bool m_compressed;
 
         bool update(const void* pixels, bool createMipMaps, URect area);
         void generateMipMaps();
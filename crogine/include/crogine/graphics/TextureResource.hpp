@@ -36,6 +36,7 @@ source distribution.
 #include <unordered_map>
 #include <string>
 #include <memory>
+#include <limits>
 
 //hash for colours
 namespace std
@@ -60,7 +61,7 @@ namespace cro
     {
     public:
         TextureResource();
-        ~TextureResource() = default;
+        ~TextureResource();
 
         TextureResource(const TextureResource&) = delete;
         TextureResource(TextureResource&&) noexcept = default;
@@ -78,6 +79,39 @@ namespace cro
         */
         bool load(std::uint32_t id, const std::string& path, bool createMipMaps = false);
 
+        /*!
+        \brief Starts loading the image at the given path in the background.
+        The image is decoded on a worker thread, and uploaded to the GPU either
+        by processPending(), or when the ID is first requested with get() or
+        load() - in which case the calling thread will wait for the decode to
+        complete if necessary. Until then the ID is not considered loaded.
+        \param id ID to assign to the texture once it has loaded.
+        \param path String containing the path of the image to load
+        \param createMipMaps Attempts to create the default MipMap levels
+        when uploading the texture.
+        \returns false if the ID is already assigned to a different path
+        */
+        bool loadAsync(std::uint32_t id, const std::string& path, bool createMipMaps = false);
+
+        /*!
+        \brief Uploads any textures requested with loadAsync() which have
+        finished decoding. This should be called from the thread which owns
+        the OpenGL context, for example once per frame while a loading screen
+        is displayed.
+        \param maxCount The maximum number of textures to upload in this call.
+        \returns The number of textures which are still waiting to be uploaded
+        */
+        std::size_t processPending(std::size_t maxCount = std::numeric_limits<std::size_t>::max());
+
+        /*!
+        \brief Starts decoding the image at the given path on a worker thread
+        so that a following call to get() with the same path only has to
+        upload it. Does nothing if the image is already loaded. Images which
+        are preloaded should always be requested with get() afterwards, else
+        the decoded data is kept in memory.
+        */
+        void preload(const std::string& path);
+
         /*!
         \brief Returns a reference to the texture currently assigned to the given ID
         If the ID doesn't correspond to a loaded texture then a reference to the fallback
@@ -117,6 +151,14 @@ namespace cro
         std::unordered_map<Colour, std::unique_ptr<Texture>> m_fallbackTextures;
         Colour m_fallbackColour;
 
+        struct PendingTexture final
+        {
+            std::string path;
+            bool createMipMaps = false;
+        };
+        std::unordered_map<std::uint32_t, PendingTexture> m_pendingTextures;
+
         Texture& getFallbackTexture();
+        bool loadPending(std::uint32_t id);
     };
 }
\ No newline at end of file
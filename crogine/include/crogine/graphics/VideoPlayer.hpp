@@ -36,14 +36,16 @@ source distribution.
 #include <crogine/graphics/RenderTexture.hpp>
 #include <crogine/graphics/SimpleQuad.hpp>
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 struct plm_t;
 typedef plm_t plm_t;
 
-struct plm_plane_t;
-typedef plm_plane_t plm_plane_t;
-
 struct plm_frame_t;
 typedef plm_frame_t plm_frame_t;
 
@@ -65,6 +67,10 @@ namespace cro
 
     In testing VCD video files have been found to not present audio
     channels to the plm decoder, and need to be remuxed as MPG-PS.
+
+    Decoding is done on a worker thread, one frame ahead of playback,
+    so the only work done by update() on the main thread is uploading
+    the frame to be displayed.
     */
 
     class CRO_EXPORT_API VideoPlayer final : public cro::Detail::SDLResource
@@ -93,13 +99,12 @@ namespace cro
         bool loadFromFile(const std::string& path);
 
         /*!
-        \brief Updates the decoding of the file, if a file is open.
-        This is automatically locked to the frame rate of the video
-        up to the maximum rate at which this is called, at which point
-        frames will be skipped.
+        \brief Updates the playback of the file, if a file is open.
+        This advances the playback time and displays the most recent
+        frame decoded by the worker thread. Frames will be skipped if
+        the worker is unable to keep up, or this is called less often
+        than the video frame rate.
         \param dt The time since this function was last called
-
-        hmmmmm - shame we can't spin this off into a thread, but OpenGL.
         */
         void update(float dt);
 
@@ -164,13 +169,61 @@ namespace cro
         plm_t* m_plm;
         bool m_looped;
 
-        float m_timeAccumulator;
         float m_frameTime;
+        float m_duration;
+        std::atomic<float> m_position;
 
         enum class State
         {
             Stopped, Playing, Paused
-        }m_state;
+        };
+        std::atomic<State> m_state;
+
+        //decoded frames are copied into one of these by the worker
+        //and uploaded by the main thread when their time comes
+        struct Frame final
+        {
+            struct Plane final
+            {
+                std::vector<std::uint8_t> data;
+                std::uint32_t width = 0;
+                std::uint32_t height = 0;
+            };
+            Plane y, cb, cr;
+
+            double time = 0.0; //presentation time
+            float position = 0.f; //position in the file
+            bool hasImage = false;
+
+            enum
+            {
+                Free, Decoding, Ready, Presenting
+            }state = Free;
+        };
+        static constexpr std::size_t FrameQueueSize = 3;
+        std::array<Frame, FrameQueueSize> m_frames = {};
+        Frame* m_decodeFrame; //frame currently being written by the video callback
+
+        //guards the frame queue and the clocks
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        double m_presentTime;
+        double m_decodeTime;
+        std::uint32_t m_generation; //incremented by seek/stop to discard in-flight frames
+        bool m_ended;
+
+        //guards m_plm, which is used by the worker while decoding
+        mutable std::mutex m_decodeMutex;
+
+        std::atomic<bool> m_running;
+        std::thread m_thread;
+
+        void startThread();
+        void stopThread();
+        void threadFunc();
+        bool canDecode() const;
+        void resetQueue();
+        bool presentFrame();
 
         cro::Shader m_shader;
 
@@ -180,7 +233,7 @@ namespace cro
         cro::SimpleQuad m_quad;
         cro::RenderTexture m_outputBuffer;
 
-        void updateTexture(std::uint32_t, plm_plane_t*);
+        void updateTexture(std::uint32_t, const Frame::Plane&);
         void updateBuffer();
 
 
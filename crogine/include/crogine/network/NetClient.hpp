@@ -139,6 +139,16 @@ namespace cro
         */
         void sendPacket(std::uint8_t id, const void* data, std::size_t size, NetFlag flags, std::uint8_t channel = 0) const;
 
+        /*!
+        \brief Sends a packet created with a NetPacketBuilder to the server.
+        The packet is sent without being copied, and the builder is left empty.
+        If there is no connection the packet is destroyed.
+        \param packet The packet to send
+        \param channel Stream channel over which to send the data
+        \see NetPacketBuilder
+        */
+        void sendPacket(NetPacketBuilder&& packet, std::uint8_t channel = 0) const;
+
         /*!
         \brief Returns a reference to the client's peer.
         Peers are only valid when connected to a server.
@@ -157,6 +167,17 @@ namespace cro
         std::list<std::any> m_activeBuffer;
         std::atomic_bool m_threadRunning;
         void threadFunc();
+
+        //batch of packets currently being read by pollEvent()
+        struct ReceivedBatch final
+        {
+            _ENetPacket* packet = nullptr;
+            std::size_t offset = 0;
+            std::uint8_t channel = 0;
+        }m_receivedBatch;
+
+        bool readBatch(NetEvent&);
+        void releaseBatch();
     };
 
 #include "NetClient.inl"
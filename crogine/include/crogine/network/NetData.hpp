@@ -137,6 +137,10 @@ namespace cro
             std::uint8_t m_id;
             void setPacketData(_ENetPacket*);
 
+            //reads the next packet from a batch starting at offset, and
+            //advances offset. Returns false if there are no more packets
+            bool readBatch(_ENetPacket* batch, std::size_t& offset);
+
             friend class NetClient;
             friend class NetHost;
         }packet;
@@ -147,7 +151,6 @@ namespace cro
         NetPeer peer;
     };
 
-#include "NetData.inl"
 
     /*!
     \brief Reliability enum.
@@ -159,4 +162,86 @@ namespace cro
         Unsequenced = 0x2, //! <packet will not be sequenced with other packets. Not supported on reliable packets
         Unreliable = 0x4 //! <packet will be fragments and sent unreliably if it exceeds MTU
     };
+
+    /*!
+    \brief Packet ID reserved for batches of packets queued with NetHost::queuePacket().
+    Batches are split back into individual packets by NetClient::pollEvent() and
+    NetHost::pollEvent() so applications should never send packets with this ID.
+    */
+    constexpr std::uint8_t NetBatchPacketID = 0xff;
+
+    /*!
+    \brief Constructs a packet in place, ready to send with a NetHost or NetClient.
+    The packet is allocated once, at its final size, when the builder is created.
+    Data can then either be appended with write() or serialised directly into the
+    buffer returned by getData(), avoiding any intermediate copies. Once sent the
+    builder is empty and can no longer be written to.
+    \begincode
+    cro::NetPacketBuilder packet(PacketID::ActorUpdate, sizeof(ActorInfo) * actorCount, cro::NetFlag::Unreliable);
+    for (const auto& actor : actors)
+    {
+        packet.write(actor.info);
+    }
+    host.broadcastPacket(std::move(packet));
+    \endcode
+    */
+    class CRO_EXPORT_API NetPacketBuilder final
+    {
+    public:
+        /*!
+        \brief Constructor.
+        \param id Unique ID of this packet
+        \param size Size in bytes of the data to be sent, not including the ID
+        \param flags Requested reliability of the packet
+        */
+        NetPacketBuilder(std::uint8_t id, std::size_t size, NetFlag flags);
+        ~NetPacketBuilder();
+
+        NetPacketBuilder(const NetPacketBuilder&) = delete;
+        NetPacketBuilder& operator = (const NetPacketBuilder&) = delete;
+        NetPacketBuilder(NetPacketBuilder&&) noexcept;
+        NetPacketBuilder& operator = (NetPacketBuilder&&) noexcept;
+
+        /*!
+        \brief Copies the given struct of simple data to the current write position
+        and advances the write position by the size of the struct.
+        */
+        template <typename T>
+        void write(const T& data);
+
+        /*!
+        \brief Copies size bytes of data to the current write position and
+        advances the write position. Writing beyond the size given on construction
+        will grow the packet, although this requires a reallocation.
+        */
+        void write(const void* data, std::size_t size);
+
+        /*!
+        \brief Returns a pointer to the beginning of the packet data, after the ID,
+        for serialising directly into the packet.
+        */
+        void* getData();
+
+        /*!
+        \brief Returns the size of the packet data, not including the ID
+        */
+        std::size_t getSize() const;
+
+        /*!
+        \brief Returns true if the builder holds a packet which has not yet been sent
+        */
+        operator bool() const { return m_packet != nullptr; }
+
+    private:
+        _ENetPacket* m_packet;
+        std::size_t m_writePosition;
+
+        //transfers ownership of the packet to the caller
+        _ENetPacket* release();
+
+        friend class NetClient;
+        friend class NetHost;
+    };
+
+#include "NetData.inl"
 }
\ No newline at end of file
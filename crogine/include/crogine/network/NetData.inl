@@ -37,4 +37,10 @@ T NetEvent::Packet::as() const
     std::memcpy(&returnData, getData(), getSize());
 
     return returnData;
-}
\ No newline at end of file
+}
+
+template <typename T>
+void NetPacketBuilder::write(const T& data)
+{
+    write(&data, sizeof(T));
+}
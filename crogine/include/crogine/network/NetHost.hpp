@@ -34,6 +34,7 @@ source distribution.
 #include <crogine/network/NetData.hpp>
 
 #include <string>
+#include <vector>
 
 struct _ENetHost;
 
@@ -152,6 +153,71 @@ namespace cro
         */
         void sendPacket(const NetPeer& peer, std::uint8_t id, const void* data, std::size_t size, NetFlag flags, std::uint8_t channel = 0) const;
 
+        /*!
+        \brief Sends a packet created with a NetPacketBuilder to the given peer.
+        The packet is sent without being copied, and the builder is left empty.
+        If the peer is not valid the packet is destroyed.
+        \param peer The peer over which to send the packet
+        \param packet The packet to send
+        \param channel Stream channel over which to send the data
+        \see NetPacketBuilder
+        */
+        void sendPacket(const NetPeer& peer, NetPacketBuilder&& packet, std::uint8_t channel = 0) const;
+
+        /*!
+        \brief Broadcasts a packet created with a NetPacketBuilder to all connected clients.
+        A single packet is shared between all the clients rather than copied for each of them.
+        \param packet The packet to send
+        \param channel Stream channel over which to send the data
+        \see NetPacketBuilder
+        */
+        void broadcastPacket(NetPacketBuilder&& packet, std::uint8_t channel = 0) const;
+
+        /*!
+        \brief Queues a small, unreliable, packet to be sent to the given peer.
+        Rather than sending each packet individually all the packets queued for a
+        peer on the same channel are combined into as few datagrams as possible,
+        which are sent the next time pollEvent() or flushQueuedPackets() is called.
+        This greatly reduces the overhead of sending many small updates each net
+        tick, such as actor positions. The packets are split up again on arrival so
+        they are received as if they were sent individually, although as they are
+        unreliable an entire batch may be lost.
+        \param peer The peer to which to send the packet
+        \param id Unique ID for this packet
+        \param data Struct of simple data to send
+        \param channel Stream channel over which to send the data
+        */
+        template <typename T>
+        void queuePacket(const NetPeer& peer, std::uint8_t id, const T& data, std::uint8_t channel = 0);
+
+        /*!
+        \brief Queues the given array of bytes to be batched with other packets
+        sent to the given peer.
+        \see queuePacket()
+        */
+        void queuePacket(const NetPeer& peer, std::uint8_t id, const void* data, std::size_t size, std::uint8_t channel = 0);
+
+        /*!
+        \brief Queues a packet to be batched with other packets sent to all connected clients.
+        \see queuePacket()
+        */
+        template <typename T>
+        void queueBroadcast(std::uint8_t id, const T& data, std::uint8_t channel = 0);
+
+        /*!
+        \brief Queues the given array of bytes to be batched with other packets sent to
+        all connected clients.
+        \see queuePacket()
+        */
+        void queueBroadcast(std::uint8_t id, const void* data, std::size_t size, std::uint8_t channel = 0);
+
+        /*!
+        \brief Sends any packets queued with queuePacket() or queueBroadcast().
+        This is called automatically by pollEvent(), but may be called manually,
+        for example at the end of each net tick.
+        */
+        void flushQueuedPackets();
+
 
         /*!
         \brief Disconnects the given peer from this host, if it is valid
@@ -167,6 +233,28 @@ namespace cro
     private:
 
         _ENetHost* m_host;
+
+        //packets queued for each peer on each channel are written
+        //directly to a single packet which is sent when flushed
+        struct QueuedBatch final
+        {
+            _ENetPacket* packet = nullptr;
+            std::size_t size = 0;
+        };
+        std::vector<QueuedBatch> m_queuedBatches; //indexed by (peer * channelCount) + channel
+        std::size_t m_channelCount;
+
+        //batch currently being read by pollEvent()
+        struct ReceivedBatch final
+        {
+            _ENetPacket* packet = nullptr;
+            _ENetPeer* peer = nullptr;
+            std::size_t offset = 0;
+            std::uint8_t channel = 0;
+        }m_receivedBatch;
+
+        bool readBatch(NetEvent&);
+        void sendBatch(QueuedBatch&, std::size_t peerIndex, std::uint8_t channel);
     };
 
 #include "NetHost.inl"
@@ -37,4 +37,16 @@ template <typename T>
 void NetHost::sendPacket(const NetPeer& peer, std::uint8_t id, const T& data, NetFlag flags, std::uint8_t channel) const
 {
     sendPacket(peer, id, (void*)&data, sizeof(T), flags, channel);
-}
\ No newline at end of file
+}
+
+template <typename T>
+void NetHost::queuePacket(const NetPeer& peer, std::uint8_t id, const T& data, std::uint8_t channel)
+{
+    queuePacket(peer, id, (void*)&data, sizeof(T), channel);
+}
+
+template <typename T>
+void NetHost::queueBroadcast(std::uint8_t id, const T& data, std::uint8_t channel)
+{
+    queueBroadcast(id, (void*)&data, sizeof(T), channel);
+}
@@ -33,6 +33,8 @@ source distribution.
 #include <crogine/core/Log.hpp>
 #include <crogine/detail/Assert.hpp>
 
+#include "PCMCache.hpp"
+
 #include <vector>
 
 using namespace cro;
@@ -110,4 +112,23 @@ const AudioSource& AudioResource::get(std::int32_t id) const
 {
     if (m_sources.count(id) == 0) return *m_fallback;
     return *m_sources.find(id)->second;
-}
\ No newline at end of file
+}
+
+void AudioResource::setCacheBudget(std::size_t bytes)
+{
+    Detail::PCMCache::getInstance().setBudget(bytes);
+}
+
+AudioResource::CacheStats AudioResource::getCacheStats()
+{
+    const auto stats = Detail::PCMCache::getInstance().getStats();
+
+    CacheStats retVal;
+    retVal.residentBytes = stats.residentBytes;
+    retVal.budget = stats.budget;
+    retVal.fileCount = stats.entryCount;
+    retVal.hits = stats.hits;
+    retVal.misses = stats.misses;
+    retVal.decodeTime = stats.decodeTime;
+    return retVal;
+}
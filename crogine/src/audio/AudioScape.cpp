@@ -30,6 +30,8 @@ source distribution.
 #include <crogine/audio/AudioResource.hpp>
 #include <crogine/audio/AudioScape.hpp>
 
+#include "PCMCache.hpp"
+
 using namespace cro;
 
 AudioScape::AudioScape()
@@ -49,6 +51,24 @@ bool AudioScape::loadFromFile(const std::string& path, AudioResource& audioResou
         m_name.clear();
 
         const auto& objs = cfg.getObjects();
+
+        //start decoding all the buffered sounds in the background so
+        //they're decoded in parallel rather than as each is loaded below
+        for (const auto& obj : objs)
+        {
+            const auto* mediaPath = obj.findProperty("path");
+            const auto* streaming = obj.findProperty("streaming");
+            if (mediaPath && streaming
+                && !streaming->getValue<bool>())
+            {
+                auto fullPath = FileSystem::getResourcePath() + mediaPath->getValue<std::string>();
+                if (FileSystem::fileExists(fullPath))
+                {
+                    Detail::PCMCache::getInstance().predecode(fullPath);
+                }
+            }
+        }
+
         for (const auto& obj : objs)
         {
             if (obj.getId().empty())
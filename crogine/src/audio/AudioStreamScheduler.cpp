@@ -0,0 +1,210 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "AudioStreamScheduler.hpp"
+
+#include <crogine/detail/Assert.hpp>
+
+using namespace cro;
+using namespace cro::Detail;
+
+AudioStreamScheduler::AudioStreamScheduler()
+    : m_nextHandle  (0),
+    m_runningTask   (-1),
+    m_removeRunning (false),
+    m_totalLatency  (0),
+    m_running       (false)
+{
+
+}
+
+AudioStreamScheduler::~AudioStreamScheduler()
+{
+    {
+        std::scoped_lock lock(m_mutex);
+        m_running = false;
+    }
+    m_condition.notify_one();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+//public
+std::int32_t AudioStreamScheduler::addTask(Task task, Duration initialDelay)
+{
+    CRO_ASSERT(task, "Task is empty");
+
+    std::int32_t handle = 0;
+    {
+        std::scoped_lock lock(m_mutex);
+
+        handle = m_nextHandle++;
+        m_tasks[handle].task = std::move(task);
+        m_queue.push({ Clock::now() + initialDelay, handle, 0 });
+
+        //the thread is only launched once it's needed, so
+        //applications which never stream audio don't pay for it
+        if (!m_running)
+        {
+            m_running = true;
+            m_thread = std::thread(&AudioStreamScheduler::threadFunc, this);
+        }
+    }
+    m_condition.notify_one();
+
+    return handle;
+}
+
+void AudioStreamScheduler::removeTask(std::int32_t handle)
+{
+    std::unique_lock lock(m_mutex);
+
+    if (m_runningTask == handle)
+    {
+        if (std::this_thread::get_id() == m_thread.get_id())
+        {
+            //the task is removing itself, so erase it once it returns
+            m_removeRunning = true;
+            return;
+        }
+
+        m_taskComplete.wait(lock, [&]() {return m_runningTask != handle; });
+    }
+
+    //any remaining queue entries are skipped once the task is missing
+    m_tasks.erase(handle);
+}
+
+void AudioStreamScheduler::wake(std::int32_t handle)
+{
+    {
+        std::scoped_lock lock(m_mutex);
+
+        auto result = m_tasks.find(handle);
+        if (result == m_tasks.end())
+        {
+            return;
+        }
+
+        //invalidates the existing queue entry
+        result->second.generation++;
+        m_queue.push({ Clock::now(), handle, result->second.generation });
+    }
+    m_condition.notify_one();
+}
+
+void AudioStreamScheduler::reportUnderrun()
+{
+    std::scoped_lock lock(m_mutex);
+    m_metrics.underruns++;
+}
+
+AudioStreamScheduler::Metrics AudioStreamScheduler::getMetrics() const
+{
+    std::scoped_lock lock(m_mutex);
+    return m_metrics;
+}
+
+AudioStreamScheduler& AudioStreamScheduler::getInstance()
+{
+    static AudioStreamScheduler instance;
+    return instance;
+}
+
+//private
+void AudioStreamScheduler::threadFunc()
+{
+    std::unique_lock lock(m_mutex);
+
+    while (m_running)
+    {
+        if (m_queue.empty())
+        {
+            m_condition.wait(lock);
+            continue;
+        }
+
+        const auto entry = m_queue.top();
+        auto result = m_tasks.find(entry.handle);
+        if (result == m_tasks.end()
+            || result->second.generation != entry.generation)
+        {
+            //task was removed or woken early
+            m_queue.pop();
+            continue;
+        }
+
+        auto now = Clock::now();
+        if (entry.deadline > now)
+        {
+            //may be woken early if a task is added with an earlier deadline
+            m_condition.wait_until(lock, entry.deadline);
+            continue;
+        }
+        m_queue.pop();
+
+        const auto latency = std::chrono::duration_cast<Duration>(now - entry.deadline);
+        m_metrics.services++;
+        m_metrics.maxLatency = std::max(m_metrics.maxLatency, latency);
+        m_totalLatency += latency;
+        m_metrics.averageLatency = m_totalLatency / m_metrics.services;
+
+        //references to unordered_map elements remain valid while other
+        //elements are inserted, although iterators are invalidated if the
+        //map rehashes. This element can't be erased by removeTask() while
+        //it is marked as running
+        m_runningTask = entry.handle;
+        auto& data = result->second;
+
+        lock.unlock();
+        const auto delay = data.task();
+        lock.lock();
+
+        m_runningTask = -1;
+
+        if (delay == Finished || m_removeRunning)
+        {
+            m_tasks.erase(entry.handle);
+            m_removeRunning = false;
+        }
+        else if (data.generation == entry.generation)
+        {
+            //if the generation changed the task was woken while
+            //running and a new entry has already been queued
+            m_queue.push({ Clock::now() + delay, entry.handle, entry.generation });
+        }
+
+        lock.unlock();
+        m_taskComplete.notify_all();
+        lock.lock();
+    }
+}
@@ -0,0 +1,158 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cro
+{
+    namespace Detail
+    {
+        /*!
+        \brief Services all audio streams from a single worker thread.
+        Rather than each stream running its own thread which polls at a
+        fixed interval, streams register a task with the scheduler. Each
+        time a task is run it returns the delay until its buffers next
+        need refilling, and tasks are serviced in deadline order from a
+        priority queue. The worker thread sleeps until the next deadline,
+        or until it is woken by a new task, so no time is spent polling
+        idle streams.
+
+        The scheduler makes no audio API calls itself, so it works with any
+        of the AudioRenderer backends, including NullImpl.
+        */
+        class AudioStreamScheduler final
+        {
+        public:
+            using Duration = std::chrono::microseconds;
+
+            /*!
+            \brief Task function. Returns the delay until the task should
+            next be run, or Finished to remove the task from the scheduler.
+            */
+            using Task = std::function<Duration()>;
+            static constexpr Duration Finished = Duration(-1);
+
+            struct Metrics final
+            {
+                std::uint64_t services = 0; //!< total number of times a task was run
+                std::uint64_t underruns = 0; //!< number of times a stream reported running out of buffered data
+                Duration maxLatency = Duration(0); //!< the latest any task was run after its deadline
+                Duration averageLatency = Duration(0);
+            };
+
+            AudioStreamScheduler();
+            ~AudioStreamScheduler();
+
+            AudioStreamScheduler(const AudioStreamScheduler&) = delete;
+            AudioStreamScheduler(AudioStreamScheduler&&) = delete;
+            AudioStreamScheduler& operator = (const AudioStreamScheduler&) = delete;
+            AudioStreamScheduler& operator = (AudioStreamScheduler&&) = delete;
+
+            /*!
+            \brief Adds a task to be first run after the given delay.
+            \returns A handle used to remove the task
+            */
+            std::int32_t addTask(Task, Duration initialDelay = Duration(0));
+
+            /*!
+            \brief Removes the task with the given handle.
+            If the task is currently running this blocks until it
+            completes, so once this returns the task is guaranteed
+            never to be run again. Safe to call with a handle which
+            has already finished.
+            */
+            void removeTask(std::int32_t handle);
+
+            /*!
+            \brief Runs the given task as soon as possible, rather than
+            waiting for its current deadline
+            */
+            void wake(std::int32_t handle);
+
+            /*!
+            \brief Used by tasks to report that a stream ran out of data
+            */
+            void reportUnderrun();
+
+            Metrics getMetrics() const;
+
+            /*!
+            \brief Returns the scheduler shared by all streams
+            */
+            static AudioStreamScheduler& getInstance();
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            struct TaskData final
+            {
+                Task task;
+                std::uint32_t generation = 0;
+            };
+
+            struct QueueEntry final
+            {
+                Clock::time_point deadline;
+                std::int32_t handle = -1;
+                std::uint32_t generation = 0;
+
+                bool operator > (const QueueEntry& other) const { return deadline > other.deadline; }
+            };
+
+            mutable std::mutex m_mutex;
+            std::condition_variable m_condition;
+            std::condition_variable m_taskComplete;
+
+            std::unordered_map<std::int32_t, TaskData> m_tasks;
+            std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> m_queue;
+            std::int32_t m_nextHandle;
+            std::int32_t m_runningTask;
+            bool m_removeRunning;
+
+            Metrics m_metrics;
+            Duration m_totalLatency;
+
+            bool m_running;
+            std::thread m_thread;
+
+            void threadFunc();
+        };
+    }
+}
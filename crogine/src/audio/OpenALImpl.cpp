@@ -33,6 +33,7 @@ source distribution.
 #include "VorbisLoader.hpp"
 #include "Mp3Loader.hpp"
 #include "BufferedStreamLoader.hpp"
+#include "PCMCache.hpp"
 
 #include <crogine/detail/Assert.hpp>
 #include <crogine/util/String.hpp>
@@ -53,6 +54,12 @@ using namespace cro::Detail;
 
 namespace
 {
+    //streams which aren't playing are polled at this rate
+    constexpr AudioStreamScheduler::Duration IdleInterval = std::chrono::milliseconds(50);
+    constexpr AudioStreamScheduler::Duration MinInterval = std::chrono::milliseconds(5);
+    //retry delay if the main thread is modifying the stream
+    constexpr AudioStreamScheduler::Duration RetryInterval = std::chrono::milliseconds(1);
+
     constexpr std::size_t STREAM_CHUNK_SIZE = 32768;// 48000u * sizeof(std::uint16_t) * 30; //30 sec of stereo @ highest quality (mono)
 
     ALenum getFormatFromData(const PCMData& data)
@@ -70,6 +77,32 @@ namespace
             return AL_FORMAT_STEREO16;
         }
     }
+
+    AudioStreamScheduler::Duration getDuration(const PCMData& data)
+    {
+        std::uint32_t bytesPerSecond = data.frequency;
+        switch (data.format)
+        {
+        default:
+        case PCMData::Format::MONO8:
+            break;
+        case PCMData::Format::MONO16:
+        case PCMData::Format::STEREO8:
+            bytesPerSecond *= 2;
+            break;
+        case PCMData::Format::STEREO16:
+            bytesPerSecond *= 4;
+            break;
+        }
+
+        if (bytesPerSecond == 0)
+        {
+            return AudioStreamScheduler::Duration(0);
+        }
+
+        return std::chrono::duration_cast<AudioStreamScheduler::Duration>(
+            std::chrono::duration<double>(static_cast<double>(data.size) / bytesPerSecond));
+    }
 }
 
 OpenALImpl::OpenALImpl()
@@ -182,44 +215,11 @@ glm::vec3 OpenALImpl::getListenerPosition() const
 
 std::int32_t OpenALImpl::requestNewBuffer(const std::string& filePath)
 {
-    auto path = FileSystem::getResourcePath() + filePath;
-
-    std::unique_ptr<AudioFile> loader;
-    
-    auto ext = FileSystem::getFileExtension(path);
-    PCMData data;
-    if (ext == ".wav")
-    {      
-        loader = std::make_unique<WavLoader>();
-        if (loader->open(path))
-        {
-            data = loader->getData();
-        }
-    }
-    else if (ext == ".ogg")
-    {
-        loader = std::make_unique<VorbisLoader>();
-        if (loader->open(path))
-        {
-            data = loader->getData();
-        }
-    }
-    else if (ext == ".mp3")
-    {
-        loader = std::make_unique<Mp3Loader>();
-        if (loader->open(path))
-        {
-            data = loader->getData();
-        }
-    }
-    else
+    //decoded data is shared with any other buffers loaded from the same file
+    auto pcm = PCMCache::getInstance().get(FileSystem::getResourcePath() + filePath);
+    if (pcm)
     {
-        Logger::log(ext + ": format not supported", Logger::Type::Error);
-    }
-
-    if (data.data)
-    {
-        return requestNewBuffer(data);
+        return requestNewBuffer(pcm->getData());
     }
     
     return -1;
@@ -339,14 +339,12 @@ void OpenALImpl::deleteStream(std::int32_t id)
     {
         alCheck(alSourceStop(stream.sourceID));
     }
-    stream.running = false;
 
-    if (stream.thread)
+    if (stream.taskID > -1)
     {
-        //we can't just detach as we need to reset the
-        //thread pointer.
-        stream.thread->join();
-        stream.thread.reset();
+        //blocks if the stream is currently being updated
+        AudioStreamScheduler::getInstance().removeTask(stream.taskID);
+        stream.taskID = -1;
     }
 
     if (stream.buffers[0])
@@ -362,6 +360,8 @@ void OpenALImpl::deleteStream(std::int32_t id)
         stream.audioFile.reset();
         stream.currentBuffer = 0;
         stream.sourceID = -1;
+        stream.bufferDuration = AudioStreamScheduler::Duration(0);
+        stream.endOfStream = false;
 
         m_nextFreeStream--;
 
@@ -400,14 +400,12 @@ std::int32_t OpenALImpl::requestAudioSource(std::int32_t buffer, bool streaming)
         }
         else
         {
-            //sync with the stream thread...
+            //sync with the stream update...
             auto& stream = m_streams[buffer];
-            while (stream.busy) {}
+            std::scoped_lock lock(stream.mutex);
 
-            stream.accessed = true;
             stream.sourceID = source;
             alCheck(alSourceQueueBuffers(source, static_cast<ALsizei>(stream.buffers.size()), stream.buffers.data()));
-            stream.accessed = false;
         }
 
         return source;
@@ -438,13 +436,10 @@ void OpenALImpl::updateAudioSource(std::int32_t sourceID, std::int32_t bufferID,
     else
     {
         auto& stream = m_streams[bufferID];
+        std::scoped_lock lock(stream.mutex);
 
-        while (stream.busy) {}
-
-        stream.accessed = true;
         stream.sourceID = sourceID;
         alCheck(alSourceQueueBuffers(sourceID, static_cast<ALsizei>(stream.buffers.size()), stream.buffers.data()));
-        stream.accessed = false;
     }
 }
 
@@ -489,7 +484,7 @@ void OpenALImpl::deleteAudioSource(std::int32_t source)
 void OpenALImpl::playSource(std::int32_t source, bool looped)
 {
     //OpenAL is supposed to be thread safe according to the spec
-    //so we only sync stream threads if we actually touch a stream
+    //so we only sync stream updates if we actually touch a stream
     //object and modify it.
 
     ALuint src = static_cast<ALuint>(source);
@@ -506,13 +501,16 @@ void OpenALImpl::playSource(std::int32_t source, bool looped)
     }
     else
     {
-        while (result->busy) {}
-
-        result->accessed = true;
+        std::scoped_lock lock(result->mutex);
         result->looped = looped;
-        result->accessed = false;
     }
     alCheck(alSourcePlay(src));
+
+    if (result != m_streams.end())
+    {
+        //refill now rather than waiting for the next idle update
+        AudioStreamScheduler::getInstance().wake(result->taskID);
+    }
 }
 
 void OpenALImpl::pauseSource(std::int32_t source)
@@ -549,11 +547,9 @@ void OpenALImpl::setPlayingOffset(std::int32_t source, cro::Time offset)
     }
     else
     {
-        while (result->busy) {}
-
-        result->accessed = true;
+        std::scoped_lock lock(result->mutex);
         result->audioFile->seek(offset);
-        result->accessed = false;
+        result->endOfStream = false;
     }
 }
 
@@ -616,6 +612,12 @@ void OpenALImpl::printDebug()
 {
     ImGui::Text("Source Cache Size %lu", m_sourcePool.size());
     ImGui::Text("Sources In Use %lu", m_nextFreeSource);
+
+    const auto metrics = AudioStreamScheduler::getInstance().getMetrics();
+    ImGui::Text("Streams In Use %lu", m_nextFreeStream);
+    ImGui::Text("Stream Underruns %llu", static_cast<unsigned long long>(metrics.underruns));
+    ImGui::Text("Stream Refill Latency Avg %lldus Max %lldus",
+        static_cast<long long>(metrics.averageLatency.count()), static_cast<long long>(metrics.maxLatency.count()));
 }
 
 //private
@@ -797,12 +799,12 @@ void OpenALImpl::enumerateDevices()
 
 OpenALStream& OpenALImpl::getNextFreeStream()
 {
-    //we shouldn't have to lock here as the stream's thread has not yet been created
+    //we shouldn't have to lock here as the stream's update has not yet been scheduled
     auto streamID = m_streamIDs[m_nextFreeStream];
 
     //attempt to open the file
     auto& stream = m_streams[streamID];
-    CRO_ASSERT(!stream.thread, "this shouldn't be running yet!");
+    CRO_ASSERT(stream.taskID == -1, "this shouldn't be running yet!");
     stream.streamID = streamID;
 
     return stream;
@@ -819,10 +821,10 @@ bool OpenALImpl::initStream(OpenALStream& stream)
         {
             auto& audioData = stream.audioFile->getData(STREAM_CHUNK_SIZE);
             alCheck(alBufferData(b, getFormatFromData(audioData), audioData.data, audioData.size, audioData.frequency));
+            stream.bufferDuration = std::max(stream.bufferDuration, getDuration(audioData));
         }
 
-        stream.running = true;
-        stream.thread = std::make_unique<std::thread>(&OpenALStream::updateStream, &stream);
+        stream.taskID = AudioStreamScheduler::getInstance().addTask([&stream]() { return stream.updateStream(); });
 
         //hurrah we has stream
         m_nextFreeStream++;
@@ -832,75 +834,77 @@ bool OpenALImpl::initStream(OpenALStream& stream)
     return false;
 }
 
-//stream thread function
-void OpenALStream::updateStream()
+//stream update function
+AudioStreamScheduler::Duration OpenALStream::updateStream()
 {
-    //this is called by a stream's thread
-    while (running)
+    //this is called by the AudioStreamScheduler's thread.
+    //if the main thread is modifying the stream try again shortly
+    std::unique_lock lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock())
     {
-        //wait for the main thread to finish what it's
-        //doing to the stream
-        while (accessed) {}
+        return RetryInterval;
+    }
 
-        //check if we need update
-        busy = true;
+    if (sourceID > -1)
+    {
+        std::int32_t processed = 0;
+        alCheck(alGetSourcei(sourceID, AL_BUFFERS_PROCESSED, &processed));
 
-        if (sourceID > -1)
+        if (processed == static_cast<std::int32_t>(buffers.size())
+            && state == AL_PLAYING
+            && !endOfStream)
         {
-            std::int32_t processed = 0;
-            alCheck(alGetSourcei(sourceID, AL_BUFFERS_PROCESSED, &processed));
+            AudioStreamScheduler::getInstance().reportUnderrun();
+        }
 
-            //if stopped rewind file and load buffers
-            ALenum newState;
-            alCheck(alGetSourcei(sourceID, AL_SOURCE_STATE, &newState));
-            if (newState != state && newState == AL_STOPPED)
-            {
-                audioFile->seek(cro::Time());
-                processed = static_cast<ALint>(buffers.size());
-            }
+        //if stopped rewind file and load buffers
+        ALenum newState;
+        alCheck(alGetSourcei(sourceID, AL_SOURCE_STATE, &newState));
+        if (newState != state && newState == AL_STOPPED)
+        {
+            audioFile->seek(cro::Time());
+            processed = static_cast<ALint>(buffers.size());
+            endOfStream = false;
+        }
 
-            //update the buffers if necessary
-            if (processed > 0
-                && state == AL_PLAYING)
+        //update the buffers if necessary
+        if (processed > 0
+            && state == AL_PLAYING)
+        {
+            for (auto i = 0; i < processed; ++i)
             {
-                for (auto i = 0; i < processed; ++i)
+                //fill buffer
+                const auto& data = audioFile->getData(STREAM_CHUNK_SIZE, looped);
+                if (data.size > 0) //only update if we have data else we'll loop even if we don't want to
                 {
-                    //fill buffer
-                    const auto& data = audioFile->getData(STREAM_CHUNK_SIZE, looped);
-                    if (data.size > 0) //only update if we have data else we'll loop even if we don't want to
-                    {
-                        //unqueue
-                        alCheck(alSourceUnqueueBuffers(sourceID, 1, &buffers[currentBuffer]));
+                    //unqueue
+                    alCheck(alSourceUnqueueBuffers(sourceID, 1, &buffers[currentBuffer]));
 
-                        //refill
-                        alCheck(alBufferData(buffers[currentBuffer], getFormatFromData(data), data.data, data.size, data.frequency));
+                    //refill
+                    alCheck(alBufferData(buffers[currentBuffer], getFormatFromData(data), data.data, data.size, data.frequency));
 
-                        //requeue
-                        alCheck(alSourceQueueBuffers(sourceID, 1, &buffers[currentBuffer]));
+                    //requeue
+                    alCheck(alSourceQueueBuffers(sourceID, 1, &buffers[currentBuffer]));
 
-                        //increment currentBuffer
-                        currentBuffer = (currentBuffer + 1) % buffers.size();
-                    }
-                }
+                    //increment currentBuffer
+                    currentBuffer = (currentBuffer + 1) % buffers.size();
 
-                busy = false;
-                processed = 0;
-            }
-            else
-            {
-                //sleep for a bit
-                //it's important to sleep *after* the busy flag is set to
-                //false as this is the time the main thread might set the 'accessed' flag
-                busy = false;
-                std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(50));
+                    bufferDuration = std::max(bufferDuration, getDuration(data));
+                }
+                else
+                {
+                    endOfStream = true;
+                }
             }
-            state = newState;
         }
-        else
+        state = newState;
+
+        if (state == AL_PLAYING)
         {
-            //sleep for a bit
-            busy = false;
-            std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(50));
+            //check again well before the oldest queued buffer runs out
+            return std::clamp(bufferDuration / 2, MinInterval, IdleInterval);
         }
     }
+
+    return IdleInterval;
 }
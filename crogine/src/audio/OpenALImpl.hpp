@@ -31,6 +31,7 @@ source distribution.
 
 #include "AudioRenderer.hpp"
 #include "AudioFile.hpp"
+#include "AudioStreamScheduler.hpp"
 
 #include <crogine/core/ConsoleClient.hpp>
 #include <crogine/gui/GuiClient.hpp>
@@ -45,7 +46,7 @@ source distribution.
 
 #include <atomic>
 #include <array>
-#include <thread>
+#include <mutex>
 #include <memory>
 
 namespace cro
@@ -62,16 +63,16 @@ namespace cro
             std::int32_t streamID = -1; //NOT the same as source ID!
             //ALint processed = 0;
 
-            std::atomic<bool> busy{ false }; //signifies the thread is processing
-            std::atomic<bool> running{ false }; //signifies the thread is running
-            std::atomic<bool> accessed{ false }; //signifies the main thread is modifying the stream
-            
-            std::unique_ptr<std::thread> thread;
-            void updateStream(); //runs in own thread
+            std::mutex mutex; //locked by the main thread when modifying the stream
+            std::int32_t taskID = -1; //handle of the update task in the AudioStreamScheduler
+            AudioStreamScheduler::Duration bufferDuration = AudioStreamScheduler::Duration(0);
+
+            AudioStreamScheduler::Duration updateStream(); //run by the AudioStreamScheduler. Returns the delay until the next update
 
             std::int32_t sourceID = -1;
             std::atomic<bool> looped{ false };
             ALenum state = AL_STOPPED;
+            bool endOfStream = false; //running out of buffers once the file has no more data isn't an underrun
         };
 
         class OpenALImpl final : public cro::AudioRendererImpl,
@@ -0,0 +1,262 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "PCMCache.hpp"
+#include "WavLoader.hpp"
+#include "VorbisLoader.hpp"
+#include "Mp3Loader.hpp"
+
+#include <crogine/core/FileSystem.hpp>
+#include <crogine/core/Log.hpp>
+#include <crogine/core/ThreadPool.hpp>
+
+#include <chrono>
+#include <cstring>
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    constexpr std::size_t DefaultBudget = 64 * 1024 * 1024;
+}
+
+PCMData DecodedPCM::getData() const
+{
+    PCMData retVal;
+    retVal.format = format;
+    retVal.frequency = frequency;
+    retVal.size = static_cast<std::uint32_t>(samples.size());
+    retVal.data = const_cast<std::uint8_t*>(samples.data());
+    return retVal;
+}
+
+PCMCache::PCMCache()
+{
+    m_stats.budget = DefaultBudget;
+
+    //make sure the shared pool is created first, so that it
+    //is destroyed after this when the process exits
+    ThreadPool::getShared();
+}
+
+PCMCache::~PCMCache()
+{
+    //make sure background decodes finish before the entries are destroyed
+    ThreadPool::getShared().wait(m_jobGroup);
+}
+
+//public
+std::shared_ptr<const DecodedPCM> PCMCache::get(const std::string& path)
+{
+    std::unique_lock lock(m_mutex);
+
+    //wait for any background decode of this file
+    m_decodeComplete.wait(lock, [&]()
+        {
+            auto result = m_entries.find(path);
+            return result == m_entries.end() || !result->second.pending;
+        });
+
+    auto result = m_entries.find(path);
+    if (result != m_entries.end())
+    {
+        m_stats.hits++;
+        m_lru.splice(m_lru.begin(), m_lru, result->second.lruPosition);
+        return result->second.data;
+    }
+
+    m_stats.misses++;
+
+    if (m_stats.budget == 0)
+    {
+        lock.unlock();
+        return decode(path);
+    }
+
+    //mark as pending so other threads requesting this file wait for it
+    m_entries[path];
+    lock.unlock();
+
+    auto data = decode(path);
+
+    lock.lock();
+    insert(path, data);
+    lock.unlock();
+    m_decodeComplete.notify_all();
+
+    return data;
+}
+
+void PCMCache::predecode(const std::string& path)
+{
+    std::scoped_lock lock(m_mutex);
+
+    if (m_stats.budget == 0
+        || m_entries.count(path) != 0)
+    {
+        return;
+    }
+
+    m_entries[path];
+
+    ThreadPool::getShared().push([this, path]()
+        {
+            auto data = decode(path);
+
+            {
+                std::scoped_lock l(m_mutex);
+                insert(path, data);
+            }
+            m_decodeComplete.notify_all();
+        }, m_jobGroup);
+}
+
+void PCMCache::setBudget(std::size_t bytes)
+{
+    std::scoped_lock lock(m_mutex);
+    m_stats.budget = bytes;
+    evict();
+}
+
+PCMCache::Stats PCMCache::getStats() const
+{
+    std::scoped_lock lock(m_mutex);
+
+    auto stats = m_stats;
+    stats.entryCount = m_lru.size();
+    return stats;
+}
+
+PCMCache& PCMCache::getInstance()
+{
+    static PCMCache instance;
+    return instance;
+}
+
+//private
+std::shared_ptr<const DecodedPCM> PCMCache::decode(const std::string& path)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    std::unique_ptr<AudioFile> loader;
+
+    auto ext = FileSystem::getFileExtension(path);
+    if (ext == ".wav")
+    {
+        loader = std::make_unique<WavLoader>();
+    }
+    else if (ext == ".ogg")
+    {
+        loader = std::make_unique<VorbisLoader>();
+    }
+    else if (ext == ".mp3")
+    {
+        loader = std::make_unique<Mp3Loader>();
+    }
+    else
+    {
+        Logger::log(ext + ": format not supported", Logger::Type::Error);
+        return nullptr;
+    }
+
+    //the entry for this path is pending while it's decoded, so an
+    //exception is treated as a failed decode rather than leaving
+    //anyone waiting in get() forever
+    std::shared_ptr<DecodedPCM> retVal;
+    try
+    {
+        if (loader->open(path))
+        {
+            const auto& data = loader->getData();
+            if (data.data)
+            {
+                retVal = std::make_shared<DecodedPCM>();
+                retVal->format = data.format;
+                retVal->frequency = data.frequency;
+                retVal->samples.resize(data.size);
+                std::memcpy(retVal->samples.data(), data.data, data.size);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        LogE << "Failed decoding " << path << ": " << e.what() << std::endl;
+        retVal.reset();
+    }
+    catch (...)
+    {
+        LogE << "Failed decoding " << path << ": unknown exception" << std::endl;
+        retVal.reset();
+    }
+
+    const std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::scoped_lock lock(m_mutex);
+    m_stats.decodeTime += elapsed.count();
+
+    return retVal;
+}
+
+void PCMCache::insert(const std::string& path, std::shared_ptr<const DecodedPCM> data)
+{
+    //assumes m_mutex is locked by the caller
+    if (!data
+        || m_stats.budget == 0)
+    {
+        //failed to decode, or caching was disabled while decoding
+        m_entries.erase(path);
+        return;
+    }
+
+    auto& entry = m_entries[path];
+    entry.pending = false;
+    entry.data = data;
+
+    m_lru.push_front(path);
+    entry.lruPosition = m_lru.begin();
+    m_stats.residentBytes += data->samples.size();
+
+    evict();
+}
+
+void PCMCache::evict()
+{
+    //assumes m_mutex is locked by the caller. Files which are
+    //still in use stay in memory until their last user releases
+    //them, they're just no longer available from the cache
+    while (m_stats.residentBytes > m_stats.budget
+        && !m_lru.empty())
+    {
+        auto result = m_entries.find(m_lru.back());
+        m_stats.residentBytes -= result->second.data->samples.size();
+        m_entries.erase(result);
+        m_lru.pop_back();
+    }
+}
@@ -0,0 +1,138 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include "PCMData.hpp"
+
+#include <crogine/core/ThreadPool.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cro
+{
+    namespace Detail
+    {
+        /*!
+        \brief Fully decoded audio file, shared between all users of the same file.
+        */
+        struct DecodedPCM final
+        {
+            std::vector<std::uint8_t> samples;
+            PCMData::Format format = PCMData::Format::NONE;
+            std::uint32_t frequency = 0;
+
+            //returns a non-owning PCMData describing the samples
+            PCMData getData() const;
+        };
+
+        /*!
+        \brief Process wide cache of decoded audio files.
+        Decoded files are keyed by their path and held as reference counted,
+        immutable buffers. Once the total size of the cached data exceeds the
+        memory budget the least recently used files are evicted. Files may be
+        decoded in the background with predecode(), in which case any calls to
+        get() for the same file will wait for the decode to complete rather
+        than decoding the file a second time.
+        */
+        class PCMCache final
+        {
+        public:
+            struct Stats final
+            {
+                std::size_t residentBytes = 0;
+                std::size_t budget = 0;
+                std::size_t entryCount = 0;
+                std::uint64_t hits = 0;
+                std::uint64_t misses = 0;
+                float decodeTime = 0.f; //!< total seconds spent decoding files
+            };
+
+            PCMCache();
+            ~PCMCache();
+
+            PCMCache(const PCMCache&) = delete;
+            PCMCache(PCMCache&&) = delete;
+            PCMCache& operator = (const PCMCache&) = delete;
+            PCMCache& operator = (PCMCache&&) = delete;
+
+            /*!
+            \brief Returns the decoded data for the file at the given path,
+            decoding it first if it is not in the cache.
+            \returns nullptr if the file could not be decoded
+            */
+            std::shared_ptr<const DecodedPCM> get(const std::string& path);
+
+            /*!
+            \brief Starts decoding the file at the given path on the shared
+            ThreadPool, if it isn't already cached. Does nothing if the cache
+            is disabled.
+            */
+            void predecode(const std::string& path);
+
+            /*!
+            \brief Sets the maximum size in bytes of the decoded data held by
+            the cache. Setting this to zero disables caching entirely.
+            */
+            void setBudget(std::size_t bytes);
+
+            Stats getStats() const;
+
+            static PCMCache& getInstance();
+
+        private:
+            struct Entry final
+            {
+                std::shared_ptr<const DecodedPCM> data;
+                bool pending = true;
+                std::list<std::string>::iterator lruPosition;
+            };
+
+            mutable std::mutex m_mutex;
+            std::condition_variable m_decodeComplete;
+
+            std::unordered_map<std::string, Entry> m_entries;
+            std::list<std::string> m_lru; //most recently used at the front
+            Stats m_stats;
+
+            ThreadPool::JobGroup m_jobGroup;
+
+            std::shared_ptr<const DecodedPCM> decode(const std::string& path);
+            void insert(const std::string& path, std::shared_ptr<const DecodedPCM>);
+            void evict();
+        };
+    }
+}
@@ -32,6 +32,7 @@ source distribution.
 #include <crogine/detail/Assert.hpp>
 
 #include "../ALCheck.hpp"
+#include "../AudioStreamScheduler.hpp"
 
 #ifdef __APPLE__
 #include "../al.h"
@@ -85,7 +86,10 @@ namespace
 }
 
 SoundStream::SoundStream()
-    : m_startState      (Status::Stopped),
+    : m_streamTask      (-1),
+    m_buffersCreated    (false),
+    m_requestStop       (false),
+    m_startState        (Status::Stopped),
     m_isStreaming       (false),
     m_channelCount      (0),
     m_sampleRate        (0),
@@ -100,7 +104,7 @@ SoundStream::SoundStream()
 
 SoundStream::~SoundStream() noexcept
 {
-    waitThread();
+    waitStream();
 }
 
 //public
@@ -136,7 +140,7 @@ void SoundStream::play()
         stop();
     }
 
-    launchThread(Status::Playing);
+    launchStream(Status::Playing);
 }
 
 void SoundStream::pause()
@@ -156,7 +160,7 @@ void SoundStream::pause()
 
 void SoundStream::stop()
 {
-    waitThread();
+    waitStream();
 
     onSeek(0);
 }
@@ -203,7 +207,7 @@ void SoundStream::setPlayingPosition(Time timeOffset)
         return;
     }
 
-    launchThread(oldStatus);
+    launchStream(oldStatus);
 }
 
 
@@ -253,127 +257,131 @@ std::int64_t SoundStream::onLoop()
 }
 
 //private
-void SoundStream::threadFunc()
+std::int32_t SoundStream::updateStream()
 {
-    std::this_thread::sleep_for(std::chrono::milliseconds(m_processingInterval));
-
-    bool requestStop = false;
-
+    if (!m_buffersCreated)
     {
-        std::scoped_lock lock(m_mutex);
-
-        if (m_startState == Status::Stopped)
+        //first update since the stream was launched
         {
-            m_isStreaming = false;
-            return;
+            std::scoped_lock lock(m_mutex);
+
+            if (m_startState == Status::Stopped)
+            {
+                m_isStreaming = false;
+                return -1;
+            }
         }
-    }
 
-    alCheck(alGenBuffers(BufferCount, m_buffers.data()));
+        alCheck(alGenBuffers(BufferCount, m_buffers.data()));
+        m_buffersCreated = true;
 
-    requestStop = fillQueue();
+        m_requestStop = fillQueue();
 
-    alCheck(alSourcePlay(m_alSource));
+        alCheck(alSourcePlay(m_alSource));
 
-    {
-        std::scoped_lock lock(m_mutex);
+        {
+            std::scoped_lock lock(m_mutex);
 
-        if (m_startState == Status::Paused)
+            if (m_startState == Status::Paused)
+            {
+                alCheck(alSourcePause(m_alSource));
+            }
+        }
+
+        return m_processingInterval;
+    }
+
+    if (SoundSource::getStatus() == Status::Stopped)
+    {
+        if (!m_requestStop)
+        {
+            alCheck(alSourcePlay(m_alSource));
+        }
+        else
         {
-            alCheck(alSourcePause(m_alSource));
+            std::scoped_lock lock(m_mutex);
+            m_isStreaming = false;
         }
     }
 
 
+    ALint processedBuffers = 0;
+    alCheck(alGetSourcei(m_alSource, AL_BUFFERS_PROCESSED, &processedBuffers));
 
-    //thread loop
-    while (1)
+    if (processedBuffers == static_cast<ALint>(BufferCount)
+        && !m_requestStop)
     {
-        //break out the loop if requested
-        {
-            std::scoped_lock lock(m_mutex);
+        Detail::AudioStreamScheduler::getInstance().reportUnderrun();
+    }
+
+    while (processedBuffers--)
+    {
+        ALuint buffer = 0;
+        alCheck(alSourceUnqueueBuffers(m_alSource, 1, &buffer));
 
-            if (!m_isStreaming)
+        std::uint32_t bufferIndex = 0;
+        for (auto i = 0u; i < BufferCount; ++i)
+        {
+            if (m_buffers[i] == buffer)
             {
+                bufferIndex = i;
                 break;
             }
         }
 
-        //sleep a bit
-        if (SoundSource::getStatus() != Status::Stopped)
+        if (m_bufferSeeks[bufferIndex] != NoLoop)
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(m_processingInterval));
+            m_samplesProcessed = static_cast<std::uint64_t>(m_bufferSeeks[bufferIndex]);
+            m_bufferSeeks[bufferIndex] = NoLoop;
         }
         else
         {
-            if (!requestStop)
+            ALint size = 0;
+            ALint bits = 0;
+
+            alCheck(alGetBufferi(buffer, AL_SIZE, &size));
+            alCheck(alGetBufferi(buffer, AL_BITS, &bits));
+
+            if (bits == 0)
             {
-                alCheck(alSourcePlay(m_alSource));
+                LogE << "Bits in sound stream are 0. Make sure audio is not corrupt and initialise() was called correctly" << std::endl;
+
+                std::scoped_lock lock(m_mutex);
+                m_isStreaming = false;
+                m_requestStop = true;
+                break;
             }
             else
             {
-                std::scoped_lock lock(m_mutex);
-                m_isStreaming = false;
+                m_samplesProcessed += static_cast<std::uint64_t>(size / (bits / 8));
             }
         }
 
-
-        ALint processedBuffers = 0;
-        alCheck(alGetSourcei(m_alSource, AL_BUFFERS_PROCESSED, &processedBuffers));
-
-        while (processedBuffers--)
+        if (!m_requestStop)
         {
-            ALuint buffer = 0;
-            alCheck(alSourceUnqueueBuffers(m_alSource, 1, &buffer));
-
-            std::uint32_t bufferIndex = 0;
-            for (auto i = 0u; i < BufferCount; ++i)
+            if (fillAndPushBuffer(bufferIndex))
             {
-                if (m_buffers[i] == buffer)
-                {
-                    bufferIndex = i;
-                    break;
-                }
+                m_requestStop = true;
             }
+        }
+    }
 
-            if (m_bufferSeeks[bufferIndex] != NoLoop)
-            {
-                m_samplesProcessed = static_cast<std::uint64_t>(m_bufferSeeks[bufferIndex]);
-                m_bufferSeeks[bufferIndex] = NoLoop;
-            }
-            else
-            {
-                ALint size = 0;
-                ALint bits = 0;
-
-                alCheck(alGetBufferi(buffer, AL_SIZE, &size));
-                alCheck(alGetBufferi(buffer, AL_BITS, &bits));
-
-                if (bits == 0)
-                {
-                    LogE << "Bits in sound stream are 0. Make sure audio is not corrupt and initialise() was called correctly" << std::endl;
-
-                    std::scoped_lock lock(m_mutex);
-                    m_isStreaming = false;
-                    requestStop = true;
-                    break;
-                }
-                else
-                {
-                    m_samplesProcessed += static_cast<std::uint64_t>(size / (bits / 8));
-                }
-            }
+    //tidy up if we were stopped during this update
+    {
+        std::scoped_lock lock(m_mutex);
 
-            if (!requestStop)
-            {
-                if (fillAndPushBuffer(bufferIndex))
-                {
-                    requestStop = true;
-                }
-            }
-        }        
+        if (!m_isStreaming)
+        {
+            finishStream();
+            return -1;
+        }
     }
 
+    return m_processingInterval;
+}
+
+void SoundStream::finishStream()
+{
     alCheck(alSourceStop(m_alSource));
 
     clearQueue();
@@ -382,6 +390,8 @@ void SoundStream::threadFunc()
 
     alCheck(alSourcei(m_alSource, AL_BUFFER, 0));
     alCheck(alDeleteBuffers(BufferCount, m_buffers.data()));
+
+    m_buffersCreated = false;
 }
 
 bool SoundStream::fillAndPushBuffer(std::uint32_t bufferID, bool loopImmediate)
@@ -460,24 +470,38 @@ void SoundStream::clearQueue()
     }
 }
 
-void SoundStream::launchThread(SoundStream::Status status)
+void SoundStream::launchStream(SoundStream::Status status)
 {
     m_isStreaming = true;
     m_startState = status;
+    m_requestStop = false;
 
-    CRO_ASSERT(!m_thread.joinable(), "");
-    m_thread = std::thread(&SoundStream::threadFunc, this);
+    CRO_ASSERT(m_streamTask == -1, "");
+    m_streamTask = Detail::AudioStreamScheduler::getInstance().addTask(
+        [&]()
+        {
+            auto delay = updateStream();
+            return delay < 0 ? Detail::AudioStreamScheduler::Finished : std::chrono::milliseconds(delay);
+        }, std::chrono::milliseconds(m_processingInterval));
 }
 
-void SoundStream::waitThread()
+void SoundStream::waitStream()
 {
     {
         std::scoped_lock lock(m_mutex);
         m_isStreaming = false;
     }
 
-    if (m_thread.joinable())
+    if (m_streamTask != -1)
     {
-        m_thread.join();
+        //blocks until any running update completes
+        Detail::AudioStreamScheduler::getInstance().removeTask(m_streamTask);
+        m_streamTask = -1;
     }
-}
\ No newline at end of file
+
+    //the stream was stopped before it could tidy up after itself
+    if (m_buffersCreated)
+    {
+        finishStream();
+    }
+}
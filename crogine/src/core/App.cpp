@@ -29,24 +29,30 @@ source distribution.
 
 #ifndef __APPLE__
 #include <crogine/detail/StackDump.hpp>
+#include <crogine/core/Log.hpp>
 #include <signal.h>
+//write out any queued log messages before dumping the stack
 static void winAbort(int)
 {
+    cro::Logger::flush();
     cro::StackDump::dump(cro::StackDump::ABRT);
 }
 
 static void winSeg(int)
 {
+    cro::Logger::flush();
     cro::StackDump::dump(cro::StackDump::SEG);
 }
 
 static void winIll(int)
 {
+    cro::Logger::flush();
     cro::StackDump::dump(cro::StackDump::ILL);
 }
 
 static void winFPE(int)
 {
+    cro::Logger::flush();
     cro::StackDump::dump(cro::StackDump::FPE);
 }
 
@@ -285,6 +291,7 @@ App::App(std::uint32_t styleFlags)
         m_prefPath = std::string(pp);
         SDL_free(pp);
         std::replace(m_prefPath.begin(), m_prefPath.end(), '\\', '/');
+        Logger::setLogDirectory(m_prefPath);
 
         if (!AudioRenderer::init())
         {
@@ -448,6 +455,8 @@ void App::run()
             simulate(frameTime);
         }
 
+        //the Console isn't thread safe so queued log messages are printed here
+        Logger::updateConsole();
         doImGui();
 
         ImGui::Render();
@@ -575,6 +584,7 @@ void App::setApplicationStrings(const std::string& organisation, const std::stri
     m_prefPath = std::string(pp);
     SDL_free(pp);
     std::replace(m_prefPath.begin(), m_prefPath.end(), '\\', '/');
+    Logger::setLogDirectory(m_prefPath);
 }
 
 //private
@@ -28,99 +28,41 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include <crogine/core/Log.hpp>
-#include <crogine/core/App.hpp>
-#include <crogine/core/Console.hpp>
 #include <crogine/core/String.hpp>
-#include <crogine/core/SysTime.hpp>
 #include <crogine/detail/Types.hpp>
 
+#include "../detail/LogSink.hpp"
+
 #include <SDL_log.h>
 
-#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
 
 using namespace cro;
 
-std::list<std::string> Logger::m_buffer;
-std::string Logger::m_output;
-
 void Logger::log(const std::string& message, Type type, Output output)
 {
-    std::string outstring;
-    switch (type)
+    if (type == Type::Error)
     {
-    case Type::Info:
-    default:
-        outstring = "INFO: " + message;
-        break;
-    case Type::Error:
-        outstring = "ERROR: " + message;
         output = Output::All;
-        break;
-    case Type::Warning:
-        outstring = "WARNING: " + message;
-        break;
     }
-#ifndef __ANDROID__
-    if (output == Output::Console || output == Output::All)
-    {
-        switch (type)
-        {
-        default:
-        case Type::Info:
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s", message.c_str());
-            break;
-        case Type::Warning:
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%s", message.c_str());
-            break;
-        case Type::Error:
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", message.c_str());
-            break;
-        }
 
-        Console::print(outstring);
-
-        const std::size_t maxBuffer = 30;
-        m_buffer.push_back(outstring);
-        if (m_buffer.size() > maxBuffer) m_buffer.pop_front();
-        updateOutString(maxBuffer);
-
-#ifdef _MSC_VER
-        outstring += "\n";
-        OutputDebugStringA(outstring.c_str());
-#endif //_MSC_VER
+    if (auto* sink = Detail::LogSink::get(); sink)
+    {
+        sink->push(type, output, false, message);
     }
-    if (output == Output::File || output == Output::All)
+    else
     {
-        //output to a log file
-        RaiiRWops file;
-        auto logPath = cro::App::getPreferencePath() + "output.log";
-        file.file = SDL_RWFromFile(logPath.c_str(), "a");
-        if (file.file)
-        {
-            auto timeStamp = SysTime::timeString();
-            timeStamp += " - ";
-            timeStamp += SysTime::dateString();
-            timeStamp += ": ";
-
-            SDL_RWwrite(file.file, timeStamp.c_str(), 1, timeStamp.size());
-            SDL_RWwrite(file.file, outstring.c_str(), 1, outstring.size());
-        }
-        else
-        {
-            log(message, type, Output::Console);
-            log("Above message was intended for log file. Opening file probably failed.", Type::Warning, Output::Console);
-        }
+        //sink was already destroyed on shutdown
+        SDL_Log("%s", message.c_str());
     }
-#else
-    //use logcat - technically SDL will log successfully on android too
-    //so this is unnecessary.
-    __android_log_print(ANDROID_LOG_VERBOSE, "CroApp", message.c_str(), 1);
-#endif //__ANDROID__
 }
 
 std::ostream& Logger::log(Logger::Type type)
 {
-    static cro::Detail::LogStream stream;
+    //each thread gets its own stream so that lines aren't interleaved
+    static thread_local cro::Detail::LogStream stream;
     switch (type)
     {
     default:
@@ -137,18 +79,29 @@ std::ostream& Logger::log(Logger::Type type)
     return stream;
 }
 
+void Logger::flush()
+{
+    if (auto* sink = Detail::LogSink::get(); sink)
+    {
+        sink->flush();
+    }
+    std::fflush(stdout);
+}
+
 //private
-void Logger::updateOutString(std::size_t maxBuffer)
+void Logger::setLogDirectory(const std::string& path)
 {
-    static size_t count = 0;
-    m_output.append(m_buffer.back());
-    m_output.append("\n");
-    count++;
+    if (auto* sink = Detail::LogSink::get(); sink)
+    {
+        sink->setFilePath(path + "output.log");
+    }
+}
 
-    if (count > maxBuffer)
+void Logger::updateConsole()
+{
+    if (auto* sink = Detail::LogSink::get(); sink)
     {
-        m_output = m_output.substr(m_output.find_first_of('\n') + 1, m_output.size());
-        count--;
+        sink->updateConsole();
     }
 }
 
@@ -191,28 +144,26 @@ int LogBuf::sync()
 {
     if (pbase() != pptr())
     {
-        //print the contents of the write buffer into the logger
-        std::size_t size = static_cast<int>(pptr() - pbase());
-
-        std::stringstream ss; //TODO this should be a member to buffer truncated messages between flushes
-        ss.write(pbase(), size);
-
-        std::string outline;
-        while (std::getline(ss, outline))
+        //pass each line of the write buffer to the logger. Lines which were
+        //truncated by the buffer filling up have a line ending added by the sink
+        //TODO partial lines should be kept until the next flush
+        auto* sink = Detail::LogSink::get();
+        const char* start = pbase();
+        while (start != pptr())
         {
-            outline += '\n';
-            Console::print(outline);
-            std::fwrite(outline.data(), 1, outline.size(), stdout);
-
-#ifdef __ANDROID__
-            //use logcat
-            __android_log_print(ANDROID_LOG_VERBOSE, "CroApp", outline.c_str(), 1);
-#endif //__ANDROID__
-
-#ifdef _MSC_VER
-            outline += "\n";
-            OutputDebugStringA(outline.c_str());
-#endif //_MSC_VER
+            const auto* newLine = static_cast<const char*>(std::memchr(start, '\n', pptr() - start));
+            const char* end = newLine ? newLine + 1 : pptr();
+
+            std::string_view line(start, end - start);
+            if (sink)
+            {
+                sink->push(Logger::Type::Info, Logger::Output::Console, true, line);
+            }
+            else
+            {
+                std::fwrite(line.data(), 1, line.size(), stdout);
+            }
+            start = end;
         }
 
         setp(pbase(), epptr());
@@ -31,28 +31,32 @@ source distribution.
 
 using namespace cro;
 
-namespace
-{
-    //max msg size is 128 bytes, so 128 messages
-    //maximum per frame is 16384 bytes
-    const std::size_t bufferSize = 16384u;
-}
-
 MessageBus::MessageBus()
-    : m_currentBuffer   (bufferSize),
-    m_pendingBuffer     (bufferSize),
-    m_inPointer         (m_pendingBuffer.data()),
-    m_outPointer        (m_currentBuffer.data()),
+    : m_currentPages    (1),
+    m_pendingPages      (1),
+    m_inPage            (0),
+    m_outPage           (0),
+    m_outOffset         (0),
     m_currentCount      (0),
     m_pendingCount      (0),
+    m_pendingBytes      (0),
     m_enabled           (true)
 {}
 
 const Message& MessageBus::poll()
 {
+    CRO_ASSERT(m_currentCount, "No messages to poll!");
+
+    //skip to the next page if we've read all of this one
+    while (m_outOffset == m_currentPages[m_outPage].used)
+    {
+        m_outPage++;
+        m_outOffset = 0;
+    }
+
     static auto size = sizeof(Message);
-    const Message& m = *reinterpret_cast<Message*>(m_outPointer);
-    m_outPointer += (size + m.m_dataSize);
+    const Message& m = *reinterpret_cast<Message*>(m_currentPages[m_outPage].buffer.data() + m_outOffset);
+    m_outOffset += (size + m.m_dataSize);
     m_currentCount--;
 
     return m;
@@ -62,11 +66,21 @@ bool MessageBus::empty()
 {
     if (m_currentCount == 0)
     {
-        m_currentBuffer.swap(m_pendingBuffer);
-        m_inPointer = m_pendingBuffer.data();
-        m_outPointer = m_currentBuffer.data();
+        m_stats.postCount = m_pendingCount;
+        m_stats.byteCount = m_pendingBytes;
+        m_stats.pageCount = m_currentPages.size() + m_pendingPages.size();
+
+        m_currentPages.swap(m_pendingPages);
+        for (auto& page : m_pendingPages)
+        {
+            page.used = 0;
+        }
+        m_inPage = 0;
+        m_outPage = 0;
+        m_outOffset = 0;
         m_currentCount = m_pendingCount;
         m_pendingCount = 0;
+        m_pendingBytes = 0;
         return true;
     }
     return false;
@@ -75,4 +89,16 @@ bool MessageBus::empty()
 std::size_t MessageBus::pendingMessageCount() const
 {
     return m_pendingCount;
-}
\ No newline at end of file
+}
+
+//private
+void MessageBus::nextPage()
+{
+    m_inPage++;
+    if (m_inPage == m_pendingPages.size())
+    {
+        //existing pages have their own buffers so
+        //pointers to messages are not invalidated
+        m_pendingPages.emplace_back();
+    }
+}
@@ -0,0 +1,273 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include <crogine/core/ThreadPool.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include <algorithm>
+
+using namespace cro;
+
+namespace
+{
+    thread_local std::size_t threadIndex = 0;
+}
+
+ThreadPool::JobGroup::~JobGroup()
+{
+    CRO_ASSERT(m_pendingCount == 0, "JobGroup destroyed with jobs still pending");
+}
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+    : m_running     (true),
+    m_queuedCount   (0),
+    m_pendingCount  (0),
+    m_nextQueue     (0)
+{
+    if (threadCount == 0)
+    {
+        const auto hwCount = std::thread::hardware_concurrency();
+        threadCount = hwCount > 1 ? hwCount - 1 : 1;
+    }
+
+    for (auto i = 0u; i < threadCount + 1; ++i)
+    {
+        m_queues.emplace_back(std::make_unique<Queue>());
+    }
+
+    for (auto i = 0u; i < threadCount; ++i)
+    {
+        m_threads.emplace_back(&ThreadPool::threadFunc, this, i + 1);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    //finish everything, not just the default group
+    while (m_pendingCount > 0)
+    {
+        if (!tryRun(0, nullptr))
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_doneCondition.wait(lock, [&]() {return m_pendingCount == 0 || m_queuedCount > 0; });
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_workCondition.notify_all();
+
+    for (auto& t : m_threads)
+    {
+        t.join();
+    }
+}
+
+//public
+void ThreadPool::push(std::function<void()> job)
+{
+    push(std::move(job), m_defaultGroup);
+}
+
+void ThreadPool::push(std::function<void()> job, JobGroup& group)
+{
+    CRO_ASSERT(job, "Job is empty");
+
+    //spread jobs over the worker queues, leaving the
+    //caller's queue free for anything it pushes itself
+    auto idx = threadIndex;
+    if (idx == 0 || idx >= m_queues.size())
+    {
+        idx = (m_nextQueue++ % m_threads.size()) + 1;
+    }
+
+    //the job is counted before it's placed in a queue, else it could
+    //be stolen and the counts decremented before they were incremented
+    m_pendingCount++;
+    group.m_pendingCount++;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queuedCount++;
+        group.m_queuedCount++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_queues[idx]->mutex);
+        m_queues[idx]->jobs.push_back({ std::move(job), &group });
+    }
+    m_workCondition.notify_one();
+
+    //wakes anyone waiting on this group from another thread
+    m_doneCondition.notify_all();
+}
+
+void ThreadPool::wait()
+{
+    wait(m_defaultGroup);
+}
+
+void ThreadPool::wait(JobGroup& group)
+{
+    while (group.m_pendingCount > 0)
+    {
+        //only run jobs from the group we're waiting for, so that
+        //we're not held up by long running jobs from elsewhere
+        if (!tryRun(0, &group))
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_doneCondition.wait(lock, [&]() {return group.m_pendingCount == 0 || group.m_queuedCount > 0; });
+        }
+    }
+
+    std::exception_ptr exception;
+    {
+        std::lock_guard<std::mutex> lock(group.m_exceptionMutex);
+        std::swap(exception, group.m_exception);
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+std::size_t ThreadPool::getThreadIndex()
+{
+    return threadIndex;
+}
+
+ThreadPool& ThreadPool::getShared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+//private
+bool ThreadPool::tryRun(std::size_t queueIndex, const JobGroup* filter)
+{
+    Job job;
+
+    if (filter)
+    {
+        //look for the oldest job in the group in any queue
+        for (auto i = 0u; i < m_queues.size() && !job.func; ++i)
+        {
+            auto& queue = *m_queues[(queueIndex + i) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            auto result = std::find_if(queue.jobs.begin(), queue.jobs.end(), 
+                [filter](const Job& j)
+                {
+                    return j.group == filter;
+                });
+
+            if (result != queue.jobs.end())
+            {
+                job = std::move(*result);
+                queue.jobs.erase(result);
+            }
+        }
+    }
+    else
+    {
+        //take the newest job from our own queue...
+        {
+            auto& queue = *m_queues[queueIndex];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.jobs.empty())
+            {
+                job = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+            }
+        }
+
+        //...else steal the oldest from someone else
+        for (auto i = 1u; i < m_queues.size() && !job.func; ++i)
+        {
+            auto& queue = *m_queues[(queueIndex + i) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.jobs.empty())
+            {
+                job = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+            }
+        }
+    }
+
+    if (!job.func)
+    {
+        return false;
+    }
+
+    auto& group = *job.group;
+    m_queuedCount--;
+    group.m_queuedCount--;
+
+    //an exception escaping here would kill the worker and leave
+    //the group pending forever, so it's passed on to wait() instead
+    try
+    {
+        job.func();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(group.m_exceptionMutex);
+        if (!group.m_exception)
+        {
+            group.m_exception = std::current_exception();
+        }
+    }
+
+    //the group may be destroyed as soon as its count reaches
+    //zero, so take the lock first to make sure the waiting
+    //thread doesn't return until we're done with it
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        group.m_pendingCount--;
+        m_pendingCount--;
+    }
+    m_doneCondition.notify_all();
+
+    return true;
+}
+
+void ThreadPool::threadFunc(std::size_t index)
+{
+    threadIndex = index;
+
+    while (m_running)
+    {
+        if (!tryRun(index, nullptr))
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workCondition.wait(lock, [&]() {return !m_running || m_queuedCount > 0; });
+        }
+    }
+}
@@ -371,7 +371,7 @@ void BalancedTree::insertLeaf(std::int32_t treeID)
         CRO_ASSERT(childA != TreeNode::Null, "Can't be null");
         CRO_ASSERT(childB != TreeNode::Null, "Can't be null");
 
-        m_nodes[index].height = std::max(m_nodes[childA].height, m_nodes[childB].height);
+        m_nodes[index].height = std::max(m_nodes[childA].height, m_nodes[childB].height) + 1;
         m_nodes[index].fatBounds = Box::merge(m_nodes[childA].fatBounds, m_nodes[childB].fatBounds);
 
         index = m_nodes[index].parent;
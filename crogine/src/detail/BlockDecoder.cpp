@@ -0,0 +1,431 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "BlockDecoder.hpp"
+
+#include <array>
+#include <algorithm>
+
+using namespace cro::Detail;
+
+namespace
+{
+    constexpr std::int32_t TexelCount = 16;
+
+    inline std::uint8_t clampByte(std::int32_t v)
+    {
+        return static_cast<std::uint8_t>(std::clamp(v, 0, 255));
+    }
+
+    inline std::uint64_t readLE64(const std::uint8_t* data)
+    {
+        std::uint64_t retVal = 0;
+        for (auto i = 7; i >= 0; --i)
+        {
+            retVal = (retVal << 8) | data[i];
+        }
+        return retVal;
+    }
+
+    inline std::uint64_t readBE64(const std::uint8_t* data)
+    {
+        std::uint64_t retVal = 0;
+        for (auto i = 0; i < 8; ++i)
+        {
+            retVal = (retVal << 8) | data[i];
+        }
+        return retVal;
+    }
+
+    //decodes the alpha block shared by BC3/BC4/BC5 in to
+    //the given channel of the output
+    void decodeAlphaBlock(const std::uint8_t* block, std::uint8_t* output, std::int32_t channel)
+    {
+        std::array<std::int32_t, 8> values = {};
+        values[0] = block[0];
+        values[1] = block[1];
+
+        if (values[0] > values[1])
+        {
+            for (auto i = 1; i < 7; ++i)
+            {
+                values[i + 1] = (((7 - i) * values[0]) + (i * values[1]) + 3) / 7;
+            }
+        }
+        else
+        {
+            for (auto i = 1; i < 5; ++i)
+            {
+                values[i + 1] = (((5 - i) * values[0]) + (i * values[1]) + 2) / 5;
+            }
+            values[6] = 0;
+            values[7] = 255;
+        }
+
+        const auto indices = readLE64(block) >> 16;
+        for (auto i = 0; i < TexelCount; ++i)
+        {
+            output[i * 4 + channel] = static_cast<std::uint8_t>(values[(indices >> (i * 3)) & 0x7]);
+        }
+    }
+
+    void decodeColourBlock(const std::uint8_t* block, std::uint8_t* output, bool punchThrough)
+    {
+        const std::uint16_t c0 = block[0] | (block[1] << 8);
+        const std::uint16_t c1 = block[2] | (block[3] << 8);
+
+        const auto expand = [](std::uint16_t c)
+        {
+            const std::int32_t r = (c >> 11) & 0x1f;
+            const std::int32_t g = (c >> 5) & 0x3f;
+            const std::int32_t b = c & 0x1f;
+            return std::array<std::int32_t, 4>({ (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), 255 });
+        };
+
+        std::array<std::array<std::int32_t, 4>, 4> colours = {};
+        colours[0] = expand(c0);
+        colours[1] = expand(c1);
+
+        if (c0 > c1 || !punchThrough)
+        {
+            for (auto i = 0; i < 3; ++i)
+            {
+                colours[2][i] = ((2 * colours[0][i]) + colours[1][i] + 1) / 3;
+                colours[3][i] = (colours[0][i] + (2 * colours[1][i]) + 1) / 3;
+            }
+            colours[2][3] = 255;
+            colours[3][3] = 255;
+        }
+        else
+        {
+            for (auto i = 0; i < 3; ++i)
+            {
+                colours[2][i] = (colours[0][i] + colours[1][i]) / 2;
+            }
+            colours[2][3] = 255;
+            colours[3] = { 0, 0, 0, 0 };
+        }
+
+        for (auto i = 0; i < TexelCount; ++i)
+        {
+            const auto index = (block[4 + (i / 4)] >> ((i % 4) * 2)) & 0x3;
+            for (auto c = 0; c < 4; ++c)
+            {
+                output[i * 4 + c] = static_cast<std::uint8_t>(colours[index][c]);
+            }
+        }
+    }
+
+    constexpr std::array<std::array<std::int32_t, 2>, 8> ETCModifiers =
+    { {
+        {2, 8}, {5, 17}, {9, 29}, {13, 42},
+        {18, 60}, {24, 80}, {33, 106}, {47, 183}
+    } };
+
+    constexpr std::array<std::int32_t, 8> ETCDistances = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+    constexpr std::array<std::array<std::int32_t, 8>, 16> EACModifiers =
+    { {
+        {-3, -6, -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12},
+        {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11},
+        {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10},
+        {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9},
+        {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9},
+        {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9},
+        {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8},
+        {-3, -5, -7, -9, 2, 4, 6, 8}
+    } };
+
+    using RGB = std::array<std::int32_t, 3>;
+
+    inline std::int32_t extend4(std::int32_t v) { return (v << 4) | v; }
+    inline std::int32_t extend5(std::int32_t v) { return (v << 3) | (v >> 2); }
+    inline std::int32_t extend6(std::int32_t v) { return (v << 2) | (v >> 4); }
+    inline std::int32_t extend7(std::int32_t v) { return (v << 1) | (v >> 6); }
+
+    inline void writeTexel(std::uint8_t* output, std::int32_t x, std::int32_t y, const RGB& colour)
+    {
+        auto* dst = output + ((y * 4 + x) * 4);
+        dst[0] = clampByte(colour[0]);
+        dst[1] = clampByte(colour[1]);
+        dst[2] = clampByte(colour[2]);
+        dst[3] = 255;
+    }
+
+    //ETC texel indices are stored column first
+    inline std::int32_t etcIndex(std::uint64_t bits, std::int32_t x, std::int32_t y)
+    {
+        const auto p = x * 4 + y;
+        return static_cast<std::int32_t>((((bits >> (16 + p)) & 1) << 1) | ((bits >> p) & 1));
+    }
+
+    void decodePaintColours(std::uint64_t bits, std::uint8_t* output, const std::array<RGB, 4>& paint)
+    {
+        for (auto y = 0; y < 4; ++y)
+        {
+            for (auto x = 0; x < 4; ++x)
+            {
+                writeTexel(output, x, y, paint[etcIndex(bits, x, y)]);
+            }
+        }
+    }
+
+    void decodeETCT(const std::uint8_t* src, std::uint64_t bits, std::uint8_t* output)
+    {
+        const RGB base0 = { extend4(((src[0] >> 1) & 0xc) | (src[0] & 0x3)), extend4(src[1] >> 4), extend4(src[1] & 0xf) };
+        const RGB base1 = { extend4(src[2] >> 4), extend4(src[2] & 0xf), extend4(src[3] >> 4) };
+        const auto d = ETCDistances[((src[3] >> 1) & 0x6) | (src[3] & 0x1)];
+
+        std::array<RGB, 4> paint;
+        paint[0] = base0;
+        paint[2] = base1;
+        for (auto i = 0; i < 3; ++i)
+        {
+            paint[1][i] = base1[i] + d;
+            paint[3][i] = base1[i] - d;
+        }
+        decodePaintColours(bits, output, paint);
+    }
+
+    void decodeETCH(const std::uint8_t* src, std::uint64_t bits, std::uint8_t* output)
+    {
+        const RGB base0 =
+        {
+            extend4((src[0] >> 3) & 0xf),
+            extend4(((src[0] << 1) & 0xe) | ((src[1] >> 4) & 0x1)),
+            extend4((src[1] & 0x8) | ((src[1] << 1) & 0x6) | (src[2] >> 7))
+        };
+        const RGB base1 =
+        {
+            extend4((src[2] >> 3) & 0xf),
+            extend4(((src[2] << 1) & 0xe) | (src[3] >> 7)),
+            extend4((src[3] >> 3) & 0xf)
+        };
+
+        const auto value0 = (base0[0] << 16) | (base0[1] << 8) | base0[2];
+        const auto value1 = (base1[0] << 16) | (base1[1] << 8) | base1[2];
+        const auto d = ETCDistances[(src[3] & 0x4) | ((src[3] << 1) & 0x2) | (value0 >= value1 ? 1 : 0)];
+
+        std::array<RGB, 4> paint;
+        for (auto i = 0; i < 3; ++i)
+        {
+            paint[0][i] = base0[i] + d;
+            paint[1][i] = base0[i] - d;
+            paint[2][i] = base1[i] + d;
+            paint[3][i] = base1[i] - d;
+        }
+        decodePaintColours(bits, output, paint);
+    }
+
+    void decodeETCPlanar(const std::uint8_t* src, std::uint8_t* output)
+    {
+        const RGB o =
+        {
+            extend6((src[0] >> 1) & 0x3f),
+            extend7(((src[0] & 1) << 6) | (src[1] >> 1)),
+            extend6(((src[1] & 1) << 5) | (src[2] & 0x18) | ((src[2] << 1) & 0x6) | (src[3] >> 7))
+        };
+        const RGB h =
+        {
+            extend6(((src[3] >> 1) & 0x3e) | (src[3] & 1)),
+            extend7(src[4] >> 1),
+            extend6(((src[4] & 1) << 5) | (src[5] >> 3))
+        };
+        const RGB v =
+        {
+            extend6(((src[5] & 0x7) << 3) | (src[6] >> 5)),
+            extend7(((src[6] & 0x1f) << 2) | (src[7] >> 6)),
+            extend6(src[7] & 0x3f)
+        };
+
+        for (auto y = 0; y < 4; ++y)
+        {
+            for (auto x = 0; x < 4; ++x)
+            {
+                RGB colour;
+                for (auto i = 0; i < 3; ++i)
+                {
+                    colour[i] = ((x * (h[i] - o[i])) + (y * (v[i] - o[i])) + (4 * o[i]) + 2) >> 2;
+                }
+                writeTexel(output, x, y, colour);
+            }
+        }
+    }
+}
+
+void BlockDecoder::decodeBC1(const std::uint8_t* block, std::uint8_t* output, bool punchThrough)
+{
+    decodeColourBlock(block, output, punchThrough);
+}
+
+void BlockDecoder::decodeBC2(const std::uint8_t* block, std::uint8_t* output)
+{
+    decodeColourBlock(block + 8, output, false);
+
+    const auto alpha = readLE64(block);
+    for (auto i = 0; i < TexelCount; ++i)
+    {
+        output[i * 4 + 3] = static_cast<std::uint8_t>(((alpha >> (i * 4)) & 0xf) * 17);
+    }
+}
+
+void BlockDecoder::decodeBC3(const std::uint8_t* block, std::uint8_t* output)
+{
+    decodeColourBlock(block + 8, output, false);
+    decodeAlphaBlock(block, output, 3);
+}
+
+void BlockDecoder::decodeBC4(const std::uint8_t* block, std::uint8_t* output)
+{
+    for (auto i = 0; i < TexelCount; ++i)
+    {
+        output[i * 4 + 1] = 0;
+        output[i * 4 + 2] = 0;
+        output[i * 4 + 3] = 255;
+    }
+    decodeAlphaBlock(block, output, 0);
+}
+
+void BlockDecoder::decodeBC5(const std::uint8_t* block, std::uint8_t* output)
+{
+    for (auto i = 0; i < TexelCount; ++i)
+    {
+        output[i * 4 + 2] = 0;
+        output[i * 4 + 3] = 255;
+    }
+    decodeAlphaBlock(block, output, 0);
+    decodeAlphaBlock(block + 8, output, 1);
+}
+
+void BlockDecoder::decodeETC2RGB(const std::uint8_t* block, std::uint8_t* output)
+{
+    const auto bits = readBE64(block);
+    const bool differential = (block[3] & 0x2) != 0;
+    const bool flip = (block[3] & 0x1) != 0;
+
+    std::array<RGB, 2> bases;
+    if (differential)
+    {
+        std::array<std::int32_t, 3> base = {};
+        std::array<std::int32_t, 3> second = {};
+        for (auto i = 0; i < 3; ++i)
+        {
+            base[i] = block[i] >> 3;
+            //3 bit two's complement delta
+            auto delta = block[i] & 0x7;
+            if (delta > 3)
+            {
+                delta -= 8;
+            }
+            second[i] = base[i] + delta;
+        }
+
+        //overflowing the second colour selects the ETC2 modes
+        if (second[0] < 0 || second[0] > 31)
+        {
+            decodeETCT(block, bits, output);
+            return;
+        }
+
+        if (second[1] < 0 || second[1] > 31)
+        {
+            decodeETCH(block, bits, output);
+            return;
+        }
+
+        if (second[2] < 0 || second[2] > 31)
+        {
+            decodeETCPlanar(block, output);
+            return;
+        }
+
+        for (auto i = 0; i < 3; ++i)
+        {
+            bases[0][i] = extend5(base[i]);
+            bases[1][i] = extend5(second[i]);
+        }
+    }
+    else
+    {
+        for (auto i = 0; i < 3; ++i)
+        {
+            bases[0][i] = extend4(block[i] >> 4);
+            bases[1][i] = extend4(block[i] & 0xf);
+        }
+    }
+
+    const std::array<std::int32_t, 2> tables = { (block[3] >> 5) & 0x7, (block[3] >> 2) & 0x7 };
+
+    for (auto y = 0; y < 4; ++y)
+    {
+        for (auto x = 0; x < 4; ++x)
+        {
+            const auto subBlock = flip ? (y / 2) : (x / 2);
+            const auto index = etcIndex(bits, x, y);
+
+            //0, 1, 2, 3 -> +small, +large, -small, -large
+            auto modifier = ETCModifiers[tables[subBlock]][index & 0x1];
+            if (index & 0x2)
+            {
+                modifier = -modifier;
+            }
+
+            const auto& base = bases[subBlock];
+            writeTexel(output, x, y, { base[0] + modifier, base[1] + modifier, base[2] + modifier });
+        }
+    }
+}
+
+void BlockDecoder::decodeETC2RGBA(const std::uint8_t* block, std::uint8_t* output)
+{
+    decodeETC2RGB(block + 8, output);
+
+    const std::int32_t base = block[0];
+    const std::int32_t multiplier = block[1] >> 4;
+    const auto& table = EACModifiers[block[1] & 0xf];
+    const auto bits = readBE64(block);
+
+    for (auto y = 0; y < 4; ++y)
+    {
+        for (auto x = 0; x < 4; ++x)
+        {
+            const auto p = x * 4 + y;
+            const auto index = (bits >> (45 - (p * 3))) & 0x7;
+            output[((y * 4 + x) * 4) + 3] = clampByte(base + (table[index] * multiplier));
+        }
+    }
+}
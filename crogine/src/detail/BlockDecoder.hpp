@@ -0,0 +1,64 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace cro::Detail::BlockDecoder
+{
+    /*
+    Each function decodes a single 4x4 block in to 16 RGBA8
+    texels, 64 bytes, written in rows from the top left.
+    Channels missing from the format are set the same way
+    the GPU returns them, eg BC4 decodes to (r, 0, 0, 255)
+    */
+
+    //BC1 (DXT1). If punchThrough is true blocks with c0 <= c1 use
+    //the 3 colour mode with transparent black, else 4 colour mode
+    void decodeBC1(const std::uint8_t* block, std::uint8_t* output, bool punchThrough = true);
+
+    //BC2 (DXT3) explicit 4 bit alpha
+    void decodeBC2(const std::uint8_t* block, std::uint8_t* output);
+
+    //BC3 (DXT5) interpolated alpha
+    void decodeBC3(const std::uint8_t* block, std::uint8_t* output);
+
+    //BC4 (RGTC1) unsigned single channel
+    void decodeBC4(const std::uint8_t* block, std::uint8_t* output);
+
+    //BC5 (RGTC2) unsigned two channel
+    void decodeBC5(const std::uint8_t* block, std::uint8_t* output);
+
+    //ETC2 RGB, including ETC1 blocks
+    void decodeETC2RGB(const std::uint8_t* block, std::uint8_t* output);
+
+    //ETC2 RGBA with EAC alpha
+    void decodeETC2RGBA(const std::uint8_t* block, std::uint8_t* output);
+}
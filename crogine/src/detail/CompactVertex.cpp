@@ -0,0 +1,594 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "CompactVertex.hpp"
+#include "GLCheck.hpp"
+
+#include <crogine/detail/ModelBinary.hpp>
+#include <crogine/graphics/MeshBuilder.hpp>
+
+#include <crogine/detail/glm/geometric.hpp>
+#include <crogine/detail/glm/gtc/packing.hpp>
+
+#include <SDL_rwops.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    //half floats have 10 bits of mantissa so this keeps the
+    //UV error below 1/1024, or about a texel on a 1024px texture
+    constexpr float MaxHalfUV = 4.f;
+
+    //number of floats used by each attribute in the version 2 layout
+    constexpr std::array<std::size_t, Mesh::Attribute::Total> FloatCounts =
+    {
+        3, 4, 3, 4, 0, 2, 2, 4, 4
+    };
+
+    //size in bytes of each attribute when quantised
+    constexpr std::array<std::size_t, Mesh::Attribute::Total> CompactSizes =
+    {
+        12, 4, 4, 6, 0, 4, 4, 4, 8
+    };
+
+    constexpr std::array<std::uint32_t, Mesh::Attribute::Total> CompactFlags =
+    {
+        0,
+        ModelBinary::CompactColour,
+        ModelBinary::CompactNormal,
+        ModelBinary::CompactTangent,
+        0,
+        ModelBinary::CompactUV0,
+        ModelBinary::CompactUV1,
+        ModelBinary::CompactBlendIndices,
+        ModelBinary::CompactBlendWeights
+    };
+
+    //attributes of the float layout used by Mesh::Data and the
+    //flag which allows them to be packed on the GPU
+    constexpr std::array<std::uint32_t, Mesh::Attribute::Total> PackedFlags =
+    {
+        0,
+        ModelBinary::CompactColour,
+        ModelBinary::CompactNormal,
+        ModelBinary::CompactTangent,
+        ModelBinary::CompactTangent,
+        ModelBinary::CompactUV0,
+        ModelBinary::CompactUV1,
+        ModelBinary::CompactBlendIndices,
+        ModelBinary::CompactBlendWeights
+    };
+
+    constexpr std::array<Mesh::AttributeFormat, Mesh::Attribute::Total> PackedFormats =
+    {
+        Mesh::AttributeFormat{ GL_FLOAT, false },
+        Mesh::AttributeFormat{ GL_UNSIGNED_BYTE, true },
+        Mesh::AttributeFormat{ GL_SHORT, true },
+        Mesh::AttributeFormat{ GL_SHORT, true },
+        Mesh::AttributeFormat{ GL_SHORT, true },
+        Mesh::AttributeFormat{ GL_HALF_FLOAT, false },
+        Mesh::AttributeFormat{ GL_HALF_FLOAT, false },
+        Mesh::AttributeFormat{ GL_UNSIGNED_BYTE, false },
+        Mesh::AttributeFormat{ GL_UNSIGNED_SHORT, true }
+    };
+
+    template <typename T>
+    void writeValue(std::vector<std::uint8_t>& dst, T value)
+    {
+        const auto offset = dst.size();
+        dst.resize(offset + sizeof(T));
+        std::memcpy(dst.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    T readValue(const std::uint8_t*& src)
+    {
+        T retVal;
+        std::memcpy(&retVal, src, sizeof(T));
+        src += sizeof(T);
+        return retVal;
+    }
+
+    glm::vec2 signNotZero(glm::vec2 v)
+    {
+        return { v.x < 0.f ? -1.f : 1.f, v.y < 0.f ? -1.f : 1.f };
+    }
+
+    void writeOct(std::vector<std::uint8_t>& dst, glm::vec3 v)
+    {
+        const auto oct = CompactVertex::octEncode(v);
+        writeValue(dst, glm::packSnorm1x16(oct.x));
+        writeValue(dst, glm::packSnorm1x16(oct.y));
+    }
+
+    glm::vec3 readOct(const std::uint8_t*& src)
+    {
+        const auto x = glm::unpackSnorm1x16(readValue<std::uint16_t>(src));
+        const auto y = glm::unpackSnorm1x16(readValue<std::uint16_t>(src));
+        return CompactVertex::octDecode({ x, y });
+    }
+}
+
+glm::vec2 CompactVertex::octEncode(glm::vec3 v)
+{
+    const auto sum = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+    if (sum == 0.f)
+    {
+        return glm::vec2(0.f);
+    }
+
+    v /= sum;
+    glm::vec2 retVal(v.x, v.y);
+    if (v.z < 0.f)
+    {
+        retVal = (1.f - glm::abs(glm::vec2(v.y, v.x))) * signNotZero(retVal);
+    }
+    return retVal;
+}
+
+glm::vec3 CompactVertex::octDecode(glm::vec2 e)
+{
+    glm::vec3 v(e.x, e.y, 1.f - std::abs(e.x) - std::abs(e.y));
+    if (v.z < 0.f)
+    {
+        const auto xy = (1.f - glm::abs(glm::vec2(v.y, v.x))) * signNotZero(glm::vec2(v.x, v.y));
+        v.x = xy.x;
+        v.y = xy.y;
+    }
+    return glm::normalize(v);
+}
+
+std::size_t CompactVertex::getVertexSize(std::uint16_t flags, std::uint32_t encoding)
+{
+    std::size_t retVal = 0;
+    for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+    {
+        if (flags & (1 << i))
+        {
+            retVal += (encoding & CompactFlags[i]) ? CompactSizes[i] : FloatCounts[i] * sizeof(float);
+        }
+    }
+    return retVal;
+}
+
+std::uint32_t CompactVertex::encode(const std::vector<float>& src, std::uint16_t flags, std::vector<std::uint8_t>& dst)
+{
+    std::size_t stride = 0;
+    std::array<std::size_t, Mesh::Attribute::Total> offsets = {};
+    for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+    {
+        if (flags & (1 << i))
+        {
+            offsets[i] = stride;
+            stride += FloatCounts[i];
+        }
+    }
+
+    if (stride == 0
+        || src.size() % stride != 0)
+    {
+        return 0;
+    }
+
+    //check which attributes can be quantised
+    std::uint32_t encoding = ModelBinary::CompactNormal | ModelBinary::CompactTangent;
+    auto checkRange = [&](std::int32_t attrib, float minVal, float maxVal, bool integral)
+    {
+        if ((flags & (1 << attrib)) == 0)
+        {
+            return;
+        }
+
+        for (auto i = 0u; i < src.size(); i += stride)
+        {
+            for (auto j = 0u; j < FloatCounts[attrib]; ++j)
+            {
+                const auto v = src[i + offsets[attrib] + j];
+                if (v < minVal || v > maxVal
+                    || (integral && v != std::floor(v)))
+                {
+                    return;
+                }
+            }
+        }
+        encoding |= CompactFlags[attrib];
+    };
+    checkRange(Mesh::Attribute::Colour, 0.f, 1.f, false);
+    checkRange(Mesh::Attribute::UV0, -MaxHalfUV, MaxHalfUV, false);
+    checkRange(Mesh::Attribute::UV1, -MaxHalfUV, MaxHalfUV, false);
+    checkRange(Mesh::Attribute::BlendIndices, 0.f, 255.f, true);
+    checkRange(Mesh::Attribute::BlendWeights, 0.f, 1.f, false);
+
+    dst.clear();
+    dst.reserve((src.size() / stride) * getVertexSize(flags, encoding));
+
+    for (auto i = 0u; i < src.size(); i += stride)
+    {
+        for (auto j = 0u; j < Mesh::Attribute::Total; ++j)
+        {
+            if ((flags & (1 << j)) == 0
+                || FloatCounts[j] == 0)
+            {
+                continue;
+            }
+
+            const auto* attrib = &src[i + offsets[j]];
+            if ((encoding & CompactFlags[j]) == 0)
+            {
+                for (auto k = 0u; k < FloatCounts[j]; ++k)
+                {
+                    writeValue(dst, attrib[k]);
+                }
+                continue;
+            }
+
+            switch (j)
+            {
+            default: break;
+            case Mesh::Attribute::Colour:
+                for (auto k = 0u; k < 4u; ++k)
+                {
+                    writeValue(dst, glm::packUnorm1x8(attrib[k]));
+                }
+                break;
+            case Mesh::Attribute::Normal:
+                writeOct(dst, { attrib[0], attrib[1], attrib[2] });
+                break;
+            case Mesh::Attribute::Tangent:
+                writeOct(dst, { attrib[0], attrib[1], attrib[2] });
+                writeValue(dst, static_cast<std::int16_t>(attrib[3] < 0.f ? -1 : 1));
+                break;
+            case Mesh::Attribute::UV0:
+            case Mesh::Attribute::UV1:
+                writeValue(dst, glm::packHalf1x16(attrib[0]));
+                writeValue(dst, glm::packHalf1x16(attrib[1]));
+                break;
+            case Mesh::Attribute::BlendIndices:
+                for (auto k = 0u; k < 4u; ++k)
+                {
+                    writeValue(dst, static_cast<std::uint8_t>(attrib[k]));
+                }
+                break;
+            case Mesh::Attribute::BlendWeights:
+                for (auto k = 0u; k < 4u; ++k)
+                {
+                    writeValue(dst, glm::packUnorm1x16(attrib[k]));
+                }
+                break;
+            }
+        }
+    }
+
+    return encoding;
+}
+
+bool CompactVertex::decode(const std::uint8_t* src, std::size_t size, std::uint16_t flags, std::uint32_t encoding, std::vector<float>& dst)
+{
+    const auto vertexSize = getVertexSize(flags, encoding);
+    if (vertexSize == 0
+        || size % vertexSize != 0)
+    {
+        return false;
+    }
+
+    std::size_t stride = 0;
+    for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+    {
+        if (flags & (1 << i))
+        {
+            stride += FloatCounts[i];
+        }
+    }
+
+    const auto vertexCount = size / vertexSize;
+    dst.clear();
+    dst.reserve(vertexCount * stride);
+
+    for (auto i = 0u; i < vertexCount; ++i)
+    {
+        for (auto j = 0u; j < Mesh::Attribute::Total; ++j)
+        {
+            if ((flags & (1 << j)) == 0
+                || FloatCounts[j] == 0)
+            {
+                continue;
+            }
+
+            if ((encoding & CompactFlags[j]) == 0)
+            {
+                for (auto k = 0u; k < FloatCounts[j]; ++k)
+                {
+                    dst.push_back(readValue<float>(src));
+                }
+                continue;
+            }
+
+            switch (j)
+            {
+            default: break;
+            case Mesh::Attribute::Colour:
+                for (auto k = 0u; k < 4u; ++k)
+                {
+                    dst.push_back(glm::unpackUnorm1x8(readValue<std::uint8_t>(src)));
+                }
+                break;
+            case Mesh::Attribute::Normal:
+            {
+                const auto n = readOct(src);
+                dst.push_back(n.x);
+                dst.push_back(n.y);
+                dst.push_back(n.z);
+            }
+                break;
+            case Mesh::Attribute::Tangent:
+            {
+                const auto t = readOct(src);
+                dst.push_back(t.x);
+                dst.push_back(t.y);
+                dst.push_back(t.z);
+                dst.push_back(static_cast<float>(readValue<std::int16_t>(src)));
+            }
+                break;
+            case Mesh::Attribute::UV0:
+            case Mesh::Attribute::UV1:
+                dst.push_back(glm::unpackHalf1x16(readValue<std::uint16_t>(src)));
+                dst.push_back(glm::unpackHalf1x16(readValue<std::uint16_t>(src)));
+                break;
+            case Mesh::Attribute::BlendIndices:
+                for (auto k = 0u; k < 4u; ++k)
+                {
+                    dst.push_back(static_cast<float>(readValue<std::uint8_t>(src)));
+                }
+                break;
+            case Mesh::Attribute::BlendWeights:
+                for (auto k = 0u; k < 4u; ++k)
+                {
+                    dst.push_back(glm::unpackUnorm1x16(readValue<std::uint16_t>(src)));
+                }
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool CompactVertex::read(SDL_RWops* file, std::size_t size, std::uint16_t flags, std::uint32_t encoding, std::vector<float>& dst)
+{
+    if ((encoding & ~ModelBinary::CompactIndices) == 0)
+    {
+        dst.resize(size / sizeof(float));
+        return SDL_RWread(file, dst.data(), size, 1) == 1;
+    }
+
+    std::vector<std::uint8_t> temp(size);
+    return SDL_RWread(file, temp.data(), size, 1) == 1
+        && decode(temp.data(), temp.size(), flags, encoding, dst);
+}
+
+std::uint32_t CompactVertex::getPackableAttributes(const std::vector<float>& src, const Mesh::Data& meshData)
+{
+    const auto stride = meshData.vertexSize / sizeof(float);
+    if (stride == 0
+        || src.size() % stride != 0)
+    {
+        return 0;
+    }
+
+    std::array<std::size_t, Mesh::Attribute::Total> offsets = {};
+    for (auto i = 1u; i < Mesh::Attribute::Total; ++i)
+    {
+        offsets[i] = offsets[i - 1] + meshData.attributes[i - 1];
+    }
+
+    std::uint32_t encoding = ModelBinary::CompactNormal | ModelBinary::CompactTangent;
+    auto checkRange = [&](std::int32_t attrib, float minVal, float maxVal, bool integral)
+    {
+        for (auto i = 0u; i < src.size(); i += stride)
+        {
+            for (auto j = 0u; j < meshData.attributes[attrib]; ++j)
+            {
+                const auto v = src[i + offsets[attrib] + j];
+                if (v < minVal || v > maxVal
+                    || (integral && v != std::floor(v)))
+                {
+                    return;
+                }
+            }
+        }
+        encoding |= PackedFlags[attrib];
+    };
+    checkRange(Mesh::Attribute::Colour, 0.f, 1.f, false);
+    checkRange(Mesh::Attribute::UV0, -MaxHalfUV, MaxHalfUV, false);
+    checkRange(Mesh::Attribute::UV1, -MaxHalfUV, MaxHalfUV, false);
+    checkRange(Mesh::Attribute::BlendIndices, 0.f, 255.f, true);
+    checkRange(Mesh::Attribute::BlendWeights, 0.f, 1.f, false);
+
+    return encoding;
+}
+
+void CompactVertex::setPackedFormat(Mesh::Data& meshData, std::uint32_t encoding)
+{
+    for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+    {
+        if (meshData.attributes[i] != 0
+            && (encoding & PackedFlags[i]))
+        {
+            meshData.attributeFormats[i] = PackedFormats[i];
+        }
+        else
+        {
+            meshData.attributeFormats[i] = {};
+        }
+    }
+
+    meshData.packedVertexSize = 0;
+    for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+    {
+        meshData.packedVertexSize += Mesh::getAttributeSize(meshData, i);
+    }
+
+    //nothing was packed
+    if (meshData.packedVertexSize == meshData.vertexSize)
+    {
+        meshData.packedVertexSize = 0;
+    }
+}
+
+void CompactVertex::pack(const std::vector<float>& src, const Mesh::Data& meshData, std::vector<std::uint8_t>& dst)
+{
+    const auto stride = meshData.vertexSize / sizeof(float);
+    CRO_ASSERT(stride != 0 && src.size() % stride == 0, "");
+
+    dst.clear();
+    dst.reserve((src.size() / stride) * Mesh::getVertexStride(meshData));
+
+    for (auto i = 0u; i < src.size(); i += stride)
+    {
+        const auto* attrib = &src[i];
+        for (auto j = 0u; j < Mesh::Attribute::Total; ++j)
+        {
+            const auto count = meshData.attributes[j];
+            const auto start = dst.size();
+
+            switch (meshData.attributeFormats[j].type)
+            {
+            default:
+            case 0:
+            case GL_FLOAT:
+                for (auto k = 0u; k < count; ++k)
+                {
+                    writeValue(dst, attrib[k]);
+                }
+                break;
+            case GL_UNSIGNED_BYTE:
+                for (auto k = 0u; k < count; ++k)
+                {
+                    writeValue(dst, meshData.attributeFormats[j].normalised ?
+                        glm::packUnorm1x8(attrib[k]) : static_cast<std::uint8_t>(attrib[k]));
+                }
+                break;
+            case GL_SHORT:
+                for (auto k = 0u; k < count; ++k)
+                {
+                    writeValue(dst, glm::packSnorm1x16(attrib[k]));
+                }
+                break;
+            case GL_UNSIGNED_SHORT:
+                for (auto k = 0u; k < count; ++k)
+                {
+                    writeValue(dst, glm::packUnorm1x16(attrib[k]));
+                }
+                break;
+            case GL_HALF_FLOAT:
+                for (auto k = 0u; k < count; ++k)
+                {
+                    writeValue(dst, glm::packHalf1x16(attrib[k]));
+                }
+                break;
+            }
+
+            //pad to the attribute size
+            dst.resize(start + Mesh::getAttributeSize(meshData, j), 0);
+            attrib += count;
+        }
+    }
+}
+
+bool CompactVertex::unpack(const std::uint8_t* src, std::size_t size, const Mesh::Data& meshData, std::vector<float>& dst)
+{
+    const auto vertexSize = Mesh::getVertexStride(meshData);
+    if (vertexSize == 0
+        || size % vertexSize != 0)
+    {
+        return false;
+    }
+
+    const auto vertexCount = size / vertexSize;
+    dst.clear();
+    dst.reserve(vertexCount * (meshData.vertexSize / sizeof(float)));
+
+    for (auto i = 0u; i < vertexCount; ++i)
+    {
+        for (auto j = 0u; j < Mesh::Attribute::Total; ++j)
+        {
+            const auto count = meshData.attributes[j];
+            const auto* next = src + Mesh::getAttributeSize(meshData, j);
+
+            switch (meshData.attributeFormats[j].type)
+            {
+            default:
+            case 0:
+            case GL_FLOAT:
+                for (auto k = 0u; k < count; ++k)
+                {
+                    dst.push_back(readValue<float>(src));
+                }
+                break;
+            case GL_UNSIGNED_BYTE:
+                for (auto k = 0u; k < count; ++k)
+                {
+                    const auto v = readValue<std::uint8_t>(src);
+                    dst.push_back(meshData.attributeFormats[j].normalised ?
+                        glm::unpackUnorm1x8(v) : static_cast<float>(v));
+                }
+                break;
+            case GL_SHORT:
+                for (auto k = 0u; k < count; ++k)
+                {
+                    dst.push_back(glm::unpackSnorm1x16(readValue<std::uint16_t>(src)));
+                }
+                break;
+            case GL_UNSIGNED_SHORT:
+                for (auto k = 0u; k < count; ++k)
+                {
+                    dst.push_back(glm::unpackUnorm1x16(readValue<std::uint16_t>(src)));
+                }
+                break;
+            case GL_HALF_FLOAT:
+                for (auto k = 0u; k < count; ++k)
+                {
+                    dst.push_back(glm::unpackHalf1x16(readValue<std::uint16_t>(src)));
+                }
+                break;
+            }
+
+            //skip padding
+            src = next;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,140 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/graphics/MeshData.hpp>
+
+#include <crogine/detail/glm/vec2.hpp>
+#include <crogine/detail/glm/vec3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+struct SDL_RWops;
+
+namespace cro::Detail::CompactVertex
+{
+    /*!
+    \brief Encodes a unit vector as two components in the range -1 to 1
+    by projecting it on to an octahedron
+    */
+    glm::vec2 octEncode(glm::vec3);
+
+    /*!
+    \brief Decodes a normalised vector encoded with octEncode()
+    */
+    glm::vec3 octDecode(glm::vec2);
+
+    /*!
+    \brief Returns the size in bytes of a single vertex with the given
+    VertexProperty flags, stored with the given ModelBinary::CompactFlags
+    */
+    std::size_t getVertexSize(std::uint16_t flags, std::uint32_t encoding);
+
+    /*!
+    \brief Converts vertex data in the float layout used by ModelBinary
+    version 2 to a compact form.
+    Attributes are only quantised if they can be stored without a
+    significant loss of precision, eg UVs which are used for tiling over
+    a large range are left as floats.
+    \param src Vertex data in the version 2 layout
+    \param flags VertexProperty flags describing the vertex layout
+    \param dst Vector to which the encoded vertex data is written
+    \returns A combination of ModelBinary::CompactFlags describing the
+    attributes which were quantised
+    */
+    std::uint32_t encode(const std::vector<float>& src, std::uint16_t flags, std::vector<std::uint8_t>& dst);
+
+    /*!
+    \brief Converts vertex data created with encode() back to the version 2 float layout
+    \param src Pointer to the encoded vertex data
+    \param size Size of the encoded data in bytes
+    \param flags VertexProperty flags describing the vertex layout
+    \param encoding ModelBinary::CompactFlags returned by encode()
+    \param dst Vector to which the decoded vertex data is written
+    \returns false if size is not a multiple of the vertex size
+    */
+    bool decode(const std::uint8_t* src, std::size_t size, std::uint16_t flags, std::uint32_t encoding, std::vector<float>& dst);
+
+    /*!
+    \brief Reads size bytes of vertex data from the current position of the given file,
+    decoding it if necessary.
+    \param file File positioned at the beginning of the vertex data of a model binary
+    \param size Size of the vertex data in bytes
+    \param flags VertexProperty flags describing the vertex layout
+    \param encoding Header::vertexEncoding of the model binary, or 0 if
+    the file is version 2 or less
+    \param dst Vector to which the vertex data is written in the version 2 layout
+    \returns false if the data could not be read
+    */
+    bool read(SDL_RWops* file, std::size_t size, std::uint16_t flags, std::uint32_t encoding, std::vector<float>& dst);
+
+    /*!
+    \brief Returns the ModelBinary::CompactFlags of the attributes which can
+    be packed without a significant loss of precision. As with encode()
+    normals and tangents are always included.
+    \param src Vertex data in the float layout described by meshData.attributes
+    \param meshData Mesh data describing the vertex layout
+    */
+    std::uint32_t getPackableAttributes(const std::vector<float>& src, const Mesh::Data& meshData);
+
+    /*!
+    \brief Sets the attribute formats and packed vertex size of the given
+    mesh data for vertex data packed with pack().
+    Normals, tangents and bitangents are stored as 4 x std::int16_t
+    normalised (the last component is padding) so that they can be used
+    by existing shaders without decoding. The other attributes flagged in
+    encoding are stored as described by ModelBinary::CompactFlags, padded
+    to a multiple of 4 bytes. Any attribute not flagged remains float.
+    \param meshData Mesh data with the attribute sizes of the float vertex layout
+    \param encoding ModelBinary::CompactFlags of the attributes to pack
+    */
+    void setPackedFormat(Mesh::Data& meshData, std::uint32_t encoding);
+
+    /*!
+    \brief Converts vertex data in the float layout of the given mesh data to
+    the packed layout set by setPackedFormat(), which can be uploaded to the
+    GPU as it is.
+    \param src Vertex data in the float layout described by meshData.attributes
+    \param meshData Mesh data with the packed format applied by setPackedFormat()
+    \param dst Vector to which the packed vertex data is written
+    */
+    void pack(const std::vector<float>& src, const Mesh::Data& meshData, std::vector<std::uint8_t>& dst);
+
+    /*!
+    \brief Converts packed vertex data back to the float layout of the given mesh data
+    \param src Pointer to the packed vertex data
+    \param size Size of the packed data in bytes
+    \param meshData Mesh data with the packed format applied by setPackedFormat()
+    \param dst Vector to which the float vertex data is written
+    \returns false if size is not a multiple of the packed vertex size
+    */
+    bool unpack(const std::uint8_t* src, std::size_t size, const Mesh::Data& meshData, std::vector<float>& dst);
+}
@@ -29,10 +29,14 @@ source distribution.
 
 #include "DistanceField.hpp"
 
+#include <crogine/detail/Assert.hpp>
+#include <crogine/core/ThreadPool.hpp>
+
 #include <cmath>
 #include <climits>
-#include <cstring>
+#include <limits>
 #include <algorithm>
+#include <atomic>
 
 using namespace cro;
 using namespace cro::Detail;
@@ -40,6 +44,21 @@ using namespace cro::Detail;
 namespace
 {
     const float INF = std::numeric_limits<float>::infinity();
+
+    //the lower envelope produces NaN when comparing two
+    //infinite values, so input uses a large finite value
+    constexpr float FarDistance = 1e20f;
+
+    //columns are gathered in blocks so that each row
+    //of the image is read as a contiguous run
+    constexpr std::int32_t ColumnBlock = 16;
+
+    //smaller images, such as single glyphs, aren't worth
+    //the cost of starting threads
+    constexpr std::int32_t MinThreadedSize = 256 * 256;
+
+    std::atomic<bool> multithreaded = true;
+
     inline std::int32_t square(std::int32_t x)
     {
         return x * x;
@@ -53,68 +72,152 @@ std::vector<std::uint8_t> DistanceField::toDF(const SDL_Surface* input)
     std::uint8_t* pixels = static_cast<std::uint8_t*>(input->pixels);
     for (auto i = 0u; i < size; ++i)
     {
-        floatData[i] = (pixels[i] > 240) ? 0.f : INF;
+        floatData[i] = (pixels[i] > 240) ? 0.f : FarDistance;
     }
 
     twoD(floatData, input->pitch, input->h);
 
-    for (auto& f : floatData)
+    return toBytes(floatData);
+}
+
+std::vector<std::uint8_t> DistanceField::toSDF(const std::vector<std::uint8_t>& coverage, std::int32_t width, std::int32_t height, float spread)
+{
+    CRO_ASSERT(coverage.size() == static_cast<std::size_t>(width * height), "");
+    CRO_ASSERT(spread > 0, "");
+
+    //distance to the nearest inside pixel, and the nearest outside pixel
+    std::vector<float> outside(coverage.size());
+    std::vector<float> inside(coverage.size());
+    for (auto i = 0u; i < coverage.size(); ++i)
     {
-        f = std::sqrt(f);
+        const bool isInside = coverage[i] > 127;
+        outside[i] = isInside ? 0.f : FarDistance;
+        inside[i] = isInside ? FarDistance : 0.f;
     }
 
-    return toBytes(floatData);
+    twoD(outside, width, height);
+    twoD(inside, width, height);
+
+    std::vector<std::uint8_t> retVal(coverage.size());
+    for (auto i = 0u; i < retVal.size(); ++i)
+    {
+        const float distance = std::sqrt(outside[i]) - std::sqrt(inside[i]);
+        const float value = std::clamp(0.5f - (distance / (2.f * spread)), 0.f, 1.f);
+        retVal[i] = static_cast<std::uint8_t>(std::round(value * 255.f));
+    }
+
+    return retVal;
+}
+
+void DistanceField::setMultithreaded(bool enabled)
+{
+    multithreaded = enabled;
 }
 
 //private
+DistanceField::Scratch::Scratch(std::int32_t width, std::int32_t height)
+    : input (ColumnBlock * std::max(width, height)),
+    output  (ColumnBlock * std::max(width, height)),
+    v       (std::max(width, height)),
+    z       (std::max(width, height) + 1)
+{
+
+}
+
 void DistanceField::twoD(std::vector<float>& floatData, std::int32_t width, std::int32_t height)
 {
-    std::vector<float> f(std::max(width, height));
+    CRO_ASSERT(floatData.size() == static_cast<std::size_t>(width * height), "");
+
+    //the calling thread runs jobs too while it waits, so
+    //split the work between it and each of the pool's workers
+    const std::int32_t threadCount = (width * height < MinThreadedSize || !multithreaded) ? 1 :
+        static_cast<std::int32_t>(ThreadPool::getShared().getThreadCount()) + 1;
 
-    for (auto x = 0; x < width; x++) 
+    if (threadCount == 1)
     {
-        for (auto y = 0; y < height; y++)
+        Scratch scratch(width, height);
+        columns(floatData.data(), width, height, 0, width, scratch);
+        rows(floatData.data(), width, 0, height, scratch);
+        return;
+    }
+
+    //each job owns its scratch buffer, rather than indexing by
+    //thread, as we may be called from one of the pool's workers
+    auto& threadPool = ThreadPool::getShared();
+    ThreadPool::JobGroup jobGroup;
+    std::vector<Scratch> scratch(threadCount, Scratch(width, height));
+
+    const auto dispatch = [&](std::int32_t count, const auto& pass)
+    {
+        for (auto i = 0; i < threadCount; ++i)
         {
-            f[y] = floatData[y * width + x];
+            const std::int32_t start = (count * i) / threadCount;
+            const std::int32_t end = (count * (i + 1)) / threadCount;
+            threadPool.push([&, i, start, end]() { pass(start, end, scratch[i]); }, jobGroup);
         }
-        auto d = oneD(f, height);
+        threadPool.wait(jobGroup);
+    };
+
+    //columns must all be complete before the rows are processed
+    dispatch(width, [&](std::int32_t start, std::int32_t end, Scratch& s) { columns(floatData.data(), width, height, start, end, s); });
+    dispatch(height, [&](std::int32_t start, std::int32_t end, Scratch& s) { rows(floatData.data(), width, start, end, s); });
+}
+
+void DistanceField::columns(float* floatData, std::int32_t width, std::int32_t height, std::int32_t start, std::int32_t end, Scratch& scratch)
+{
+    for (auto x = start; x < end; x += ColumnBlock)
+    {
+        const auto blockWidth = std::min(ColumnBlock, end - x);
 
         for (auto y = 0; y < height; y++)
         {
-            floatData[y * width + x] = d[y];
+            const float* row = floatData + (y * width + x);
+            for (auto i = 0; i < blockWidth; ++i)
+            {
+                scratch.input[i * height + y] = row[i];
+            }
         }
-    }
 
-    for (auto y = 0; y < height; y++)
-    {
-        for (auto x = 0; x < width; x++)
+        for (auto i = 0; i < blockWidth; ++i)
         {
-            f[x] = floatData[y * width + x];
+            oneD(&scratch.input[i * height], &scratch.output[i * height], scratch, height);
         }
-        auto d = oneD(f, width);
 
-        for (auto x = 0; x < width; x++)
+        for (auto y = 0; y < height; y++)
         {
-            floatData[y * width + x] = d[x];
+            float* row = floatData + (y * width + x);
+            for (auto i = 0; i < blockWidth; ++i)
+            {
+                row[i] = scratch.output[i * height + y];
+            }
         }
     }
 }
 
-std::vector<float> DistanceField::oneD(const std::vector<float>& floatData, std::size_t size)
+void DistanceField::rows(float* floatData, std::int32_t width, std::int32_t start, std::int32_t end, Scratch& scratch)
+{
+    for (auto y = start; y < end; y++)
+    {
+        float* row = floatData + (y * width);
+        std::copy(row, row + width, scratch.input.begin());
+        oneD(scratch.input.data(), row, scratch, width);
+    }
+}
+
+void DistanceField::oneD(const float* floatData, float* d, Scratch& scratch, std::int32_t size)
 {
-    std::vector<float> d(size);
-    std::vector<std::int32_t> v(size);
-    std::vector<float> z(size + 1);
+    auto* v = scratch.v.data();
+    auto* z = scratch.z.data();
 
     std::int32_t k = 0;
     v[0] = 0;
     z[0] = -INF;
     z[1] = INF;
 
-    for (auto q = 1u; q <= size - 1; q++)
+    for (auto q = 1; q < size; q++)
     {
         float s = ((floatData[q] + square(q)) - (floatData[v[k]] + square(v[k]))) / (2 * q - 2 * v[k]);
-        while (s <= z[k]) 
+        while (s <= z[k])
         {
             k--;
             s = ((floatData[q] + square(q)) - (floatData[v[k]] + square(v[k]))) / (2 * q - 2 * v[k]);
@@ -122,32 +225,34 @@ std::vector<float> DistanceField::oneD(const std::vector<float>& floatData, std:
         k++;
         v[k] = q;
         z[k] = s;
-        z[k + 1] = +INF;
+        z[k + 1] = INF;
     }
 
     k = 0;
-    for (auto q = 0u; q <= size - 1; q++) 
+    for (auto q = 0; q < size; q++)
     {
         while (z[k + 1] < q)
+        {
             k++;
+        }
         d[q] = square(q - v[k]) + floatData[v[k]];
     }
-
-    return d;
 }
 
-std::vector<std::uint8_t> DistanceField::toBytes(const std::vector<float>& floatData)
+std::vector<std::uint8_t> DistanceField::toBytes(std::vector<float>& floatData)
 {
+    //take the root in place while finding the range
+    //rather than making a second pass
     float min, max;
-    min = max = floatData[0];
-    for (auto f : floatData)
+    min = max = std::sqrt(floatData[0]);
+    for (auto& f : floatData)
     {
+        f = std::sqrt(f);
         if (f < min) min = f;
         if (f > max) max = f;
     }
 
     std::vector<std::uint8_t> retVal(floatData.size());
-    std::memset(retVal.data(), 0, retVal.size());
     if (min == max)
     {
         return retVal;
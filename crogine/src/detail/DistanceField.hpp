@@ -46,10 +46,39 @@ namespace cro
         public:
             static std::vector<std::uint8_t> toDF(const SDL_Surface* input);
 
+            /*!
+            \brief Creates a signed distance field from a single channel
+            coverage bitmap, such as a rasterised glyph.
+            Pixels with coverage greater than half are considered inside.
+            The returned values are centred on 128 at the edge and reach
+            0 or 255 at spread pixels outside or inside respectively.
+            */
+            static std::vector<std::uint8_t> toSDF(const std::vector<std::uint8_t>& coverage, std::int32_t width, std::int32_t height, float spread);
+
+            /*!
+            \brief Enables or disables splitting large images across the
+            shared ThreadPool. The output is identical either way. Enabled
+            by default.
+            */
+            static void setMultithreaded(bool);
+
         private:
+            //working memory for the 1D transform, allocated once
+            //per thread rather than once per row or column
+            struct Scratch final
+            {
+                Scratch(std::int32_t width, std::int32_t height);
+                std::vector<float> input;
+                std::vector<float> output;
+                std::vector<std::int32_t> v;
+                std::vector<float> z;
+            };
+
             static void twoD(std::vector<float>&, std::int32_t, std::int32_t);
-            static std::vector<float> oneD(const std::vector<float>&, std::size_t);
-            static std::vector<std::uint8_t> toBytes(const std::vector<float>&);
+            static void columns(float*, std::int32_t, std::int32_t, std::int32_t, std::int32_t, Scratch&);
+            static void rows(float*, std::int32_t, std::int32_t, std::int32_t, Scratch&);
+            static void oneD(const float*, float*, Scratch&, std::int32_t);
+            static std::vector<std::uint8_t> toBytes(std::vector<float>&);
         };
     }
 }
\ No newline at end of file
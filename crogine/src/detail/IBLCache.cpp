@@ -0,0 +1,138 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "IBLCache.hpp"
+
+#include <crogine/core/App.hpp>
+#include <crogine/core/FileSystem.hpp>
+#include <crogine/core/Log.hpp>
+
+#include <SDL_rwops.h>
+
+#include <cstdio>
+
+using namespace cro;
+using namespace cro::Detail;
+
+IBLCache::Header IBLCache::createHeader(std::uint64_t sourceHash, std::uint32_t skyboxSize,
+    std::uint32_t irradianceSize, std::uint32_t prefilterSize, std::uint32_t prefilterLevels)
+{
+    Header header;
+    header.sourceHash = sourceHash;
+    header.skyboxSize = skyboxSize;
+    header.irradianceSize = irradianceSize;
+    header.prefilterSize = prefilterSize;
+    header.prefilterLevels = prefilterLevels;
+
+    header.dataSize = levelSize(skyboxSize) + levelSize(irradianceSize);
+    for (auto i = 0u; i < prefilterLevels; ++i)
+    {
+        header.dataSize += levelSize(prefilterSize >> i);
+    }
+    header.dataSize *= sizeof(std::uint16_t);
+
+    return header;
+}
+
+bool IBLCache::isValid(const Header& header, const Header& expected, std::size_t fileSize)
+{
+    return header.magic == expected.magic
+        && header.version == expected.version
+        && header.sourceHash == expected.sourceHash
+        && header.skyboxSize == expected.skyboxSize
+        && header.irradianceSize == expected.irradianceSize
+        && header.prefilterSize == expected.prefilterSize
+        && header.prefilterLevels == expected.prefilterLevels
+        && header.dataSize == expected.dataSize
+        && fileSize == sizeof(Header) + expected.dataSize;
+}
+
+std::uint64_t IBLCache::hash(const std::uint8_t* data, std::size_t size)
+{
+    std::uint64_t retVal = 0xcbf29ce484222325ull;
+    for (auto i = 0u; i < size; ++i)
+    {
+        retVal ^= data[i];
+        retVal *= 0x100000001b3ull;
+    }
+    return retVal;
+}
+
+std::string IBLCache::getLocalPath(const std::string& sourcePath)
+{
+    const auto ext = FileSystem::getFileExtension(sourcePath);
+    return sourcePath.substr(0, sourcePath.size() - ext.size()) + ".cenv";
+}
+
+std::string IBLCache::getUserPath(const std::string& sourcePath)
+{
+    //named from the path rather than the contents so
+    //that editing the source replaces the old cache
+    const auto pathHash = hash(reinterpret_cast<const std::uint8_t*>(sourcePath.data()), sourcePath.size());
+
+    char name[24] = {};
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(pathHash));
+
+    return App::getPreferencePath() + "cache/" + name + ".cenv";
+}
+
+bool IBLCache::write(const std::string& path, const Header& header, const std::vector<std::uint16_t>& data)
+{
+    if (data.size() * sizeof(std::uint16_t) != header.dataSize)
+    {
+        LogE << "IBL cache data size doesn't match header" << std::endl;
+        return false;
+    }
+
+    const auto dir = FileSystem::getFilePath(path);
+    if (!dir.empty()
+        && !FileSystem::directoryExists(dir))
+    {
+        FileSystem::createDirectory(dir);
+    }
+
+    auto* file = SDL_RWFromFile(path.c_str(), "wb");
+    if (!file)
+    {
+        LogE << "Failed opening " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    bool retVal = SDL_RWwrite(file, &header, sizeof(header), 1) == 1
+        && SDL_RWwrite(file, data.data(), header.dataSize, 1) == 1;
+    SDL_RWclose(file);
+
+    if (!retVal)
+    {
+        LogE << "Failed writing IBL cache " << path << std::endl;
+        std::remove(path.c_str());
+    }
+
+    return retVal;
+}
@@ -0,0 +1,116 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace cro::Detail::IBLCache
+{
+    //appears at the beginning of the file
+    static constexpr std::uint32_t MAGIC = 0x564e4543; //CENV
+    static constexpr std::uint32_t Version = 1;
+
+    struct Header final
+    {
+        std::uint32_t magic = MAGIC;
+        //files with a different version are rebuilt
+        std::uint32_t version = Version;
+        //hash of the *.hdr file the data was created from
+        std::uint64_t sourceHash = 0;
+
+        //face sizes of each cube map, in texels
+        std::uint32_t skyboxSize = 0;
+        std::uint32_t irradianceSize = 0;
+        std::uint32_t prefilterSize = 0;
+        //number of mip levels stored for the prefilter map
+        std::uint32_t prefilterLevels = 0;
+
+        //size of the texel data in bytes
+        std::uint64_t dataSize = 0;
+    };
+    /*
+    Texel data immediately follows the header, stored as
+    three channel (RGB) half floats, one face after another
+    in GL_TEXTURE_CUBE_MAP_POSITIVE_X order:
+
+    skybox level 0
+    irradiance level 0
+    prefilter levels 0 - prefilterLevels-1, each half the size of the last
+
+    The skybox mip chain is not stored, it is regenerated on upload.
+    */
+
+    /*!
+    \brief Returns the number of half floats in a level
+    of a cube map with the given face size.
+    */
+    constexpr std::size_t levelSize(std::uint32_t faceSize)
+    {
+        return static_cast<std::size_t>(faceSize) * faceSize * 3 * 6;
+    }
+
+    /*!
+    \brief Returns a header with the given sizes and the
+    correct data size filled in
+    */
+    Header createHeader(std::uint64_t sourceHash, std::uint32_t skyboxSize,
+        std::uint32_t irradianceSize, std::uint32_t prefilterSize, std::uint32_t prefilterLevels);
+
+    /*!
+    \brief Returns true if a cache file of fileSize bytes
+    starting with the given header matches the expected header
+    */
+    bool isValid(const Header& header, const Header& expected, std::size_t fileSize);
+
+    /*!
+    \brief FNV-1a hash of the given data
+    */
+    std::uint64_t hash(const std::uint8_t* data, std::size_t size);
+
+    /*!
+    \brief Returns the path of a cache file shipped alongside
+    the source file, eg sky.hdr -> sky.cenv
+    */
+    std::string getLocalPath(const std::string& sourcePath);
+
+    /*!
+    \brief Returns the path of the cache file stored in the
+    user's preference directory for the given source
+    */
+    std::string getUserPath(const std::string& sourcePath);
+
+    /*!
+    \brief Writes the header and texel data to the given path
+    */
+    bool write(const std::string& path, const Header& header, const std::vector<std::uint16_t>& data);
+}
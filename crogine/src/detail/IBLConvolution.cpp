@@ -0,0 +1,415 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "IBLConvolution.hpp"
+#include "IBLCache.hpp"
+
+#include <crogine/detail/Assert.hpp>
+#include <crogine/core/ThreadPool.hpp>
+#include <crogine/detail/glm/common.hpp>
+#include <crogine/detail/glm/geometric.hpp>
+
+#include <atomic>
+#include <cmath>
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    constexpr float PI = 3.14159265359f;
+
+    //these match the values used by the shaders in PBRCubemap.hpp
+    constexpr float IrradianceSampleDelta = 0.025f;
+    constexpr std::uint32_t PrefilterSampleCount = 1024;
+    constexpr float PrefilterSourceResolution = 1024.f;
+
+    std::atomic<bool> multithreaded = true;
+
+    float radicalInverse(std::uint32_t bits)
+    {
+        bits = (bits << 16u) | (bits >> 16u);
+        bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+        bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+        bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+        bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+        return static_cast<float>(bits) * 2.3283064365386963e-10f;
+    }
+
+    //sample direction relative to a normal of (0,0,1)
+    struct TangentSample final
+    {
+        glm::vec3 direction = glm::vec3(0.f);
+        float weight = 0.f;
+        float level = 0.f;
+    };
+}
+
+//public
+IBLConvolution::Cubemap IBLConvolution::fromEquirectangular(const float* data, std::int32_t width, std::int32_t height, std::int32_t channels, std::uint32_t size)
+{
+    CRO_ASSERT(data && width > 0 && height > 0, "");
+    CRO_ASSERT(channels >= 3, "");
+
+    const auto texel = [&](std::int32_t x, std::int32_t y)
+    {
+        x = std::clamp(x, 0, width - 1);
+        y = std::clamp(y, 0, height - 1);
+        const auto* t = data + ((y * width + x) * channels);
+        return glm::vec3(t[0], t[1], t[2]);
+    };
+
+    Cubemap retVal;
+    retVal.size = size;
+    retVal.levels.emplace_back(IBLCache::levelSize(size));
+
+    forEachTexel(retVal, 0, 
+        [&](glm::vec3 direction)
+        {
+            //matches sampleSphericalMap() in HDRToCubeFrag
+            direction = glm::normalize(direction);
+            const float u = (std::atan2(direction.z, direction.x) * 0.1591f) + 0.5f;
+            const float v = (std::asin(direction.y) * 0.3183f) + 0.5f;
+
+            const float x = (u * width) - 0.5f;
+            const float y = (v * height) - 0.5f;
+            const auto x0 = static_cast<std::int32_t>(std::floor(x));
+            const auto y0 = static_cast<std::int32_t>(std::floor(y));
+            const float fx = x - x0;
+            const float fy = y - y0;
+
+            return glm::mix(glm::mix(texel(x0, y0), texel(x0 + 1, y0), fx),
+                            glm::mix(texel(x0, y0 + 1), texel(x0 + 1, y0 + 1), fx), fy);
+        });
+
+    return retVal;
+}
+
+void IBLConvolution::generateMipmaps(Cubemap& cubemap)
+{
+    CRO_ASSERT(!cubemap.levels.empty(), "");
+    cubemap.levels.resize(1);
+
+    for (auto level = 1u; cubemap.getSize(level - 1) > 1; ++level)
+    {
+        const auto srcSize = cubemap.getSize(level - 1);
+        const auto dstSize = cubemap.getSize(level);
+        cubemap.levels.emplace_back(IBLCache::levelSize(dstSize));
+        const auto& src = cubemap.levels[level - 1];
+        auto& dst = cubemap.levels[level];
+
+        for (auto face = 0u; face < 6u; ++face)
+        {
+            const auto* srcFace = src.data() + (face * srcSize * srcSize * 3);
+            auto* dstFace = dst.data() + (face * dstSize * dstSize * 3);
+
+            for (auto y = 0u; y < dstSize; ++y)
+            {
+                for (auto x = 0u; x < dstSize; ++x)
+                {
+                    for (auto c = 0u; c < 3u; ++c)
+                    {
+                        const auto sx = x * 2;
+                        const auto sy = y * 2;
+                        const auto sx1 = std::min(sx + 1, srcSize - 1);
+                        const auto sy1 = std::min(sy + 1, srcSize - 1);
+
+                        dstFace[(y * dstSize + x) * 3 + c] =
+                            (srcFace[(sy * srcSize + sx) * 3 + c]
+                            + srcFace[(sy * srcSize + sx1) * 3 + c]
+                            + srcFace[(sy1 * srcSize + sx) * 3 + c]
+                            + srcFace[(sy1 * srcSize + sx1) * 3 + c]) * 0.25f;
+                    }
+                }
+            }
+        }
+    }
+}
+
+IBLConvolution::Cubemap IBLConvolution::convolveIrradiance(const Cubemap& source, std::uint32_t size)
+{
+    CRO_ASSERT(!source.levels.empty(), "");
+
+    //the hemisphere samples are the same for every texel, only the basis changes
+    std::vector<TangentSample> samples;
+    for (float phi = 0.f; phi < 2.f * PI; phi += IrradianceSampleDelta)
+    {
+        for (float theta = 0.f; theta < 0.5f * PI; theta += IrradianceSampleDelta)
+        {
+            auto& s = samples.emplace_back();
+            s.direction = glm::vec3(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta));
+            s.weight = std::cos(theta) * std::sin(theta);
+        }
+    }
+
+    //on the GPU neighbouring output texels are so far apart that the
+    //implicit LOD selects the level closest in size to the output
+    const float level = std::log2(static_cast<float>(source.size) / size);
+
+    Cubemap retVal;
+    retVal.size = size;
+    retVal.levels.emplace_back(IBLCache::levelSize(size));
+
+    forEachTexel(retVal, 0,
+        [&](glm::vec3 direction)
+        {
+            //matches IrradianceFrag, including its unnormalised basis
+            const auto normal = glm::normalize(direction);
+            auto up = glm::vec3(0.f, 1.f, 0.f);
+            const auto right = glm::cross(up, normal);
+            up = glm::cross(normal, right);
+
+            glm::vec3 irradiance(0.f);
+            for (const auto& s : samples)
+            {
+                const auto sampleVec = (s.direction.x * right) + (s.direction.y * up) + (s.direction.z * normal);
+                irradiance += sample(source, sampleVec, level) * s.weight;
+            }
+            return PI * irradiance * (1.f / static_cast<float>(samples.size()));
+        });
+
+    return retVal;
+}
+
+IBLConvolution::Cubemap IBLConvolution::prefilter(const Cubemap& source, std::uint32_t size, std::uint32_t levelCount)
+{
+    CRO_ASSERT(!source.levels.empty(), "");
+    CRO_ASSERT(levelCount > 1, "");
+
+    Cubemap retVal;
+    retVal.size = size;
+
+    const float maxLevel = static_cast<float>(source.levels.size() - 1);
+    const float saTexel = 4.f * PI / (6.f * PrefilterSourceResolution * PrefilterSourceResolution);
+
+    for (auto level = 0u; level < levelCount; ++level)
+    {
+        retVal.levels.emplace_back(IBLCache::levelSize(retVal.getSize(level)));
+        const float roughness = static_cast<float>(level) / static_cast<float>(levelCount - 1);
+
+        //as view == normal the importance samples are the same for
+        //every texel in the level, so precalculate them in tangent space
+        std::vector<TangentSample> samples;
+        const float a = roughness * roughness;
+        const float a2 = a * a;
+        for (auto i = 0u; i < PrefilterSampleCount; ++i)
+        {
+            const float x = static_cast<float>(i) / PrefilterSampleCount;
+            const float y = radicalInverse(i);
+
+            const float phi = 2.f * PI * x;
+            const float cosTheta = std::sqrt((1.f - y) / (1.f + (a2 - 1.f) * y));
+            const float sinTheta = std::sqrt(1.f - cosTheta * cosTheta);
+            const glm::vec3 halfDir(std::cos(phi) * sinTheta, std::sin(phi) * sinTheta, cosTheta);
+            const auto lightDir = glm::normalize(2.f * halfDir.z * halfDir - glm::vec3(0.f, 0.f, 1.f));
+
+            const float NdotL = std::max(lightDir.z, 0.f);
+            if (NdotL > 0)
+            {
+                const float NdotH = std::max(halfDir.z, 0.f);
+                const float denom = (NdotH * NdotH * (a2 - 1.f) + 1.f);
+                const float D = a2 / (PI * denom * denom);
+                const float pdf = D * NdotH / (4.f * NdotH) + 0.0001f;
+                const float saSample = 1.f / (static_cast<float>(PrefilterSampleCount) * pdf + 0.0001f);
+
+                auto& s = samples.emplace_back();
+                s.direction = lightDir;
+                s.weight = NdotL;
+                s.level = roughness == 0 ? 0.f : std::clamp(0.5f * std::log2(saSample / saTexel), 0.f, maxLevel);
+            }
+        }
+
+        forEachTexel(retVal, level,
+            [&](glm::vec3 direction)
+            {
+                const auto normal = glm::normalize(direction);
+                const auto up = std::abs(normal.z) < 0.999f ? glm::vec3(0.f, 0.f, 1.f) : glm::vec3(1.f, 0.f, 0.f);
+                const auto tangent = glm::normalize(glm::cross(up, normal));
+                const auto bitangent = glm::cross(normal, tangent);
+
+                glm::vec3 colour(0.f);
+                float totalWeight = 0.f;
+                for (const auto& s : samples)
+                {
+                    const auto lightDir = (tangent * s.direction.x) + (bitangent * s.direction.y) + (normal * s.direction.z);
+                    colour += sample(source, lightDir, s.level) * s.weight;
+                    totalWeight += s.weight;
+                }
+                return colour / totalWeight;
+            });
+    }
+
+    return retVal;
+}
+
+glm::vec3 IBLConvolution::getDirection(std::uint32_t face, float s, float t)
+{
+    const float sc = (s * 2.f) - 1.f;
+    const float tc = (t * 2.f) - 1.f;
+
+    switch (face)
+    {
+    default:
+    case 0: return { 1.f, -tc, -sc };
+    case 1: return { -1.f, -tc, sc };
+    case 2: return { sc, 1.f, tc };
+    case 3: return { sc, -1.f, -tc };
+    case 4: return { sc, -tc, 1.f };
+    case 5: return { -sc, -tc, -1.f };
+    }
+}
+
+glm::vec3 IBLConvolution::sample(const Cubemap& cubemap, glm::vec3 direction, float level)
+{
+    //face selection as described in the GL spec
+    const auto absDir = glm::abs(direction);
+    std::uint32_t face = 0;
+    float sc = 0.f;
+    float tc = 0.f;
+    float ma = 0.f;
+
+    if (absDir.x >= absDir.y && absDir.x >= absDir.z)
+    {
+        face = direction.x > 0 ? 0 : 1;
+        sc = direction.x > 0 ? -direction.z : direction.z;
+        tc = -direction.y;
+        ma = absDir.x;
+    }
+    else if (absDir.y >= absDir.z)
+    {
+        face = direction.y > 0 ? 2 : 3;
+        sc = direction.x;
+        tc = direction.y > 0 ? direction.z : -direction.z;
+        ma = absDir.y;
+    }
+    else
+    {
+        face = direction.z > 0 ? 4 : 5;
+        sc = direction.z > 0 ? direction.x : -direction.x;
+        tc = -direction.y;
+        ma = absDir.z;
+    }
+
+    if (ma == 0)
+    {
+        return glm::vec3(0.f);
+    }
+
+    const float s = ((sc / ma) + 1.f) * 0.5f;
+    const float t = ((tc / ma) + 1.f) * 0.5f;
+
+    level = std::clamp(level, 0.f, static_cast<float>(cubemap.levels.size() - 1));
+    const auto level0 = static_cast<std::uint32_t>(level);
+    const float amount = level - level0;
+
+    auto retVal = sampleLevel(cubemap, face, s, t, level0);
+    if (amount > 0)
+    {
+        retVal = glm::mix(retVal, sampleLevel(cubemap, face, s, t, level0 + 1), amount);
+    }
+    return retVal;
+}
+
+void IBLConvolution::setMultithreaded(bool enabled)
+{
+    multithreaded = enabled;
+}
+
+//private
+glm::vec3 IBLConvolution::sampleLevel(const Cubemap& cubemap, std::uint32_t face, float s, float t, std::uint32_t level)
+{
+    const auto size = static_cast<std::int32_t>(cubemap.getSize(level));
+    const auto* data = cubemap.levels[level].data() + (face * size * size * 3);
+
+    const float x = (s * size) - 0.5f;
+    const float y = (t * size) - 0.5f;
+    const auto x0 = static_cast<std::int32_t>(std::floor(x));
+    const auto y0 = static_cast<std::int32_t>(std::floor(y));
+    const float fx = x - x0;
+    const float fy = y - y0;
+
+    const auto texel = [&](std::int32_t tx, std::int32_t ty)
+    {
+        tx = std::clamp(tx, 0, size - 1);
+        ty = std::clamp(ty, 0, size - 1);
+        const auto* p = data + ((ty * size + tx) * 3);
+        return glm::vec3(p[0], p[1], p[2]);
+    };
+
+    return glm::mix(glm::mix(texel(x0, y0), texel(x0 + 1, y0), fx),
+                    glm::mix(texel(x0, y0 + 1), texel(x0 + 1, y0 + 1), fx), fy);
+}
+
+template <typename Func>
+void IBLConvolution::forEachTexel(Cubemap& cubemap, std::uint32_t level, const Func& func)
+{
+    const auto size = cubemap.getSize(level);
+    auto& output = cubemap.levels[level];
+
+    const auto processRows = [&, size](std::uint32_t start, std::uint32_t end)
+    {
+        //rows are counted across all six faces
+        for (auto row = start; row < end; ++row)
+        {
+            const auto face = row / size;
+            const auto y = row % size;
+            auto* dst = output.data() + (row * size * 3);
+
+            for (auto x = 0u; x < size; ++x)
+            {
+                const auto direction = getDirection(face, (x + 0.5f) / size, (y + 0.5f) / size);
+                const auto colour = func(direction);
+                dst[x * 3] = colour.r;
+                dst[x * 3 + 1] = colour.g;
+                dst[x * 3 + 2] = colour.b;
+            }
+        }
+    };
+
+    //the calling thread runs jobs too while it waits, so
+    //split the rows between it and each of the pool's workers
+    auto& threadPool = ThreadPool::getShared();
+    const auto rowCount = size * 6;
+    const auto threadCount = std::min(rowCount, static_cast<std::uint32_t>(threadPool.getThreadCount()) + 1);
+    if (threadCount == 1
+        || !multithreaded)
+    {
+        processRows(0, rowCount);
+        return;
+    }
+
+    ThreadPool::JobGroup jobGroup;
+    for (auto i = 0u; i < threadCount; ++i)
+    {
+        const auto start = (rowCount * i) / threadCount;
+        const auto end = (rowCount * (i + 1)) / threadCount;
+        threadPool.push([&, start, end]() { processRows(start, end); }, jobGroup);
+    }
+    threadPool.wait(jobGroup);
+}
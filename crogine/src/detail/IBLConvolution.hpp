@@ -0,0 +1,117 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/detail/glm/vec3.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+namespace cro::Detail
+{
+    /*!
+    \brief CPU reference implementation of the image based lighting
+    convolution performed by EnvironmentMap on the GPU.
+    This is used to build IBL cache files offline, without an
+    OpenGL context, and as a reference to test the GPU output against.
+    The results differ only slightly from the GPU versions, as edges
+    are clamped per face rather than filtered seamlessly.
+    */
+    class IBLConvolution final
+    {
+    public:
+        /*!
+        \brief RGB float cube map. Each level contains all 6 faces
+        in GL_TEXTURE_CUBE_MAP_POSITIVE_X order, with texel rows
+        ordered as they would be uploaded with glTexImage2D()
+        */
+        struct Cubemap final
+        {
+            std::uint32_t size = 0;
+            std::vector<std::vector<float>> levels;
+
+            std::uint32_t getSize(std::uint32_t level) const { return std::max(1u, size >> level); }
+        };
+
+        /*!
+        \brief Projects an equirectangular image on to the faces of a cube map
+        \param data Float image data, with the first row at the bottom of the image
+        (as loaded by stbi with vertical flip enabled)
+        \param width Width of the image
+        \param height Height of the image
+        \param channels Number of channels in the image. Must be at least 3
+        \param size Face size of the output cube map
+        */
+        static Cubemap fromEquirectangular(const float* data, std::int32_t width, std::int32_t height, std::int32_t channels, std::uint32_t size);
+
+        /*!
+        \brief Fills the mip chain of the given cube map with a box filter
+        */
+        static void generateMipmaps(Cubemap&);
+
+        /*!
+        \brief Creates the diffuse irradiance map of the given
+        source, which should have a full mip chain.
+        */
+        static Cubemap convolveIrradiance(const Cubemap& source, std::uint32_t size);
+
+        /*!
+        \brief Creates the prefiltered specular map of the given
+        source, which should have a full mip chain. Each of levelCount
+        levels is filtered with roughness level / (levelCount - 1)
+        */
+        static Cubemap prefilter(const Cubemap& source, std::uint32_t size, std::uint32_t levelCount);
+
+        /*!
+        \brief Returns the direction from the centre of the cube
+        through the given coordinates of a face, in the range 0-1
+        */
+        static glm::vec3 getDirection(std::uint32_t face, float s, float t);
+
+        /*!
+        \brief Samples the given level of the cube map with trilinear filtering
+        */
+        static glm::vec3 sample(const Cubemap&, glm::vec3 direction, float level);
+
+        /*!
+        \brief Enables or disables splitting the texels of each level
+        across the shared ThreadPool. The output is identical either
+        way. Enabled by default.
+        */
+        static void setMultithreaded(bool);
+
+    private:
+        static glm::vec3 sampleLevel(const Cubemap&, std::uint32_t face, float s, float t, std::uint32_t level);
+
+        template <typename Func>
+        static void forEachTexel(Cubemap&, std::uint32_t level, const Func&);
+    };
+}
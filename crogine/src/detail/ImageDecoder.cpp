@@ -0,0 +1,163 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "ImageDecoder.hpp"
+
+#include <crogine/core/FileSystem.hpp>
+#include <crogine/core/Log.hpp>
+
+#include <filesystem>
+
+using namespace cro;
+using namespace cro::Detail;
+
+ImageDecoder::ImageDecoder()
+{
+    //make sure the shared pool is created first, so that it
+    //is destroyed after this when the process exits
+    ThreadPool::getShared();
+}
+
+ImageDecoder::~ImageDecoder()
+{
+    //make sure background decodes finish before the entries are destroyed
+    ThreadPool::getShared().wait(m_jobGroup);
+}
+
+//public
+void ImageDecoder::predecode(const std::string& path)
+{
+    std::scoped_lock lock(m_mutex);
+
+    if (m_entries.count(path) != 0)
+    {
+        return;
+    }
+
+    m_entries[path];
+
+    ThreadPool::getShared().push([this, path]()
+        {
+            //an exception would leave the entry pending, and take() waiting
+            //forever, so treat it as a failed decode
+            std::unique_ptr<DecodedImage> image;
+            try
+            {
+                image = decode(path);
+            }
+            catch (const std::exception& e)
+            {
+                LogE << "Failed decoding " << path << ": " << e.what() << std::endl;
+            }
+            catch (...)
+            {
+                LogE << "Failed decoding " << path << ": unknown exception" << std::endl;
+            }
+
+            {
+                std::scoped_lock l(m_mutex);
+                auto& entry = m_entries[path];
+                entry.image = std::move(image);
+                entry.pending = false;
+            }
+            m_decodeComplete.notify_all();
+        }, m_jobGroup);
+}
+
+bool ImageDecoder::isReady(const std::string& path) const
+{
+    std::scoped_lock lock(m_mutex);
+
+    auto result = m_entries.find(path);
+    return result != m_entries.end() && !result->second.pending;
+}
+
+bool ImageDecoder::take(const std::string& path, std::unique_ptr<DecodedImage>& dst)
+{
+    std::unique_lock lock(m_mutex);
+
+    if (m_entries.count(path) == 0)
+    {
+        return false;
+    }
+
+    m_decodeComplete.wait(lock, [&]()
+        {
+            return !m_entries.at(path).pending;
+        });
+
+    auto result = m_entries.find(path);
+    dst = std::move(result->second.image);
+    m_entries.erase(result);
+
+    return true;
+}
+
+std::unique_ptr<DecodedImage> ImageDecoder::decode(const std::string& path)
+{
+    auto image = std::make_unique<DecodedImage>();
+
+    if (CompressedImage::isCompressedFile(path))
+    {
+        if (!image->compressed.loadFromFile(path, true))
+        {
+            return nullptr;
+        }
+        image->isCompressed = true;
+    }
+    else if (!image->pixels.loadFromFile(path, true))
+    {
+        return nullptr;
+    }
+
+    return image;
+}
+
+std::string ImageDecoder::resolvePath(const std::string& filePath)
+{
+    std::filesystem::path p(filePath);
+    auto path = FileSystem::getResourcePath();
+    //only add resource path if not done so already
+    if (!p.is_absolute() &&
+        filePath.find(path) == std::string::npos)
+    {
+        path += filePath;
+    }
+    else
+    {
+        path = filePath;
+    }
+    return path;
+}
+
+ImageDecoder& ImageDecoder::getInstance()
+{
+    static ImageDecoder instance;
+    return instance;
+}
@@ -0,0 +1,128 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/core/ThreadPool.hpp>
+#include <crogine/graphics/ImageArray.hpp>
+#include <crogine/graphics/CompressedImage.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace cro
+{
+    namespace Detail
+    {
+        /*!
+        \brief Image data which has been read from disk and decoded,
+        ready to be uploaded to a Texture. The rows are ordered bottom
+        to top as Texture expects.
+        */
+        struct DecodedImage final
+        {
+            ImageArray<std::uint8_t> pixels;
+            CompressedImage compressed; //!< used instead of pixels for *.ktx2 and *.dds files
+            bool isCompressed = false;
+        };
+
+        /*!
+        \brief Process wide queue of images being decoded in the background.
+        Image decoding is CPU bound, so predecode() allows a set of images
+        to be decoded in parallel on the shared ThreadPool, leaving only the upload
+        to be done on the thread with the OpenGL context. Each decoded image
+        is held until it is claimed by take(), at which point it is removed
+        from the queue - so every call to predecode() should be matched by
+        a call to take() with the same path.
+        */
+        class ImageDecoder final
+        {
+        public:
+            ImageDecoder();
+            ~ImageDecoder();
+
+            ImageDecoder(const ImageDecoder&) = delete;
+            ImageDecoder(ImageDecoder&&) = delete;
+            ImageDecoder& operator = (const ImageDecoder&) = delete;
+            ImageDecoder& operator = (ImageDecoder&&) = delete;
+
+            /*!
+            \brief Starts decoding the image at the given path on a worker thread.
+            Does nothing if the image is already queued.
+            \param path Path to the image, as returned by resolvePath()
+            */
+            void predecode(const std::string& path);
+
+            /*!
+            \brief Returns true if the image at the given path has been queued
+            and has finished decoding, so that calling take() won't block.
+            */
+            bool isReady(const std::string& path) const;
+
+            /*!
+            \brief Claims a decoded image, waiting for it if it is still being decoded.
+            \param path Path to the image passed to predecode()
+            \param dst Set to the decoded image, or nullptr if it failed to decode,
+            including if decoding threw an exception
+            \returns false if the image was never queued
+            */
+            bool take(const std::string& path, std::unique_ptr<DecodedImage>& dst);
+
+            /*!
+            \brief Decodes the image at the given path on the calling thread.
+            \returns nullptr if the image failed to decode
+            */
+            static std::unique_ptr<DecodedImage> decode(const std::string& path);
+
+            /*!
+            \brief Prepends the resource path to the given path if necessary
+            */
+            static std::string resolvePath(const std::string& path);
+
+            static ImageDecoder& getInstance();
+
+        private:
+            struct Entry final
+            {
+                std::unique_ptr<DecodedImage> image;
+                bool pending = true;
+            };
+
+            mutable std::mutex m_mutex;
+            std::condition_variable m_decodeComplete;
+            std::unordered_map<std::string, Entry> m_entries;
+
+            ThreadPool::JobGroup m_jobGroup;
+        };
+    }
+}
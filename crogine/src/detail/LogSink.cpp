@@ -0,0 +1,442 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "LogSink.hpp"
+
+#include <crogine/core/Console.hpp>
+#include <crogine/core/SysTime.hpp>
+
+#include <SDL_log.h>
+
+#ifdef __ANDROID__
+#include <android/log.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    //set once the sink has been destroyed during static
+    //destruction, after which messages are written directly
+    std::atomic<bool> sinkDestroyed{ false };
+
+    constexpr std::size_t SlotMask = LogSink::SlotCount - 1;
+    static_assert((LogSink::SlotCount & SlotMask) == 0, "SlotCount must be a power of 2");
+    static_assert(LogSink::MaxSlotsPerMessage <= LogSink::SlotCount);
+
+    constexpr std::size_t MaxConsoleLines = 50;
+    constexpr std::size_t FileBatchSize = 16 * 1024;
+    constexpr auto SleepTime = std::chrono::milliseconds(10);
+
+    const std::string& getPrefix(Logger::Type type)
+    {
+        static const std::string Info("INFO: ");
+        static const std::string Warning("WARNING: ");
+        static const std::string Error("ERROR: ");
+
+        switch (type)
+        {
+        default:
+        case Logger::Type::Info:
+            return Info;
+        case Logger::Type::Warning:
+            return Warning;
+        case Logger::Type::Error:
+            return Error;
+        }
+    }
+}
+
+LogSink::LogSink()
+    : m_slots           (std::make_unique<Slot[]>(SlotCount)),
+    m_writeIndex        (0),
+    m_readIndex         (0),
+    m_running           (true),
+    m_sleeping          (false),
+    m_timeStampTime     (0),
+    m_file              (nullptr),
+    m_filePathChanged   (false)
+{
+    for (auto i = 0u; i < SlotCount; ++i)
+    {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_message.reserve(SlotTextSize * MaxSlotsPerMessage);
+    m_fileBatch.reserve(FileBatchSize);
+    m_consoleLines.reserve(MaxConsoleLines);
+
+    m_thread = std::thread(&LogSink::threadFunc, this);
+}
+
+LogSink::~LogSink()
+{
+    sinkDestroyed = true;
+
+    m_running = false;
+    m_condition.notify_one();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    std::scoped_lock lock(m_drainMutex);
+    drain();
+
+    if (m_file)
+    {
+        SDL_RWclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+//public
+LogSink* LogSink::get()
+{
+    if (sinkDestroyed)
+    {
+        return nullptr;
+    }
+
+    static LogSink sink;
+    return &sink;
+}
+
+void LogSink::push(Logger::Type type, Logger::Output output, bool formatted, std::string_view message)
+{
+    const auto timestamp = m_timer.elapsed();
+    const auto length = std::min(message.size(), SlotTextSize * MaxSlotsPerMessage);
+    const auto count = std::max(std::size_t(1), (length + SlotTextSize - 1) / SlotTextSize);
+
+    //claim count consecutive slots
+    auto pos = m_writeIndex.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        const auto seq = m_slots[pos & SlotMask].sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+        if (diff == 0)
+        {
+            if (m_writeIndex.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else
+        {
+            if (diff < 0)
+            {
+                //buffer is full - wait for the sink to catch up
+                m_condition.notify_one();
+                std::this_thread::yield();
+            }
+            pos = m_writeIndex.load(std::memory_order_relaxed);
+        }
+    }
+
+    //continuation slots are published first so that once the
+    //first slot is visible the entire message is ready to read.
+    //Only the first slot is guaranteed to be free when claimed,
+    //the rest may still be waiting for the sink to release them
+    for (auto i = count - 1; i > 0; --i)
+    {
+        auto& slot = m_slots[(pos + i) & SlotMask];
+        while (slot.sequence.load(std::memory_order_acquire) != pos + i)
+        {
+            m_condition.notify_one();
+            std::this_thread::yield();
+        }
+
+        const auto offset = i * SlotTextSize;
+        std::memcpy(slot.text.data(), message.data() + offset, std::min(SlotTextSize, length - offset));
+        slot.sequence.store(pos + i + 1, std::memory_order_release);
+    }
+
+    auto& slot = m_slots[pos & SlotMask];
+    slot.timestamp = timestamp;
+    slot.length = static_cast<std::uint32_t>(length);
+    slot.slotCount = static_cast<std::uint32_t>(count);
+    slot.type = type;
+    slot.output = output;
+    slot.formatted = formatted;
+    std::memcpy(slot.text.data(), message.data(), std::min(SlotTextSize, length));
+    slot.sequence.store(pos + 1, std::memory_order_release);
+
+    //pairs with the fence in threadFunc() so that either the sink
+    //sees the new message or we see that it's waiting to be woken
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed))
+    {
+        m_condition.notify_one();
+    }
+}
+
+void LogSink::flush()
+{
+    //the sink thread can't wait on itself, and if we crashed
+    //while already flushing this thread holds the lock
+    static thread_local bool flushing = false;
+    if (flushing
+        || std::this_thread::get_id() == m_thread.get_id())
+    {
+        return;
+    }
+
+    flushing = true;
+    {
+        std::scoped_lock lock(m_drainMutex);
+        drain();
+    }
+    flushing = false;
+}
+
+void LogSink::setFilePath(const std::string& path)
+{
+    std::scoped_lock lock(m_pathMutex);
+    m_nextFilePath = path;
+    m_filePathChanged = true;
+}
+
+void LogSink::updateConsole()
+{
+    {
+        std::scoped_lock lock(m_consoleMutex);
+        m_consoleOutput.swap(m_consoleLines);
+    }
+
+    for (const auto& line : m_consoleOutput)
+    {
+        Console::print(line);
+    }
+    m_consoleOutput.clear();
+}
+
+//private
+void LogSink::threadFunc()
+{
+    while (m_running)
+    {
+        bool drained = false;
+        {
+            std::scoped_lock lock(m_drainMutex);
+            drained = drain();
+        }
+
+        if (!drained)
+        {
+            std::unique_lock lock(m_waitMutex);
+            m_sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            //check once more in case a message arrived before
+            //the producer could see that we're going to sleep
+            const auto readIndex = m_readIndex.load(std::memory_order_relaxed);
+            if (m_running
+                && m_slots[readIndex & SlotMask].sequence.load(std::memory_order_acquire) != readIndex + 1)
+            {
+                m_condition.wait_for(lock, SleepTime);
+            }
+            m_sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool LogSink::drain()
+{
+    bool drained = false;
+    auto readIndex = m_readIndex.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        const auto& slot = m_slots[readIndex & SlotMask];
+        if (slot.sequence.load(std::memory_order_acquire) != readIndex + 1)
+        {
+            break;
+        }
+
+        write(slot, readIndex);
+
+        const auto count = slot.slotCount;
+        for (auto i = 0u; i < count; ++i)
+        {
+            m_slots[(readIndex + i) & SlotMask].sequence.store(readIndex + i + SlotCount, std::memory_order_release);
+        }
+        readIndex += count;
+        m_readIndex.store(readIndex, std::memory_order_relaxed);
+        drained = true;
+    }
+
+    if (drained)
+    {
+        writeFile();
+    }
+    return drained;
+}
+
+void LogSink::write(const Slot& slot, std::size_t index)
+{
+    m_message.assign(slot.text.data(), std::min(SlotTextSize, std::size_t(slot.length)));
+    for (auto i = 1u; i < slot.slotCount; ++i)
+    {
+        const auto offset = i * SlotTextSize;
+        const auto& next = m_slots[(index + i) & SlotMask];
+        m_message.append(next.text.data(), std::min(SlotTextSize, slot.length - offset));
+    }
+
+    if (slot.formatted)
+    {
+        //LogStream output is already prefixed and only goes to the console
+        if (m_message.empty() || m_message.back() != '\n')
+        {
+            m_message += '\n';
+        }
+        std::fwrite(m_message.data(), 1, m_message.size(), stdout);
+#ifdef __ANDROID__
+        __android_log_print(ANDROID_LOG_VERBOSE, "CroApp", "%s", m_message.c_str());
+#endif
+        printConsole(m_message);
+#ifdef _MSC_VER
+        m_message += "\n";
+        OutputDebugStringA(m_message.c_str());
+#endif
+        return;
+    }
+
+#ifdef __ANDROID__
+    //use logcat - technically SDL will log successfully on android too
+    //so this is unnecessary.
+    __android_log_print(ANDROID_LOG_VERBOSE, "CroApp", "%s", m_message.c_str());
+#else
+    const auto& prefix = getPrefix(slot.type);
+
+    if (slot.output == Logger::Output::Console || slot.output == Logger::Output::All)
+    {
+        switch (slot.type)
+        {
+        default:
+        case Logger::Type::Info:
+            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s", m_message.c_str());
+            break;
+        case Logger::Type::Warning:
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%s", m_message.c_str());
+            break;
+        case Logger::Type::Error:
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", m_message.c_str());
+            break;
+        }
+
+        printConsole(prefix + m_message);
+
+#ifdef _MSC_VER
+        auto outstring = prefix + m_message + "\n";
+        OutputDebugStringA(outstring.c_str());
+#endif //_MSC_VER
+    }
+
+    if (slot.output == Logger::Output::File || slot.output == Logger::Output::All)
+    {
+        //wall clock time for the date, the timer for
+        //ordering messages which arrive in the same second
+        std::array<char, 32> elapsed = {};
+        std::snprintf(elapsed.data(), elapsed.size(), " (%.6f): ", slot.timestamp);
+
+        const auto now = std::time(nullptr);
+        if (now != m_timeStampTime)
+        {
+            m_timeStamp = SysTime::timeString() + " - " + SysTime::dateString();
+            m_timeStampTime = now;
+        }
+
+        m_fileBatch += m_timeStamp;
+        m_fileBatch += elapsed.data();
+        m_fileBatch += prefix;
+        m_fileBatch += m_message;
+        m_fileBatch += '\n';
+    }
+#endif //__ANDROID__
+}
+
+void LogSink::writeFile()
+{
+    if (m_fileBatch.empty())
+    {
+        return;
+    }
+
+    if (m_filePathChanged.exchange(false))
+    {
+        std::scoped_lock lock(m_pathMutex);
+        if (m_nextFilePath != m_filePath
+            && m_file)
+        {
+            SDL_RWclose(m_file);
+            m_file = nullptr;
+        }
+        m_filePath = m_nextFilePath;
+    }
+
+    if (!m_file)
+    {
+        m_file = SDL_RWFromFile(m_filePath.empty() ? "output.log" : m_filePath.c_str(), "a");
+    }
+
+    if (m_file)
+    {
+        SDL_RWwrite(m_file, m_fileBatch.data(), 1, m_fileBatch.size());
+#ifdef HAVE_STDIO_H
+        //SDL has no flush, and buffered output is lost if we crash
+        if (m_file->type == SDL_RWOPS_STDFILE)
+        {
+            std::fflush(m_file->hidden.stdio.fp);
+        }
+#endif
+    }
+    else
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%s", "Messages were intended for log file. Opening file probably failed.");
+        printConsole("WARNING: Messages were intended for log file. Opening file probably failed.");
+    }
+    m_fileBatch.clear();
+}
+
+void LogSink::printConsole(const std::string& line)
+{
+    std::scoped_lock lock(m_consoleMutex);
+    if (m_consoleLines.size() == MaxConsoleLines)
+    {
+        m_consoleLines.erase(m_consoleLines.begin());
+    }
+    m_consoleLines.push_back(line);
+}
@@ -0,0 +1,156 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/core/Log.hpp>
+#include <crogine/core/HiResTimer.hpp>
+
+#include <SDL_rwops.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace cro
+{
+    namespace Detail
+    {
+        /*!
+        \brief Receives messages from the Logger and writes them out on a
+        background thread.
+        Messages are copied into a preallocated ring buffer which any thread
+        can write to without locking. Messages which are longer than a single
+        slot are stored in consecutive slots. The sink thread drains the buffer
+        in batches, keeping the log file open between batches.
+        Lines destined for the Console are queued until the main thread
+        collects them with updateConsole(), as the Console is not thread safe.
+        */
+        class LogSink final
+        {
+        public:
+            LogSink();
+            ~LogSink();
+
+            LogSink(const LogSink&) = delete;
+            LogSink(LogSink&&) = delete;
+            LogSink& operator = (const LogSink&) = delete;
+            LogSink& operator = (LogSink&&) = delete;
+
+            /*!
+            \brief Returns the active sink, or nullptr if it has
+            already been destroyed during static destruction
+            */
+            static LogSink* get();
+
+            /*!
+            \brief Queues a message.
+            \param formatted True if the message already contains its
+            type prefix and line ending, as it does from the LogStream
+            */
+            void push(Logger::Type type, Logger::Output output, bool formatted, std::string_view message);
+
+            /*!
+            \brief Writes out everything currently in the queue and
+            flushes the log file. Safe to call from any thread. Does
+            nothing if called from the sink thread, or recursively from
+            a crash while flushing, rather than dead-locking.
+            */
+            void flush();
+
+            void setFilePath(const std::string&);
+
+            /*!
+            \brief Prints any queued lines to the Console.
+            Must only be called from the main thread.
+            */
+            void updateConsole();
+
+            static constexpr std::size_t SlotCount = 1024; //must be a power of 2
+            static constexpr std::size_t SlotTextSize = 208;
+            static constexpr std::size_t MaxSlotsPerMessage = 32; //longer messages are truncated
+
+        private:
+            struct alignas(64) Slot final
+            {
+                std::atomic<std::size_t> sequence{ 0 };
+                double timestamp = 0.0;
+                std::uint32_t length = 0; //size of the entire message, in the first slot
+                std::uint32_t slotCount = 1;
+                Logger::Type type = Logger::Type::Info;
+                Logger::Output output = Logger::Output::Console;
+                bool formatted = false;
+                std::array<char, SlotTextSize> text = {};
+            };
+            std::unique_ptr<Slot[]> m_slots;
+
+            alignas(64) std::atomic<std::size_t> m_writeIndex;
+            alignas(64) std::atomic<std::size_t> m_readIndex; //only written while holding m_drainMutex
+
+            HiResTimer m_timer;
+
+            std::mutex m_drainMutex;
+            std::mutex m_waitMutex;
+            std::condition_variable m_condition;
+            std::atomic<bool> m_running;
+            std::atomic<bool> m_sleeping;
+            std::thread m_thread;
+
+            //only accessed while holding m_drainMutex
+            std::string m_message;
+            std::string m_fileBatch;
+            std::string m_timeStamp; //wall clock time is only reformatted once a second
+            std::time_t m_timeStampTime;
+            std::string m_filePath;
+            SDL_RWops* m_file;
+
+            std::mutex m_pathMutex;
+            std::string m_nextFilePath;
+            std::atomic<bool> m_filePathChanged;
+
+            std::mutex m_consoleMutex;
+            std::vector<std::string> m_consoleLines;
+            std::vector<std::string> m_consoleOutput; //main thread only
+
+            void threadFunc();
+            bool drain();
+            void write(const Slot&, std::size_t);
+            void writeFile();
+            void printConsole(const std::string& line);
+        };
+    }
+}
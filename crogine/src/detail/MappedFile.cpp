@@ -0,0 +1,147 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace cro::Detail;
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+//public
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        m_file = nullptr;
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size)
+        || size.QuadPart == 0)
+    {
+        close();
+        return false;
+    }
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping)
+    {
+        close();
+        return false;
+    }
+
+    m_data = static_cast<const std::uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_data)
+    {
+        close();
+        return false;
+    }
+    m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0
+        || info.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    //the mapping remains valid after the descriptor is closed
+    auto* data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+    m_data = static_cast<const std::uint8_t*>(data);
+    m_size = static_cast<std::size_t>(info.st_size);
+#endif
+
+    return true;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+    if (m_data)
+    {
+        UnmapViewOfFile(m_data);
+    }
+
+    if (m_mapping)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+
+    if (m_file)
+    {
+        CloseHandle(m_file);
+        m_file = nullptr;
+    }
+#else
+    if (m_data)
+    {
+        munmap(const_cast<std::uint8_t*>(m_data), m_size);
+    }
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
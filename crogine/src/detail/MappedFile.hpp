@@ -0,0 +1,74 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace cro::Detail
+{
+    /*!
+    \brief Read-only view of a file mapped in to memory.
+    The mapping is released when the MappedFile is destroyed
+    or when another file is opened.
+    */
+    class MappedFile final
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile(MappedFile&&) = delete;
+        MappedFile& operator = (const MappedFile&) = delete;
+        MappedFile& operator = (MappedFile&&) = delete;
+
+        /*!
+        \brief Maps the file at the given absolute path
+        \returns false if the file couldn't be opened or mapped
+        */
+        bool open(const std::string& path);
+
+        void close();
+
+        const std::uint8_t* getData() const { return m_data; }
+        std::size_t getSize() const { return m_size; }
+
+    private:
+        const std::uint8_t* m_data = nullptr;
+        std::size_t m_size = 0;
+
+#ifdef _WIN32
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+#endif
+    };
+}
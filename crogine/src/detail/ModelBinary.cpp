@@ -28,6 +28,7 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include "GLCheck.hpp"
+#include "CompactVertex.hpp"
 
 #include <crogine/detail/ModelBinary.hpp>
 #include <crogine/graphics/MeshBuilder.hpp>
@@ -36,11 +37,15 @@ source distribution.
 
 using namespace cro;
 
-bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path, bool includeSkeleton)
+bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path, bool includeSkeleton, bool compact)
 {
     bool retVal = false;
 
     Detail::ModelBinary::HeaderV2 header;
+    if (compact)
+    {
+        header.version = 3;
+    }
     std::uint32_t skelOffset = sizeof(header);
 
     //if these are not empty after processing
@@ -50,6 +55,10 @@ bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path
     std::vector<float> outVertexData;
     std::vector<std::uint32_t> outIndexData;
 
+    //used instead of the above for version 3 files
+    std::vector<std::uint8_t> outCompactVertexData;
+    std::vector<std::uint16_t> outCompactIndexData;
+
     if (entity.hasComponent<Model>())
     {
         header.meshOffset = sizeof(header);
@@ -57,51 +66,10 @@ bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path
         const auto& meshData = entity.getComponent<Model>().getMeshData();
 
         //download the mesh data from vbo/ibo
+        //this unpacks the vertex data if it was loaded from a compact binary
         std::vector<float> vertexData;
         std::vector<std::vector<std::uint32_t>> indexData;
-
-        vertexData.resize(meshData.vertexCount * (meshData.vertexSize / sizeof(float)));
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
-        glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, meshData.vertexCount * meshData.vertexSize, vertexData.data()));
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
-
-        indexData.resize(meshData.submeshCount);
-
-        for (auto i = 0u; i < meshData.submeshCount; ++i)
-        {
-            indexData[i].resize(meshData.indexData[i].indexCount);
-            glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.indexData[i].ibo));
-
-            //fudgy kludge for different index types
-            switch (meshData.indexData[i].format)
-            {
-            default: break;
-            case GL_UNSIGNED_BYTE:
-            {
-                std::vector<std::uint8_t> temp(meshData.indexData[i].indexCount);
-                glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, meshData.indexData[i].indexCount, temp.data()));
-                for (auto j = 0u; j < meshData.indexData[i].indexCount; ++j)
-                {
-                    indexData[i][j] = temp[j];
-                }
-            }
-            break;
-            case GL_UNSIGNED_SHORT:
-            {
-                std::vector<std::uint16_t> temp(meshData.indexData[i].indexCount);
-                glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, meshData.indexData[i].indexCount * sizeof(std::uint16_t), temp.data()));
-                for (auto j = 0u; j < meshData.indexData[i].indexCount; ++j)
-                {
-                    indexData[i][j] = temp[j];
-                }
-            }
-            break;
-            case GL_UNSIGNED_INT:
-                glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, meshData.indexData[i].indexCount * sizeof(std::uint32_t), indexData[i].data()));
-                break;
-            }
-        }
-        glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+        Mesh::readVertexData(meshData, vertexData, indexData);
 
         //parse the vertex data and correct the colour for missing
         //alpha channel, and setup the tangent value to compensate
@@ -243,16 +211,37 @@ bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path
         }
 
 
+        std::size_t vertexBytes = outVertexData.size() * sizeof(float);
+        std::size_t indexBytes = outIndexData.size() * sizeof(std::uint32_t);
+        if (compact)
+        {
+            //this returns 0 if the data couldn't be encoded, in which case it's written as floats
+            header.vertexEncoding = CompactVertex::encode(outVertexData, meshHeader.flags, outCompactVertexData);
+            if (header.vertexEncoding != 0)
+            {
+                vertexBytes = outCompactVertexData.size();
+            }
+
+            const auto maxIndex = std::max_element(outIndexData.begin(), outIndexData.end());
+            if (maxIndex == outIndexData.end()
+                || *maxIndex <= std::numeric_limits<std::uint16_t>::max())
+            {
+                header.vertexEncoding |= CompactIndices;
+                outCompactIndexData.assign(outIndexData.begin(), outIndexData.end());
+                indexBytes = outCompactIndexData.size() * sizeof(std::uint16_t);
+            }
+        }
+
         //update the header with relevant detail
         meshHeader.indexArrayCount = static_cast<std::uint16_t>(indexData.size());
         meshHeader.indexArrayOffset = header.meshOffset
             + static_cast<std::uint32_t>(sizeof(meshHeader)
             + (outIndexSizes.size() * sizeof(std::uint32_t))
-            + (outVertexData.size() * sizeof(float)));
+            + vertexBytes);
 
         //update the skeleton offset with the size of the mesh data
         skelOffset = meshHeader.indexArrayOffset
-            + static_cast<std::uint32_t>(outIndexData.size() * sizeof(std::uint32_t));
+            + static_cast<std::uint32_t>(indexBytes);
 
         retVal = true;
     }
@@ -327,8 +316,24 @@ bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path
                 //write mesh data
                 SDL_RWwrite(file, &meshHeader, sizeof(meshHeader), 1);
                 SDL_RWwrite(file, outIndexSizes.data(), sizeof(std::uint32_t), outIndexSizes.size());
-                SDL_RWwrite(file, outVertexData.data(), sizeof(float), outVertexData.size());
-                SDL_RWwrite(file, outIndexData.data(), sizeof(std::uint32_t), outIndexData.size());
+
+                if ((header.vertexEncoding & ~CompactIndices) == 0)
+                {
+                    SDL_RWwrite(file, outVertexData.data(), sizeof(float), outVertexData.size());
+                }
+                else
+                {
+                    SDL_RWwrite(file, outCompactVertexData.data(), 1, outCompactVertexData.size());
+                }
+
+                if (header.vertexEncoding & CompactIndices)
+                {
+                    SDL_RWwrite(file, outCompactIndexData.data(), sizeof(std::uint16_t), outCompactIndexData.size());
+                }
+                else
+                {
+                    SDL_RWwrite(file, outIndexData.data(), sizeof(std::uint32_t), outIndexData.size());
+                }
             }
 
             if (header.skeletonOffset)
@@ -436,17 +441,33 @@ cro::Mesh::Data cro::Detail::ModelBinary::read(const std::string& binPath, std::
                 }
             }
 
+            const auto encoding = header.version > 2 ? header.vertexEncoding : 0;
+
             auto pos = SDL_RWtell(file.file);
             auto vertSize = meshHeader.indexArrayOffset - pos;
 
-            std::vector<float> tempVerts(vertSize / sizeof(float));
-            SDL_RWread(file.file, tempVerts.data(), vertSize, 1);
+            std::vector<float> tempVerts;
+            if (!CompactVertex::read(file.file, vertSize, meshHeader.flags, encoding, tempVerts))
+            {
+                LogE << binPath << ": failed reading vertex data" << std::endl;
+                return {};
+            }
             CRO_ASSERT(tempVerts.size() % vertStride == 0, "");
 
+            std::vector<std::uint16_t> compactIndices;
             for (auto i = 0u; i < meshHeader.indexArrayCount; ++i)
             {
                 dstIdx[i].resize(sizes[i]);
-                SDL_RWread(file.file, dstIdx[i].data(), sizes[i] * sizeof(std::uint32_t), 1);
+                if (encoding & CompactIndices)
+                {
+                    compactIndices.resize(sizes[i]);
+                    SDL_RWread(file.file, compactIndices.data(), sizes[i] * sizeof(std::uint16_t), 1);
+                    std::copy(compactIndices.begin(), compactIndices.end(), dstIdx[i].begin());
+                }
+                else
+                {
+                    SDL_RWread(file.file, dstIdx[i].data(), sizes[i] * sizeof(std::uint32_t), 1);
+                }
             }
 
             dstVert.swap(tempVerts);
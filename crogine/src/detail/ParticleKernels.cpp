@@ -0,0 +1,210 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "ParticleKernels.hpp"
+
+#include <crogine/util/Constants.hpp>
+#include <crogine/detail/Assert.hpp>
+#include <crogine/detail/glm/geometric.hpp>
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CRO_PARTICLE_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CRO_PARTICLE_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace cro;
+
+namespace
+{
+    //thin wrapper so the kernel can be written once
+    //for SSE, NEON and plain scalar fallback
+#if defined(CRO_PARTICLE_SSE)
+    using Float4 = __m128;
+    inline Float4 load(const float* p) { return _mm_loadu_ps(p); }
+    inline void store(float* p, Float4 v) { _mm_storeu_ps(p, v); }
+    inline Float4 splat(float f) { return _mm_set1_ps(f); }
+    inline Float4 add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+    inline Float4 sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+    inline Float4 mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+    inline Float4 min(Float4 a, Float4 b) { return _mm_min_ps(a, b); }
+    inline Float4 max(Float4 a, Float4 b) { return _mm_max_ps(a, b); }
+#elif defined(CRO_PARTICLE_NEON)
+    using Float4 = float32x4_t;
+    inline Float4 load(const float* p) { return vld1q_f32(p); }
+    inline void store(float* p, Float4 v) { vst1q_f32(p, v); }
+    inline Float4 splat(float f) { return vdupq_n_f32(f); }
+    inline Float4 add(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+    inline Float4 sub(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+    inline Float4 mul(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+    inline Float4 min(Float4 a, Float4 b) { return vminq_f32(a, b); }
+    inline Float4 max(Float4 a, Float4 b) { return vmaxq_f32(a, b); }
+#else
+    struct Float4 final
+    {
+        float v[4] = {};
+    };
+    inline Float4 load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+    inline void store(float* p, Float4 a) { for (auto i = 0; i < 4; ++i) p[i] = a.v[i]; }
+    inline Float4 splat(float f) { return { { f, f, f, f } }; }
+    inline Float4 add(Float4 a, Float4 b) { for (auto i = 0; i < 4; ++i) a.v[i] += b.v[i]; return a; }
+    inline Float4 sub(Float4 a, Float4 b) { for (auto i = 0; i < 4; ++i) a.v[i] -= b.v[i]; return a; }
+    inline Float4 mul(Float4 a, Float4 b) { for (auto i = 0; i < 4; ++i) a.v[i] *= b.v[i]; return a; }
+    inline Float4 min(Float4 a, Float4 b) { for (auto i = 0; i < 4; ++i) a.v[i] = std::min(a.v[i], b.v[i]); return a; }
+    inline Float4 max(Float4 a, Float4 b) { for (auto i = 0; i < 4; ++i) a.v[i] = std::max(a.v[i], b.v[i]); return a; }
+#endif
+
+    //v = v * acceleration + (gravity + force) * dt
+    //p += v * dt
+    inline void integrate(float* position, float* velocity, const float* gravity,
+        Float4 acceleration, Float4 force, Float4 dt)
+    {
+        auto v = mul(load(velocity), acceleration);
+        v = add(v, mul(add(load(gravity), force), dt));
+        store(velocity, v);
+        store(position, add(load(position), mul(v, dt)));
+    }
+}
+
+void Detail::updateParticles(ParticleStore& particles, std::size_t count, const ParticleUpdateParams& params)
+{
+    CRO_ASSERT(count <= particles.capacity(), "");
+
+    float* posX = particles.get(ParticleStore::PositionX);
+    float* posY = particles.get(ParticleStore::PositionY);
+    float* posZ = particles.get(ParticleStore::PositionZ);
+    float* velX = particles.get(ParticleStore::VelocityX);
+    float* velY = particles.get(ParticleStore::VelocityY);
+    float* velZ = particles.get(ParticleStore::VelocityZ);
+    const float* gravX = particles.get(ParticleStore::GravityX);
+    const float* gravY = particles.get(ParticleStore::GravityY);
+    const float* gravZ = particles.get(ParticleStore::GravityZ);
+    const float* acceleration = particles.get(ParticleStore::Acceleration);
+
+    float* lifetime = particles.get(ParticleStore::Lifetime);
+    const float* invMaxLifetime = particles.get(ParticleStore::InverseMaxLifetime);
+    float* alpha = particles.get(ParticleStore::Alpha);
+    float* rotation = particles.get(ParticleStore::Rotation);
+    float* scale = particles.get(ParticleStore::Scale);
+
+    const auto dt = splat(params.dt);
+    const auto forceX = splat(params.force.x);
+    const auto forceY = splat(params.force.y);
+    const auto forceZ = splat(params.force.z);
+    const auto rotationDelta = splat(params.rotation);
+    const auto scaleDelta = splat(params.scale);
+    const auto zero = splat(0.f);
+    const auto one = splat(1.f);
+
+    //capacity is padded to a multiple of 4 so it's safe to round up
+    const auto paddedCount = (count + 3) & ~std::size_t(3);
+    for (auto i = 0u; i < paddedCount; i += 4)
+    {
+        const auto acc = load(acceleration + i);
+        integrate(posX + i, velX + i, gravX + i, acc, forceX, dt);
+        integrate(posY + i, velY + i, gravY + i, acc, forceY, dt);
+        integrate(posZ + i, velZ + i, gravZ + i, acc, forceZ, dt);
+
+        //lifetime and colour fade
+        const auto life = sub(load(lifetime + i), dt);
+        store(lifetime + i, life);
+        store(alpha + i, min(one, max(zero, mul(life, load(invMaxLifetime + i)))));
+
+        store(rotation + i, add(load(rotation + i), rotationDelta));
+        store(scale + i, mul(load(scale + i), scaleDelta));
+    }
+}
+
+Sphere Detail::calcParticleBounds(const ParticleStore& particles, std::size_t count)
+{
+    const float* posX = particles.get(ParticleStore::PositionX);
+    const float* posY = particles.get(ParticleStore::PositionY);
+    const float* posZ = particles.get(ParticleStore::PositionZ);
+
+    glm::vec3 minBounds(std::numeric_limits<float>::max());
+    glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        minBounds.x = std::min(minBounds.x, posX[i]);
+        minBounds.y = std::min(minBounds.y, posY[i]);
+        minBounds.z = std::min(minBounds.z, posZ[i]);
+
+        maxBounds.x = std::max(maxBounds.x, posX[i]);
+        maxBounds.y = std::max(maxBounds.y, posY[i]);
+        maxBounds.z = std::max(maxBounds.z, posZ[i]);
+    }
+
+    Sphere bounds;
+    if (count)
+    {
+        auto dist = (maxBounds - minBounds) / 2.f;
+        bounds.centre = dist + minBounds;
+        bounds.radius = glm::length(dist);
+    }
+    return bounds;
+}
+
+void Detail::writeParticleVertices(const ParticleStore& particles, std::size_t count, float* dst)
+{
+    const float* posX = particles.get(ParticleStore::PositionX);
+    const float* posY = particles.get(ParticleStore::PositionY);
+    const float* posZ = particles.get(ParticleStore::PositionZ);
+    const float* red = particles.get(ParticleStore::Red);
+    const float* green = particles.get(ParticleStore::Green);
+    const float* blue = particles.get(ParticleStore::Blue);
+    const float* alpha = particles.get(ParticleStore::Alpha);
+    const float* rotation = particles.get(ParticleStore::Rotation);
+    const float* scale = particles.get(ParticleStore::Scale);
+    const auto* frameIDs = particles.getFrameIDs();
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        //position
+        *dst++ = posX[i];
+        *dst++ = posY[i];
+        *dst++ = posZ[i];
+
+        //colour
+        *dst++ = red[i];
+        *dst++ = green[i];
+        *dst++ = blue[i];
+        *dst++ = alpha[i];
+
+        //rotation/size/animation
+        *dst++ = rotation[i] * Util::Const::degToRad;
+        *dst++ = scale[i];
+        *dst++ = static_cast<float>(frameIDs[i]);
+    }
+}
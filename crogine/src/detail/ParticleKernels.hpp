@@ -0,0 +1,79 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/ecs/components/ParticleEmitter.hpp>
+#include <crogine/graphics/Spatial.hpp>
+
+#include <crogine/detail/glm/vec3.hpp>
+
+#include <cstddef>
+
+namespace cro
+{
+    namespace Detail
+    {
+        /*!
+        \brief Per-emitter values used when updating particles.
+        These are calculated once per frame rather than once per particle.
+        */
+        struct ParticleUpdateParams final
+        {
+            glm::vec3 force = glm::vec3(0.f); //!< sum of all emitter forces
+            float dt = 0.f;
+            float rotation = 0.f; //!< amount to add to rotation this frame
+            float scale = 1.f; //!< amount to multiply scale by this frame
+        };
+
+        //number of floats written per particle: position, colour, rotation/scale/frame
+        constexpr std::size_t ParticleVertexSize = 3 + 4 + 3;
+
+        /*!
+        \brief Updates the velocity, position, lifetime, alpha, rotation
+        and scale of the first count particles in the given store.
+        Particles are processed 4 at a time using SSE or NEON where
+        available, so any padding up to the next multiple of 4 is also
+        updated.
+        */
+        void updateParticles(ParticleStore&, std::size_t count, const ParticleUpdateParams&);
+
+        /*!
+        \brief Returns a Sphere containing the positions of the first
+        count particles in the given store.
+        */
+        Sphere calcParticleBounds(const ParticleStore&, std::size_t count);
+
+        /*!
+        \brief Writes interleaved vertex data for the first count particles
+        directly to dst, which must have space for count * ParticleVertexSize floats.
+        */
+        void writeParticleVertices(const ParticleStore&, std::size_t count, float* dst);
+    }
+}
@@ -0,0 +1,144 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "SpriteBatch.hpp"
+#include "GLCheck.hpp"
+
+#include <crogine/detail/glm/vec4.hpp>
+
+using namespace cro;
+using namespace cro::Detail;
+
+bool SpriteBatchKey::operator==(const SpriteBatchKey& other) const
+{
+    return textureID == other.textureID
+        && shaderID == other.shaderID
+        && blendMode == other.blendMode
+        && facing == other.facing
+        && scissor.left == other.scissor.left
+        && scissor.bottom == other.scissor.bottom
+        && scissor.width == other.scissor.width
+        && scissor.height == other.scissor.height;
+}
+
+//public
+void SpriteBatcher::clear()
+{
+    m_vertices.clear();
+    m_batches.clear();
+}
+
+bool SpriteBatcher::canBatch(std::uint32_t primitiveType)
+{
+    return primitiveType == GL_TRIANGLES
+        || primitiveType == GL_TRIANGLE_STRIP
+        || primitiveType == GL_TRIANGLE_FAN;
+}
+
+bool SpriteBatcher::add(const SpriteBatchKey& key, const std::vector<Vertex2D>& vertices, std::uint32_t primitiveType, const glm::mat4& worldTransform)
+{
+    if (!canBatch(primitiveType))
+    {
+        return false;
+    }
+
+    const auto transform = [&](const Vertex2D& v)
+    {
+        auto& dst = m_vertices.emplace_back(v);
+        dst.position = glm::vec2(worldTransform * glm::vec4(v.position, 0.f, 1.f));
+    };
+
+    const auto firstVertex = m_vertices.size();
+    const auto count = vertices.size();
+
+    switch (primitiveType)
+    {
+    default: break;
+    case GL_TRIANGLES:
+        for (auto i = 0u; i < count - (count % 3); ++i)
+        {
+            transform(vertices[i]);
+        }
+        break;
+    case GL_TRIANGLE_STRIP:
+        //every other triangle in a strip has reversed winding
+        //so swap the first two indices to keep the facing consistent
+        for (auto i = 2u; i < count; ++i)
+        {
+            if (i % 2 == 0)
+            {
+                transform(vertices[i - 2]);
+                transform(vertices[i - 1]);
+            }
+            else
+            {
+                transform(vertices[i - 1]);
+                transform(vertices[i - 2]);
+            }
+            transform(vertices[i]);
+        }
+        break;
+    case GL_TRIANGLE_FAN:
+        for (auto i = 2u; i < count; ++i)
+        {
+            transform(vertices[0]);
+            transform(vertices[i - 1]);
+            transform(vertices[i]);
+        }
+        break;
+    }
+
+    const auto added = static_cast<std::uint32_t>(m_vertices.size() - firstVertex);
+    if (added == 0)
+    {
+        //nothing to draw, but don't break the current batch either
+        return true;
+    }
+
+    if (m_batches.empty()
+        || m_batches.back().vertexCount == 0
+        || m_batches.back().key != key)
+    {
+        auto& batch = m_batches.emplace_back();
+        batch.key = key;
+        batch.firstVertex = static_cast<std::uint32_t>(firstVertex);
+    }
+
+    m_batches.back().vertexCount += added;
+    m_batches.back().drawableCount++;
+
+    return true;
+}
+
+void SpriteBatcher::addUnbatched(std::size_t drawableIndex)
+{
+    auto& batch = m_batches.emplace_back();
+    batch.drawableIndex = drawableIndex;
+    batch.drawableCount = 1;
+}
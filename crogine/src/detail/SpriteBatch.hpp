@@ -0,0 +1,119 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/graphics/Vertex2D.hpp>
+#include <crogine/graphics/MaterialData.hpp>
+#include <crogine/graphics/Rectangle.hpp>
+
+#include <crogine/detail/glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace cro
+{
+    namespace Detail
+    {
+        /*!
+        \brief Describes the render state with which a Drawable2D is drawn.
+        Consecutive drawables with identical keys are merged into a single draw.
+        */
+        struct SpriteBatchKey final
+        {
+            std::uint32_t textureID = 0;
+            std::uint32_t shaderID = 0;
+            Material::BlendMode blendMode = Material::BlendMode::None;
+            std::uint32_t facing = 0;
+            IntRect scissor;
+
+            bool operator == (const SpriteBatchKey&) const;
+            bool operator != (const SpriteBatchKey& other) const { return !(*this == other); }
+        };
+
+        /*!
+        \brief A single draw produced by the SpriteBatcher.
+        If vertexCount is zero then this entry refers to a drawable
+        which could not be batched, and drawableIndex contains its
+        index in the list of drawables passed to the batcher.
+        */
+        struct SpriteBatch final
+        {
+            SpriteBatchKey key;
+            std::uint32_t firstVertex = 0;
+            std::uint32_t vertexCount = 0;
+            std::uint32_t drawableCount = 0; //!< number of drawables merged into this batch
+            std::size_t drawableIndex = 0;
+        };
+
+        /*!
+        \brief Builds a list of batched draws from drawables submitted in render order.
+        Vertices are transformed to world space and converted to a triangle list
+        so that drawables with different transforms and primitive types can share
+        a single draw call. This class does no rendering of its own and makes no
+        OpenGL calls, so the output can be inspected without a valid context.
+        */
+        class SpriteBatcher final
+        {
+        public:
+            /*!
+            \brief Clears all vertices and batches, retaining allocated memory
+            */
+            void clear();
+
+            /*!
+            \brief Returns true if the given primitive type can be merged into a batch
+            */
+            static bool canBatch(std::uint32_t primitiveType);
+
+            /*!
+            \brief Appends the given vertices, transformed by the given matrix.
+            If the key matches the previous batch the vertices are merged with it,
+            else a new batch is started.
+            \returns false if the primitive type cannot be batched, in which
+            case nothing is added
+            */
+            bool add(const SpriteBatchKey&, const std::vector<Vertex2D>&, std::uint32_t primitiveType, const glm::mat4& worldTransform);
+
+            /*!
+            \brief Inserts a drawable which will be drawn individually, breaking any current batch
+            */
+            void addUnbatched(std::size_t drawableIndex);
+
+            const std::vector<Vertex2D>& getVertices() const { return m_vertices; }
+            const std::vector<SpriteBatch>& getBatches() const { return m_batches; }
+
+        private:
+            std::vector<Vertex2D> m_vertices;
+            std::vector<SpriteBatch> m_batches;
+        };
+    }
+}
@@ -28,13 +28,63 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include "StaticMeshFile.hpp"
+#include "CompactVertex.hpp"
 
 #include <crogine/core/Log.hpp>
+#include <crogine/detail/ModelBinary.hpp>
+#include <crogine/graphics/MeshBuilder.hpp>
 
 #include <SDL_rwops.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace cro::Detail
 {
+    Mesh::Data getCMFLayout(std::uint8_t flags)
+    {
+        Mesh::Data meshData;
+        meshData.attributes[Mesh::Position] = 3;
+        meshData.attributeFlags = VertexProperty::Position;
+        if (flags & VertexProperty::Colour)
+        {
+            meshData.attributes[Mesh::Colour] = 3;
+            meshData.attributeFlags |= VertexProperty::Colour;
+        }
+
+        if (flags & VertexProperty::Normal)
+        {
+            meshData.attributes[Mesh::Normal] = 3;
+            meshData.attributeFlags |= VertexProperty::Normal;
+        }
+
+        if (flags & (VertexProperty::Tangent | VertexProperty::Bitangent))
+        {
+            meshData.attributes[Mesh::Tangent] = 3;
+            meshData.attributes[Mesh::Bitangent] = 3;
+            meshData.attributeFlags |= VertexProperty::Tangent | VertexProperty::Bitangent;
+        }
+
+        if (flags & VertexProperty::UV0)
+        {
+            meshData.attributes[Mesh::UV0] = 2;
+            meshData.attributeFlags |= VertexProperty::UV0;
+        }
+        if (flags & VertexProperty::UV1)
+        {
+            meshData.attributes[Mesh::UV1] = 2;
+            meshData.attributeFlags |= VertexProperty::UV1;
+        }
+
+        for (auto a : meshData.attributes)
+        {
+            meshData.vertexSize += a;
+        }
+        meshData.vertexSize *= sizeof(float);
+
+        return meshData;
+    }
+
     bool readCMF(const std::string& path, MeshFile& output)
     {
         auto* file = SDL_RWFromFile(path.c_str(), "rb");
@@ -69,6 +119,19 @@ namespace cro::Detail
             return false;
         }
 
+        const bool compact = (output.flags & CompactMeshFile) != 0;
+        output.flags &= ~CompactMeshFile;
+        output.vertexEncoding = 0;
+        output.packedData.clear();
+        if (compact)
+        {
+            readCount = SDL_RWread(file, &output.vertexEncoding, sizeof(std::uint32_t), 1);
+            if (checkError(readCount))
+            {
+                return false;
+            }
+        }
+
         std::int32_t indexArrayOffset = 0;
         std::vector<std::int32_t> indexSizes(output.arrayCount);
         readCount = SDL_RWread(file, &indexArrayOffset, sizeof(std::int32_t), 1);
@@ -85,19 +148,70 @@ namespace cro::Detail
         std::size_t headerSize = sizeof(output.flags) + sizeof(output.arrayCount) +
             sizeof(indexArrayOffset) + ((sizeof(std::int32_t) * output.arrayCount));
 
-        std::size_t vboSize = (indexArrayOffset - headerSize) / sizeof(float);
-        output.vboData.resize(vboSize);
-        readCount = SDL_RWread(file, output.vboData.data(), sizeof(float), vboSize);
-        if (checkError(readCount))
+        if (compact)
         {
+            headerSize += sizeof(output.vertexEncoding);
+        }
+
+        if (indexArrayOffset < static_cast<std::int32_t>(headerSize))
+        {
+            LogE << path << ": invalid index array offset" << std::endl;
+            SDL_RWclose(file);
             return false;
         }
 
+        if (compact)
+        {
+            auto meshData = getCMFLayout(output.flags);
+            CompactVertex::setPackedFormat(meshData, output.vertexEncoding);
+
+            output.packedData.resize(indexArrayOffset - headerSize);
+            readCount = SDL_RWread(file, output.packedData.data(), output.packedData.size(), 1);
+            if (checkError(readCount))
+            {
+                return false;
+            }
+
+            if (!CompactVertex::unpack(output.packedData.data(), output.packedData.size(), meshData, output.vboData))
+            {
+                LogE << path << ": invalid vertex data size" << std::endl;
+                SDL_RWclose(file);
+                return false;
+            }
+
+            //nothing to upload if the vertex data couldn't be packed
+            if (meshData.packedVertexSize == 0)
+            {
+                output.packedData.clear();
+            }
+        }
+        else
+        {
+            std::size_t vboSize = (indexArrayOffset - headerSize) / sizeof(float);
+            output.vboData.resize(vboSize);
+            readCount = SDL_RWread(file, output.vboData.data(), sizeof(float), vboSize);
+            if (checkError(readCount))
+            {
+                return false;
+            }
+        }
+
         output.indexArrays.resize(output.arrayCount);
+        std::vector<std::uint16_t> compactIndices;
         for (auto i = 0; i < output.arrayCount; ++i)
         {
-            output.indexArrays[i].resize(indexSizes[i] / sizeof(std::uint32_t));
-            readCount = SDL_RWread(file, output.indexArrays[i].data(), sizeof(std::uint32_t), indexSizes[i] / sizeof(std::uint32_t));
+            if (output.vertexEncoding & ModelBinary::CompactIndices)
+            {
+                compactIndices.resize(indexSizes[i] / sizeof(std::uint16_t));
+                readCount = SDL_RWread(file, compactIndices.data(), sizeof(std::uint16_t), compactIndices.size());
+                output.indexArrays[i].assign(compactIndices.begin(), compactIndices.end());
+            }
+            else
+            {
+                output.indexArrays[i].resize(indexSizes[i] / sizeof(std::uint32_t));
+                readCount = SDL_RWread(file, output.indexArrays[i].data(), sizeof(std::uint32_t), indexSizes[i] / sizeof(std::uint32_t));
+            }
+
             if (checkError(readCount))
             {
                 return false;
@@ -108,4 +222,99 @@ namespace cro::Detail
 
         return true;
     }
-}
\ No newline at end of file
+
+    bool writeCMF(const std::string& path, const MeshFile& input, bool compact)
+    {
+        const auto meshData = getCMFLayout(input.flags);
+        if (input.vboData.empty()
+            || input.vboData.size() % (meshData.vertexSize / sizeof(float)) != 0
+            || input.indexArrays.size() != input.arrayCount)
+        {
+            LogE << path << ": invalid mesh data" << std::endl;
+            return false;
+        }
+
+        std::uint32_t encoding = 0;
+        std::vector<std::uint8_t> packedData;
+        if (compact)
+        {
+            auto packedMesh = meshData;
+            encoding = CompactVertex::getPackableAttributes(input.vboData, packedMesh);
+            CompactVertex::setPackedFormat(packedMesh, encoding);
+            CompactVertex::pack(input.vboData, packedMesh, packedData);
+
+            std::uint32_t maxIndex = 0;
+            for (const auto& indices : input.indexArrays)
+            {
+                if (!indices.empty())
+                {
+                    maxIndex = std::max(maxIndex, *std::max_element(indices.begin(), indices.end()));
+                }
+            }
+
+            if (maxIndex <= std::numeric_limits<std::uint16_t>::max())
+            {
+                encoding |= ModelBinary::CompactIndices;
+            }
+        }
+
+        const std::size_t indexSize = (encoding & ModelBinary::CompactIndices) ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+        std::vector<std::int32_t> indexSizes;
+        for (const auto& indices : input.indexArrays)
+        {
+            indexSizes.push_back(static_cast<std::int32_t>(indices.size() * indexSize));
+        }
+
+        const std::uint8_t flags = input.flags | (compact ? CompactMeshFile : 0);
+        std::size_t headerSize = sizeof(flags) + sizeof(input.arrayCount) + sizeof(std::int32_t)
+            + (sizeof(std::int32_t) * input.arrayCount);
+        if (compact)
+        {
+            headerSize += sizeof(encoding);
+        }
+
+        const std::int32_t indexArrayOffset = static_cast<std::int32_t>(headerSize
+            + (compact ? packedData.size() : input.vboData.size() * sizeof(float)));
+
+        auto* file = SDL_RWFromFile(path.c_str(), "wb");
+        if (!file)
+        {
+            LogE << path << ": " << SDL_GetError() << std::endl;
+            return false;
+        }
+
+        SDL_RWwrite(file, &flags, sizeof(flags), 1);
+        SDL_RWwrite(file, &input.arrayCount, sizeof(input.arrayCount), 1);
+        if (compact)
+        {
+            SDL_RWwrite(file, &encoding, sizeof(encoding), 1);
+        }
+        SDL_RWwrite(file, &indexArrayOffset, sizeof(indexArrayOffset), 1);
+        SDL_RWwrite(file, indexSizes.data(), sizeof(std::int32_t), indexSizes.size());
+
+        if (compact)
+        {
+            SDL_RWwrite(file, packedData.data(), 1, packedData.size());
+        }
+        else
+        {
+            SDL_RWwrite(file, input.vboData.data(), sizeof(float), input.vboData.size());
+        }
+
+        for (const auto& indices : input.indexArrays)
+        {
+            if (encoding & ModelBinary::CompactIndices)
+            {
+                std::vector<std::uint16_t> compactIndices(indices.begin(), indices.end());
+                SDL_RWwrite(file, compactIndices.data(), sizeof(std::uint16_t), compactIndices.size());
+            }
+            else
+            {
+                SDL_RWwrite(file, indices.data(), sizeof(std::uint32_t), indices.size());
+            }
+        }
+
+        SDL_RWclose(file);
+        return true;
+    }
+}
@@ -29,12 +29,17 @@ source distribution.
 
 #pragma once
 
+#include <crogine/graphics/MeshData.hpp>
+
 #include <vector>
 #include <string>
 #include <cstdint>
 
 namespace cro::Detail
 {
+    //static meshes never use blend indices so this bit of
+    //the flags byte marks a version 3 file with compact vertex data
+    static constexpr std::uint8_t CompactMeshFile = 0x80;
 
     struct MeshFile final
     {
@@ -42,7 +47,26 @@ namespace cro::Detail
         std::vector<std::vector<std::uint32_t>> indexArrays;
         std::uint8_t flags = 0;
         std::uint8_t arrayCount = 0;
+
+        //version 3 files only. A combination of ModelBinary::CompactFlags
+        //and the vertex data as it is stored in the file, which can be
+        //uploaded to a vbo with the format set by CompactVertex::setPackedFormat()
+        std::uint32_t vertexEncoding = 0;
+        std::vector<std::uint8_t> packedData;
     };
 
+    /*!
+    \brief Returns mesh data with the attribute sizes and vertex size
+    of the float vertex layout described by the given cmf flags
+    */
+    Mesh::Data getCMFLayout(std::uint8_t flags);
+
     bool readCMF(const std::string&, MeshFile&);
-}
\ No newline at end of file
+
+    /*!
+    \brief Writes the vertex and index data of the given MeshFile.
+    If compact is true a version 3 file is written, quantising any
+    attributes which fit, and using 16 bit indices where possible.
+    */
+    bool writeCMF(const std::string&, const MeshFile&, bool compact);
+}
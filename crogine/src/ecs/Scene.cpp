@@ -169,7 +169,7 @@ namespace
 
     void updateView(cro::Camera& camera)
     {
-        glm::vec2 size(cro::App::getWindow().getSize());
+        glm::vec2 size(cro::App::isValid() ? cro::App::getWindow().getSize() : glm::uvec2(1920u, 1080u));
         if (camera.isOrthographic())
         {
             camera.setOrthographic(0.f, size.x, 0.f, size.y, 0.f, 10.f);
@@ -237,10 +237,7 @@ void Scene::simulate(float dt)
         d->process(dt);
     }
 
-    for (const auto& entity : m_pendingEntities)
-    {
-        m_systemManager.addToSystems(entity);
-    }
+    m_systemManager.addToSystems(m_pendingEntities);
     m_pendingEntities.clear();
 
     /*
@@ -249,9 +246,9 @@ void Scene::simulate(float dt)
     don't affect the entity vector mid iteration
     */
     m_destroyedEntities.swap(m_destroyedBuffer);
+    m_systemManager.removeFromSystems(m_destroyedEntities);
     for (const auto& entity : m_destroyedEntities)
     {
-        m_systemManager.removeFromSystems(entity);
         m_entityManager.destroyEntity(entity);
     }
     m_destroyedEntities.clear();
@@ -32,12 +32,19 @@ source distribution.
 
 using namespace cro;
 
+namespace
+{
+    constexpr std::uint32_t NullIndex = std::numeric_limits<std::uint32_t>::max();
+}
+
 System::System(MessageBus& mb, UniqueType t)
     : m_messageBus  (mb),
     m_type          (t),
     m_scene         (nullptr),
     m_updateIndex   (0),
-    m_active        (false)
+    m_active        (false),
+    m_declaresAccess(false),
+    m_filterMessages(false)
 {}
 
 //public
@@ -53,22 +60,94 @@ const std::vector<Entity>& System::getEntities() const
 
 void System::addEntity(Entity entity)
 {
+    const auto id = entity.getIndex();
+    if (id >= m_entityIndices.size())
+    {
+        m_entityIndices.resize(id + 1, NullIndex);
+    }
+    m_entityIndices[id] = static_cast<std::uint32_t>(m_entities.size());
+
     m_entities.push_back(entity);
     onEntityAdded(entity);
 }
 
+void System::addEntities(const std::vector<Entity>& entities)
+{
+    m_entities.reserve(m_entities.size() + entities.size());
+    for (auto e : entities)
+    {
+        addEntity(e);
+    }
+}
+
 void System::removeEntity(Entity entity)
 {
-    m_entities.erase(std::remove_if(std::begin(m_entities), std::end(m_entities),
-        [&entity, this](const Entity& e)
+    const auto idx = findEntity(entity);
+    if (idx != NullIndex)
+    {
+        m_entityIndices[entity.getIndex()] = NullIndex;
+        m_entities.erase(m_entities.begin() + idx);
+
+        for (auto i = idx; i < m_entities.size(); ++i)
+        {
+            m_entityIndices[m_entities[i].getIndex()] = i;
+        }
+
+        onEntityRemoved(entity);
+    }
+}
+
+void System::removeEntities(const std::vector<Entity>& entities)
+{
+    m_removalFlags.resize(m_entities.size());
+
+    auto first = static_cast<std::uint32_t>(m_entities.size());
+    for (auto e : entities)
+    {
+        const auto idx = findEntity(e);
+        if (idx != NullIndex)
+        {
+            m_entityIndices[e.getIndex()] = NullIndex;
+            m_removalFlags[idx] = 1;
+            first = std::min(first, idx);
+        }
+    }
+
+    if (first == m_entities.size())
+    {
+        //nothing to remove
+        return;
+    }
+
+    //compact the list, preserving the order
+    auto dst = first;
+    for (auto i = first; i < m_entities.size(); ++i)
     {
-        if (entity == e)
+        const auto entity = m_entities[i];
+        if (m_removalFlags[i])
         {
-            onEntityRemoved(e);
-            return true;
+            m_removalFlags[i] = 0;
+            m_removedEntities.push_back(entity);
         }
-        return false;
-    }), std::end(m_entities));
+        else
+        {
+            m_entityIndices[entity.getIndex()] = dst;
+            m_entities[dst++] = entity;
+        }
+    }
+    m_entities.resize(dst);
+
+    //do this last so any callbacks see the updated list
+    for (auto e : m_removedEntities)
+    {
+        onEntityRemoved(e);
+    }
+    m_removedEntities.clear();
+}
+
+bool System::hasEntity(Entity entity) const
+{
+    return findEntity(entity) != NullIndex;
 }
 
 const ComponentMask& System::getComponentMask() const
@@ -81,6 +160,21 @@ void System::handleMessage(const Message&) {}
 void System::process(float) {}
 
 //protected
+void System::subscribe(Message::ID id)
+{
+    m_filterMessages = true;
+    if (std::find(m_subscriptions.begin(), m_subscriptions.end(), id) == m_subscriptions.end())
+    {
+        m_subscriptions.push_back(id);
+    }
+}
+
+void System::ignoreMessages()
+{
+    m_filterMessages = true;
+    m_subscriptions.clear();
+}
+
 void System::setScene(Scene& scene)
 {
     m_scene = &scene;
@@ -93,6 +187,38 @@ Scene* System::getScene()
 }
 
 //private
+std::uint32_t System::findEntity(Entity entity) const
+{
+    const auto id = entity.getIndex();
+    if (id < m_entityIndices.size())
+    {
+        const auto idx = m_entityIndices[id];
+        if (idx < m_entities.size()
+            && m_entities[idx] == entity)
+        {
+            return idx;
+        }
+
+        if (idx != NullIndex)
+        {
+            //the entity list was modified directly via getEntities()
+            //so fall back to searching it
+            auto result = std::find(m_entities.begin(), m_entities.end(), entity);
+            if (result != m_entities.end())
+            {
+                return static_cast<std::uint32_t>(std::distance(m_entities.begin(), result));
+            }
+        }
+    }
+    return NullIndex;
+}
+
+bool System::subscribed(Message::ID id) const
+{
+    return !m_filterMessages
+        || std::find(m_subscriptions.begin(), m_subscriptions.end(), id) != m_subscriptions.end();
+}
+
 void System::processTypes(ComponentManager& cm)
 {
     for (const auto& componentType : m_pendingTypes)
@@ -100,4 +226,27 @@ void System::processTypes(ComponentManager& cm)
         m_componentMask.set(cm.getFromTypeID(componentType));
     }
     m_pendingTypes.clear();
+
+    for (const auto& componentType : m_pendingReadTypes)
+    {
+        m_readMask.set(cm.getFromTypeID(componentType));
+    }
+    m_pendingReadTypes.clear();
+
+    for (const auto& componentType : m_pendingWriteTypes)
+    {
+        m_writeMask.set(cm.getFromTypeID(componentType));
+    }
+    m_pendingWriteTypes.clear();
+}
+
+bool System::conflicts(const System& other) const
+{
+    if (!m_declaresAccess || !other.m_declaresAccess)
+    {
+        return true;
+    }
+
+    return (m_writeMask & (other.m_readMask | other.m_writeMask)).any()
+        || (other.m_writeMask & m_readMask).any();
 }
\ No newline at end of file
@@ -47,7 +47,13 @@ SystemManager::SystemManager(Scene& scene, ComponentManager& cm, std::uint32_t i
     : m_scene                   (scene),
     m_componentManager          (cm),
     m_infoFlags                 (infoFlags),
-    m_systemUpdateAccumulator   (0.f)
+    m_systemUpdateAccumulator   (0.f),
+    m_scheduleDirty             (true),
+    m_multithreaded             (true),
+    m_dispatchCount             (0),
+    m_lastDispatchCount         (0),
+    m_forwardCount              (0),
+    m_lastForwardCount          (0)
 {
     //TODO refactor this into a single window with panes for each flag
     if (infoFlags & INFO_FLAG_SYSTEMS_ACTIVE)
@@ -86,7 +92,7 @@ SystemManager::SystemManager(Scene& scene, ComponentManager& cm, std::uint32_t i
                 ImGui::BeginChild("inner");
                 for (const auto* s : m_activeSystems)
                 {
-                    ImGui::Text("%s\n\tEntities: %lu\n", s->getType().name(), s->getEntities().size());
+                    ImGui::Text("%s\n\tEntities: %zu\n", s->getType().name(), s->getEntities().size());
                 }
                 ImGui::EndChild();
             }
@@ -110,14 +116,39 @@ SystemManager::SystemManager(Scene& scene, ComponentManager& cm, std::uint32_t i
                         return a.elapsed > b.elapsed;
                 });
 
-                for (const auto& [system, elapsed] : m_systemSamples)
+                for (const auto& [system, elapsed, thread] : m_systemSamples)
                 {
-                    ImGui::Text("%s: %2.4fms", system->getType().name(), elapsed);
+                    if (system)
+                    {
+                        ImGui::Text("%s: %2.4fms (thread %zu)", system->getType().name(), elapsed, thread);
+                    }
                 }
             }
             ImGui::End();
         });
     }
+
+    if ((infoFlags & INFO_FLAG_MESSAGE_BUS) != 0)
+    {
+        registerWindow(
+            [&]()
+            {
+                ImGui::SetNextWindowSize({ 220.f, 160.f }, ImGuiCond_FirstUseEver);
+
+                std::string label = "Message Bus " + std::to_string(m_scene.getInstanceID());
+                if (ImGui::Begin(label.c_str()))
+                {
+                    const auto& stats = m_scene.getMessageBus().getStats();
+                    ImGui::Text("Posts: %zu", stats.postCount);
+                    ImGui::Text("Bytes: %zu", stats.byteCount);
+                    ImGui::Text("Pages: %zu", stats.pageCount);
+                    ImGui::Separator();
+                    ImGui::Text("Messages Forwarded: %zu", m_lastForwardCount);
+                    ImGui::Text("System Dispatches: %zu", m_lastDispatchCount);
+                }
+                ImGui::End();
+            });
+    }
 }
 
 void SystemManager::addToSystems(Entity entity)
@@ -133,6 +164,14 @@ void SystemManager::addToSystems(Entity entity)
     }
 }
 
+void SystemManager::addToSystems(const std::vector<Entity>& entities)
+{
+    for (auto entity : entities)
+    {
+        addToSystems(entity);
+    }
+}
+
 void SystemManager::removeFromSystems(Entity entity)
 {
     for (auto& sys : m_systems)
@@ -141,17 +180,40 @@ void SystemManager::removeFromSystems(Entity entity)
     }
 }
 
-void SystemManager::forwardMessage(const Message& msg)
+void SystemManager::removeFromSystems(const std::vector<Entity>& entities)
 {
     for (auto& sys : m_systems)
+    {
+        sys->removeEntities(entities);
+    }
+}
+
+void SystemManager::forwardMessage(const Message& msg)
+{
+    const auto& subscribers = getSubscribers(msg.id);
+    for (auto* sys : subscribers)
     {
         sys->handleMessage(msg);
     }
+
+    m_forwardCount++;
+    m_dispatchCount += subscribers.size();
 }
 
 void SystemManager::process(float dt)
 {
+    m_lastDispatchCount = m_dispatchCount;
+    m_lastForwardCount = m_forwardCount;
+    m_dispatchCount = 0;
+    m_forwardCount = 0;
+
+    if (m_scheduleDirty)
+    {
+        buildSchedule();
+    }
+
     //hmm I wish this could be conditionally compiled...
+    bool takeSample = false;
     if (m_infoFlags)
     {        
         m_systemUpdateAccumulator += m_systemTimer.restart();
@@ -160,26 +222,98 @@ void SystemManager::process(float dt)
         {
             m_systemUpdateAccumulator -= SystemTimeUpdateRate;
             m_systemSamples.clear();
-        
-            for (auto& system : m_activeSystems)
+            m_systemSamples.resize(m_activeSystems.size());
+            takeSample = true;
+        }
+    }
+
+    for (const auto& stage : m_schedule)
+    {
+        if (stage.size() == 1
+            || !m_multithreaded)
+        {
+            for (auto idx : stage)
             {
-                system->process(dt);
-                m_systemSamples.emplace_back(system, m_systemTimer.restart() * 1000.f);
+                processSystem(idx, dt, takeSample);
             }
         }
         else
         {
-            for (auto& system : m_activeSystems)
+            auto& threadPool = ThreadPool::getShared();
+            for (auto idx : stage)
             {
-                system->process(dt);
+                threadPool.push([&, idx, dt, takeSample]()
+                    {
+                        processSystem(idx, dt, takeSample);
+                    }, m_jobGroup);
             }
+            //rethrows anything thrown by a system once the whole stage is done
+            threadPool.wait(m_jobGroup);
         }
     }
-    else
+}
+
+//private
+const std::vector<System*>& SystemManager::getSubscribers(Message::ID id)
+{
+    if (auto result = m_subscribers.find(id); result != m_subscribers.end())
+    {
+        return result->second;
+    }
+
+    //keep the same order in which the systems were added
+    auto& subscribers = m_subscribers[id];
+    for (auto& sys : m_systems)
+    {
+        if (sys->subscribed(id))
+        {
+            subscribers.push_back(sys.get());
+        }
+    }
+    return subscribers;
+}
+
+void SystemManager::buildSchedule()
+{
+    //each system is placed in the stage after the last system
+    //it conflicts with, so that conflicting systems are always
+    //processed in the order in which they were added
+    m_schedule.clear();
+    std::vector<std::size_t> stages(m_activeSystems.size());
+
+    for (auto i = 0u; i < m_activeSystems.size(); ++i)
     {
-        for (auto& system : m_activeSystems)
+        std::size_t stage = 0;
+        for (auto j = 0u; j < i; ++j)
+        {
+            if (m_activeSystems[i]->conflicts(*m_activeSystems[j]))
+            {
+                stage = std::max(stage, stages[j] + 1);
+            }
+        }
+        stages[i] = stage;
+
+        if (stage == m_schedule.size())
         {
-            system->process(dt);
+            m_schedule.emplace_back();
         }
+        m_schedule[stage].push_back(i);
+    }
+
+    m_scheduleDirty = false;
+}
+
+void SystemManager::processSystem(std::size_t idx, float dt, bool takeSample)
+{
+    auto* system = m_activeSystems[idx];
+    if (takeSample)
+    {
+        HiResTimer timer;
+        system->process(dt);
+        m_systemSamples[idx] = SystemSample(system, timer.restart() * 1000.f, ThreadPool::getThreadIndex());
+    }
+    else
+    {
+        system->process(dt);
     }
 }
\ No newline at end of file
@@ -45,7 +45,8 @@ Camera::Camera()
     m_shadowExpansion   (0.f),
     m_dirtyTx           (true)
 {
-    glm::vec2 windowSize(App::getWindow().getSize());
+    //there's no window when running headless, such as in tests
+    glm::vec2 windowSize(App::isValid() ? App::getWindow().getSize() : glm::uvec2(1920u, 1080u));
     m_aspectRatio = windowSize.x / windowSize.y;
     m_projectionMatrix = glm::perspective(m_verticalFOV, m_aspectRatio, m_nearPlane, m_farPlane);
 
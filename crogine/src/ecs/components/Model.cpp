@@ -452,7 +452,12 @@ void Model::bindMaterial(Material::Data& material)
             material.attribs[i][Material::Data::Size] = static_cast<std::int32_t>(m_meshData.attributes[i]);
 
             //calc the pointer offset for each attrib
-            material.attribs[i][Material::Data::Offset] = static_cast<std::int32_t>(pointerOffset * sizeof(float));
+            material.attribs[i][Material::Data::Offset] = static_cast<std::int32_t>(pointerOffset);
+
+            //packed attributes, eg from compact model binaries, are normalised or half float
+            const auto& format = m_meshData.attributeFormats[i];
+            material.attribs[i][Material::Data::Type] = format.type == 0 ? GL_FLOAT : static_cast<std::int32_t>(format.type);
+            material.attribs[i][Material::Data::Normalised] = format.normalised ? GL_TRUE : GL_FALSE;
         }
         else
         {
@@ -460,14 +465,16 @@ void Model::bindMaterial(Material::Data& material)
             //with a new shader
             material.attribs[i][Material::Data::Size] = 0;
             material.attribs[i][Material::Data::Offset] = 0;
+            material.attribs[i][Material::Data::Type] = GL_FLOAT;
+            material.attribs[i][Material::Data::Normalised] = GL_FALSE;
         }
-        pointerOffset += m_meshData.attributes[i]; //count the offset regardless as the mesh may have more attributes than material
+        pointerOffset += Mesh::getAttributeSize(m_meshData, i); //count the offset regardless as the mesh may have more attributes than material
     }
 
     //sort by size
     std::sort(std::begin(material.attribs), std::end(material.attribs),
-        [](const std::array<std::int32_t, 3>& ip,
-            const std::array<std::int32_t, 3>& op)
+        [](const std::array<std::int32_t, 5>& ip,
+            const std::array<std::int32_t, 5>& op)
         {
             return ip[Material::Data::Size] > op[Material::Data::Size];
         });
@@ -529,7 +536,8 @@ void Model::updateVAO(std::size_t idx, std::int32_t passIndex)
     {
         glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
         glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
-            GL_FLOAT, GL_FALSE, static_cast<GLsizei>(m_meshData.vertexSize),
+            static_cast<GLenum>(attribs[j][Material::Data::Type]), static_cast<GLboolean>(attribs[j][Material::Data::Normalised]),
+            static_cast<GLsizei>(Mesh::getVertexStride(m_meshData)),
             reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
     }
     
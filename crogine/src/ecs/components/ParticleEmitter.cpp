@@ -31,13 +31,15 @@ source distribution.
 
 #include <crogine/graphics/TextureResource.hpp>
 #include <crogine/core/ConfigFile.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include <algorithm>
 
 using namespace cro;
 
 ParticleEmitter::ParticleEmitter()
     : m_vbo                 (0),
     m_vao                   (0),
-    m_particles             (MaxParticles),
     m_nextFreeParticle      (0),
     m_running               (false),
     m_emissionTime          (0.f),
@@ -46,10 +48,11 @@ ParticleEmitter::ParticleEmitter()
     m_currentTimestamp      (0.f),
     m_emissionTimestamp     (0.f),
     m_pendingUpdate         (true),
+    m_vertexDataDirty       (false),
     m_renderFlags           (std::numeric_limits<std::uint64_t>::max()),
     m_releaseCount          (-1)
 {
-
+    m_particles.resize(MaxParticles);
 }
 
 //void ParticleEmitter::applySettings(const EmitterSettings& es)
@@ -324,4 +327,66 @@ bool EmitterSettings::saveToFile(const std::string& path)
     }
 
     return cfg.save(path);
-}
\ No newline at end of file
+}
+//particle store
+void Detail::ParticleStore::resize(std::size_t size)
+{
+    //pad to a multiple of 4 so SIMD updates never run off the end
+    m_capacity = (size + 3) & ~std::size_t(3);
+
+    m_floatData.assign(m_capacity * Channel::Count, 0.f);
+    m_frameIDs.assign(m_capacity, 0);
+    m_loopCounts.assign(m_capacity, 0);
+
+    //avoids dividing by zero when updating unused padding
+    std::fill_n(get(InverseMaxLifetime), m_capacity, 1.f);
+    std::fill_n(get(Scale), m_capacity, 1.f);
+    std::fill_n(get(Acceleration), m_capacity, 1.f);
+}
+
+void Detail::ParticleStore::set(std::size_t index, const Particle& p)
+{
+    CRO_ASSERT(index < m_capacity, "Index out of range");
+    CRO_ASSERT(p.maxLifeTime > 0, "Max lifetime must be greater than 0");
+
+    get(PositionX)[index] = p.position.x;
+    get(PositionY)[index] = p.position.y;
+    get(PositionZ)[index] = p.position.z;
+
+    get(VelocityX)[index] = p.velocity.x;
+    get(VelocityY)[index] = p.velocity.y;
+    get(VelocityZ)[index] = p.velocity.z;
+
+    get(GravityX)[index] = p.gravity.x;
+    get(GravityY)[index] = p.gravity.y;
+    get(GravityZ)[index] = p.gravity.z;
+
+    get(Red)[index] = p.colour.getRed();
+    get(Green)[index] = p.colour.getGreen();
+    get(Blue)[index] = p.colour.getBlue();
+    get(Alpha)[index] = p.colour.getAlpha();
+
+    get(Lifetime)[index] = p.lifetime;
+    get(InverseMaxLifetime)[index] = 1.f / p.maxLifeTime;
+    get(FrameTime)[index] = p.frameTime;
+    get(Rotation)[index] = p.rotation;
+    get(Scale)[index] = p.scale;
+    get(Acceleration)[index] = p.acceleration;
+
+    m_frameIDs[index] = p.frameID;
+    m_loopCounts[index] = p.loopCount;
+}
+
+void Detail::ParticleStore::move(std::size_t dst, std::size_t src)
+{
+    CRO_ASSERT(dst < m_capacity && src < m_capacity, "Index out of range");
+
+    for (auto i = 0u; i < Channel::Count; ++i)
+    {
+        auto* channel = get(static_cast<Channel>(i));
+        channel[dst] = channel[src];
+    }
+
+    m_frameIDs[dst] = m_frameIDs[src];
+    m_loopCounts[dst] = m_loopCounts[src];
+}
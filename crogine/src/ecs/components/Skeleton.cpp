@@ -32,6 +32,8 @@ source distribution.
 #include <crogine/ecs/components/Skeleton.hpp>
 #include <crogine/ecs/components/Transform.hpp>
 
+#include <numeric>
+
 using namespace cro;
 
 void SkeletalAnim::resetInterp(const Skeleton& skel)
@@ -178,6 +180,9 @@ void Skeleton::addFrame(const std::vector<Joint>& frame)
     {
         m_frameSize = frame.size();
         m_currentFrame.resize(m_frameSize);
+
+        //joint hierarchy is the same for every frame
+        buildJointOrder(frame);
     }
 
     CRO_ASSERT(frame.size() == m_frameSize, "Incorrect frame size");
@@ -273,6 +278,36 @@ void Skeleton::buildKeyframe(std::size_t frame)
     }
 }
 
+void Skeleton::buildJointOrder(const std::vector<Joint>& frame)
+{
+    //we can't reorder the joints themselves as the indices
+    //are referenced by vertex data, attachments and notifications
+    //so store the order in which the joints should be evaluated
+    std::vector<std::uint32_t> depths(frame.size());
+    for (auto i = 0u; i < frame.size(); ++i)
+    {
+        auto parent = frame[i].parent;
+        while (parent != -1)
+        {
+            CRO_ASSERT(parent < static_cast<std::int32_t>(frame.size()), "Parent index out of range");
+            CRO_ASSERT(depths[i] < frame.size(), "Joint hierarchy contains a cycle");
+            depths[i]++;
+            parent = frame[parent].parent;
+        }
+    }
+
+    m_jointOrder.resize(frame.size());
+    std::iota(m_jointOrder.begin(), m_jointOrder.end(), 0);
+
+    //stable sort preserves the existing order for
+    //models which are already exported parent first
+    std::stable_sort(m_jointOrder.begin(), m_jointOrder.end(),
+        [&depths](std::uint32_t a, std::uint32_t b)
+        {
+            return depths[a] < depths[b];
+        });
+}
+
 //----attachment struct-----//
 void Attachment::setParent(std::int32_t parent)
 {
@@ -286,7 +321,7 @@ void Attachment::setModel(cro::Entity model)
         m_model.isValid() &&
         m_model.hasComponent<cro::Transform>())
     {
-        m_model.getComponent<cro::Transform>().m_attachmentTransform = glm::mat4(1.f);
+        m_model.getComponent<cro::Transform>().setAttachmentTransform(glm::mat4(1.f));
     }
 
     m_model = model;
@@ -36,17 +36,43 @@ source distribution.
 #include <crogine/detail/glm/gtc/matrix_transform.hpp>
 #include <crogine/detail/glm/gtc/matrix_access.hpp>
 
+#include <thread>
+
 using namespace cro;
 
+namespace
+{
+    struct CacheLock final
+    {
+        explicit CacheLock(std::atomic_flag& f)
+            : flag(f)
+        {
+            while (flag.test_and_set(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        ~CacheLock()
+        {
+            flag.clear(std::memory_order_release);
+        }
+
+        std::atomic_flag& flag;
+    };
+}
+
 Transform::Transform()
     : m_origin              (0.f, 0.f, 0.f),
     m_position              (0.f, 0.f, 0.f),
     m_scale                 (1.f, 1.f, 1.f),
     m_rotation              (1.f, 0.f, 0.f, 0.f),
     m_transform             (1.f),
+    m_worldTransform        (1.f),
     m_parent                (nullptr),
     m_depth                 (0),
-    m_dirtyFlags            (Flags::Tx),
+    m_dirtyFlags            (Flags::Tx | Flags::Parent),
+    m_changeCount           (0),
     m_attachmentTransform   (1.f)
 {
 
@@ -58,9 +84,11 @@ Transform::Transform(Transform&& other) noexcept
     m_scale                 (1.f, 1.f, 1.f),
     m_rotation              (1.f, 0.f, 0.f, 0.f),
     m_transform             (1.f),
+    m_worldTransform        (1.f),
     m_parent                (nullptr),
     m_depth                 (0),
-    m_dirtyFlags            (Flags::Tx),
+    m_dirtyFlags            (Flags::Tx | Flags::Parent),
+    m_changeCount           (0),
     m_attachmentTransform   (1.f)
 {
     CRO_ASSERT(other.m_parent != this, "Invalid assignment");
@@ -71,6 +99,7 @@ Transform::Transform(Transform&& other) noexcept
         for (auto c : m_children)
         {
             c->m_parent = nullptr;
+            c->markWorldDirty();
 
             while (c->m_depth > 0)
             {
@@ -124,10 +153,16 @@ Transform::Transform(Transform&& other) noexcept
         setRotation(other.getRotation());
         setScale(other.getScale());
         setOrigin(other.getOrigin());
-        m_dirtyFlags = Flags::Tx;
+        m_dirtyFlags = Flags::Tx | Flags::Parent;
+        m_changeCount = other.m_changeCount + 1;
         m_attachmentTransform = other.m_attachmentTransform;
         m_callbacks.swap(other.m_callbacks);
 
+        for (auto c : m_children)
+        {
+            c->markWorldDirty();
+        }
+
         other.reset();
     }
 }
@@ -148,6 +183,7 @@ Transform& Transform::operator=(Transform&& other) noexcept
         for (auto c : m_children)
         {
             c->m_parent = nullptr;
+            c->markWorldDirty();
 
             while (c->m_depth > 0)
             {
@@ -198,10 +234,16 @@ Transform& Transform::operator=(Transform&& other) noexcept
         setRotation(other.getRotation());
         setScale(other.getScale());
         setOrigin(other.getOrigin());
-        m_dirtyFlags = Flags::Tx;
+        m_dirtyFlags = Flags::Tx | Flags::Parent;
+        m_changeCount = other.m_changeCount + 1;
         m_attachmentTransform = other.m_attachmentTransform;
         m_callbacks.swap(other.m_callbacks);
 
+        for (auto c : m_children)
+        {
+            c->markWorldDirty();
+        }
+
         other.reset();
     }
     return *this;
@@ -219,6 +261,7 @@ Transform::~Transform()
     for (auto c : m_children)
     {
         c->m_parent = nullptr;
+        c->markWorldDirty();
 
         while (c->m_depth > 0)
         {
@@ -231,7 +274,7 @@ Transform::~Transform()
 void Transform::setOrigin(glm::vec3 o)
 {
     m_origin = o;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::setOrigin(glm::vec2 o)
@@ -242,21 +285,21 @@ void Transform::setOrigin(glm::vec2 o)
 void Transform::setPosition(glm::vec3 position)
 {
     m_position = position;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::setPosition(glm::vec2 position)
 {
     m_position.x = position.x;
     m_position.y = position.t;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::setRotation(glm::vec3 axis, float angle)
 {
     glm::quat q = glm::quat(1.f, 0.f, 0.f, 0.f);
     m_rotation = glm::rotate(q, angle, axis);
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::setRotation(float radians)
@@ -267,19 +310,19 @@ void Transform::setRotation(float radians)
 void Transform::setRotation(glm::quat rotation)
 {
     m_rotation = rotation;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::setRotation(glm::mat4 rotation)
 {
     m_rotation = glm::quat_cast(rotation);
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::setScale(glm::vec3 scale)
 {
     m_scale = scale;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::setScale(glm::vec2 scale)
@@ -290,7 +333,7 @@ void Transform::setScale(glm::vec2 scale)
 void Transform::move(glm::vec3 distance)
 {
     m_position += distance;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::move(glm::vec2 distance)
@@ -301,7 +344,7 @@ void Transform::move(glm::vec2 distance)
 void Transform::rotate(glm::vec3 axis, float rotation)
 {
     m_rotation = glm::rotate(m_rotation, rotation, glm::normalize(axis));
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::rotate(float amount)
@@ -312,18 +355,19 @@ void Transform::rotate(float amount)
 void Transform::rotate(glm::quat rotation)
 {
     m_rotation = rotation * m_rotation;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::rotate(glm::mat4 rotation)
 {
     m_rotation = glm::quat_cast(rotation) * m_rotation;
+    markDirty();
 }
 
 void Transform::scale(glm::vec3 scale)
 {
     m_scale *= scale;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::scale(glm::vec2 amount)
@@ -383,14 +427,27 @@ glm::mat4 Transform::getLocalTransform() const
 {
     if (m_dirtyFlags & Tx)
     {
-        m_transform = glm::translate(glm::mat4(1.f), m_position);
-        m_transform *= glm::toMat4(m_rotation);
-        m_transform = glm::scale(m_transform, m_scale);
-        m_transform = glm::translate(m_transform, -m_origin);
+        //another thread may have got here first
+        bool updated = false;
+        {
+            CacheLock lock(m_cacheLock);
+            if (m_dirtyFlags & Tx)
+            {
+                m_transform = glm::translate(glm::mat4(1.f), m_position);
+                m_transform *= glm::toMat4(m_rotation);
+                m_transform = glm::scale(m_transform, m_scale);
+                m_transform = glm::translate(m_transform, -m_origin);
 
-        m_dirtyFlags &= ~Tx;
+                m_dirtyFlags &= ~Tx;
+                updated = true;
+            }
+        }
 
-        doCallbacks();
+        //callbacks may read this transform so don't hold the lock
+        if (updated)
+        {
+            doCallbacks();
+        }
     }
 
     return m_attachmentTransform * m_transform;
@@ -425,17 +482,31 @@ void Transform::setLocalTransform(glm::mat4 transform)
     //m_dirtyFlags |= Tx;
     m_transform = glm::translate(transform, -m_origin);
     m_dirtyFlags &= ~Tx;
+    markWorldDirty();
 
     doCallbacks();
 }
 
 glm::mat4 Transform::getWorldTransform() const
 {
-    if (m_parent)
+    //the world transform is cached and only rebuilt when either
+    //this transform or one of its parents has been modified.
+    if (m_dirtyFlags & Parent)
     {
-        return m_parent->getWorldTransform() * getLocalTransform();
+        //these take their own locks, so are fetched first. If another
+        //thread is doing the same thing it'll get the same result.
+        const auto localTransform = getLocalTransform();
+        const auto worldTransform = m_parent ? m_parent->getWorldTransform() * localTransform : localTransform;
+
+        CacheLock lock(m_cacheLock);
+        if (m_dirtyFlags & Parent)
+        {
+            m_worldTransform = worldTransform;
+            m_dirtyFlags &= ~Parent;
+        }
+        return worldTransform;
     }
-    return getLocalTransform();
+    return m_worldTransform;
 }
 
 glm::vec3 Transform::getForwardVector() const
@@ -479,6 +550,7 @@ bool Transform::addChild(Transform& child)
                 }), otherSiblings.end());
         }
         child.m_parent = this;
+        child.markWorldDirty();
 
         //correct the depth
         while (child.m_depth < (m_depth + 1))
@@ -503,6 +575,7 @@ void Transform::removeChild(Transform& tx)
     if (tx.m_parent != this) return;
 
     tx.m_parent = nullptr;
+    tx.markWorldDirty();
 
     while (tx.m_depth > 0)
     {
@@ -529,6 +602,7 @@ void Transform::reset()
     m_scale = glm::vec3(1.f, 1.f, 1.f);
     m_rotation = glm::quat(1.f, 0.f, 0.f, 0.f);
     m_transform = glm::mat4(1.f);
+    m_worldTransform = glm::mat4(1.f);
     m_parent = nullptr;
     m_dirtyFlags = 0;
     m_depth = 0;
@@ -551,6 +625,35 @@ void Transform::doCallbacks() const
     }
 }
 
+void Transform::markDirty()
+{
+    m_dirtyFlags |= Tx;
+    markWorldDirty();
+}
+
+void Transform::markWorldDirty()
+{
+    m_changeCount++;
+
+    //if the Parent flag is already set then all our
+    //children will have been flagged too, so we can
+    //stop here rather than walking the entire subtree
+    if ((m_dirtyFlags & Parent) == 0)
+    {
+        m_dirtyFlags |= Parent;
+        for (auto c : m_children)
+        {
+            c->markWorldDirty();
+        }
+    }
+}
+
+void Transform::setAttachmentTransform(const glm::mat4& tx)
+{
+    m_attachmentTransform = tx;
+    markWorldDirty();
+}
+
 void Transform::increaseDepth()
 {
     m_depth++;
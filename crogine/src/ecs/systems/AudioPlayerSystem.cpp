@@ -39,6 +39,7 @@ AudioPlayerSystem::AudioPlayerSystem(cro::MessageBus& mb)
     : System(mb, typeid(AudioPlayerSystem))
 {
     requireComponent<AudioEmitter>();
+    ignoreMessages();
 }
 
 //public
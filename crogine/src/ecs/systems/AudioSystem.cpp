@@ -46,6 +46,7 @@ AudioSystem::AudioSystem(MessageBus& mb)
     : System(mb, typeid(AudioSystem))
 {
     requireComponent<AudioEmitter>();
+    ignoreMessages();
 }
 
 //public
@@ -41,6 +41,7 @@ BillboardSystem::BillboardSystem(MessageBus& mb)
     : System(mb, typeid(BillboardSystem))
 {
     requireComponent<BillboardCollection>();
+    ignoreMessages();
 }
 
 //public
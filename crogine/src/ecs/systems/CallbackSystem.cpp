@@ -37,6 +37,10 @@ CallbackSystem::CallbackSystem(MessageBus& mb)
     : System(mb, typeid(CallbackSystem))
 {
     requireComponent<Callback>();
+    ignoreMessages();
+
+    //callbacks may access any component, so no access is
+    //declared and the system is always processed on its own
 }
 
 void CallbackSystem::process(float dt)
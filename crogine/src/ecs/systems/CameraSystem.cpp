@@ -43,6 +43,7 @@ CameraSystem::CameraSystem(cro::MessageBus& mb)
 {
     requireComponent<Camera>();
     requireComponent<Transform>();
+    subscribe(Message::WindowMessage);
 }
 
 //public
@@ -31,50 +31,146 @@ source distribution.
 #include <crogine/ecs/systems/CommandSystem.hpp>
 #include <crogine/core/Clock.hpp>
 
+#include <algorithm>
+
 using namespace cro;
 
 namespace
 {
-    //this can be made larger if necessary, is only used to prevent continual reallocation of heap memory
-    //TODO could be make this a circular buffer to prevent crashes when we exceed max size? We might lose
-    //some commands however.
+    //initial size of the command queue - used to prevent continual reallocation of heap memory.
+    //The queue will grow if more commands than this are sent in a single frame
     const std::size_t MaxCommands = 4096;
+    const std::uint32_t BucketCount = 32;
 }
 
 CommandSystem::CommandSystem(MessageBus& mb)
     : System        (mb, typeid(CommandSystem)),
-    m_commands      (MaxCommands),
-    m_commandBuffer (MaxCommands),
-    m_count         (0)
+    m_overflowCount (0)
 {
     requireComponent<CommandTarget>();
+    ignoreMessages();
+
+    //commands may access any component, so no access is
+    //declared and the system is always processed on its own
+
+    m_commands.reserve(MaxCommands);
+    m_commandBuffer.reserve(MaxCommands);
 }
 
 //public
 void CommandSystem::sendCommand(const Command& cmd)
 {
-    if (m_count < MaxCommands)
+    if (m_commandBuffer.size() >= MaxCommands)
     {
-        m_commandBuffer[m_count++] = cmd;
+        m_overflowCount++;
     }
+    m_commandBuffer.push_back(cmd);
 }
 
 void CommandSystem::process(float dt)
 {
-    auto count = m_count;
-    m_count = 0;
+    //commands sent while executing these are queued for the next frame
     m_commands.swap(m_commandBuffer);
+    m_commandBuffer.clear();
 
-    auto& entities = getEntities();
+    //IDs are usually set directly so check for any modifications since last frame
+    const auto& entities = getEntities();
+    for (auto e : entities)
+    {
+        const auto id = e.getComponent<CommandTarget>().ID;
+        if (id != m_bucketIDs[e.getIndex()])
+        {
+            updateBuckets(e, id);
+        }
+    }
 
-    for (auto i = 0u; i < count; ++i)
+    for (const auto& cmd : m_commands)
     {
-        for (auto& e : entities)
+        executeCommand(cmd, dt);
+    }
+    m_commands.clear();
+}
+
+//private
+void CommandSystem::updateBuckets(Entity entity, std::uint32_t newID)
+{
+    auto& oldID = m_bucketIDs[entity.getIndex()];
+    const auto removed = oldID & ~newID;
+    const auto added = newID & ~oldID;
+
+    for (auto i = 0u; i < BucketCount; ++i)
+    {
+        const auto mask = (1u << i);
+        if (removed & mask)
         {
-            if (e.getComponent<CommandTarget>().ID & m_commands[i].targetFlags)
+            auto& bucket = m_buckets[i];
+            auto result = std::find(bucket.begin(), bucket.end(), entity);
+            if (result != bucket.end())
             {
-                m_commands[i].action(e, dt);
+                bucket.erase(result);
             }
         }
+        else if (added & mask)
+        {
+            m_buckets[i].push_back(entity);
+        }
     }
-}
\ No newline at end of file
+
+    oldID = newID;
+}
+
+void CommandSystem::executeCommand(const Command& cmd, float dt)
+{
+    for (auto i = 0u; i < BucketCount; ++i)
+    {
+        const auto mask = (1u << i);
+        if ((cmd.targetFlags & mask) == 0)
+        {
+            continue;
+        }
+
+        //entities which match more than one of the command's flags
+        //are only visited from the bucket of the lowest matching bit
+        const auto lowerFlags = cmd.targetFlags & (mask - 1);
+
+        for (auto e : m_buckets[i])
+        {
+            const auto id = m_bucketIDs[e.getIndex()];
+            if ((id & lowerFlags) == 0)
+            {
+                //a previous command may have removed this entity's flags since it was sorted
+                if (e.getComponent<CommandTarget>().ID & cmd.targetFlags)
+                {
+                    cmd.action(e, dt);
+                }
+
+                //don't modify the bucket while we're iterating over it
+                if (e.getComponent<CommandTarget>().ID != id)
+                {
+                    m_changedTargets.push_back(e);
+                }
+            }
+        }
+    }
+
+    for (auto e : m_changedTargets)
+    {
+        updateBuckets(e, e.getComponent<CommandTarget>().ID);
+    }
+    m_changedTargets.clear();
+}
+
+void CommandSystem::onEntityAdded(Entity entity)
+{
+    if (m_bucketIDs.size() <= entity.getIndex())
+    {
+        m_bucketIDs.resize(entity.getIndex() + 1, 0);
+    }
+    m_bucketIDs[entity.getIndex()] = 0;
+    updateBuckets(entity, entity.getComponent<CommandTarget>().ID);
+}
+
+void CommandSystem::onEntityRemoved(Entity entity)
+{
+    updateBuckets(entity, 0);
+}
@@ -29,16 +29,30 @@ source distribution.
 
 #include <crogine/ecs/systems/DebugInfo.hpp>
 #include <crogine/ecs/components/Transform.hpp>
+#include <crogine/ecs/systems/ModelRenderer.hpp>
+#include <crogine/ecs/systems/ShadowMapRenderer.hpp>
+#include <crogine/ecs/systems/DeferredRenderSystem.hpp>
+#include <crogine/ecs/Scene.hpp>
 #include <crogine/core/Clock.hpp>
 #include <crogine/core/App.hpp>
 #include <crogine/core/Console.hpp>
 
 using namespace cro;
 
+namespace
+{
+    void printDrawListStats(const std::string& name, const DrawListStats& stats)
+    {
+        Console::printStat(name + " Draw List Allocations", std::to_string(stats.allocations));
+        Console::printStat(name + " Draw List Memory", std::to_string(stats.reservedBytes / 1024) + "kb");
+    }
+}
+
 DebugInfo::DebugInfo(MessageBus& mb)
     : System(mb, typeid(DebugInfo))
 {
     requireComponent<Transform>();
+    ignoreMessages();
 }
 
 //public
@@ -59,4 +73,22 @@ void DebugInfo::process(float)
 
         Console::printStat("Entity " + std::to_string(e.getIndex()), op);
     }
+
+    //draw lists are reset each frame so the allocation
+    //count should settle once the scene is running
+    const auto* scene = getScene();
+    if (const auto* system = scene->getSystem<ModelRenderer>(); system)
+    {
+        printDrawListStats("ModelRenderer", system->getDrawListStats());
+    }
+
+    if (const auto* system = scene->getSystem<ShadowMapRenderer>(); system)
+    {
+        printDrawListStats("ShadowMapRenderer", system->getDrawListStats());
+    }
+
+    if (const auto* system = scene->getSystem<DeferredRenderSystem>(); system)
+    {
+        printDrawListStats("DeferredRenderSystem", system->getDrawListStats());
+    }
 }
\ No newline at end of file
@@ -100,6 +100,7 @@ DeferredRenderSystem::DeferredRenderSystem(MessageBus& mb)
 {
     requireComponent<Model>();
     requireComponent<Transform>();
+    ignoreMessages();
 
     //for some reason we can't const initialise this
     //the colours all end up zeroed..?
@@ -206,7 +207,7 @@ void DeferredRenderSystem::updateDrawList(Entity camera)
 
                 SortData f;
                 f.entity = entity;
-                d.distanceFromCamera = distance;
+                f.distanceFromCamera = distance;
 
                 //TODO a large model with a centre behind the camera
                 //might still intersect the view but register as being
@@ -218,11 +219,11 @@ void DeferredRenderSystem::updateDrawList(Entity camera)
                 {
                     if (!model.m_materials[Mesh::IndexData::Final][i].deferred)
                     {
-                        f.materialIDs.push_back(static_cast<std::int32_t>(i));
+                        f.materialIDs.push_back(static_cast<std::uint8_t>(i));
                     }
                     else
                     {
-                        d.materialIDs.push_back(static_cast<std::int32_t>(i));
+                        d.materialIDs.push_back(static_cast<std::uint8_t>(i));
                     }
                 }
 
@@ -279,7 +280,7 @@ void DeferredRenderSystem::render(Entity camera, const RenderTarget& rt)
     auto& buffer = camera.getComponent<GBuffer>().buffer;
     buffer.clear(ClearColours);
 
-    for (auto [entity, matIDs, depth] : deferred)
+    for (const auto& [entity, matIDs, depth] : deferred)
     {
         //foreach submesh / material:
         const auto& model = entity.getComponent<Model>();
@@ -332,7 +333,7 @@ void DeferredRenderSystem::render(Entity camera, const RenderTarget& rt)
     glCheck(glBlendEquationi(TextureIndex::Accum, GL_FUNC_ADD));
     glCheck(glBlendEquationi(TextureIndex::Reveal, GL_FUNC_ADD));
 
-    for (auto [entity, matIDs, depth] : forward)
+    for (const auto& [entity, matIDs, depth] : forward)
     {
         //foreach submesh / material:
         const auto& model = entity.getComponent<Model>();
@@ -486,6 +487,17 @@ void DeferredRenderSystem::setEnvironmentMap(const EnvironmentMap& map)
     m_envMap = &map;
 }
 
+DrawListStats DeferredRenderSystem::getDrawListStats() const
+{
+    DrawListStats stats;
+    for (const auto& list : m_visibleLists)
+    {
+        stats.allocations += list.deferred.getAllocationCount() + list.forward.getAllocationCount();
+        stats.reservedBytes += list.deferred.getReservedBytes() + list.forward.getReservedBytes();
+    }
+    return stats;
+}
+
 //private
 bool DeferredRenderSystem::loadPBRShader()
 {
@@ -40,6 +40,10 @@ DynamicTreeSystem::DynamicTreeSystem(MessageBus& mb, float unitsPerMetre)
 {
     requireComponent<DynamicTreeComponent>();
     requireComponent<Transform>();
+    ignoreMessages();
+
+    declareRead<Transform>();
+    declareWrite<DynamicTreeComponent>();
 }
 
 //public
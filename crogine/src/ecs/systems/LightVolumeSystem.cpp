@@ -133,6 +133,11 @@ LightVolumeSystem::LightVolumeSystem(MessageBus& mb, std::int32_t spaceIndex)
     requireComponent<LightVolume>();
     requireComponent<Model>();
     requireComponent<Transform>();
+    ignoreMessages();
+
+    declareRead<Model>();
+    declareRead<Transform>();
+    declareWrite<LightVolume>();
 
     std::fill(m_uniformIDs.begin(), m_uniformIDs.end(), -1);
 
@@ -216,6 +221,8 @@ void LightVolumeSystem::updateDrawList(Entity cameraEnt)
     //TODO - and this goes for all culling functions
     //the world space transform of the sphere could be cached for a frame
     //instead of being recalculated for every active camera
+    m_cullBatch.clear();
+    m_cullEntities.clear();
     for (auto entity : entities)
     {
         const auto& model = entity.getComponent<Model>();
@@ -250,17 +257,17 @@ void LightVolumeSystem::updateDrawList(Entity cameraEnt)
             continue;
         }
 
-        bool visible = true;
-        std::size_t j = 0;
-        while (visible && j < frustum.size())
-        {
-            visible = (Spatial::intersects(frustum[j++], sphere) != Planar::Back);
-        }
+        light.cullAttenuation = 1.f - smoothstep(light.maxVisibilityDistance - (light.maxVisibilityDistance * 0.33f), light.maxVisibilityDistance, l2);
+        m_cullBatch.push_back(sphere);
+        m_cullEntities.push_back(entity);
+    }
 
-        if (visible)
+    Spatial::intersects(frustum, m_cullBatch, m_cullResults);
+    for (auto i = 0u; i < m_cullEntities.size(); ++i)
+    {
+        if (Spatial::isVisible(m_cullResults, i))
         {
-            light.cullAttenuation = 1.f - smoothstep(light.maxVisibilityDistance - (light.maxVisibilityDistance * 0.33f), light.maxVisibilityDistance, l2);
-            drawList.push_back(entity);
+            drawList.push_back(m_cullEntities[i]);
         }
     }
 }
@@ -49,22 +49,74 @@ source distribution.
 #include <crogine/detail/glm/gtc/matrix_inverse.hpp>
 #include <crogine/detail/glm/gtx/norm.hpp>
 
+#include <cstring>
+#include <limits>
+
 using namespace cro;
 
 namespace
 {
+    constexpr std::uint32_t InvalidState = std::numeric_limits<std::uint32_t>::max();
+
+    //one bit per frustum plane. When a tree node is entirely in
+    //front of a plane its bit is cleared so that none of its
+    //children need testing against that plane again
+    constexpr std::uint32_t AllPlanes = 0x3f;
+
+    //sort key layout, from most significant bit
+    //opaque:      transparent(1) | blend(3) | shader(16) | textures(16) | depth(28)
+    //transparent: transparent(1) | inverse depth(28) | blend(3) | shader(16) | textures(16)
+    constexpr std::uint64_t TransparentBit = (1ull << 63);
+    constexpr std::uint64_t DepthBits = 28;
+    constexpr std::uint64_t DepthMask = (1ull << DepthBits) - 1;
+    constexpr std::uint64_t BlendMask = 0x7;
+    constexpr std::uint64_t ShaderMask = 0xffff;
+
+    //the bit pattern of a positive float increases with its value
+    //so dropping the sign bit and lowest mantissa bits gives us a
+    //quantised depth which still sorts correctly at any distance
+    std::uint64_t quantiseDepth(float distance)
+    {
+        distance = std::max(0.f, distance);
+
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &distance, sizeof(bits));
+        return (bits >> (31 - DepthBits)) & DepthMask;
+    }
 
+    //creates a 16 bit value which is the same for any materials
+    //which have the same set of textures, regardless of order
+    std::uint64_t hashTextures(const Material::Data& material)
+    {
+        std::uint32_t hash = 0;
+        for (const auto& [name, prop] : material.properties)
+        {
+            switch (prop.second.type)
+            {
+            default: break;
+            case Material::Property::Texture:
+            case Material::Property::TextureArray:
+            case Material::Property::Cubemap:
+            case Material::Property::CubemapArray:
+                hash += prop.second.textureID * 2654435761u;
+                break;
+            }
+        }
+        return (hash >> 16);
+    }
 }
 
 ModelRenderer::ModelRenderer(MessageBus& mb)
     : System        (mb, typeid(ModelRenderer)),
     m_drawLists     (1),
-    m_pass          (Mesh::IndexData::Final)/*,
+    m_pass          (Mesh::IndexData::Final),
     m_tree          (1.f),
-    m_useTreeQueries(false)*/
+    m_useTreeQueries(false),
+    m_treeRefitPending(true)
 {
     requireComponent<Transform>();
     requireComponent<Model>();
+    ignoreMessages();
 }
 
 //public
@@ -76,11 +128,11 @@ void ModelRenderer::updateDrawList(Entity cameraEnt)
         m_drawLists.resize(camComponent.getDrawListIndex() + 1);
     }
 
-    /*if (m_useTreeQueries)
+    if (m_useTreeQueries)
     {
         updateDrawListBalancedTree(cameraEnt);
     }
-    else*/
+    else
     {
         updateDrawListDefault(cameraEnt);
     }
@@ -91,44 +143,31 @@ void ModelRenderer::updateDrawList(Entity cameraEnt)
         + ", Camera " + std::to_string(cameraEnt.getIndex()), std::to_string(m_drawLists[camComponent.getDrawListIndex()][0].size()));
     //DPRINT("Total ents", std::to_string(entities.size()));
 
-    //sort lists by depth
-    //flag values make sure transparent materials are rendered last
-    //with opaque going front to back and transparent back to front
+    //sort lists by key - see createSortKey()
+    //key values make sure transparent materials are rendered last
+    //with opaque grouped by state then going front to back and
+    //transparent back to front
     auto& drawList = m_drawLists[camComponent.getDrawListIndex()];
     for (auto i = 0; i < passCount; ++i)
     {
         std::sort(std::begin(drawList[i]), std::end(drawList[i]),
-            [](MaterialPair& a, MaterialPair& b)
+            [](const MaterialPair& a, const MaterialPair& b)
             {
-                return a.second.flags < b.second.flags;
+                return a.second.key < b.second.key;
             });
     }
 }
 
 void ModelRenderer::process(float dt)
 {
+    m_renderStats = {};
+    m_treeRefitPending = true;
+
     auto& entities = getEntities();
     for (auto entity : entities)
     {
         auto& model = entity.getComponent<Model>();
         model.updateMaterialAnimations(dt);
-
-        /*if (m_useTreeQueries)
-        {
-            if (!entity.destroyed())
-            {
-                const auto& tx = entity.getComponent<Transform>();
-                auto worldPosition = tx.getWorldPosition();
-                auto worldBounds = model.getAABB();
-
-                worldBounds += tx.getOrigin();
-                worldBounds = tx.getWorldTransform() * worldBounds;
-
-                m_tree.moveNode(model.m_treeID, worldBounds, worldPosition - model.m_lastWorldPosition);
-
-                model.m_lastWorldPosition = worldPosition;
-            }
-        }*/
     }
 }
 
@@ -147,6 +186,20 @@ void ModelRenderer::render(Entity camera, const RenderTarget& rt)
 
         glCheck(glCullFace(pass.getCullFace()));
 
+        //the draw list is sorted by shader and blend mode so we only
+        //need to update state when it differs from the previous draw
+        std::uint32_t currentShader = InvalidState;
+        std::uint32_t currentEntity = InvalidState;
+        std::int32_t currentBlendMode = -1;
+        std::int32_t currentDoubleSided = -1;
+        std::int32_t currentDepthTest = -1;
+        std::uint32_t currentFacing = InvalidState;
+
+        const Model* model = nullptr;
+        glm::mat4 worldMat = glm::mat4(1.f);
+        glm::mat4 worldView = glm::mat4(1.f);
+        glm::mat3 normalMat = glm::mat3(1.f);
+
         //DPRINT("Render count", std::to_string(m_visibleEntities.size()));
         const auto& visibleEntities = m_drawLists[camComponent.getDrawListIndex()][camComponent.getActivePassIndex()];
         for (const auto& [entity, sortData] : visibleEntities)
@@ -158,78 +211,121 @@ void ModelRenderer::render(Entity camera, const RenderTarget& rt)
                 continue;
             }
 #endif
+            const bool entityChanged = (entity.getIndex() != currentEntity);
+            if (entityChanged)
+            {
+                currentEntity = entity.getIndex();
+                model = &entity.getComponent<Model>();
 
-            //foreach submesh / material:
-            const auto& model = entity.getComponent<Model>();
-            glCheck(glFrontFace(model.m_facing));
+                if (model->m_facing != currentFacing)
+                {
+                    currentFacing = model->m_facing;
+                    glCheck(glFrontFace(currentFacing));
+                }
 
-            //calc entity transform
-            const auto& tx = entity.getComponent<Transform>();
-            const glm::mat4 worldMat = tx.getWorldTransform();
-            const glm::mat4 worldView = pass.viewMatrix * worldMat;
-            //hmm for some reason doing this only once breaks rendering
-            //const glm::mat4 normalMat = glm::inverseTranspose(glm::mat3(worldMat));
+                //calc entity transform
+                const auto& tx = entity.getComponent<Transform>();
+                worldMat = tx.getWorldTransform();
+                worldView = pass.viewMatrix * worldMat;
+                normalMat = glm::inverseTranspose(glm::mat3(worldMat));
 
 #ifndef PLATFORM_DESKTOP
-            glCheck(glBindBuffer(GL_ARRAY_BUFFER, model.m_meshData.vbo));
+                glCheck(glBindBuffer(GL_ARRAY_BUFFER, model->m_meshData.vbo));
 #endif //PLATFORM
+            }
+
+            const auto i = sortData.matID;
+            const auto& material = model->m_materials[Mesh::IndexData::Final][i];
 
-            for (auto i : sortData.matIDs)
+            const bool shaderChanged = (material.shader != currentShader);
+            if (shaderChanged)
             {
                 //bind shader
-                glCheck(glUseProgram(model.m_materials[Mesh::IndexData::Final][i].shader));
+                currentShader = material.shader;
+                glCheck(glUseProgram(currentShader));
+                m_renderStats.programBinds++;
+
+                //apply standard uniforms - these are the same for every
+                //draw with this shader, so only need setting on bind
+                glCheck(glUniform3f(material.uniforms[Material::Camera], cameraPosition.x, cameraPosition.y, cameraPosition.z));
+                glCheck(glUniform2f(material.uniforms[Material::ScreenSize], screenSize.x, screenSize.y));
+                glCheck(glUniform4f(material.uniforms[Material::ClipPlane], clipPlane[0], clipPlane[1], clipPlane[2], clipPlane[3]));
+                glCheck(glUniformMatrix4fv(material.uniforms[Material::View], 1, GL_FALSE, glm::value_ptr(pass.viewMatrix)));
+                glCheck(glUniformMatrix4fv(material.uniforms[Material::ViewProjection], 1, GL_FALSE, glm::value_ptr(pass.viewProjectionMatrix)));
+                glCheck(glUniformMatrix4fv(material.uniforms[Material::Projection], 1, GL_FALSE, glm::value_ptr(camComponent.getProjectionMatrix())));
+                m_renderStats.uniformUploads += 6;
+            }
 
-                //apply shader uniforms from material
-                glCheck(glUniformMatrix4fv(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::WorldView], 1, GL_FALSE, glm::value_ptr(worldView)));
-                applyProperties(model.m_materials[Mesh::IndexData::Final][i], model, *getScene(), camComponent);
+            if (shaderChanged || entityChanged)
+            {
+                glCheck(glUniformMatrix4fv(material.uniforms[Material::WorldView], 1, GL_FALSE, glm::value_ptr(worldView)));
+                glCheck(glUniformMatrix4fv(material.uniforms[Material::World], 1, GL_FALSE, glm::value_ptr(worldMat)));
+                glCheck(glUniformMatrix3fv(material.uniforms[Material::Normal], 1, GL_FALSE, glm::value_ptr(normalMat)));
+                m_renderStats.uniformUploads += 3;
+            }
 
-                //apply standard uniforms
-                glCheck(glUniform3f(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::Camera], cameraPosition.x, cameraPosition.y, cameraPosition.z));
-                glCheck(glUniform2f(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::ScreenSize], screenSize.x, screenSize.y));
-                glCheck(glUniform4f(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::ClipPlane], clipPlane[0], clipPlane[1], clipPlane[2], clipPlane[3]));
-                glCheck(glUniformMatrix4fv(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::View], 1, GL_FALSE, glm::value_ptr(pass.viewMatrix)));
-                glCheck(glUniformMatrix4fv(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::ViewProjection], 1, GL_FALSE, glm::value_ptr(pass.viewProjectionMatrix)));
-                glCheck(glUniformMatrix4fv(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::Projection], 1, GL_FALSE, glm::value_ptr(camComponent.getProjectionMatrix())));
-                glCheck(glUniformMatrix4fv(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::World], 1, GL_FALSE, glm::value_ptr(worldMat)));
-                glCheck(glUniformMatrix3fv(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::Normal], 1, GL_FALSE, glm::value_ptr(glm::inverseTranspose(glm::mat3(worldMat)))));
+            //apply shader uniforms from material
+            applyProperties(material, *model, *getScene(), camComponent);
+            m_renderStats.uniformUploads += static_cast<std::uint32_t>(material.properties.size() + material.optionalUniformCount);
 
-                applyBlendMode(model.m_materials[Mesh::IndexData::Final][i]/*.blendMode*/);
+            //custom blend modes may differ between materials so always apply them
+            if (material.blendMode == Material::BlendMode::Custom
+                || static_cast<std::int32_t>(material.blendMode) != currentBlendMode)
+            {
+                currentBlendMode = static_cast<std::int32_t>(material.blendMode);
+                applyBlendMode(material);
 
-                glCheck(model.m_materials[Mesh::IndexData::Final][i].doubleSided ? glDisable(GL_CULL_FACE) : glEnable(GL_CULL_FACE));
-                glCheck(model.m_materials[Mesh::IndexData::Final][i].enableDepthTest ? glEnable(GL_DEPTH_TEST) : glDisable(GL_DEPTH_TEST));
+                //custom blend modes may modify culling or depth testing
+                currentDoubleSided = -1;
+                currentDepthTest = -1;
+            }
+
+            if (static_cast<std::int32_t>(material.doubleSided) != currentDoubleSided)
+            {
+                currentDoubleSided = material.doubleSided ? 1 : 0;
+                glCheck(material.doubleSided ? glDisable(GL_CULL_FACE) : glEnable(GL_CULL_FACE));
+            }
+
+            if (static_cast<std::int32_t>(material.enableDepthTest) != currentDepthTest)
+            {
+                currentDepthTest = material.enableDepthTest ? 1 : 0;
+                glCheck(material.enableDepthTest ? glEnable(GL_DEPTH_TEST) : glDisable(GL_DEPTH_TEST));
+            }
+
+            m_renderStats.drawCalls++;
 
 #ifdef PLATFORM_DESKTOP
-                model.draw(i, Mesh::IndexData::Final);
+            model->draw(i, Mesh::IndexData::Final);
 
 #else //GLES 2 doesn't have VAO support without extensions
 
-                //bind attribs
-                const auto& attribs = model.m_materials[Mesh::IndexData::Final][i].attribs;
-                for (auto j = 0u; j < model.m_materials[Mesh::IndexData::Final][i].attribCount; ++j)
-                {
-                    glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
-                    glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
-                        GL_FLOAT, GL_FALSE, static_cast<GLsizei>(model.m_meshData.vertexSize),
-                        reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
-                }
+            //bind attribs
+            const auto& attribs = material.attribs;
+            for (auto j = 0u; j < material.attribCount; ++j)
+            {
+                glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
+                glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
+                    static_cast<GLenum>(attribs[j][Material::Data::Type]), static_cast<GLboolean>(attribs[j][Material::Data::Normalised]),
+                    static_cast<GLsizei>(Mesh::getVertexStride(model->m_meshData)),
+                    reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
+            }
 
-                //bind element/index buffer
-                const auto& indexData = model.m_meshData.indexData[i];
-                glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexData.ibo));
+            //bind element/index buffer
+            const auto& indexData = model->m_meshData.indexData[i];
+            glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexData.ibo));
 
-                //draw elements
-                glCheck(glDrawElements(static_cast<GLenum>(indexData.primitiveType), indexData.indexCount, static_cast<GLenum>(indexData.format), 0));
+            //draw elements
+            glCheck(glDrawElements(static_cast<GLenum>(indexData.primitiveType), indexData.indexCount, static_cast<GLenum>(indexData.format), 0));
 
-                glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+            glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
 
-                //unbind attribs
-                for (auto j = 0u; j < model.m_materials[Mesh::IndexData::Final][i].attribCount; ++j)
-                {
-                    glCheck(glDisableVertexAttribArray(attribs[j][Material::Data::Index]));
+            //unbind attribs
+            for (auto j = 0u; j < material.attribCount; ++j)
+            {
+                glCheck(glDisableVertexAttribArray(attribs[j][Material::Data::Index]));
             }
 #endif //PLATFORM 
         }
-    }
 
 #ifdef PLATFORM_DESKTOP
         glCheck(glBindVertexArray(0));
@@ -244,7 +340,7 @@ void ModelRenderer::render(Entity camera, const RenderTarget& rt)
         glCheck(glDisable(GL_CULL_FACE));
         glCheck(glDisable(GL_DEPTH_TEST));
         glCheck(glDepthMask(GL_TRUE)); //restore this else clearing the depth buffer fails
-}
+    }
 }
 
 std::size_t ModelRenderer::getVisibleCount(std::size_t cameraIndex, std::int32_t passIndex) const
@@ -262,6 +358,70 @@ std::size_t ModelRenderer::getVisibleCount(std::size_t cameraIndex, std::int32_t
     return 0;
 }
 
+DrawListStats ModelRenderer::getDrawListStats() const
+{
+    DrawListStats stats;
+    for (const auto& drawList : m_drawLists)
+    {
+        for (const auto& list : drawList)
+        {
+            stats.allocations += list.getAllocationCount();
+            stats.reservedBytes += list.getReservedBytes();
+        }
+    }
+    return stats;
+}
+
+void ModelRenderer::setTreeCullingEnabled(bool enabled)
+{
+    if (enabled == m_useTreeQueries)
+    {
+        return;
+    }
+
+    m_useTreeQueries = enabled;
+
+    //the tree is only maintained while it's in use
+    //so it's rebuilt each time it's enabled
+    auto& entities = getEntities();
+    for (auto entity : entities)
+    {
+        if (enabled)
+        {
+            addToTree(entity);
+        }
+        else
+        {
+            auto& model = entity.getComponent<Model>();
+            m_tree.removeFromTree(model.m_treeID);
+            model.m_treeID = -1;
+        }
+    }
+}
+
+std::uint64_t ModelRenderer::createSortKey(const Material::Data& material, float distance)
+{
+    const auto depth = quantiseDepth(distance);
+    const auto blend = static_cast<std::uint64_t>(material.blendMode) & BlendMask;
+    const auto shader = static_cast<std::uint64_t>(material.shader) & ShaderMask;
+    const auto textures = hashTextures(material);
+
+    if (material.blendMode != Material::BlendMode::None)
+    {
+        //back to front, so invert the depth
+        return TransparentBit
+            | ((DepthMask - depth) << 35)
+            | (blend << 32)
+            | (shader << 16)
+            | textures;
+    }
+
+    return (blend << 60)
+        | (shader << 44)
+        | (textures << DepthBits)
+        | depth;
+}
+
 const std::string& ModelRenderer::getDefaultVertexShader(std::int32_t type)
 {
     static const std::string defaultVal;
@@ -303,12 +463,20 @@ void ModelRenderer::onEntityAdded(Entity entity)
     auto& model = entity.getComponent<Model>();
     model.updateBounds();
 
-    //model.m_treeID = m_tree.addToTree(entity, model.getAABB());
+    if (m_useTreeQueries)
+    {
+        addToTree(entity);
+    }
 }
 
 void ModelRenderer::onEntityRemoved(Entity entity)
 {
-    //m_tree.removeFromTree(entity.getComponent<Model>().m_treeID);
+    auto& model = entity.getComponent<Model>();
+    if (model.m_treeID != -1)
+    {
+        m_tree.removeFromTree(model.m_treeID);
+        model.m_treeID = -1;
+    }
 }
 
 //private
@@ -329,6 +497,8 @@ void ModelRenderer::updateDrawListDefault(Entity cameraEnt)
         list.clear();
     }
 
+    m_cullBatch.clear();
+    m_cullEntities.clear();
     for (auto& entity : entities)
     {
         auto& model = entity.getComponent<Model>();
@@ -343,240 +513,218 @@ void ModelRenderer::updateDrawListDefault(Entity cameraEnt)
         }
 
         //use the bounding sphere for depth testing
-        auto sphere = model.getBoundingSphere();
-        const auto& tx = entity.getComponent<Transform>();
-
-        sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f));
-        auto scale = tx.getWorldScale();
+        m_cullBatch.push_back(getWorldSphere(entity, model));
+        m_cullEntities.push_back(entity);
+    }
 
-        /*if (scale.x * scale.y * scale.z == 0)
+    //for each pass in the list (different passes may use different projections, eg reflections)
+    for (auto p = 0; p < passCount; ++p)
+    {
+        if (Spatial::intersects(camComponent.getPass(p).getFrustum(), m_cullBatch, m_cullResults) == 0)
         {
             continue;
-        }*/
-
-        sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f);
+        }
 
-        //for some reason the tighter fitting Spheres cause incorrect culling
-        //so this is a hack to mitigate it somewhat
-        sphere.radius *= 1.2f;
+        for (auto i = 0u; i < m_cullEntities.size(); ++i)
+        {
+            if (Spatial::isVisible(m_cullResults, i))
+            {
+                const Sphere sphere(m_cullBatch.radius[i], { m_cullBatch.x[i], m_cullBatch.y[i], m_cullBatch.z[i] });
+                addToDrawList(m_cullEntities[i], m_cullEntities[i].getComponent<Model>(), sphere, camComponent, cameraPos, p, 0);
+            }
+        }
+    }
+}
 
-        //for each pass in the list (different passes may use different projections, eg reflections)
-        for (auto p = 0; p < passCount; ++p)
+void ModelRenderer::updateDrawListBalancedTree(Entity cameraEnt)
+{
+    //draw lists are updated by the CameraSystem, which may well be processed
+    //before this system, so refit any moved nodes here rather than in process()
+    //to make sure the query doesn't use last frame's bounds. This only needs
+    //doing for the first camera each frame, as the others share the same tree.
+    if (m_treeRefitPending)
+    {
+        for (auto entity : getEntities())
         {
-            if ((model.m_renderFlags & camComponent.getPass(p).renderFlags) == 0)
+            if (!entity.destroyed())
             {
-                continue;
+                updateTreeNode(entity);
             }
-            
-            //this is a good approximation of distance based on the centre
-            //of the model (large models might suffer without face sorting...)
-            //assuming the forward vector is normalised - though WHY would you
-            //scale the view matrix???
-            auto direction = (sphere.centre - cameraPos);
-            float distance = glm::dot(camComponent.getPass(p).forwardVector, direction);
-
-            if (distance < -sphere.radius)
+        }
+        m_treeRefitPending = false;
+    }
+
+    const auto& camComponent = cameraEnt.getComponent<Camera>();
+    const auto cameraPos = cameraEnt.getComponent<Transform>().getWorldPosition();
+    const auto passCount = camComponent.reflectionBuffer.available() ? 2 : 1;
+
+    auto& drawList = m_drawLists[camComponent.getDrawListIndex()];
+    for (auto& list : drawList)
+    {
+        list.clear();
+    }
+
+    const auto& nodes = m_tree.getNodes();
+    for (auto p = 0; p < passCount; ++p)
+    {
+        const auto& frustum = camComponent.getPass(p).getFrustum();
+
+        //each entry holds a node ID and the planes which still need testing
+        Detail::FixedStack<std::pair<std::int32_t, std::uint32_t>, 256> stack;
+        stack.push(std::make_pair(m_tree.getRoot(), AllPlanes));
+
+        while (stack.size() > 0)
+        {
+            auto [treeID, planeMask] = stack.pop();
+            if (treeID == Detail::TreeNode::Null)
             {
-                //model is behind the camera
                 continue;
             }
 
+            const auto& node = nodes[treeID];
 
             bool visible = true;
-            //if (camComponent.isOrthographic())
+            for (auto j = 0u; j < frustum.size() && visible; ++j)
             {
-                const auto& frustum = camComponent.getPass(p).getFrustum();
-
-                std::size_t j = 0;
-                while (visible && j < frustum.size())
+                if (planeMask & (1 << j))
                 {
-                    visible = (Spatial::intersects(frustum[j++], sphere) != Planar::Back);
+                    switch (Spatial::intersects(frustum[j], node.fatBounds))
+                    {
+                    default: break;
+                    case Planar::Back:
+                        visible = false;
+                        break;
+                    case Planar::Front:
+                        planeMask &= ~(1 << j);
+                        break;
+                    }
                 }
             }
-            /*else
-            {
-                //well measuring this says it's nearly twice as slow...
-                model.m_visible = cro::Util::Frustum::visible(camComponent.getFrustumData(), camComponent.getPass(p).viewMatrix * tx.getWorldTransform(), model.getAABB());
-            }*/
 
-            if (visible)
+            if (!visible)
             {
-                auto opaque = std::make_pair(entity, SortData());
-                auto transparent = std::make_pair(entity, SortData());
+                continue;
+            }
 
-                //foreach material
-                //add ent/index pair to alpha or opaque list
-                for (auto i = 0u; i < model.m_meshData.submeshCount; ++i)
+            if (node.isLeaf())
+            {
+                if (node.entity.isValid())
                 {
-                    if (model.m_materials[Mesh::IndexData::Final][i].blendMode != Material::BlendMode::None)
-                    {
-                        transparent.second.matIDs.push_back(static_cast<std::int32_t>(i));
-                        transparent.second.flags = static_cast<std::int64_t>(-distance * 1000000.f); //suitably large number to shift decimal point
-                        transparent.second.flags += 0x0FFF000000000000; //gaurentees embiggenment so that sorting places transparent last
-                    }
-                    else
+                    const auto& model = node.entity.getComponent<Model>();
+                    if (!model.isHidden())
                     {
-                        opaque.second.matIDs.push_back(static_cast<std::int32_t>(i));
-                        opaque.second.flags = static_cast<std::int64_t>(distance * 1000000.f);
+                        //the sphere centre is inside the node's bounds, so it's
+                        //also in front of any planes the node is in front of
+                        addToDrawList(node.entity, model, getWorldSphere(node.entity, model), camComponent, cameraPos, p, planeMask);
                     }
                 }
-
-                if (!opaque.second.matIDs.empty())
-                {
-                    drawList[p].push_back(opaque);
-                }
-
-                if (!transparent.second.matIDs.empty())
-                {
-                    drawList[p].push_back(transparent);
-                }
+            }
+            else
+            {
+                stack.push(std::make_pair(node.childA, planeMask));
+                stack.push(std::make_pair(node.childB, planeMask));
             }
         }
     }
 }
 
-void ModelRenderer::updateDrawListBalancedTree(Entity cameraEnt)
+void ModelRenderer::addToTree(Entity entity)
+{
+    auto& model = entity.getComponent<Model>();
+    const auto& tx = entity.getComponent<Transform>();
+
+    //the tree adds the origin to the bounds, but the world
+    //transform of a Model already includes it
+    model.m_treeID = m_tree.addToTree(entity, model.getAABB() + -tx.getOrigin());
+    model.m_lastWorldPosition = tx.getWorldPosition();
+    model.m_lastTransformChange = tx.getChangeCount();
+}
+
+void ModelRenderer::updateTreeNode(Entity entity)
+{
+    auto& model = entity.getComponent<Model>();
+    const auto& tx = entity.getComponent<Transform>();
+
+    bool refit = (tx.getChangeCount() != model.m_lastTransformChange);
+    if (model.m_meshBox != model.m_meshData.boundingBox)
+    {
+        model.updateBounds();
+        refit = true;
+    }
+
+    //static models are skipped entirely
+    if (refit)
+    {
+        const auto worldPosition = tx.getWorldPosition();
+        m_tree.moveNode(model.m_treeID, tx.getWorldTransform() * model.getAABB(), worldPosition - model.m_lastWorldPosition);
+
+        model.m_lastWorldPosition = worldPosition;
+        model.m_lastTransformChange = tx.getChangeCount();
+    }
+}
+
+void ModelRenderer::addToDrawList(Entity entity, const Model& model, const Sphere& sphere, const Camera& camComponent, glm::vec3 cameraPos, std::int32_t passIndex, std::uint32_t planeMask)
 {
-    //const auto& camComponent = cameraEnt.getComponent<Camera>();
-    //auto cameraPos = cameraEnt.getComponent<Transform>().getWorldPosition();
-
-    //auto& drawList = m_drawLists[camComponent.getDrawListIndex()];
-
-    //for (auto& list : drawList)
-    //{
-    //    list.clear();
-    //}
-
-    //auto passCount = camComponent.reflectionBuffer.available() ? 2 : 1;
-
-    //for (auto p = 0; p < passCount; ++p)
-    //{
-    //    const auto& frustumBounds = camComponent.getPass(p).getAABB();
-    //    auto entities = queryTree(frustumBounds);
-
-    //    for (auto entity : entities)
-    //    {
-    //        auto& model = entity.getComponent<Model>();
-    //        if (model.isHidden())
-    //        {
-    //            continue;
-    //        }
-
-    //        if ((model.m_renderFlags & camComponent.getPass(p).renderFlags) == 0)
-    //        {
-    //            continue;
-    //        }
-
-    //        if (model.m_meshBox != model.m_meshData.boundingBox)
-    //        {
-    //            model.updateBounds();
-    //        }
-
-    //        //use the bounding sphere for depth testing
-    //        auto sphere = model.getBoundingSphere();
-    //        const auto& tx = entity.getComponent<Transform>();
-
-    //        sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f));
-    //        auto scale = tx.getScale();
-    //        sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f);
-
-    //        auto direction = (sphere.centre - cameraPos);
-    //        float distance = glm::dot(camComponent.getPass(p).forwardVector, direction);
-
-    //        if (distance < -sphere.radius)
-    //        {
-    //            //model is behind the camera
-    //            continue;
-    //        }
-
-    //        //frustum test
-    //        bool visible = true;
-    //        //if (camComponent.isOrthographic())
-    //        {
-    //            const auto& frustum = camComponent.getPass(p).getFrustum();
-
-    //            visible = true;
-    //            std::size_t j = 0;
-    //            while (visible && j < frustum.size())
-    //            {
-    //                visible = (Spatial::intersects(frustum[j++], sphere) != Planar::Back);
-    //            }
-    //        }
-    //        /*else
-    //        {
-    //            model.m_visible = cro::Util::Frustum::visible(camComponent.getFrustumData(), camComponent.getPass(p).viewMatrix * tx.getWorldTransform(), model.getAABB());
-    //        }*/
-
-    //        //add visible ents to lists for depth sorting
-    //        if (visible)
-    //        {
-    //            auto opaque = std::make_pair(entity, SortData());
-    //            auto transparent = std::make_pair(entity, SortData());
-
-    //            //foreach material
-    //            //add ent/index pair to alpha or opaque list
-    //            for (auto i = 0u; i < model.m_meshData.submeshCount; ++i)
-    //            {
-    //                if (model.m_materials[Mesh::IndexData::Final][i].blendMode != Material::BlendMode::None)
-    //                {
-    //                    transparent.second.matIDs.push_back(static_cast<std::int32_t>(i));
-    //                    transparent.second.flags = static_cast<std::int64_t>(-distance * 1000000.f); //suitably large number to shift decimal point
-    //                    transparent.second.flags += 0x0FFF000000000000; //gaurentees embiggenment so that sorting places transparent last
-    //                }
-    //                else
-    //                {
-    //                    opaque.second.matIDs.push_back(static_cast<std::int32_t>(i));
-    //                    opaque.second.flags = static_cast<std::int64_t>(distance * 1000000.f);
-    //                }
-    //            }
-
-    //            if (!opaque.second.matIDs.empty())
-    //            {
-    //                drawList[p].push_back(opaque);
-    //            }
-
-    //            if (!transparent.second.matIDs.empty())
-    //            {
-    //                drawList[p].push_back(transparent);
-    //            }
-    //        }
-    //    }
-    //}
+    const auto& pass = camComponent.getPass(passIndex);
+    if ((model.m_renderFlags & pass.renderFlags) == 0)
+    {
+        return;
+    }
+
+    //this is a good approximation of distance based on the centre
+    //of the model (large models might suffer without face sorting...)
+    //assuming the forward vector is normalised - though WHY would you
+    //scale the view matrix???
+    auto direction = (sphere.centre - cameraPos);
+    float distance = glm::dot(pass.forwardVector, direction);
+
+    if (distance < -sphere.radius)
+    {
+        //model is behind the camera
+        return;
+    }
+
+    const auto& frustum = pass.getFrustum();
+    for (auto j = 0u; j < frustum.size(); ++j)
+    {
+        if ((planeMask & (1 << j))
+            && Spatial::intersects(frustum[j], sphere) == Planar::Back)
+        {
+            return;
+        }
+    }
+    //foreach material add a keyed entry to the list
+    auto& list = m_drawLists[camComponent.getDrawListIndex()][passIndex];
+    for (auto i = 0u; i < model.m_meshData.submeshCount; ++i)
+    {
+        const auto& material = model.m_materials[Mesh::IndexData::Final][i];
+        auto& entry = list.emplace_back(entity, SortData());
+        entry.second.key = createSortKey(material, distance);
+        entry.second.matID = static_cast<std::int32_t>(i);
+    }
 }
 
-//std::vector<Entity> ModelRenderer::queryTree(Box area) const
-//{
-//    Detail::FixedStack<std::int32_t, 256> stack;
-//    stack.push(m_tree.getRoot());
-//
-//    std::vector<Entity> retVal;
-//    retVal.reserve(256);
-//
-//    while (stack.size() > 0)
-//    {
-//        auto treeID = stack.pop();
-//        if (treeID == Detail::TreeNode::Null)
-//        {
-//            continue;
-//        }
-//
-//        const auto& node = m_tree.getNodes()[treeID];
-//        if (area.intersects(node.fatBounds))
-//        {
-//            if (node.isLeaf() && node.entity.isValid())
-//            {
-//                //we have a candidate, stash
-//                retVal.push_back(node.entity);
-//            }
-//            else
-//            {
-//                stack.push(node.childA);
-//                stack.push(node.childB);
-//            }
-//        }
-//    }
-//    return retVal;
-//}
+Sphere ModelRenderer::getWorldSphere(Entity entity, const Model& model)
+{
+    auto sphere = model.getBoundingSphere();
+    const auto& tx = entity.getComponent<Transform>();
+
+    sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f));
+    auto scale = tx.getWorldScale();
+
+    /*if (scale.x * scale.y * scale.z == 0)
+    {
+        continue;
+    }*/
+
+    sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f);
+
+    //for some reason the tighter fitting Spheres cause incorrect culling
+    //so this is a hack to mitigate it somewhat
+    sphere.radius *= 1.2f;
+
+    return sphere;
+}
 
 void ModelRenderer::applyProperties(const Material::Data& material, const Model& model, const Scene& scene, const Camera& camera)
 {
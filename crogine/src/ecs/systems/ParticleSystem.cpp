@@ -42,6 +42,7 @@ source distribution.
 #include <crogine/util/Matrix.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/ParticleKernels.hpp"
 
 #include <crogine/detail/glm/gtc/type_ptr.hpp>
 #include <crogine/detail/glm/gtx/norm.hpp>
@@ -194,25 +195,14 @@ LIGHT_OUT = vec4(vec3(0.0), 1.0);
     const std::size_t MaxParticleSystems = 128; //max number of VBOs - must be divisible by min count
     const std::size_t MinParticleSystems = 4; //min amount before resizing - this many added on resize (so don't make too large!!)
     const std::size_t VertexSize = 10 * sizeof(float); //pos, colour, rotation/scale vert attribs
-
-
-    bool inFrustum(const Frustum& frustum, const ParticleEmitter& emitter)
-    {
-        bool visible = true;
-        std::size_t i = 0;
-        while (visible && i < frustum.size())
-        {
-            visible = (Spatial::intersects(frustum[i++], emitter.getBounds()) != Planar::Back);
-        }
-
-        return visible;
-    }
 }
 
 ParticleSystem::ParticleSystem(MessageBus& mb)
     : System            (mb, typeid(ParticleSystem)),
     m_drawLists         (1),
+#ifndef PLATFORM_DESKTOP
     m_dataBuffer        (MaxVertData),
+#endif
     m_vboIDs            (MaxParticleSystems),
     m_vaoIDs            (MaxParticleSystems),
     m_nextBuffer        (0),
@@ -231,6 +221,10 @@ ParticleSystem::ParticleSystem(MessageBus& mb)
 
     requireComponent<Transform>();
     requireComponent<ParticleEmitter>();
+    ignoreMessages();
+
+    declareRead<Transform>();
+    declareWrite<ParticleEmitter>();
 
     const std::array<std::string, ShaderID::Count> Defines =
     {
@@ -334,18 +328,20 @@ void ParticleSystem::updateDrawList(Entity cameraEnt)
     }
 
     const auto& entities = getEntities();
-    for (auto entity : entities)
+    for (auto i = 0; i < passCount; ++i)
     {
-        auto& emitter = entity.getComponent<ParticleEmitter>();
-        const auto emitterDirection = entity.getComponent<cro::Transform>().getWorldPosition() - camPos;
+        m_cullBatch.clear();
+        m_cullEntities.clear();
 
-        for (auto i = 0; i < passCount; ++i)
+        for (auto entity : entities)
         {
+            auto& emitter = entity.getComponent<ParticleEmitter>();
             if ((emitter.m_renderFlags & cam.getPass(i).renderFlags) == 0)
             {
                 continue;
             }
 
+            const auto emitterDirection = entity.getComponent<cro::Transform>().getWorldPosition() - camPos;
             if (glm::dot(forwardVec, emitterDirection) > 0)
             {
                 if (!emitter.m_pendingUpdate)
@@ -354,13 +350,22 @@ void ParticleSystem::updateDrawList(Entity cameraEnt)
                     m_potentiallyVisible.push_back(entity);
                 }
 
-                const auto& frustum = cam.getPass(i).getFrustum();
-                if (emitter.m_nextFreeParticle > 0 && inFrustum(frustum, emitter))
+                if (emitter.m_nextFreeParticle > 0)
                 {
-                    drawlist[i].push_back(entity);
+                    m_cullBatch.push_back(emitter.getBounds());
+                    m_cullEntities.push_back(entity);
                 }
             }
         }
+
+        Spatial::intersects(cam.getPass(i).getFrustum(), m_cullBatch, m_cullResults);
+        for (auto j = 0u; j < m_cullEntities.size(); ++j)
+        {
+            if (Spatial::isVisible(m_cullResults, j))
+            {
+                drawlist[i].push_back(m_cullEntities[j]);
+            }
+        }
     }
 
     DPRINT("Visible particle Systems", std::to_string(drawlist[0].size()));
@@ -418,13 +423,13 @@ void ParticleSystem::process(float dt)
                 auto emitCount = emitter.settings.emitCount;
                 while (emitCount--)
                 {
-                    if (emitter.m_nextFreeParticle < emitter.m_particles.size() - 1)
+                    if (emitter.m_nextFreeParticle < ParticleEmitter::MaxParticles - 1)
                     {
                         //TODO a lot of this only needs to be calc'd ONCE for every particle in emitCount
                         const auto& settings = emitter.settings;
                         CRO_ASSERT(settings.emitRate > 0, "Emit rate must be grater than 0");
                         CRO_ASSERT(settings.lifetime > 0, "Lifetime must be greater than 0");
-                        auto& p = emitter.m_particles[emitter.m_nextFreeParticle];
+                        Particle p;
                         p.colour = settings.colour;
                         p.gravity = settings.gravity;
                         p.lifetime = settings.lifetime + cro::Util::Random::value(-settings.lifetimeVariance, settings.lifetimeVariance + epsilon);
@@ -466,7 +471,7 @@ void ParticleSystem::process(float dt)
                         offset *= worldScale;
                         p.position += offset;
 
-
+                        emitter.m_particles.set(emitter.m_nextFreeParticle, p);
                         emitter.m_nextFreeParticle++;
                         if (emitter.m_releaseCount > 0)
                         {
@@ -483,102 +488,68 @@ void ParticleSystem::process(float dt)
         }
 
         //update each particle
-        glm::vec3 minBounds(std::numeric_limits<float>::max());
-        glm::vec3 maxBounds(0.f);
-
-        float framerate = 1.f / emitter.settings.framerate;
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+        Detail::ParticleUpdateParams params;
+        params.dt = dt;
+        params.rotation = emitter.settings.rotationSpeed * dt;
+        params.scale = 1.f + (emitter.settings.scaleModifier * dt);
+        for (auto f : emitter.settings.forces)
         {
-            auto& p = emitter.m_particles[i];
-
-            p.velocity *= p.acceleration;
-            p.velocity += p.gravity * dt;
-            for (auto f : emitter.settings.forces)
-            {
-                p.velocity += f * dt;
-            }
-            p.position += p.velocity * dt;            
-           
-            p.lifetime -= dt;
-            p.colour.setAlpha(std::min(1.f, std::max(p.lifetime / p.maxLifeTime, 0.f)));
+            params.force += f;
+        }
+        Detail::updateParticles(emitter.m_particles, emitter.m_nextFreeParticle, params);
 
-            p.rotation += emitter.settings.rotationSpeed * dt;
-            p.scale += ((p.scale * emitter.settings.scaleModifier) * dt);
+        auto* frameIDs = emitter.m_particles.getFrameIDs();
+        auto* loopCounts = emitter.m_particles.getLoopCounts();
+        if (emitter.settings.animate)
+        {
+            const float framerate = 1.f / emitter.settings.framerate;
+            auto* frameTimes = emitter.m_particles.get(Detail::ParticleStore::FrameTime);
 
-            if (emitter.settings.animate)
+            for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
             {
-                p.frameTime += dt;
-                if (p.frameTime > framerate)
+                frameTimes[i] += dt;
+                if (frameTimes[i] > framerate)
                 {
-                    p.frameID++;
-                    if (p.frameID == emitter.settings.frameCount
-                        && p.loopCount)
+                    frameIDs[i]++;
+                    if (frameIDs[i] == emitter.settings.frameCount
+                        && loopCounts[i])
                     {
-                        p.loopCount--;
-                        p.frameID = 0;
+                        loopCounts[i]--;
+                        frameIDs[i] = 0;
                     }
-                    p.frameTime -= framerate;
+                    frameTimes[i] -= framerate;
                 }
             }
-
-            //update bounds for culling
-            if (p.position.x < minBounds.x) minBounds.x = p.position.x;
-            if (p.position.y < minBounds.y) minBounds.y = p.position.y;
-            if (p.position.z < minBounds.z) minBounds.z = p.position.z;
-
-            if (p.position.x > maxBounds.x) maxBounds.x = p.position.x;
-            if (p.position.y > maxBounds.y) maxBounds.y = p.position.y;
-            if (p.position.z > maxBounds.z) maxBounds.z = p.position.z;
         }
-        auto dist = (maxBounds - minBounds) / 2.f;
-        emitter.m_bounds.centre = dist + minBounds;
-        emitter.m_bounds.radius = glm::length(dist);
 
-        //go over again and remove dead particles with pop/swap
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+        //go over again and remove dead particles by moving the last one into their place
+        const auto* lifetimes = emitter.m_particles.get(Detail::ParticleStore::Lifetime);
+        for (auto i = 0u; i < emitter.m_nextFreeParticle;)
         {
-            if (emitter.m_particles[i].lifetime < 0
-                || ((emitter.m_particles[i].frameID == emitter.settings.frameCount)
-                    && (emitter.m_particles[i].loopCount == 0)))
+            if (lifetimes[i] < 0
+                || ((frameIDs[i] == emitter.settings.frameCount)
+                    && (loopCounts[i] == 0)))
             {
                 emitter.m_nextFreeParticle--;
-                std::swap(emitter.m_particles[i], emitter.m_particles[emitter.m_nextFreeParticle]);                
+                emitter.m_particles.move(i, emitter.m_nextFreeParticle);
+            }
+            else
+            {
+                ++i;
             }
         }
         //DPRINT("Next free Particle", std::to_string(emitter.m_nextFreeParticle));
 
         //TODO sort verts by depth? should be drawing back to front for transparency really.
 
-        //update VBO
-        std::size_t idx = 0;
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
-        {
-            const auto& p = emitter.m_particles[i];
-
-            //position
-            m_dataBuffer[idx++] = p.position.x;
-            m_dataBuffer[idx++] = p.position.y;
-            m_dataBuffer[idx++] = p.position.z;
-
-            //colour
-            m_dataBuffer[idx++] = p.colour.getRed();
-            m_dataBuffer[idx++] = p.colour.getGreen();
-            m_dataBuffer[idx++] = p.colour.getBlue();
-            m_dataBuffer[idx++] = p.colour.getAlpha();
-
-            //rotation/size/animation
-            m_dataBuffer[idx++] = p.rotation * Util::Const::degToRad;
-            m_dataBuffer[idx++] = p.scale;
-            m_dataBuffer[idx++] = static_cast<float>(p.frameID);
-        }
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, emitter.m_vbo));
-        glCheck(glBufferSubData(GL_ARRAY_BUFFER, 0, idx * sizeof(float), m_dataBuffer.data()));
+        //the VBO is updated in render() so that no GL calls are
+        //made here, which allows the system to run on a worker thread
+        emitter.m_bounds = Detail::calcParticleBounds(emitter.m_particles, emitter.m_nextFreeParticle);
+        emitter.m_vertexDataDirty = true;
 
         emitter.m_previousPosition = e.getComponent<cro::Transform>().getWorldPosition();
     }
 
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
-
     m_potentiallyVisible.clear();
 }
 
@@ -643,7 +614,8 @@ void ParticleSystem::render(Entity camera, const RenderTarget& rt)
                 continue;
             }
 
-            const auto& emitter = entity.getComponent<ParticleEmitter>();
+            auto& emitter = entity.getComponent<ParticleEmitter>();
+            updateVertexData(emitter);
 
             //apply blend mode - this also binds the appropriate shader for current mode
             switch (emitter.settings.blendmode)
@@ -716,6 +688,33 @@ void ParticleSystem::render(Entity camera, const RenderTarget& rt)
 }
 
 //private
+void ParticleSystem::updateVertexData(ParticleEmitter& emitter)
+{
+    //vertex data is written straight to the mapped
+    //buffer where possible to save copying it twice
+    if (emitter.m_vertexDataDirty
+        && emitter.m_nextFreeParticle)
+    {
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, emitter.m_vbo));
+
+        const auto byteCount = emitter.m_nextFreeParticle * Detail::ParticleVertexSize * sizeof(float);
+#ifdef PLATFORM_DESKTOP
+        void* dst = nullptr;
+        glCheck(dst = glMapBufferRange(GL_ARRAY_BUFFER, 0, byteCount, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+        if (dst)
+        {
+            Detail::writeParticleVertices(emitter.m_particles, emitter.m_nextFreeParticle, static_cast<float*>(dst));
+            glCheck(glUnmapBuffer(GL_ARRAY_BUFFER));
+        }
+#else
+        Detail::writeParticleVertices(emitter.m_particles, emitter.m_nextFreeParticle, m_dataBuffer.data());
+        glCheck(glBufferSubData(GL_ARRAY_BUFFER, 0, byteCount, m_dataBuffer.data()));
+#endif
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    }
+    emitter.m_vertexDataDirty = false;
+}
+
 void ParticleSystem::onEntityAdded(Entity entity)
 {    
     //check VBO count and increase if needed
@@ -44,6 +44,7 @@ ProjectionMapSystem::ProjectionMapSystem(MessageBus& mb)
 {
     requireComponent<Transform>();
     requireComponent<ProjectionMap>();
+    ignoreMessages();
 }
 
 //public
@@ -39,12 +39,18 @@ source distribution.
 #include <crogine/core/Console.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/SpriteBatch.hpp"
 #include "../../graphics/shaders/Sprite.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 
 namespace
 {
+    //initial size of the batching vertex buffer, in vertices
+    constexpr std::size_t MinArenaSize = 4096;
+
     //std::vector<float> buns =
     //{
     //    0.f,0.f,  0.f,0.f, 1.f,0.f,0.f,1.f,
@@ -57,17 +63,39 @@ namespace
 using namespace cro;
 
 RenderSystem2D::RenderSystem2D(MessageBus& mb)
-    : System        (mb, typeid(RenderSystem2D)),
-    m_sortOrder     (DepthAxis::Z),
-    m_needsSort     (true),
-    m_drawLists     (1)
+    : System            (mb, typeid(RenderSystem2D)),
+    m_sortOrder         (DepthAxis::Z),
+    m_needsSort         (true),
+    m_drawLists         (1),
+    m_batchingEnabled   (false),
+    m_batcher           (std::make_unique<Detail::SpriteBatcher>())
 {
     requireComponent<Drawable2D>();
     requireComponent<Transform>();
+    ignoreMessages();
 
     //load default shaders
     m_colouredShader.loadFromString(Shaders::Sprite::Vertex, Shaders::Sprite::Coloured);
     m_texturedShader.loadFromString(Shaders::Sprite::Vertex, Shaders::Sprite::Textured, "#define TEXTURED\n");
+
+    //store the uniform locations used when drawing batches
+    const std::array<const Shader*, 2u> shaders = { &m_colouredShader, &m_texturedShader };
+    for (auto i = 0u; i < shaders.size(); ++i)
+    {
+        const auto& uniforms = shaders[i]->getUniformMap();
+        if (uniforms.count("u_worldMatrix"))
+        {
+            m_defaultUniforms[i].world = uniforms.at("u_worldMatrix");
+        }
+        if (uniforms.count("u_viewProjectionMatrix"))
+        {
+            m_defaultUniforms[i].viewProjection = uniforms.at("u_viewProjectionMatrix");
+        }
+        if (uniforms.count("u_texture"))
+        {
+            m_defaultUniforms[i].texture = uniforms.at("u_texture");
+        }
+    }
 }
 
 RenderSystem2D::~RenderSystem2D()
@@ -78,6 +106,18 @@ RenderSystem2D::~RenderSystem2D()
     {
         resetDrawable(entity);
     }
+
+    if (m_vertexArena.vbo)
+    {
+        glCheck(glDeleteBuffers(1, &m_vertexArena.vbo));
+    }
+
+#ifdef PLATFORM_DESKTOP
+    if (m_vertexArena.vao[0])
+    {
+        glCheck(glDeleteVertexArrays(2, m_vertexArena.vao.data()));
+    }
+#endif
 }
 
 //public
@@ -144,6 +184,8 @@ void RenderSystem2D::updateDrawList(Entity camEnt)
 
 void RenderSystem2D::process(float)
 {
+    m_renderStats = {};
+
     auto& entities = getEntities();
     for (auto entity : entities)
     {
@@ -165,8 +207,10 @@ void RenderSystem2D::process(float)
             drawable.applyShader();
         }
 
-        //check data flag and update buffer if needed
-        if (drawable.m_updateBufferData)
+        //check data flag and update buffer if needed - batched
+        //drawables are read directly from the vertex data when rendering
+        if (drawable.m_updateBufferData
+            && !(m_batchingEnabled && isBatchable(drawable)))
         {
             //bind VBO and upload data
             glCheck(glBindBuffer(GL_ARRAY_BUFFER, drawable.m_vbo));
@@ -215,6 +259,7 @@ void RenderSystem2D::render(Entity cameraEntity, const RenderTarget& rt)
     {
         const auto& pass = camComponent.getActivePass();
         auto viewport = rt.getViewport(camComponent.viewport);
+        auto targetSize = rt.getSize();
 
         glCheck(glDepthMask(GL_FALSE));
         glCheck(glEnable(GL_CULL_FACE));
@@ -224,131 +269,20 @@ void RenderSystem2D::render(Entity cameraEntity, const RenderTarget& rt)
         std::uint32_t lastProgram = 0;
 
         const auto& entities = m_drawLists[camComponent.getDrawListIndex()];
-        for (auto entity : entities)
+        if (m_batchingEnabled)
         {
+            renderBatched(entities, pass, viewport, targetSize, lastProgram);
+        }
+        else
+        {
+            for (auto entity : entities)
+            {
 #ifdef CRO_DEBUG_
-            //these are probably OK to draw as they aren't yet cleared up
-            //(just marked for removal) but it will ASSERT on debug builds
-            if (!entity.isValid()) continue;
+                //these are probably OK to draw as they aren't yet cleared up
+                //(just marked for removal) but it will ASSERT on debug builds
+                if (!entity.isValid()) continue;
 #endif
-
-            const auto& drawable = entity.getComponent<Drawable2D>();
-            const auto& tx = entity.getComponent<cro::Transform>();
-            glm::mat4 worldMat = tx.getWorldTransform();
-
-            if (//TODO surely these ought to be culling criteria?
-                drawable.m_shader && !drawable.m_updateBufferData)
-            {
-                //apply shader
-                auto program = drawable.m_shader->getGLHandle();
-                if (program != lastProgram)
-                {
-                    glCheck(glUseProgram(program));
-                    lastProgram = program;
-                }
-                //glCheck(glUniformMatrix4fv(drawable.m_worldUniform, 1, GL_FALSE, &(worldMat[0].x)));
-                glCheck(glUniformMatrix4fv(drawable.m_viewProjectionUniform, 1, GL_FALSE, glm::value_ptr(pass.viewProjectionMatrix)));
-                glCheck(glUniformMatrix4fv(drawable.m_worldUniform, 1, GL_FALSE, glm::value_ptr(worldMat)));
-
-                //apply texture if active
-                if (drawable.m_textureInfo.textureID.textureID)
-                {
-                    glCheck(glActiveTexture(GL_TEXTURE0));
-                    glCheck(glBindTexture(GL_TEXTURE_2D, drawable.m_textureInfo.textureID.textureID));
-                    glCheck(glUniform1i(drawable.m_textureUniform, 0));
-                }
-
-                //apply any custom uniforms
-                std::int32_t j = 1;
-                for (const auto& [uniform, value] : drawable.m_textureIDBindings)
-                {
-                    glCheck(glActiveTexture(GL_TEXTURE0 + j));
-                    glCheck(glBindTexture(GL_TEXTURE_2D, value));
-                    glCheck(glUniform1i(uniform, j));
-                    j++;
-                }
-                for (auto [uniform, value] : drawable.m_floatBindings)
-                {
-                    glCheck(glUniform1f(uniform, value));
-                }
-                for (auto [uniform, value] : drawable.m_vec2Bindings)
-                {
-                    glCheck(glUniform2f(uniform, value.x, value.y));
-                }
-                for (auto [uniform, value] : drawable.m_vec3Bindings)
-                {
-                    glCheck(glUniform3f(uniform, value.x, value.y, value.z));
-                }
-                for (auto [uniform, value] : drawable.m_vec4Bindings)
-                {
-                    glCheck(glUniform4f(uniform, value.r, value.g, value.b, value.a));
-                }
-                for (auto [uniform, value] : drawable.m_boolBindings)
-                {
-                    glCheck(glUniform1i(uniform, value));
-                }
-                for (const auto& [uniform, value] : drawable.m_matBindings)
-                {
-                    glCheck(glUniformMatrix4fv(uniform, 1, GL_FALSE, value));
-                }
-
-                applyBlendMode(drawable.m_blendMode);
-
-                if (drawable.m_cropped)
-                {
-                    //convert cropping area to target coords (remember this might not be a window!)
-                    glm::vec2 start(drawable.m_croppingWorldArea.left, drawable.m_croppingWorldArea.bottom);
-                    glm::vec2 end(start.x + drawable.m_croppingWorldArea.width, start.y + drawable.m_croppingWorldArea.height);
-
-                    auto scissorStart = mapCoordsToPixel(start, pass.viewProjectionMatrix, viewport);
-                    auto scissorEnd = mapCoordsToPixel(end, pass.viewProjectionMatrix, viewport);
-
-                    scissorStart.x = std::clamp(scissorStart.x, 0, viewport.width - 1);
-                    scissorStart.y = std::clamp(scissorStart.y, 0, viewport.height - 1);
-
-                    scissorEnd.x = std::clamp(scissorEnd.x, scissorStart.x, viewport.width);
-                    scissorEnd.y = std::clamp(scissorEnd.y, scissorStart.y, viewport.height);
-
-                    auto w = scissorEnd.x - scissorStart.x;
-                    auto h = scissorEnd.y - scissorStart.y;
-
-                    glCheck(glScissor(scissorStart.x, scissorStart.y, w, h));
-                }
-                else
-                {
-                    auto rtSize = rt.getSize();
-                    glCheck(glScissor(0, 0, rtSize.x, rtSize.y));
-                }
-
-                glCheck(glFrontFace(drawable.m_facing));
-
-#ifdef PLATFORM_DESKTOP
-                glCheck(glBindVertexArray(drawable.m_vao));
-                glCheck(glDrawArrays(static_cast<GLenum>(drawable.m_primitiveType), 0, static_cast<GLsizei>(drawable.m_vertices.size())));
-
-#else //GLES 2 doesn't have VAO support without extensions
-                glCheck(glBindBuffer(GL_ARRAY_BUFFER, drawable.m_vbo));
-
-                //bind attribs
-                //const auto& attribs = drawable.m_vertexAttribs;
-                for (const auto& [id, size, offset] : drawable.m_vertexAttributes)
-                {
-                    glCheck(glEnableVertexAttribArray(id));
-                    glCheck(glVertexAttribPointer(id, size,
-                        GL_FLOAT, GL_FALSE, static_cast<GLsizei>(Vertex2D::Size),
-                        reinterpret_cast<void*>(static_cast<intptr_t>(offset))));
-                }
-
-                //draw array
-                glCheck(glDrawArrays(static_cast<GLenum>(drawable.m_primitiveType), 0, drawable.m_vertices.size()));
-
-                //and unbind... this could be saved by only changing when switching shader
-                for (const auto& attrib : drawable.m_vertexAttributes)
-                {
-                    glCheck(glDisableVertexAttribArray(attrib.id));
-                }
-
-#endif //PLATFORM 
+                drawEntity(entity, pass, viewport, targetSize, lastProgram);
             }
         }
 
@@ -415,6 +349,327 @@ glm::ivec2 RenderSystem2D::mapCoordsToPixel(glm::vec2 coord, const glm::mat4& vi
     return retVal;
 }
 
+IntRect RenderSystem2D::getScissor(const Drawable2D& drawable, const glm::mat4& viewProjectionMatrix, IntRect viewport, glm::uvec2 targetSize) const
+{
+    if (drawable.m_cropped)
+    {
+        //convert cropping area to target coords (remember this might not be a window!)
+        glm::vec2 start(drawable.m_croppingWorldArea.left, drawable.m_croppingWorldArea.bottom);
+        glm::vec2 end(start.x + drawable.m_croppingWorldArea.width, start.y + drawable.m_croppingWorldArea.height);
+
+        auto scissorStart = mapCoordsToPixel(start, viewProjectionMatrix, viewport);
+        auto scissorEnd = mapCoordsToPixel(end, viewProjectionMatrix, viewport);
+
+        scissorStart.x = std::clamp(scissorStart.x, 0, viewport.width - 1);
+        scissorStart.y = std::clamp(scissorStart.y, 0, viewport.height - 1);
+
+        scissorEnd.x = std::clamp(scissorEnd.x, scissorStart.x, viewport.width);
+        scissorEnd.y = std::clamp(scissorEnd.y, scissorStart.y, viewport.height);
+
+        return IntRect(scissorStart.x, scissorStart.y, scissorEnd.x - scissorStart.x, scissorEnd.y - scissorStart.y);
+    }
+
+    return IntRect(0, 0, static_cast<std::int32_t>(targetSize.x), static_cast<std::int32_t>(targetSize.y));
+}
+
+bool RenderSystem2D::isBatchable(const Drawable2D& drawable) const
+{
+    //custom shaders may rely on the world matrix or bound
+    //uniforms, so only the default shaders can be batched
+    return (drawable.m_shader == &m_colouredShader || drawable.m_shader == &m_texturedShader)
+        && drawable.m_textureIDBindings.empty()
+        && drawable.m_floatBindings.empty()
+        && drawable.m_vec2Bindings.empty()
+        && drawable.m_vec3Bindings.empty()
+        && drawable.m_vec4Bindings.empty()
+        && drawable.m_boolBindings.empty()
+        && drawable.m_matBindings.empty()
+        && Detail::SpriteBatcher::canBatch(drawable.m_primitiveType);
+}
+
+void RenderSystem2D::renderBatched(const std::vector<Entity>& entities, const Camera::Pass& pass, IntRect viewport, glm::uvec2 targetSize, std::uint32_t& lastProgram)
+{
+    m_batcher->clear();
+    for (auto i = 0u; i < entities.size(); ++i)
+    {
+        auto entity = entities[i];
+#ifdef CRO_DEBUG_
+        if (!entity.isValid()) continue;
+#endif
+
+        const auto& drawable = entity.getComponent<Drawable2D>();
+        if (isBatchable(drawable))
+        {
+            Detail::SpriteBatchKey key;
+            key.textureID = drawable.m_textureInfo.textureID.textureID;
+            key.shaderID = drawable.m_shader->getGLHandle();
+            key.blendMode = drawable.m_blendMode;
+            key.facing = drawable.m_facing;
+            key.scissor = getScissor(drawable, pass.viewProjectionMatrix, viewport, targetSize);
+
+            m_batcher->add(key, drawable.m_vertices, drawable.m_primitiveType, entity.getComponent<cro::Transform>().getWorldTransform());
+        }
+        else
+        {
+            m_batcher->addUnbatched(i);
+        }
+    }
+
+    const auto baseVertex = static_cast<GLint>(uploadArena(m_batcher->getVertices()));
+    static const glm::mat4 identity(1.f);
+
+    for (const auto& batch : m_batcher->getBatches())
+    {
+        if (batch.vertexCount == 0)
+        {
+            drawEntity(entities[batch.drawableIndex], pass, viewport, targetSize, lastProgram);
+            continue;
+        }
+
+        const std::size_t shaderIndex = batch.key.shaderID == m_texturedShader.getGLHandle() ? 1 : 0;
+        const auto& uniforms = m_defaultUniforms[shaderIndex];
+
+        if (batch.key.shaderID != lastProgram)
+        {
+            glCheck(glUseProgram(batch.key.shaderID));
+            lastProgram = batch.key.shaderID;
+        }
+        //unbatched drawables may have modified these so always apply them
+        glCheck(glUniformMatrix4fv(uniforms.viewProjection, 1, GL_FALSE, glm::value_ptr(pass.viewProjectionMatrix)));
+        glCheck(glUniformMatrix4fv(uniforms.world, 1, GL_FALSE, glm::value_ptr(identity)));
+
+        if (batch.key.textureID)
+        {
+            glCheck(glActiveTexture(GL_TEXTURE0));
+            glCheck(glBindTexture(GL_TEXTURE_2D, batch.key.textureID));
+            glCheck(glUniform1i(uniforms.texture, 0));
+        }
+
+        applyBlendMode(batch.key.blendMode);
+
+        const auto& scissor = batch.key.scissor;
+        glCheck(glScissor(scissor.left, scissor.bottom, scissor.width, scissor.height));
+
+        glCheck(glFrontFace(batch.key.facing));
+
+#ifdef PLATFORM_DESKTOP
+        glCheck(glBindVertexArray(m_vertexArena.vao[shaderIndex]));
+        glCheck(glDrawArrays(GL_TRIANGLES, baseVertex + batch.firstVertex, static_cast<GLsizei>(batch.vertexCount)));
+#else
+        const auto& shader = shaderIndex == 1 ? m_texturedShader : m_colouredShader;
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vertexArena.vbo));
+        applyArenaAttributes(shader);
+
+        glCheck(glDrawArrays(GL_TRIANGLES, baseVertex + batch.firstVertex, static_cast<GLsizei>(batch.vertexCount)));
+
+        for (auto attrib : { Mesh::Attribute::Position, Mesh::Attribute::Colour, Mesh::Attribute::UV0 })
+        {
+            if (shader.getAttribMap()[attrib] != -1)
+            {
+                glCheck(glDisableVertexAttribArray(shader.getAttribMap()[attrib]));
+            }
+        }
+#endif
+        m_renderStats.drawables += batch.drawableCount;
+        m_renderStats.batches++;
+        m_renderStats.drawCalls++;
+    }
+}
+
+std::size_t RenderSystem2D::uploadArena(const std::vector<Vertex2D>& vertices)
+{
+    if (vertices.empty())
+    {
+        return 0;
+    }
+
+    if (m_vertexArena.vbo == 0)
+    {
+        glCheck(glGenBuffers(1, &m_vertexArena.vbo));
+
+#ifdef PLATFORM_DESKTOP
+        glCheck(glGenVertexArrays(2, m_vertexArena.vao.data()));
+
+        const std::array<const Shader*, 2u> shaders = { &m_colouredShader, &m_texturedShader };
+        for (auto i = 0u; i < shaders.size(); ++i)
+        {
+            glCheck(glBindVertexArray(m_vertexArena.vao[i]));
+            glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vertexArena.vbo));
+            applyArenaAttributes(*shaders[i]);
+        }
+        glCheck(glBindVertexArray(0));
+#endif
+    }
+
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vertexArena.vbo));
+
+    if (vertices.size() > m_vertexArena.capacity)
+    {
+        m_vertexArena.capacity = std::max(vertices.size() * 2, MinArenaSize);
+        glCheck(glBufferData(GL_ARRAY_BUFFER, m_vertexArena.capacity * Vertex2D::Size, nullptr, GL_STREAM_DRAW));
+        m_vertexArena.offset = 0;
+    }
+    else if (m_vertexArena.offset + vertices.size() > m_vertexArena.capacity)
+    {
+        //orphan the existing storage rather than stalling
+        //until any pending draws from it have completed
+        glCheck(glBufferData(GL_ARRAY_BUFFER, m_vertexArena.capacity * Vertex2D::Size, nullptr, GL_STREAM_DRAW));
+        m_vertexArena.offset = 0;
+    }
+
+    const auto byteOffset = static_cast<GLintptr>(m_vertexArena.offset * Vertex2D::Size);
+    const auto byteCount = static_cast<GLsizeiptr>(vertices.size() * Vertex2D::Size);
+
+#ifdef PLATFORM_DESKTOP
+    //the range written is never in use by a previous draw, so
+    //there's no need to synchronise with the GPU
+    void* dst = nullptr;
+    glCheck(dst = glMapBufferRange(GL_ARRAY_BUFFER, byteOffset, byteCount,
+                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+    if (dst)
+    {
+        std::memcpy(dst, vertices.data(), byteCount);
+        glCheck(glUnmapBuffer(GL_ARRAY_BUFFER));
+    }
+    else
+    {
+        glCheck(glBufferSubData(GL_ARRAY_BUFFER, byteOffset, byteCount, vertices.data()));
+    }
+#else
+    glCheck(glBufferSubData(GL_ARRAY_BUFFER, byteOffset, byteCount, vertices.data()));
+#endif
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+
+    auto retVal = m_vertexArena.offset;
+    m_vertexArena.offset += vertices.size();
+    return retVal;
+}
+
+void RenderSystem2D::applyArenaAttributes(const Shader& shader)
+{
+    //these are fixed properties of Vertex2D, see Drawable2D::applyShader()
+    const auto& attribs = shader.getAttribMap();
+    const std::array<std::array<std::int32_t, 3u>, 3u> layout =
+    {{
+        { attribs[Mesh::Attribute::Position], 2, 0 },
+        { attribs[Mesh::Attribute::UV0], 2, 2 * sizeof(float) },
+        { attribs[Mesh::Attribute::Colour], 4, 4 * sizeof(float) }
+    }};
+
+    for (const auto& [id, size, offset] : layout)
+    {
+        if (id != -1)
+        {
+            glCheck(glEnableVertexAttribArray(id));
+            glCheck(glVertexAttribPointer(id, size,
+                GL_FLOAT, GL_FALSE, static_cast<GLsizei>(Vertex2D::Size),
+                reinterpret_cast<void*>(static_cast<intptr_t>(offset))));
+        }
+    }
+}
+
+void RenderSystem2D::drawEntity(Entity entity, const Camera::Pass& pass, IntRect viewport, glm::uvec2 targetSize, std::uint32_t& lastProgram)
+{
+    const auto& drawable = entity.getComponent<Drawable2D>();
+    const auto& tx = entity.getComponent<cro::Transform>();
+    glm::mat4 worldMat = tx.getWorldTransform();
+
+    if (//TODO surely these ought to be culling criteria?
+        drawable.m_shader && !drawable.m_updateBufferData)
+    {
+        //apply shader
+        auto program = drawable.m_shader->getGLHandle();
+        if (program != lastProgram)
+        {
+            glCheck(glUseProgram(program));
+            lastProgram = program;
+        }
+        //glCheck(glUniformMatrix4fv(drawable.m_worldUniform, 1, GL_FALSE, &(worldMat[0].x)));
+        glCheck(glUniformMatrix4fv(drawable.m_viewProjectionUniform, 1, GL_FALSE, glm::value_ptr(pass.viewProjectionMatrix)));
+        glCheck(glUniformMatrix4fv(drawable.m_worldUniform, 1, GL_FALSE, glm::value_ptr(worldMat)));
+
+        //apply texture if active
+        if (drawable.m_textureInfo.textureID.textureID)
+        {
+            glCheck(glActiveTexture(GL_TEXTURE0));
+            glCheck(glBindTexture(GL_TEXTURE_2D, drawable.m_textureInfo.textureID.textureID));
+            glCheck(glUniform1i(drawable.m_textureUniform, 0));
+        }
+
+        //apply any custom uniforms
+        std::int32_t j = 1;
+        for (const auto& [uniform, value] : drawable.m_textureIDBindings)
+        {
+            glCheck(glActiveTexture(GL_TEXTURE0 + j));
+            glCheck(glBindTexture(GL_TEXTURE_2D, value));
+            glCheck(glUniform1i(uniform, j));
+            j++;
+        }
+        for (auto [uniform, value] : drawable.m_floatBindings)
+        {
+            glCheck(glUniform1f(uniform, value));
+        }
+        for (auto [uniform, value] : drawable.m_vec2Bindings)
+        {
+            glCheck(glUniform2f(uniform, value.x, value.y));
+        }
+        for (auto [uniform, value] : drawable.m_vec3Bindings)
+        {
+            glCheck(glUniform3f(uniform, value.x, value.y, value.z));
+        }
+        for (auto [uniform, value] : drawable.m_vec4Bindings)
+        {
+            glCheck(glUniform4f(uniform, value.r, value.g, value.b, value.a));
+        }
+        for (auto [uniform, value] : drawable.m_boolBindings)
+        {
+            glCheck(glUniform1i(uniform, value));
+        }
+        for (const auto& [uniform, value] : drawable.m_matBindings)
+        {
+            glCheck(glUniformMatrix4fv(uniform, 1, GL_FALSE, value));
+        }
+
+        applyBlendMode(drawable.m_blendMode);
+
+        auto scissor = getScissor(drawable, pass.viewProjectionMatrix, viewport, targetSize);
+        glCheck(glScissor(scissor.left, scissor.bottom, scissor.width, scissor.height));
+
+        glCheck(glFrontFace(drawable.m_facing));
+
+#ifdef PLATFORM_DESKTOP
+        glCheck(glBindVertexArray(drawable.m_vao));
+        glCheck(glDrawArrays(static_cast<GLenum>(drawable.m_primitiveType), 0, static_cast<GLsizei>(drawable.m_vertices.size())));
+
+#else //GLES 2 doesn't have VAO support without extensions
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, drawable.m_vbo));
+
+        //bind attribs
+        //const auto& attribs = drawable.m_vertexAttribs;
+        for (const auto& [id, size, offset] : drawable.m_vertexAttributes)
+        {
+            glCheck(glEnableVertexAttribArray(id));
+            glCheck(glVertexAttribPointer(id, size,
+                GL_FLOAT, GL_FALSE, static_cast<GLsizei>(Vertex2D::Size),
+                reinterpret_cast<void*>(static_cast<intptr_t>(offset))));
+        }
+
+        //draw array
+        glCheck(glDrawArrays(static_cast<GLenum>(drawable.m_primitiveType), 0, drawable.m_vertices.size()));
+
+        //and unbind... this could be saved by only changing when switching shader
+        for (const auto& attrib : drawable.m_vertexAttributes)
+        {
+            glCheck(glDisableVertexAttribArray(attrib.id));
+        }
+
+#endif //PLATFORM 
+
+        m_renderStats.drawables++;
+        m_renderStats.drawCalls++;
+    }
+}
+
 void RenderSystem2D::onEntityAdded(Entity entity)
 {
     //create the VBO (VAO is applied when shader is set)
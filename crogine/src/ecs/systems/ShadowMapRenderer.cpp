@@ -64,6 +64,7 @@ ShadowMapRenderer::ShadowMapRenderer(cro::MessageBus& mb)
     requireComponent<cro::Model>();
     requireComponent<cro::Transform>();
     requireComponent<cro::ShadowCaster>();
+    ignoreMessages();
 }
 
 //public
@@ -120,16 +121,22 @@ void ShadowMapRenderer::updateDrawList(Entity camEnt)
             m_drawLists.emplace_back();
         }
 
+        //resizing keeps the existing arenas so their memory is reused
         auto& drawList = m_drawLists[m_activeCameras.size()];
-        drawList.clear();
         drawList.resize(camera.getCascadeCount());
+        for (auto& cascade : drawList)
+        {
+            cascade.clear();
+        }
 
         m_activeCameras.push_back(camEnt);
 
 
         //store the results here to use in frustum culling
-        std::vector<glm::vec3> lightPositions;
-        std::vector<Box> frustums;
+        auto& lightPositions = m_lightPositions;
+        auto& frustums = m_cascadeFrustums;
+        lightPositions.clear();
+        frustums.clear();
 #ifdef CRO_DEBUG_
         camera.lightCorners.clear();
 #endif
@@ -188,7 +195,18 @@ void ShadowMapRenderer::updateDrawList(Entity camEnt)
             camera.m_shadowProjectionMatrices[i] = lightProj;
             camera.m_shadowViewProjectionMatrices[i] = lightProj * lightView;
 
-            frustums.emplace_back(minPos, maxPos);
+            //the planes of the light space AABB, moved into world space
+            //so that the casters can be culled without transforming them
+            const auto toWorld = glm::transpose(lightView);
+            frustums.emplace_back() =
+            {
+                toWorld * Plane(1.f, 0.f, 0.f, -minPos.x),
+                toWorld * Plane(-1.f, 0.f, 0.f, maxPos.x),
+                toWorld * Plane(0.f, 1.f, 0.f, -minPos.y),
+                toWorld * Plane(0.f, -1.f, 0.f, maxPos.y),
+                toWorld * Plane(0.f, 0.f, 1.f, -minPos.z),
+                toWorld * Plane(0.f, 0.f, -1.f, maxPos.z)
+            };
 #ifdef CRO_DEBUG_
             camera.lightCorners.emplace_back() =
             {
@@ -211,6 +229,9 @@ void ShadowMapRenderer::updateDrawList(Entity camEnt)
 #endif
 
         //use depth frusta to cull entities
+        m_cullBatch.clear();
+        m_cullEntities.clear();
+
         auto& entities = getEntities();
         for (auto& entity : entities)
         {
@@ -244,23 +265,24 @@ void ShadowMapRenderer::updateDrawList(Entity camEnt)
 
             sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f);
 
-            std::vector<std::pair<std::size_t, std::size_t>> drawListOffsets;
+            m_cullBatch.push_back(sphere);
+            m_cullEntities.push_back(entity);
+        }
 
-            for (auto i = 0u; i < camera.getCascadeCount(); ++i)
+        for (auto i = 0u; i < camera.getCascadeCount(); ++i)
+        {
+            Spatial::intersects(frustums[i], m_cullBatch, m_cullResults);
+            for (auto j = 0u; j < m_cullEntities.size(); ++j)
             {
-                float distance = glm::dot(-lightDir, sphere.centre - lightPositions[i]);
-
-                //put sphere into lightspace and do an AABB test on the ortho projection
-                auto lightSphere = sphere;
-                lightSphere.centre = glm::vec3(camera.m_shadowViewMatrices[i] * glm::vec4(lightSphere.centre, 1.f));
-                
-                if (frustums[i].intersects(lightSphere))
+                if (Spatial::isVisible(m_cullResults, j))
                 {
+                    const glm::vec3 centre(m_cullBatch.x[j], m_cullBatch.y[j], m_cullBatch.z[j]);
+                    float distance = glm::dot(-lightDir, centre - lightPositions[i]);
 #ifdef PLATFORM_DESKTOP
-                    drawList[i].emplace_back(entity, distance);
+                    drawList[i].emplace_back(m_cullEntities[j], distance);
 #else
                     //just place them all in the same draw list
-                    drawList[0].emplace_back(entity, distance);
+                    drawList[0].emplace_back(m_cullEntities[j], distance);
 #endif
 #ifdef CRO_DEBUG_
                     visibleCount++;
@@ -282,11 +304,25 @@ void ShadowMapRenderer::updateDrawList(Entity camEnt)
 #ifdef CRO_DEBUG_
         //some objects might appear in multiple cascades
         DPRINT("Rendered 3D shadow ents", std::to_string(visibleCount));
-        camera.lightPositions.swap(lightPositions);
+        camera.lightPositions = lightPositions;
 #endif
     }
 }
 
+DrawListStats ShadowMapRenderer::getDrawListStats() const
+{
+    DrawListStats stats;
+    for (const auto& drawList : m_drawLists)
+    {
+        for (const auto& cascade : drawList)
+        {
+            stats.allocations += cascade.getAllocationCount();
+            stats.reservedBytes += cascade.getReservedBytes();
+        }
+    }
+    return stats;
+}
+
 //private
 void ShadowMapRenderer::render()
 {
@@ -391,7 +427,8 @@ void ShadowMapRenderer::render()
                     {
                         glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
                         glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
-                            GL_FLOAT, GL_FALSE, static_cast<GLsizei>(model.m_meshData.vertexSize),
+                            static_cast<GLenum>(attribs[j][Material::Data::Type]), static_cast<GLboolean>(attribs[j][Material::Data::Normalised]),
+                            static_cast<GLsizei>(Mesh::getVertexStride(model.m_meshData)),
                             reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
                     }
 
@@ -63,13 +63,22 @@ namespace
     }
 
     float playbackRate = 1.f;
+
+    //fewer skeletons than this per batch aren't worth the overhead of a thread
+    constexpr std::size_t MinBatchSize = 16;
 }
 
 SkeletalAnimator::SkeletalAnimator(MessageBus& mb)
-    : System(mb, typeid(SkeletalAnimator))
+    : System        (mb, typeid(SkeletalAnimator)),
+    m_multithreaded (true)
 {
     requireComponent<Model>();
     requireComponent<Skeleton>();
+
+    //attachments write to the Transform of other entities
+    declareWrite<Model>();
+    declareWrite<Skeleton>();
+    declareWrite<Transform>();
 }
 
 //public
@@ -80,74 +89,105 @@ void SkeletalAnimator::process(float dt)
     const auto camPos = getScene()->getActiveCamera().getComponent<cro::Transform>().getWorldPosition();
     const auto camDir = cro::Util::Matrix::getForwardVector(getScene()->getActiveCamera().getComponent<cro::Transform>().getWorldTransform());
 
-    //TODO we might increase perf a bit if we split the entities across
-    //a series of joblists each in its own thread, then wait for those lists to complete
-    //gotta try it to find out. I have a feeling it'll actually be worse on low numbers
-    //also remember raising messages is not thread safe so might have to do all those
-    //on the main thread anyway...
-
     auto& entities = getEntities();
-    for (auto& entity : entities)
-    {      
-        auto& skel = entity.getComponent<Skeleton>();
+    m_contexts.resize(entities.size());
 
-        //check the model is roughly in front of the camera and within interp distance
-        auto direction = entity.getComponent<cro::Transform>().getWorldPosition() - camPos;
-        bool useInterpolation = (glm::dot(direction, camDir) > 0 //could squeeze a bit more out of this if we take FOV into account...
-            && glm::length2(direction) < skel.m_interpolationDistance
-            && skel.m_useInterpolation);
+    buildUpdateOrder();
 
-        const AnimationContext ctx = 
+    //skeletons are updated one level at a time, so that any skeleton
+    //attached to another is evaluated with its parent's current pose
+    std::size_t levelStart = 0;
+    for (auto levelEnd : m_levelEnds)
+    {
+        //world transforms are lazily evaluated so make sure to fetch
+        //them here rather than from multiple threads at once. This also
+        //picks up any attachment transforms set by the previous level
+        for (auto j = levelStart; j < levelEnd; ++j)
         {
-            useInterpolation,
-            entity.getComponent<cro::Transform>().getWorldTransform(),
-            dt,
-            skel.m_nextAnimation < 0
-        };
+            const auto i = m_updateOrder[j];
+            const auto& skel = entities[i].getComponent<Skeleton>();
+            const auto& tx = entities[i].getComponent<cro::Transform>();
 
+            //check the model is roughly in front of the camera and within interp distance
+            auto direction = tx.getWorldPosition() - camPos;
+            bool useInterpolation = (glm::dot(direction, camDir) > 0 //could squeeze a bit more out of this if we take FOV into account...
+                && glm::length2(direction) < skel.m_interpolationDistance
+                && skel.m_useInterpolation);
 
-        //update current animation
-        updateAnimation(skel.m_animations[skel.m_currentAnimation], skel, entity, ctx);
+            m_contexts[i] =
+            {
+                useInterpolation,
+                tx.getWorldTransform(),
+                dt,
+                skel.m_nextAnimation < 0
+            };
+        }
 
-        //if we have a new animation start updating it and blend its output
-        //with the current anim according to blend time
-        if (skel.m_nextAnimation > -1)
+        //split the level into batches, each of which
+        //is updated on its own thread if there are enough
+        const auto levelSize = levelEnd - levelStart;
+        std::size_t batchCount = 1;
+        if (m_multithreaded
+            && levelSize >= MinBatchSize * 2)
         {
-            //update the next animation to start blending it in
-            updateAnimation(skel.m_animations[skel.m_nextAnimation], skel, entity, ctx);
+            batchCount = std::min(levelSize / MinBatchSize, ThreadPool::getShared().getThreadCount() + 1);
+        }
 
-            //blend to next animation
-            skel.m_currentBlendTime += dt;
-            if (!entity.getComponent<Model>().isHidden())
+        if (m_batches.size() < batchCount)
+        {
+            m_batches.resize(batchCount);
+        }
+
+        const auto batchSize = (levelSize + (batchCount - 1)) / batchCount;
+        if (batchCount == 1)
+        {
+            processBatch(m_batches[0], levelStart, levelEnd);
+        }
+        else
+        {
+            auto& threadPool = ThreadPool::getShared();
+            for (auto i = 0u; i < batchCount; ++i)
             {
-                //hmm if interpolation is disabled we probably only want to blend once
-                //per frame at the current framerate - although blend times are so short
-                //in most cases it's probably not worth the effort
-                float interpTime = std::min(1.f, skel.m_currentBlendTime / skel.m_blendTime);
-                blendAnimations(skel.m_animations[skel.m_currentAnimation], skel.m_animations[skel.m_nextAnimation], interpTime, skel);
+                const auto start = levelStart + (i * batchSize);
+                const auto end = std::min(start + batchSize, levelEnd);
+                threadPool.push([&, i, start, end]()
+                    {
+                        processBatch(m_batches[i], start, end);
+                    }, m_jobGroup);
             }
+            threadPool.wait(m_jobGroup);
+        }
 
-            if (skel.m_currentBlendTime > skel.m_blendTime)
+        //posting messages isn't thread safe so raise any events
+        //here, batches are in update order so the output is the
+        //same as if we'd updated everything on one thread
+        for (auto i = 0u; i < batchCount; ++i)
+        {
+            for (const auto& evt : m_batches[i].events)
             {
-                //update to current animation to next animation
-                skel.m_animations[skel.m_currentAnimation].playbackRate = 0.f;
-                skel.m_currentAnimation = skel.m_nextAnimation;
-
-                skel.m_nextAnimation = -1;
-                skel.m_currentBlendTime = 0.f;
+                *postMessage<Message::SkeletalAnimationEvent>(Message::SkeletalAnimationMessage) = evt;
             }
+            m_batches[i].events.clear();
         }
 
-        //update the position of attachments.
+        //update the position of attachments. These may belong to any entity
+        //so are done here to make sure only one thread modifies a Transform.
         //TODO only do this if the frame was updated (? won't account for entity transform changing though)
-        for (auto i = 0u; i < skel.m_attachments.size(); ++i)
+        for (auto j = levelStart; j < levelEnd; ++j)
         {
-            auto& ap = skel.m_attachments[i];
-            if (ap.getModel().isValid())
+            const auto i = m_updateOrder[j];
+            auto& skel = entities[i].getComponent<Skeleton>();
+            for (auto k = 0u; k < skel.m_attachments.size(); ++k)
             {
-                ap.getModel().getComponent<cro::Transform>().m_attachmentTransform = ctx.worldTransform * skel.getAttachmentTransform(i);
+                auto& ap = skel.m_attachments[k];
+                if (ap.getModel().isValid())
+                {
+                    ap.getModel().getComponent<cro::Transform>().setAttachmentTransform(m_contexts[i].worldTransform * skel.getAttachmentTransform(k));
+                }
             }
         }
+
+        levelStart = levelEnd;
     }
 }
 
@@ -201,6 +241,50 @@ float SkeletalAnimator::getPlaybackRate() const
 }
 
 //private
+void SkeletalAnimator::processBatch(Batch& batch, std::size_t start, std::size_t end)
+{
+    const auto& entities = getEntities();
+    for (auto j = start; j < end; ++j)
+    {
+        const auto i = m_updateOrder[j];
+        auto entity = entities[i];
+        auto& skel = entity.getComponent<Skeleton>();
+        const auto& ctx = m_contexts[i];
+
+        //update current animation
+        updateAnimation(skel.m_animations[skel.m_currentAnimation], skel, entity, ctx, batch);
+
+        //if we have a new animation start updating it and blend its output
+        //with the current anim according to blend time
+        if (skel.m_nextAnimation > -1)
+        {
+            //update the next animation to start blending it in
+            updateAnimation(skel.m_animations[skel.m_nextAnimation], skel, entity, ctx, batch);
+
+            //blend to next animation
+            skel.m_currentBlendTime += ctx.dt;
+            if (!entity.getComponent<Model>().isHidden())
+            {
+                //hmm if interpolation is disabled we probably only want to blend once
+                //per frame at the current framerate - although blend times are so short
+                //in most cases it's probably not worth the effort
+                float interpTime = std::min(1.f, skel.m_currentBlendTime / skel.m_blendTime);
+                blendAnimations(skel.m_animations[skel.m_currentAnimation], skel.m_animations[skel.m_nextAnimation], interpTime, skel, batch.mixBuffer);
+            }
+
+            if (skel.m_currentBlendTime > skel.m_blendTime)
+            {
+                //update to current animation to next animation
+                skel.m_animations[skel.m_currentAnimation].playbackRate = 0.f;
+                skel.m_currentAnimation = skel.m_nextAnimation;
+
+                skel.m_nextAnimation = -1;
+                skel.m_currentBlendTime = 0.f;
+            }
+        }
+    }
+}
+
 void SkeletalAnimator::onEntityAdded(Entity entity)
 {
     auto& skeleton = entity.getComponent<Skeleton>();
@@ -214,7 +298,7 @@ void SkeletalAnimator::onEntityAdded(Entity entity)
 
     if (skeleton.m_invBindPose.empty())
     {
-        skeleton.m_invBindPose.resize(skeleton.m_frameSize);
+        skeleton.setInverseBindPose(std::vector<glm::mat4>(skeleton.m_frameSize, glm::mat4(1.f)));
     }
 
     //update the bounds for each key frame
@@ -227,7 +311,106 @@ void SkeletalAnimator::onEntityAdded(Entity entity)
     entity.getComponent<Model>().getMeshData().boundingSphere = skeleton.m_keyFrameBounds[0];
 }
 
-void SkeletalAnimator::updateAnimation(SkeletalAnim& anim, Skeleton& skel, Entity entity, const AnimationContext& ctx) const
+void SkeletalAnimator::buildUpdateOrder()
+{
+    const auto& entities = getEntities();
+
+    m_updateOrder.resize(entities.size());
+    m_levelEnds.clear();
+
+    //most scenes have no skeletons attached to other skeletons
+    //so skip the sort and update everything as a single level
+    bool hasDependencies = false;
+    for (auto entity : entities)
+    {
+        for (const auto& ap : entity.getComponent<Skeleton>().m_attachments)
+        {
+            if (ap.getModel().isValid()
+                && ap.getModel().hasComponent<Skeleton>())
+            {
+                hasDependencies = true;
+                break;
+            }
+        }
+
+        if (hasDependencies)
+        {
+            break;
+        }
+    }
+
+    if (!hasDependencies)
+    {
+        for (auto i = 0u; i < entities.size(); ++i)
+        {
+            m_updateOrder[i] = i;
+        }
+        m_levelEnds.push_back(entities.size());
+        return;
+    }
+
+    m_entityIndices.clear();
+    for (auto i = 0u; i < entities.size(); ++i)
+    {
+        m_entityIndices.insert(std::make_pair(entities[i].getIndex(), i));
+    }
+
+    //the level of a skeleton is one more than that of the skeleton it's
+    //attached to. No chain can be longer than the number of entities, so
+    //capping the level there stops circular attachments looping forever.
+    m_depths.assign(entities.size(), 0);
+    std::size_t maxDepth = 0;
+    for (auto pass = 0u; pass < entities.size(); ++pass)
+    {
+        bool changed = false;
+        for (auto i = 0u; i < entities.size(); ++i)
+        {
+            for (const auto& ap : entities[i].getComponent<Skeleton>().m_attachments)
+            {
+                if (ap.getModel().isValid())
+                {
+                    if (auto result = m_entityIndices.find(ap.getModel().getIndex()); result != m_entityIndices.end()
+                        && m_depths[result->second] < m_depths[i] + 1
+                        && m_depths[i] + 1 < entities.size())
+                    {
+                        m_depths[result->second] = m_depths[i] + 1;
+                        maxDepth = std::max(maxDepth, m_depths[result->second]);
+                        changed = true;
+                    }
+                }
+            }
+        }
+
+        if (!changed)
+        {
+            break;
+        }
+    }
+
+    //counting sort keeps entity order within each level
+    m_levelEnds.resize(maxDepth + 1, 0);
+    for (auto depth : m_depths)
+    {
+        m_levelEnds[depth]++;
+    }
+
+    std::size_t levelStart = 0;
+    for (auto& levelEnd : m_levelEnds)
+    {
+        const auto count = levelEnd;
+        levelEnd = levelStart;
+        levelStart += count;
+    }
+
+    //m_levelEnds currently holds the start of each level, so
+    //inserting advances each one to the end of its level
+    for (auto i = 0u; i < entities.size(); ++i)
+    {
+        m_updateOrder[m_levelEnds[m_depths[i]]++] = i;
+    }
+}
+
+void SkeletalAnimator::updateAnimation(SkeletalAnim& anim, Skeleton& skel, Entity entity, const AnimationContext& ctx, Batch& batch) const
 {
     anim.currentFrameTime += ctx.dt * anim.playbackRate;
 
@@ -262,10 +445,10 @@ void SkeletalAnimator::updateAnimation(SkeletalAnim& anim, Skeleton& skel, Entit
                 {
                     skel.stop();
 
-                    auto* msg = postMessage<Message::SkeletalAnimationEvent>(Message::SkeletalAnimationMessage);
-                    msg->userType = Message::SkeletalAnimationEvent::Stopped;
-                    msg->entity = entity;
-                    msg->animationID = skel.getCurrentAnimation();
+                    auto& msg = batch.events.emplace_back();
+                    msg.userType = Message::SkeletalAnimationEvent::Stopped;
+                    msg.entity = entity;
+                    msg.animationID = skel.getCurrentAnimation();
                 }
                 else
                 {
@@ -283,11 +466,11 @@ void SkeletalAnimator::updateAnimation(SkeletalAnim& anim, Skeleton& skel, Entit
                 (ctx.worldTransform * skel.m_rootTransform *
                     skel.m_frames[(anim.currentFrame * skel.m_frameSize) + joint].worldMatrix)[3];
 
-            auto* msg = postMessage<Message::SkeletalAnimationEvent>(Message::SkeletalAnimationMessage);
-            msg->position = position;
-            msg->userType = uid;
-            msg->entity = entity;
-            msg->animationID = skel.getCurrentAnimation();
+            auto& msg = batch.events.emplace_back();
+            msg.position = position;
+            msg.userType = uid;
+            msg.entity = entity;
+            msg.animationID = skel.getCurrentAnimation();
         }
     }
 
@@ -298,12 +481,12 @@ void SkeletalAnimator::updateAnimation(SkeletalAnim& anim, Skeleton& skel, Entit
         if (ctx.useInterpolation)
         {
             float interpTime = anim.currentFrameTime / anim.frameTime;
-            interpolateAnimation(anim, nextFrame, interpTime, skel, ctx.writeOutput);
+            interpolateAnimation(anim, nextFrame, interpTime, skel, ctx.writeOutput, batch.mixBuffer);
         }
     }
 }
 
-void SkeletalAnimator::interpolateAnimation(SkeletalAnim& source, std::size_t targetFrame, float time, Skeleton& skeleton, bool output) const
+void SkeletalAnimator::interpolateAnimation(SkeletalAnim& source, std::size_t targetFrame, float time, Skeleton& skeleton, bool output, std::vector<glm::mat4>& mixBuffer) const
 {
     //TODO interpolate hit boxes for key frames(?)
 
@@ -314,55 +497,50 @@ void SkeletalAnimator::interpolateAnimation(SkeletalAnim& source, std::size_t ta
     //stores interpolated output in source so we can use it to blend.
     //we mix all the joints first to prevent it happening multiple times
     //when we create the world transforms.
-    m_mixBuffer.resize(skeleton.m_frameSize);
+    mixBuffer.resize(skeleton.m_frameSize);
     for (auto i = 0u; i < skeleton.m_frameSize; ++i)
     {
-        m_mixBuffer[i] = mixJoint(skeleton.m_frames[startA + i], skeleton.m_frames[startB + i], time, source.interpolationOutput[i]);
+        mixBuffer[i] = mixJoint(skeleton.m_frames[startA + i], skeleton.m_frames[startB + i], time, source.interpolationOutput[i]);
     }
 
-    for (auto i = 0u; i < skeleton.m_frameSize; ++i)
+    //joints are visited parent first so each joint only
+    //needs to be multiplied by its parent's world transform
+    for (auto i : skeleton.m_jointOrder)
     {
-        glm::mat4 worldMatrix = m_mixBuffer[i];
-
-        std::int32_t parent = skeleton.m_frames[startA + i].parent;
-        while (parent != -1)
+        const auto parent = skeleton.m_frames[startA + i].parent;
+        if (parent != -1)
         {
-            worldMatrix = m_mixBuffer[parent] * worldMatrix;
-            parent = skeleton.m_frames[startA + parent].parent;
+            mixBuffer[i] = mixBuffer[parent] * mixBuffer[i];
         }
 
         //note this gets overwritten if blending animations - might be
         //useful to prevent it happening in those cases?
         if (output)
         {
-            skeleton.m_currentFrame[i] = skeleton.m_rootTransform * worldMatrix * skeleton.m_invBindPose[i];
+            skeleton.m_currentFrame[i] = skeleton.m_rootTransform * mixBuffer[i] * skeleton.m_invBindPose[i];
         }
-        
     }
 }
 
-void SkeletalAnimator::blendAnimations(const SkeletalAnim& a, const SkeletalAnim& b, float time, Skeleton& skeleton) const
+void SkeletalAnimator::blendAnimations(const SkeletalAnim& a, const SkeletalAnim& b, float time, Skeleton& skeleton, std::vector<glm::mat4>& mixBuffer) const
 {
     Joint temp; //we need something to pass as a func param
-    m_mixBuffer.resize(skeleton.m_frameSize);
+    mixBuffer.resize(skeleton.m_frameSize);
 
     for (auto i = 0u; i < skeleton.m_frameSize; ++i)
     {
-        m_mixBuffer[i] = mixJoint(a.interpolationOutput[i], b.interpolationOutput[i], time, temp);
+        mixBuffer[i] = mixJoint(a.interpolationOutput[i], b.interpolationOutput[i], time, temp);
     }
 
-    for (auto i = 0u; i < skeleton.m_frameSize; ++i)
+    for (auto i : skeleton.m_jointOrder)
     {
-        auto worldMat = m_mixBuffer[i];
-
-        auto parent = a.interpolationOutput[i].parent;
-        while (parent != -1)
+        const auto parent = a.interpolationOutput[i].parent;
+        if (parent != -1)
         {
-            worldMat = m_mixBuffer[parent] * worldMat;
-            parent = a.interpolationOutput[parent].parent;
+            mixBuffer[i] = mixBuffer[parent] * mixBuffer[i];
         }
 
-        skeleton.m_currentFrame[i] = skeleton.m_rootTransform * worldMat * skeleton.m_invBindPose[i];
+        skeleton.m_currentFrame[i] = skeleton.m_rootTransform * mixBuffer[i] * skeleton.m_invBindPose[i];
     }
 }
 
@@ -370,9 +548,11 @@ void SkeletalAnimator::updateBoundsFromCurrentFrame(Skeleton& dest, const Mesh::
 {
     //store these in case we want to update the bounds
     std::vector<glm::vec3> positions;
+    positions.reserve(dest.m_frameSize);
     for (auto i = 0u; i < dest.m_frameSize; ++i)
     {
-        positions.push_back(glm::vec3(dest.m_currentFrame[i] * glm::inverse(dest.m_invBindPose[i]) * glm::vec4(0.f, 0.f, 0.f, 1.f)));
+        //bind pose is cached when the inverse bind pose is set
+        positions.emplace_back((dest.m_currentFrame[i] * dest.m_bindPose[i])[3]);
     }
 
     if (!positions.empty())
@@ -46,6 +46,10 @@ SpriteAnimator::SpriteAnimator(MessageBus& mb)
 {
     requireComponent<Sprite>();
     requireComponent<SpriteAnimation>();
+    ignoreMessages();
+
+    declareWrite<Sprite>();
+    declareWrite<SpriteAnimation>();
 
     m_animationEvents.reserve(MaxEvents);
 }
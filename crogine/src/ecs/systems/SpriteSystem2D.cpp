@@ -39,6 +39,10 @@ SpriteSystem2D::SpriteSystem2D(MessageBus& mb)
 {
     requireComponent<Sprite>();
     requireComponent<Drawable2D>();
+    ignoreMessages();
+
+    declareWrite<Sprite>();
+    declareWrite<Drawable2D>();
 }
 
 //public
@@ -49,6 +49,7 @@ SpriteSystem3D::SpriteSystem3D(MessageBus& mb, float pixelsPerUnit)
     CRO_ASSERT(pixelsPerUnit > 0, "Must be positive value");
     requireComponent<Sprite>();
     requireComponent<Model>();
+    ignoreMessages();
 
     m_colouredShader.loadFromString(Shaders::Sprite::Vertex, Shaders::Sprite::Coloured);
     m_texturedShader.loadFromString(Shaders::Sprite::Vertex, Shaders::Sprite::Textured, "#define TEXTURED\n");
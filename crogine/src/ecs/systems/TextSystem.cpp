@@ -34,6 +34,7 @@ source distribution.
 #include <crogine/graphics/Font.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../../graphics/shaders/Sprite.hpp"
 
 using namespace cro;
 
@@ -43,6 +44,9 @@ TextSystem::TextSystem(MessageBus& mb)
     requireComponent<Drawable2D>();
     requireComponent<Text>();
     requireComponent<Transform>();
+    ignoreMessages();
+
+    m_sdfShader.loadFromString(Shaders::Sprite::Vertex, Shaders::Text::SDFFragment, "#define TEXTURED\n");
 }
 
 void TextSystem::process(float)
@@ -96,6 +100,21 @@ void TextSystem::process(float)
             {
                 text.updateVertices(drawable);
                 drawable.setPrimitiveType(GL_TRIANGLES);
+
+                //swap to the distance field shader if the font requires
+                //it, without replacing any shader set by the user
+                if (text.getFont()->isSDF())
+                {
+                    if (!drawable.m_customShader)
+                    {
+                        drawable.setShader(&m_sdfShader);
+                    }
+                }
+                else if (drawable.m_shader == &m_sdfShader)
+                {
+                    drawable.setShader(nullptr);
+                }
+
                 m_readPages.push_back({ text.getFont(), text.getCharacterSize() }); //font needs its pages marked as read
 
                 //do this last as updateVertices() might set this flag (and would then be reset, below)
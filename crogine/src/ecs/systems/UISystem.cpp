@@ -66,6 +66,10 @@ UISystem::UISystem(MessageBus& mb)
 {
     requireComponent<UIInput>();
     requireComponent<Transform>();
+    subscribe(Message::WindowMessage);
+
+    //button callbacks may access any component, so no access
+    //is declared and the system is always processed on its own
 
     //default callback for components which don't have one assigned
     m_buttonCallbacks.push_back([](Entity, ButtonEvent) {});
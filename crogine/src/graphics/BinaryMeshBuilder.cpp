@@ -33,6 +33,7 @@ source distribution.
 #include <crogine/core/FileSystem.hpp>
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/CompactVertex.hpp"
 
 using namespace cro;
 
@@ -113,6 +114,8 @@ Mesh::Data BinaryMeshBuilder::build() const
             std::vector<float> tempVerts;
             std::vector<std::uint32_t> sizes(meshHeader.indexArrayCount);
             std::vector<std::vector<std::uint32_t>> indexData(meshHeader.indexArrayCount);
+            std::vector<std::vector<std::uint16_t>> compactIndexData(meshHeader.indexArrayCount);
+            const auto encoding = header.version > 2 ? header.vertexEncoding : 0;
 
             SDL_RWread(file.file, sizes.data(), meshHeader.indexArrayCount * sizeof(std::uint32_t), 1);
 
@@ -159,14 +162,26 @@ Mesh::Data BinaryMeshBuilder::build() const
 
             auto pos = SDL_RWtell(file.file);
             auto vertSize = meshHeader.indexArrayOffset - pos;
-            tempVerts.resize(vertSize / sizeof(float));
-            SDL_RWread(file.file, tempVerts.data(), vertSize, 1);
+            if (!Detail::CompactVertex::read(file.file, vertSize, meshHeader.flags, encoding, tempVerts))
+            {
+                LogE << m_path << ": failed reading vertex data" << std::endl;
+                return {};
+            }
             CRO_ASSERT(tempVerts.size() % vertStride == 0, "");
             
+            //16 bit indices are uploaded as they are, halving the size of the index buffers
             for (auto i = 0u; i < meshHeader.indexArrayCount; ++i)
             {
-                indexData[i].resize(sizes[i]);
-                SDL_RWread(file.file, indexData[i].data(), sizes[i] * sizeof(std::uint32_t), 1);
+                if (encoding & Detail::ModelBinary::CompactIndices)
+                {
+                    compactIndexData[i].resize(sizes[i]);
+                    SDL_RWread(file.file, compactIndexData[i].data(), sizes[i] * sizeof(std::uint16_t), 1);
+                }
+                else
+                {
+                    indexData[i].resize(sizes[i]);
+                    SDL_RWread(file.file, indexData[i].data(), sizes[i] * sizeof(std::uint32_t), 1);
+                }
             }
 
             //process vertex data
@@ -262,16 +277,40 @@ Mesh::Data BinaryMeshBuilder::build() const
             meshData.primitiveType = GL_TRIANGLES;
             meshData.vertexSize = getVertexSize(meshData.attributes);
             meshData.vertexCount = vertData.size() / (meshData.vertexSize / sizeof(float));
-            createVBO(meshData, vertData);
+
+            //compact attributes are kept packed on the GPU, halving the size of the VBO
+            if (encoding & ~Detail::ModelBinary::CompactIndices)
+            {
+                Detail::CompactVertex::setPackedFormat(meshData, encoding);
+            }
+
+            if (meshData.packedVertexSize != 0)
+            {
+                std::vector<std::uint8_t> packedData;
+                Detail::CompactVertex::pack(vertData, meshData, packedData);
+                createVBO(meshData, packedData);
+            }
+            else
+            {
+                createVBO(meshData, vertData);
+            }
 
             meshData.submeshCount = meshHeader.indexArrayCount;
             for (auto i = 0u; i < meshData.submeshCount; ++i)
             {
-                meshData.indexData[i].format = GL_UNSIGNED_INT;
                 meshData.indexData[i].primitiveType = meshData.primitiveType;
-                meshData.indexData[i].indexCount = static_cast<std::uint32_t>(indexData[i].size());
+                meshData.indexData[i].indexCount = sizes[i];
 
-                createIBO(meshData, indexData[i].data(), i, sizeof(std::uint32_t));
+                if (encoding & Detail::ModelBinary::CompactIndices)
+                {
+                    meshData.indexData[i].format = GL_UNSIGNED_SHORT;
+                    createIBO(meshData, compactIndexData[i].data(), i, sizeof(std::uint16_t));
+                }
+                else
+                {
+                    meshData.indexData[i].format = GL_UNSIGNED_INT;
+                    createIBO(meshData, indexData[i].data(), i, sizeof(std::uint32_t));
+                }
             }
 
             //boundingbox / sphere
@@ -0,0 +1,701 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include <crogine/graphics/CompressedImage.hpp>
+#include <crogine/core/FileSystem.hpp>
+#include <crogine/core/Log.hpp>
+#include <crogine/detail/Assert.hpp>
+#include <crogine/detail/Types.hpp>
+
+#include "../detail/BlockDecoder.hpp"
+
+#include <SDL_rwops.h>
+
+#include <array>
+#include <cstring>
+#include <algorithm>
+
+using namespace cro;
+
+namespace
+{
+    constexpr std::array<std::uint8_t, 12> KTX2Identifier = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+    constexpr std::size_t KTX2HeaderSize = 80;
+    constexpr std::size_t KTX2LevelSize = 24;
+
+    constexpr std::uint32_t DDSMagic = 0x20534444;
+    constexpr std::size_t DDSHeaderSize = 128; //including magic
+    constexpr std::size_t DDSDX10HeaderSize = 20;
+
+    //the largest texture most GL 4.1 drivers accept. Files may be parsed
+    //on a worker thread without a context, so it can't be queried here
+    constexpr std::uint32_t MaxImageSize = 16384;
+
+    constexpr std::uint32_t makeFourCC(char a, char b, char c, char d)
+    {
+        return static_cast<std::uint32_t>(a) | (static_cast<std::uint32_t>(b) << 8)
+            | (static_cast<std::uint32_t>(c) << 16) | (static_cast<std::uint32_t>(d) << 24);
+    }
+
+    //both containers are little endian
+    template <typename T>
+    T read(const std::uint8_t* data)
+    {
+        T retVal;
+        std::memcpy(&retVal, data, sizeof(T));
+        return retVal;
+    }
+
+    CompressedImage::Format fromVkFormat(std::uint32_t format)
+    {
+        switch (format)
+        {
+        default: return CompressedImage::Format::None;
+        case 131: //VK_FORMAT_BC1_RGB_UNORM_BLOCK
+        case 132:
+        case 133: //VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+        case 134:
+            return CompressedImage::Format::BC1;
+        case 135: //VK_FORMAT_BC2_UNORM_BLOCK
+        case 136:
+            return CompressedImage::Format::BC2;
+        case 137: //VK_FORMAT_BC3_UNORM_BLOCK
+        case 138:
+            return CompressedImage::Format::BC3;
+        case 139: //VK_FORMAT_BC4_UNORM_BLOCK
+            return CompressedImage::Format::BC4;
+        case 141: //VK_FORMAT_BC5_UNORM_BLOCK
+            return CompressedImage::Format::BC5;
+        case 145: //VK_FORMAT_BC7_UNORM_BLOCK
+        case 146:
+            return CompressedImage::Format::BC7;
+        case 147: //VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+        case 148:
+            return CompressedImage::Format::ETC2_RGB;
+        case 151: //VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+        case 152:
+            return CompressedImage::Format::ETC2_RGBA;
+        }
+    }
+
+    CompressedImage::Format fromDXGIFormat(std::uint32_t format)
+    {
+        switch (format)
+        {
+        default: return CompressedImage::Format::None;
+        case 71: //DXGI_FORMAT_BC1_UNORM
+        case 72:
+            return CompressedImage::Format::BC1;
+        case 74: //DXGI_FORMAT_BC2_UNORM
+        case 75:
+            return CompressedImage::Format::BC2;
+        case 77: //DXGI_FORMAT_BC3_UNORM
+        case 78:
+            return CompressedImage::Format::BC3;
+        case 80: //DXGI_FORMAT_BC4_UNORM
+            return CompressedImage::Format::BC4;
+        case 83: //DXGI_FORMAT_BC5_UNORM
+            return CompressedImage::Format::BC5;
+        case 98: //DXGI_FORMAT_BC7_UNORM
+        case 99:
+            return CompressedImage::Format::BC7;
+        }
+    }
+
+    CompressedImage::Format fromFourCC(std::uint32_t fourCC)
+    {
+        switch (fourCC)
+        {
+        default: return CompressedImage::Format::None;
+        case makeFourCC('D', 'X', 'T', '1'):
+            return CompressedImage::Format::BC1;
+        case makeFourCC('D', 'X', 'T', '2'):
+        case makeFourCC('D', 'X', 'T', '3'):
+            return CompressedImage::Format::BC2;
+        case makeFourCC('D', 'X', 'T', '4'):
+        case makeFourCC('D', 'X', 'T', '5'):
+            return CompressedImage::Format::BC3;
+        case makeFourCC('A', 'T', 'I', '1'):
+        case makeFourCC('B', 'C', '4', 'U'):
+            return CompressedImage::Format::BC4;
+        case makeFourCC('A', 'T', 'I', '2'):
+        case makeFourCC('B', 'C', '5', 'U'):
+            return CompressedImage::Format::BC5;
+        }
+    }
+
+    //a full mip chain ends at 1x1, so no valid file has more levels than this
+    std::uint32_t calcMaxLevelCount(std::uint32_t width, std::uint32_t height)
+    {
+        auto size = std::max(width, height);
+        std::uint32_t count = 1;
+        while (size > 1)
+        {
+            size >>= 1;
+            count++;
+        }
+        return count;
+    }
+
+    std::size_t calcByteCount(CompressedImage::Format format, glm::uvec2 size)
+    {
+        const auto blocksX = (static_cast<std::size_t>(size.x) + 3) / 4;
+        const auto blocksY = (static_cast<std::size_t>(size.y) + 3) / 4;
+        return blocksX * blocksY * CompressedImage::getBlockSize(format);
+    }
+
+    //reverses the order of the first rowCount rows of a block
+    //the colour indices of BC1 are one byte per row
+    void flipColourBlock(std::uint8_t* block, std::uint32_t rowCount)
+    {
+        std::reverse(block + 4, block + 4 + rowCount);
+    }
+
+    //BC2 alpha is 16 bits per row
+    void flipExplicitAlphaBlock(std::uint8_t* block, std::uint32_t rowCount)
+    {
+        for (auto i = 0u; i < rowCount / 2; ++i)
+        {
+            std::swap(block[i * 2], block[(rowCount - 1 - i) * 2]);
+            std::swap(block[i * 2 + 1], block[(rowCount - 1 - i) * 2 + 1]);
+        }
+    }
+
+    //BC3/4/5 alpha indices are 12 bits per row, starting at the 3rd byte
+    void flipAlphaBlock(std::uint8_t* block, std::uint32_t rowCount)
+    {
+        std::uint64_t bits = 0;
+        for (auto i = 7; i > 1; --i)
+        {
+            bits = (bits << 8) | block[i];
+        }
+
+        std::array<std::uint64_t, 4> rows = {};
+        for (auto i = 0u; i < 4u; ++i)
+        {
+            rows[i] = (bits >> (i * 12)) & 0xfff;
+        }
+        std::reverse(rows.begin(), rows.begin() + rowCount);
+
+        bits = 0;
+        for (auto i = 0u; i < 4u; ++i)
+        {
+            bits |= rows[i] << (i * 12);
+        }
+
+        for (auto i = 2; i < 8; ++i)
+        {
+            block[i] = static_cast<std::uint8_t>(bits & 0xff);
+            bits >>= 8;
+        }
+    }
+}
+
+//public
+bool CompressedImage::loadFromFile(const std::string& path, bool flipOnLoad)
+{
+    reset();
+
+    RaiiRWops file;
+    file.file = SDL_RWFromFile(path.c_str(), "rb");
+    if (!file.file)
+    {
+        LogE << "Failed opening " << path << ": " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    const auto size = SDL_RWsize(file.file);
+    if (size <= 0)
+    {
+        LogE << path << ": file is empty" << std::endl;
+        return false;
+    }
+
+    std::vector<std::uint8_t> fileData(static_cast<std::size_t>(size));
+    if (SDL_RWread(file.file, fileData.data(), fileData.size(), 1) != 1)
+    {
+        LogE << "Failed reading " << path << std::endl;
+        return false;
+    }
+
+    if (!loadFromMemory(fileData.data(), fileData.size(), flipOnLoad))
+    {
+        LogE << "Failed loading " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool CompressedImage::loadFromMemory(const std::uint8_t* data, std::size_t size, bool flipOnLoad)
+{
+    reset();
+
+    bool result = false;
+    if (size >= KTX2Identifier.size()
+        && std::equal(KTX2Identifier.begin(), KTX2Identifier.end(), data))
+    {
+        result = parseKTX2(data, size);
+    }
+    else if (size >= DDSHeaderSize
+        && read<std::uint32_t>(data) == DDSMagic)
+    {
+        result = parseDDS(data, size);
+    }
+    else
+    {
+        LogE << "Compressed image is not a KTX2 or DDS file" << std::endl;
+    }
+
+    if (!result)
+    {
+        reset();
+        return false;
+    }
+
+    if (flipOnLoad && !m_bottomUp)
+    {
+        if (flipBlocks())
+        {
+            m_bottomUp = true;
+        }
+        else
+        {
+            //decompress() will flip the decoded image instead
+            m_flipRows = true;
+        }
+    }
+
+    return true;
+}
+
+glm::uvec2 CompressedImage::getSize() const
+{
+    return m_levels.empty() ? glm::uvec2(0u) : m_levels[0].size;
+}
+
+glm::uvec2 CompressedImage::getLevelSize(std::size_t level) const
+{
+    CRO_ASSERT(level < m_levels.size(), "");
+    return m_levels[level].size;
+}
+
+const std::uint8_t* CompressedImage::getLevelData(std::size_t level) const
+{
+    CRO_ASSERT(level < m_levels.size(), "");
+    return m_data.data() + m_levels[level].offset;
+}
+
+std::size_t CompressedImage::getLevelByteCount(std::size_t level) const
+{
+    CRO_ASSERT(level < m_levels.size(), "");
+    return m_levels[level].byteCount;
+}
+
+bool CompressedImage::canDecompress() const
+{
+    return m_format != Format::None
+        && m_format != Format::BC7;
+}
+
+std::vector<std::uint8_t> CompressedImage::decompress(std::size_t level) const
+{
+    std::vector<std::uint8_t> retVal;
+    if (!canDecompress()
+        || level >= m_levels.size())
+    {
+        return retVal;
+    }
+
+    void(*decode)(const std::uint8_t*, std::uint8_t*) = nullptr;
+    switch (m_format)
+    {
+    default: return retVal;
+    case Format::BC1: decode = [](const std::uint8_t* b, std::uint8_t* o) { Detail::BlockDecoder::decodeBC1(b, o); }; break;
+    case Format::BC2: decode = Detail::BlockDecoder::decodeBC2; break;
+    case Format::BC3: decode = Detail::BlockDecoder::decodeBC3; break;
+    case Format::BC4: decode = Detail::BlockDecoder::decodeBC4; break;
+    case Format::BC5: decode = Detail::BlockDecoder::decodeBC5; break;
+    case Format::ETC2_RGB: decode = Detail::BlockDecoder::decodeETC2RGB; break;
+    case Format::ETC2_RGBA: decode = Detail::BlockDecoder::decodeETC2RGBA; break;
+    }
+
+    const auto size = m_levels[level].size;
+    const auto blockSize = getBlockSize(m_format);
+    const auto blocksX = (size.x + 3) / 4;
+    const auto blocksY = (size.y + 3) / 4;
+    const auto* block = getLevelData(level);
+
+    retVal.resize(size.x * size.y * 4);
+    std::array<std::uint8_t, 64> texels = {};
+
+    for (auto by = 0u; by < blocksY; ++by)
+    {
+        for (auto bx = 0u; bx < blocksX; ++bx)
+        {
+            decode(block, texels.data());
+            block += blockSize;
+
+            //partial blocks at the edges are clipped
+            const auto width = std::min(4u, size.x - (bx * 4));
+            const auto height = std::min(4u, size.y - (by * 4));
+            for (auto y = 0u; y < height; ++y)
+            {
+                auto dstY = (by * 4) + y;
+                if (m_flipRows)
+                {
+                    dstY = size.y - 1 - dstY;
+                }
+                std::memcpy(&retVal[((dstY * size.x) + (bx * 4)) * 4], &texels[y * 16], width * 4);
+            }
+        }
+    }
+
+    return retVal;
+}
+
+std::size_t CompressedImage::getBlockSize(Format format)
+{
+    switch (format)
+    {
+    default:
+    case Format::None:
+        return 0;
+    case Format::BC1:
+    case Format::BC4:
+    case Format::ETC2_RGB:
+        return 8;
+    case Format::BC2:
+    case Format::BC3:
+    case Format::BC5:
+    case Format::BC7:
+    case Format::ETC2_RGBA:
+        return 16;
+    }
+}
+
+bool CompressedImage::isCompressedFile(const std::string& path)
+{
+    auto ext = FileSystem::getFileExtension(path);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) {return static_cast<char>(std::tolower(c)); });
+
+    return ext == ".ktx2" || ext == ".dds";
+}
+
+//private
+bool CompressedImage::parseKTX2(const std::uint8_t* data, std::size_t size)
+{
+    if (size < KTX2HeaderSize)
+    {
+        LogE << "KTX2 file too small" << std::endl;
+        return false;
+    }
+
+    const auto vkFormat = read<std::uint32_t>(data + 12);
+    const auto width = read<std::uint32_t>(data + 20);
+    const auto height = read<std::uint32_t>(data + 24);
+    const auto depth = read<std::uint32_t>(data + 28);
+    const auto layerCount = read<std::uint32_t>(data + 32);
+    const auto faceCount = read<std::uint32_t>(data + 36);
+    const auto levelCount = std::max(1u, read<std::uint32_t>(data + 40));
+    const auto supercompression = read<std::uint32_t>(data + 44);
+    const auto kvdOffset = read<std::uint32_t>(data + 56);
+    const auto kvdLength = read<std::uint32_t>(data + 60);
+
+    m_format = fromVkFormat(vkFormat);
+    if (m_format == Format::None)
+    {
+        LogE << "Unsupported KTX2 format " << vkFormat << std::endl;
+        return false;
+    }
+
+    if (width == 0 || height == 0 || depth > 1
+        || layerCount > 1 || faceCount != 1)
+    {
+        LogE << "Only single 2D KTX2 images are supported" << std::endl;
+        return false;
+    }
+
+    if (width > MaxImageSize || height > MaxImageSize)
+    {
+        LogE << "KTX2 image " << width << "x" << height << " is larger than " << MaxImageSize << "x" << MaxImageSize << std::endl;
+        return false;
+    }
+
+    if (supercompression != 0)
+    {
+        LogE << "KTX2 supercompression is not supported" << std::endl;
+        return false;
+    }
+
+    if (levelCount > calcMaxLevelCount(width, height))
+    {
+        LogE << "KTX2 level count " << levelCount << " is too large for " << width << "x" << height << std::endl;
+        return false;
+    }
+
+    if (KTX2HeaderSize + (levelCount * KTX2LevelSize) > size)
+    {
+        LogE << "KTX2 level index is truncated" << std::endl;
+        return false;
+    }
+
+    //the orientation is 'rd' (top down) unless specified otherwise
+    if (kvdLength != 0
+        && static_cast<std::size_t>(kvdOffset) + kvdLength <= size)
+    {
+        static const std::string OrientationKey("KTXorientation");
+
+        std::size_t offset = kvdOffset;
+        const std::size_t end = offset + kvdLength;
+        while (offset + 4 <= end)
+        {
+            const auto length = read<std::uint32_t>(data + offset);
+            offset += 4;
+            if (offset + length > end)
+            {
+                break;
+            }
+
+            const char* kv = reinterpret_cast<const char*>(data + offset);
+            if (length > OrientationKey.size() + 2
+                && std::strncmp(kv, OrientationKey.c_str(), OrientationKey.size() + 1) == 0)
+            {
+                m_bottomUp = kv[OrientationKey.size() + 2] == 'u';
+            }
+
+            offset += (length + 3) & ~3u;
+        }
+    }
+
+    //levels are stored smallest first, but the index is base first
+    for (auto i = 0u; i < levelCount; ++i)
+    {
+        const auto* entry = data + KTX2HeaderSize + (i * KTX2LevelSize);
+        const auto offset = read<std::uint64_t>(entry);
+        const auto length = read<std::uint64_t>(entry + 8);
+
+        const glm::uvec2 levelSize(std::max(1u, width >> i), std::max(1u, height >> i));
+        if (offset > size
+            || length != calcByteCount(m_format, levelSize)
+            || !addLevel(data, size, static_cast<std::size_t>(offset), levelSize))
+        {
+            LogE << "KTX2 level " << i << " is invalid" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CompressedImage::parseDDS(const std::uint8_t* data, std::size_t size)
+{
+    static constexpr std::uint32_t DDPF_FOURCC = 0x4;
+    static constexpr std::uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+    static constexpr std::uint32_t DDSCAPS2_CUBEMAP = 0x200;
+    static constexpr std::uint32_t DDSCAPS2_VOLUME = 0x200000;
+
+    const auto flags = read<std::uint32_t>(data + 8);
+    const auto height = read<std::uint32_t>(data + 12);
+    const auto width = read<std::uint32_t>(data + 16);
+    const auto mipCount = read<std::uint32_t>(data + 28);
+    const auto pixelFlags = read<std::uint32_t>(data + 80);
+    const auto fourCC = read<std::uint32_t>(data + 84);
+    const auto caps2 = read<std::uint32_t>(data + 112);
+
+    if (read<std::uint32_t>(data + 4) != 124
+        || width == 0 || height == 0)
+    {
+        LogE << "Invalid DDS header" << std::endl;
+        return false;
+    }
+
+    if (width > MaxImageSize || height > MaxImageSize)
+    {
+        LogE << "DDS image " << width << "x" << height << " is larger than " << MaxImageSize << "x" << MaxImageSize << std::endl;
+        return false;
+    }
+
+    if (caps2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME))
+    {
+        LogE << "DDS cube maps and volume textures are not supported" << std::endl;
+        return false;
+    }
+
+    if ((pixelFlags & DDPF_FOURCC) == 0)
+    {
+        LogE << "Uncompressed DDS files are not supported" << std::endl;
+        return false;
+    }
+
+    std::size_t offset = DDSHeaderSize;
+    if (fourCC == makeFourCC('D', 'X', '1', '0'))
+    {
+        if (size < DDSHeaderSize + DDSDX10HeaderSize)
+        {
+            LogE << "DDS DX10 header is truncated" << std::endl;
+            return false;
+        }
+
+        const auto* header = data + DDSHeaderSize;
+        static constexpr std::uint32_t TextureCube = 0x4;
+        if (read<std::uint32_t>(header + 4) != 3 //DDS_DIMENSION_TEXTURE2D
+            || (read<std::uint32_t>(header + 8) & TextureCube)
+            || read<std::uint32_t>(header + 12) > 1)
+        {
+            LogE << "Only single 2D DDS images are supported" << std::endl;
+            return false;
+        }
+
+        m_format = fromDXGIFormat(read<std::uint32_t>(header));
+        offset += DDSDX10HeaderSize;
+    }
+    else
+    {
+        m_format = fromFourCC(fourCC);
+    }
+
+    if (m_format == Format::None)
+    {
+        LogE << "Unsupported DDS format" << std::endl;
+        return false;
+    }
+
+    const auto levelCount = (flags & DDSD_MIPMAPCOUNT) ? std::max(1u, mipCount) : 1u;
+    if (levelCount > calcMaxLevelCount(width, height))
+    {
+        LogE << "DDS mip count " << levelCount << " is too large for " << width << "x" << height << std::endl;
+        return false;
+    }
+
+    for (auto i = 0u; i < levelCount; ++i)
+    {
+        const glm::uvec2 levelSize(std::max(1u, width >> i), std::max(1u, height >> i));
+        if (!addLevel(data, size, offset, levelSize))
+        {
+            LogE << "DDS level " << i << " is truncated" << std::endl;
+            return false;
+        }
+        offset += m_levels.back().byteCount;
+    }
+
+    return true;
+}
+
+bool CompressedImage::addLevel(const std::uint8_t* data, std::size_t size, std::size_t offset, glm::uvec2 levelSize)
+{
+    const auto byteCount = calcByteCount(m_format, levelSize);
+    if (offset + byteCount > size)
+    {
+        return false;
+    }
+
+    auto& level = m_levels.emplace_back();
+    level.size = levelSize;
+    level.offset = m_data.size();
+    level.byteCount = byteCount;
+
+    m_data.insert(m_data.end(), data + offset, data + offset + byteCount);
+    return true;
+}
+
+bool CompressedImage::flipBlocks()
+{
+    //the blocks of other formats can't be reordered without re-encoding
+    if (m_format != Format::BC1 && m_format != Format::BC2
+        && m_format != Format::BC3 && m_format != Format::BC4
+        && m_format != Format::BC5)
+    {
+        return false;
+    }
+
+    //rows would move between blocks when the height isn't a
+    //multiple of 4, unless the whole level fits in one block
+    for (const auto& level : m_levels)
+    {
+        if (level.size.y > 4 && (level.size.y % 4) != 0)
+        {
+            return false;
+        }
+    }
+
+    const auto blockSize = getBlockSize(m_format);
+    for (const auto& level : m_levels)
+    {
+        const auto rowCount = std::min(4u, level.size.y);
+        const auto blocksX = (level.size.x + 3) / 4;
+        const auto blocksY = (level.size.y + 3) / 4;
+        auto* levelData = m_data.data() + level.offset;
+
+        for (auto i = 0u; i < blocksX * blocksY; ++i)
+        {
+            auto* block = levelData + (i * blockSize);
+            switch (m_format)
+            {
+            default: break;
+            case Format::BC1:
+                flipColourBlock(block, rowCount);
+                break;
+            case Format::BC2:
+                flipExplicitAlphaBlock(block, rowCount);
+                flipColourBlock(block + 8, rowCount);
+                break;
+            case Format::BC3:
+                flipAlphaBlock(block, rowCount);
+                flipColourBlock(block + 8, rowCount);
+                break;
+            case Format::BC4:
+                flipAlphaBlock(block, rowCount);
+                break;
+            case Format::BC5:
+                flipAlphaBlock(block, rowCount);
+                flipAlphaBlock(block + 8, rowCount);
+                break;
+            }
+        }
+
+        //then swap the rows of blocks
+        const auto rowBytes = blocksX * blockSize;
+        for (auto y = 0u; y < blocksY / 2; ++y)
+        {
+            std::swap_ranges(levelData + (y * rowBytes), levelData + ((y + 1) * rowBytes),
+                levelData + ((blocksY - 1 - y) * rowBytes));
+        }
+    }
+
+    return true;
+}
+
+void CompressedImage::reset()
+{
+    m_format = Format::None;
+    m_data.clear();
+    m_levels.clear();
+    m_bottomUp = false;
+    m_flipRows = false;
+}
@@ -30,12 +30,16 @@ source distribution.
 #include "../detail/stb_image.h"
 #include "../detail/SDLImageRead.hpp"
 #include "../detail/GLCheck.hpp"
+#include "../detail/IBLCache.hpp"
+#include "../detail/IBLConvolution.hpp"
+#include "../detail/MappedFile.hpp"
 
 #include <crogine/core/FileSystem.hpp>
 #include <crogine/core/Log.hpp>
 
 #include <crogine/detail/glm/mat4x4.hpp>
 #include <crogine/detail/glm/gtc/matrix_transform.hpp>
+#include <crogine/detail/glm/gtc/packing.hpp>
 
 #include <crogine/util/Constants.hpp>
 
@@ -44,6 +48,7 @@ source distribution.
 
 #include <array>
 #include <vector>
+#include <cstring>
 #include <filesystem>
 
 using namespace cro;
@@ -98,6 +103,7 @@ namespace
     const std::uint32_t CubemapSize = 512u;
     const std::uint32_t IrradianceMapSize = 32u;
     const std::uint32_t PrefilterMapSize = 512u;
+    const std::uint32_t PrefilterLevels = 5u;
     const std::int32_t CubeVertCount = 36;
 
     const auto projectionMatrix = glm::perspective(90.f * cro::Util::Const::degToRad, 1.f, 0.1f, 2.f);
@@ -110,6 +116,59 @@ namespace
         glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f,  0.0f,  1.0f), glm::vec3(0.0f, -1.0f,  0.0f)),
         glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f,  0.0f, -1.0f), glm::vec3(0.0f, -1.0f,  0.0f))
     };
+
+    //the BRDF lookup doesn't depend on the environment so
+    //it's created once and shared by all EnvironmentMaps
+    struct SharedBRDF final
+    {
+        std::uint32_t texture = 0;
+        std::uint32_t refCount = 0;
+    }sharedBRDF;
+
+    std::string getFullPath(const std::string& filePath)
+    {
+        std::filesystem::path p(filePath);
+        if (p.is_absolute())
+        {
+            return filePath;
+        }
+        return FileSystem::getResourcePath() + filePath;
+    }
+
+    std::vector<std::uint8_t> readFile(const std::string& path)
+    {
+        std::vector<std::uint8_t> retVal;
+
+        auto* file = SDL_RWFromFile(path.c_str(), "rb");
+        if (!file)
+        {
+            LogE << "SDLRW_ops Failed opening " << path << std::endl;
+            return retVal;
+        }
+
+        const auto size = SDL_RWsize(file);
+        if (size > 0)
+        {
+            retVal.resize(static_cast<std::size_t>(size));
+            if (SDL_RWread(file, retVal.data(), retVal.size(), 1) != 1)
+            {
+                LogE << "Failed reading " << path << std::endl;
+                retVal.clear();
+            }
+        }
+        SDL_RWclose(file);
+
+        return retVal;
+    }
+
+    void setCubemapParameters(std::int32_t minFilter)
+    {
+        glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+        glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+        glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE));
+        glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, minFilter));
+        glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    }
 }
 
 EnvironmentMap::EnvironmentMap()
@@ -118,16 +177,25 @@ EnvironmentMap::EnvironmentMap()
 {
     std::fill(m_textures.begin(), m_textures.end(), 0);
 
-    glCheck(glGenTextures(4, m_textures.data()));
+    //BRDF is shared, and created on first load
+    glCheck(glGenTextures(BRDF, m_textures.data()));
+    sharedBRDF.refCount++;
 }
 
 EnvironmentMap::~EnvironmentMap()
 {
     if (m_textures[Skybox])
     {
-        glCheck(glDeleteTextures(4, m_textures.data()));
+        glCheck(glDeleteTextures(BRDF, m_textures.data()));
     }
     deleteCube();
+
+    if (--sharedBRDF.refCount == 0
+        && sharedBRDF.texture)
+    {
+        glCheck(glDeleteTextures(1, &sharedBRDF.texture));
+        sharedBRDF.texture = 0;
+    }
 }
 
 //public
@@ -138,16 +206,7 @@ bool EnvironmentMap::loadFromFile(const std::string& filePath)
     return false;
 #else
 
-    std::string path;
-    std::filesystem::path p(filePath);
-    if (p.is_absolute())
-    {
-        path = filePath;
-    }
-    else
-    {
-        path = FileSystem::getResourcePath() + filePath;
-    }
+    const auto path = getFullPath(filePath);
 
     if (!cro::FileSystem::fileExists(path))
     {
@@ -155,15 +214,29 @@ bool EnvironmentMap::loadFromFile(const std::string& filePath)
         return false;
     }
 
-    auto* file = SDL_RWFromFile(path.c_str(), "rb");
-    if (!file)
+    for (auto i = 0u; i < BRDF; ++i)
+    {
+        if (m_textures[i] == 0)
+        {
+            LogE << "Failed creating one or more textures" << std::endl;
+            return false;
+        }
+    }
+
+    //the whole file is read so that it can be hashed
+    //and compared with any existing cache before decoding
+    const auto fileData = readFile(path);
+    if (fileData.empty())
     {
-        LogE << "SDLRW_ops Failed opening " << filePath << std::endl;
         return false;
     }
 
-    STBIMG_stbio_RWops io;
-    stbi_callback_from_RW(file, &io);
+    const auto sourceHash = Detail::IBLCache::hash(fileData.data(), fileData.size());
+    if (loadFromCache(Detail::IBLCache::getLocalPath(path), sourceHash)
+        || loadFromCache(Detail::IBLCache::getUserPath(path), sourceHash))
+    {
+        return createBRDFMap();
+    }
 
     std::int32_t width = 0;
     std::int32_t height = 0;
@@ -172,7 +245,9 @@ bool EnvironmentMap::loadFromFile(const std::string& filePath)
     TempTexture tempTexture;
 
     stbi_set_flip_vertically_on_load(1);
-    auto* data = stbi_loadf_from_callbacks(&io.stb_cbs, &io, &width, &height, &componentCount, 0);
+    auto* data = stbi_loadf_from_memory(fileData.data(), static_cast<std::int32_t>(fileData.size()), &width, &height, &componentCount, 0);
+    stbi_set_flip_vertically_on_load(0);
+
     if (data)
     {
         //store the image in a temp texture - we're going to write this to a cube map
@@ -193,8 +268,6 @@ bool EnvironmentMap::loadFromFile(const std::string& filePath)
         
         return false;
     }
-    stbi_set_flip_vertically_on_load(0);
-    SDL_RWclose(file);
 
     //create a temp render buffer/frame buffer to render the sides with
     TempFrameBuffer tempFBO;
@@ -210,21 +283,6 @@ bool EnvironmentMap::loadFromFile(const std::string& filePath)
     glCheck(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, tempRBO.handle));
 
     //create the cubemap which will be the skybox
-    if (m_textures[Skybox] == 0)
-    {
-        LogE << "No valid textures were created." << std::endl;
-        return false;
-    }
-
-    for (auto t : m_textures)
-    {
-        if (t == 0)
-        {
-            LogE << "Failed creating one or more textures" << std::endl;
-            return false;
-        }
-    }
-
     glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP, m_textures[Skybox]));
 
     for (auto i = 0u; i < 6u; ++i)
@@ -289,13 +347,7 @@ bool EnvironmentMap::loadFromFile(const std::string& filePath)
     }
     renderPrefilterMap(tempFBO.handle, tempRBO.handle, shader);
 
-
-    if (!shader.loadFromString(BRDFVert, BRDFFrag))
-    {
-        LogE << "Failed creating BRDF shader" << std::endl;
-        return false;
-    }
-    renderBRDFMap(tempFBO.handle, tempRBO.handle, shader);
+    writeCache(Detail::IBLCache::getUserPath(path), sourceHash);
 
     //make sure everything is put back neat :)
     glCheck(glBindVertexArray(0));
@@ -303,11 +355,64 @@ bool EnvironmentMap::loadFromFile(const std::string& filePath)
     glCheck(glUseProgram(0));
 
     deleteCube();
-    return true;
+    return createBRDFMap();
 
 #endif //PLATFORM_MOBILE
 }
 
+bool EnvironmentMap::createCache(const std::string& filePath, const std::string& cachePath)
+{
+    const auto path = getFullPath(filePath);
+    const auto fileData = readFile(path);
+    if (fileData.empty())
+    {
+        return false;
+    }
+
+    std::int32_t width = 0;
+    std::int32_t height = 0;
+    std::int32_t componentCount = 0;
+
+    stbi_set_flip_vertically_on_load(1);
+    auto* data = stbi_loadf_from_memory(fileData.data(), static_cast<std::int32_t>(fileData.size()), &width, &height, &componentCount, 3);
+    stbi_set_flip_vertically_on_load(0);
+
+    if (!data)
+    {
+        LogE << "STBI Failed opening " << filePath << ": " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+
+    using Detail::IBLConvolution;
+    auto skybox = IBLConvolution::fromEquirectangular(data, width, height, 3, CubemapSize);
+    stbi_image_free(data);
+
+    IBLConvolution::generateMipmaps(skybox);
+    const auto irradiance = IBLConvolution::convolveIrradiance(skybox, IrradianceMapSize);
+    const auto prefilter = IBLConvolution::prefilter(skybox, PrefilterMapSize, PrefilterLevels);
+
+    const auto header = Detail::IBLCache::createHeader(Detail::IBLCache::hash(fileData.data(), fileData.size()),
+        CubemapSize, IrradianceMapSize, PrefilterMapSize, PrefilterLevels);
+
+    std::vector<std::uint16_t> halfData;
+    halfData.reserve(header.dataSize / sizeof(std::uint16_t));
+    const auto pack = [&](const std::vector<float>& level)
+    {
+        for (auto f : level)
+        {
+            halfData.push_back(glm::packHalf1x16(f));
+        }
+    };
+    pack(skybox.levels[0]);
+    pack(irradiance.levels[0]);
+    for (const auto& level : prefilter.levels)
+    {
+        pack(level);
+    }
+
+    return Detail::IBLCache::write(cachePath.empty() ? Detail::IBLCache::getLocalPath(path) : cachePath, header, halfData);
+}
+
 void EnvironmentMap::renderIrradianceMap(std::uint32_t fbo, std::uint32_t rbo, Shader& shader)
 {
     //create a smaller cube map to hold the irradiance map
@@ -367,6 +472,9 @@ void EnvironmentMap::renderPrefilterMap(std::uint32_t fbo, std::uint32_t rbo, Sh
     glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
     glCheck(glGenerateMipmap(GL_TEXTURE_CUBE_MAP));    
 
+    //only the levels rendered below are used
+    glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, PrefilterLevels - 1));
+
     //read from the skybox
     glCheck(glUseProgram(shader.getGLHandle()));
     glCheck(glUniform1i(shader.getUniformMap().at("u_environmentMap"), 0));
@@ -376,8 +484,7 @@ void EnvironmentMap::renderPrefilterMap(std::uint32_t fbo, std::uint32_t rbo, Sh
 
     //render multiple mip levels to vary the roughness
     glCheck(glBindFramebuffer(GL_FRAMEBUFFER, fbo));
-    const std::uint32_t MaxLevels = 5;
-    for (auto i = 0u; i < MaxLevels; ++i)
+    for (auto i = 0u; i < PrefilterLevels; ++i)
     {
         //resize the RBO for each level...
         auto mipSize = static_cast<std::uint32_t>(PrefilterMapSize * std::pow(0.5f, i));
@@ -387,7 +494,7 @@ void EnvironmentMap::renderPrefilterMap(std::uint32_t fbo, std::uint32_t rbo, Sh
 
         glViewport(0, 0, mipSize, mipSize);
 
-        float roughness = static_cast<float>(i) / static_cast<float>(MaxLevels - 1);
+        float roughness = static_cast<float>(i) / static_cast<float>(PrefilterLevels - 1);
         glCheck(glUniform1f(shader.getUniformMap().at("u_roughness"), roughness));
 
         //render each side of this level
@@ -458,6 +565,121 @@ void EnvironmentMap::renderBRDFMap(std::uint32_t fbo, std::uint32_t rbo, Shader&
     glCheck(glDeleteVertexArrays(1, &quadVAO));
 }
 
+bool EnvironmentMap::createBRDFMap()
+{
+    if (sharedBRDF.texture == 0)
+    {
+        cro::Shader shader;
+        if (!shader.loadFromString(BRDFVert, BRDFFrag))
+        {
+            LogE << "Failed creating BRDF shader" << std::endl;
+            return false;
+        }
+
+        TempFrameBuffer tempFBO;
+        TempRenderBuffer tempRBO;
+        glCheck(glGenFramebuffers(1, &tempFBO.handle));
+        glCheck(glGenRenderbuffers(1, &tempRBO.handle));
+        glCheck(glBindFramebuffer(GL_FRAMEBUFFER, tempFBO.handle));
+        glCheck(glBindRenderbuffer(GL_RENDERBUFFER, tempRBO.handle));
+        glCheck(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, tempRBO.handle));
+
+        glCheck(glGenTextures(1, &sharedBRDF.texture));
+        m_textures[BRDF] = sharedBRDF.texture;
+        renderBRDFMap(tempFBO.handle, tempRBO.handle, shader);
+
+        glCheck(glBindVertexArray(0));
+        glCheck(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+        glCheck(glUseProgram(0));
+    }
+
+    m_textures[BRDF] = sharedBRDF.texture;
+    return true;
+}
+
+bool EnvironmentMap::loadFromCache(const std::string& path, std::uint64_t sourceHash)
+{
+    Detail::MappedFile file;
+    if (!file.open(path)
+        || file.getSize() < sizeof(Detail::IBLCache::Header))
+    {
+        return false;
+    }
+
+    Detail::IBLCache::Header header;
+    std::memcpy(&header, file.getData(), sizeof(header));
+
+    const auto expected = Detail::IBLCache::createHeader(sourceHash, CubemapSize, IrradianceMapSize, PrefilterMapSize, PrefilterLevels);
+    if (!Detail::IBLCache::isValid(header, expected, file.getSize()))
+    {
+        //stale, it'll be replaced once the source is processed
+        return false;
+    }
+
+    //texels are uploaded directly from the mapped file
+    const auto* texels = file.getData() + sizeof(header);
+    const auto uploadLevel = [&](std::uint32_t level, std::uint32_t size)
+    {
+        for (auto i = 0u; i < 6u; ++i)
+        {
+            glCheck(glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level, GL_RGB16F, size, size, 0, GL_RGB, GL_HALF_FLOAT, texels));
+            texels += size * size * 3 * sizeof(std::uint16_t);
+        }
+    };
+
+    glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP, m_textures[Skybox]));
+    uploadLevel(0, CubemapSize);
+    setCubemapParameters(GL_LINEAR_MIPMAP_LINEAR);
+    glCheck(glGenerateMipmap(GL_TEXTURE_CUBE_MAP));
+
+    glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP, m_textures[Irradiance]));
+    uploadLevel(0, IrradianceMapSize);
+    setCubemapParameters(GL_LINEAR);
+
+    glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP, m_textures[Prefilter]));
+    for (auto i = 0u; i < PrefilterLevels; ++i)
+    {
+        uploadLevel(i, PrefilterMapSize >> i);
+    }
+    setCubemapParameters(GL_LINEAR_MIPMAP_LINEAR);
+    glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, PrefilterLevels - 1));
+
+    glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP, 0));
+
+    return true;
+}
+
+void EnvironmentMap::writeCache(const std::string& path, std::uint64_t sourceHash) const
+{
+    const auto header = Detail::IBLCache::createHeader(sourceHash, CubemapSize, IrradianceMapSize, PrefilterMapSize, PrefilterLevels);
+    std::vector<std::uint16_t> data(header.dataSize / sizeof(std::uint16_t));
+
+    auto* texels = data.data();
+    const auto readLevel = [&](std::uint32_t level, std::uint32_t size)
+    {
+        for (auto i = 0u; i < 6u; ++i)
+        {
+            glCheck(glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level, GL_RGB, GL_HALF_FLOAT, texels));
+            texels += Detail::IBLCache::levelSize(size) / 6;
+        }
+    };
+
+    glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP, m_textures[Skybox]));
+    readLevel(0, CubemapSize);
+
+    glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP, m_textures[Irradiance]));
+    readLevel(0, IrradianceMapSize);
+
+    glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP, m_textures[Prefilter]));
+    for (auto i = 0u; i < PrefilterLevels; ++i)
+    {
+        readLevel(i, PrefilterMapSize >> i);
+    }
+    glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP, 0));
+
+    Detail::IBLCache::write(path, header, data);
+}
+
 void EnvironmentMap::createCube()
 {
     std::vector<float> verts =
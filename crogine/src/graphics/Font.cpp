@@ -39,8 +39,10 @@ by Laurent Gomila et al https://github.com/SFML/SFML/blob/master/src/SFML/Graphi
 #include <crogine/graphics/Colour.hpp>
 #include <crogine/detail/Types.hpp>
 #include <crogine/core/FileSystem.hpp>
+#include <crogine/core/HiResTimer.hpp>
 
 #include <array>
+#include <cmath>
 #include <cstring>
 
 #include <ft2build.h>
@@ -58,7 +60,15 @@ namespace
 {
     constexpr float MagicNumber = static_cast<float>(1 << 6);
 
-    //used to create a unique key for bold/outline/codepoint glyphs
+    //in SDF mode all glyphs are rasterised at this size into
+    //a single page, and scaled to the requested size on lookup
+    constexpr std::uint32_t SDFPageKey = 0;
+    constexpr std::uint32_t SDFCharSize = 64;
+    constexpr std::uint32_t SDFSpread = 8;
+
+    //used to create a unique key for bold/outline/codepoint glyphs.
+    //keying on the codepoint rather than the glyph index means
+    //cache hits don't need to query freetype at all
     //see https://github.com/SFML/SFML/blob/master/src/SFML/Graphics/Font.cpp#L66
     template <typename T, typename U>
     inline T reinterpret(const U& input)
@@ -68,9 +78,9 @@ namespace
         std::memcpy(&output, &input, sizeof(U));
         return output;
     }
-    std::uint64_t combine(float outlineThickness, bool bold, std::uint32_t index)
+    std::uint64_t combine(float outlineThickness, bool bold, std::uint32_t codepoint)
     {
-        return (static_cast<std::uint64_t>(reinterpret<std::uint32_t>(outlineThickness)) << 32) | (static_cast<std::uint64_t>(bold) << 31) | index;
+        return (static_cast<std::uint64_t>(reinterpret<std::uint32_t>(outlineThickness)) << 32) | (static_cast<std::uint64_t>(bold) << 31) | codepoint;
     }
 
     //if we use the same font as multiple sub-fonts (eg emoji font)
@@ -146,7 +156,8 @@ namespace
 }
 
 Font::Font()
-    : m_useSmoothing(false)
+    : m_useSmoothing(false),
+    m_useSDF        (false)
 {
     if (!fontDataResource)
     {
@@ -253,23 +264,28 @@ bool Font::appendFromFile(const std::string& filePath, FontAppendmentContext ctx
 
 Glyph Font::getGlyph(std::uint32_t codepoint, std::uint32_t charSize, bool bold, float outlineThickness) const
 {
-    auto& fontData = getFontData(codepoint);
-    auto& currentGlyphs = m_pages[charSize].glyphs;
-    auto key = combine(outlineThickness, bold, FT_Get_Char_Index(std::any_cast<FT_Face>(fontData.face), codepoint));
+    const auto& fontData = getFontData(codepoint);
+    bold = bold && fontData.context.allowBold;
+    outlineThickness = fontData.context.allowOutline ? outlineThickness : 0.f;
 
-    auto result = currentGlyphs.find(key);
-    if (result != currentGlyphs.end())
-    {
-        return result->second;
-    }
-    else
+    if (m_useSDF
+        && charSize != 0)
     {
-        //add the glyph to the page
-        auto glyph = loadGlyph(codepoint, charSize, bold && fontData.context.allowBold, fontData.context.allowOutline ? outlineThickness : 0.f);
-        return currentGlyphs.insert(std::make_pair(key, glyph)).first->second;
+        //outlines are stroked at the SDF size so quantise the
+        //scaled thickness to limit the number of variations stored
+        const float scale = static_cast<float>(charSize) / SDFCharSize;
+        outlineThickness = std::round((outlineThickness / scale) * 4.f) / 4.f;
+
+        auto glyph = findGlyph(SDFPageKey, codepoint, SDFCharSize, bold, outlineThickness);
+        glyph.advance *= scale;
+        glyph.bounds.left *= scale;
+        glyph.bounds.bottom *= scale;
+        glyph.bounds.width *= scale;
+        glyph.bounds.height *= scale;
+        return glyph;
     }
 
-    return {};
+    return findGlyph(charSize, codepoint, charSize, bold, outlineThickness);
 }
 
 const Texture& Font::getTexture(std::uint32_t charSize) const
@@ -278,7 +294,7 @@ const Texture& Font::getTexture(std::uint32_t charSize) const
     //TODO this may return an invalid texture if the
     //current charSize is not inserted in the page map
     //and is automatically created
-    return m_pages[charSize].texture;
+    return m_pages[getPageKey(charSize)].texture;
 }
 
 float Font::getLineHeight(std::uint32_t charSize) const
@@ -339,13 +355,39 @@ void Font::setSmooth(bool smooth)
     {
         m_useSmoothing = smooth;
 
-        for (auto& page : m_pages)
+        for (auto& [key, page] : m_pages)
         {
-            page.second.texture.setSmooth(smooth);
+            //distance fields are always sampled linearly
+            page.texture.setSmooth(smooth || (m_useSDF && key == SDFPageKey));
         }
     }
 }
 
+void Font::setSDF(bool sdf)
+{
+    m_useSDF = sdf;
+}
+
+bool Font::isSDF() const
+{
+    return m_useSDF;
+}
+
+Font::AtlasStats Font::getAtlasStats() const
+{
+    AtlasStats retVal = m_atlasStats;
+    retVal.pageCount = m_pages.size();
+
+    for (const auto& [key, page] : m_pages)
+    {
+        const auto size = page.texture.getSize();
+        retVal.textureBytes += static_cast<std::size_t>(size.x) * size.y * 4;
+        retVal.glyphCount += page.glyphs.size();
+    }
+
+    return retVal;
+}
+
 //private
 const Font::FontData& Font::getFontData(std::uint32_t codepoint) const
 {
@@ -361,7 +403,33 @@ const Font::FontData& Font::getFontData(std::uint32_t codepoint) const
     return m_fontData[0];
 }
 
-Glyph Font::loadGlyph(std::uint32_t codepoint, std::uint32_t charSize, bool bold, float outlineThickness) const
+std::uint32_t Font::getPageKey(std::uint32_t charSize) const
+{
+    return m_useSDF ? SDFPageKey : charSize;
+}
+
+const Glyph& Font::findGlyph(std::uint32_t pageKey, std::uint32_t codepoint, std::uint32_t charSize, bool bold, float outlineThickness) const
+{
+    auto& page = m_pages[pageKey];
+    auto key = combine(outlineThickness, bold, codepoint);
+
+    auto result = page.glyphs.find(key);
+    if (result != page.glyphs.end())
+    {
+        return result->second;
+    }
+
+    //add the glyph to the page
+    HiResTimer timer;
+    auto glyph = loadGlyph(page, codepoint, charSize, bold, outlineThickness);
+
+    m_atlasStats.glyphMisses++;
+    m_atlasStats.rasteriseTime += timer.restart() * 1000.f;
+
+    return page.glyphs.insert(std::make_pair(key, glyph)).first->second;
+}
+
+Glyph Font::loadGlyph(Page& page, std::uint32_t codepoint, std::uint32_t charSize, bool bold, float outlineThickness) const
 {
     Glyph retVal;
 
@@ -464,15 +532,14 @@ Glyph Font::loadGlyph(std::uint32_t codepoint, std::uint32_t charSize, bool bold
 
     if (width > 0 && height > 0)
     {
-        const std::uint32_t padding = 2;
+        //distance fields need room for the spread outside the glyph
+        const std::uint32_t padding = m_useSDF ? SDFSpread : 2;
 
         //pad the glyph to stop potential bleed
         width += 2 * padding;
         height += 2 * padding;
 
-        //get the current page
-        auto& page = m_pages[charSize];
-        page.texture.setSmooth(m_useSmoothing);
+        page.texture.setSmooth(m_useSmoothing || m_useSDF);
 
         //find somewhere to insert the glyph
         retVal.textureBounds = getGlyphRect(page, width, height);
@@ -558,6 +625,27 @@ Glyph Font::loadGlyph(std::uint32_t codepoint, std::uint32_t charSize, bool bold
             }
         }
 
+        if (m_useSDF)
+        {
+            //convert the coverage to distance and store it in the
+            //alpha channel, so the texture is still valid for the
+            //default shader if not drawn with the SDF shader
+            std::vector<std::uint8_t> coverage(width * height);
+            for (auto i = 0u; i < coverage.size(); ++i)
+            {
+                coverage[i] = m_pixelBuffer[i * 4 + 3];
+            }
+
+            auto distance = Detail::DistanceField::toSDF(coverage, width, height, static_cast<float>(SDFSpread));
+            for (auto i = 0u; i < distance.size(); ++i)
+            {
+                m_pixelBuffer[i * 4] = 255;
+                m_pixelBuffer[i * 4 + 1] = 255;
+                m_pixelBuffer[i * 4 + 2] = 255;
+                m_pixelBuffer[i * 4 + 3] = distance[i];
+            }
+        }
+
         //finally copy to texture
         auto x = static_cast<std::uint32_t>(retVal.textureBounds.left) - padding;
         auto y = static_cast<std::uint32_t>(retVal.textureBounds.bottom) - padding;
@@ -713,16 +801,17 @@ void Font::cleanup()
 
     m_pages.clear();
     m_pixelBuffer.clear();
+    m_atlasStats = {};
 }
 
 bool Font::pageUpdated(std::uint32_t charSize) const
 {
-    return m_pages[charSize].updated;
+    return m_pages[getPageKey(charSize)].updated;
 }
 
 void Font::markPageRead(std::uint32_t charSize) const
 {
-    m_pages[charSize].updated = false;
+    m_pages[getPageKey(charSize)].updated = false;
 }
 
 void Font::registerObserver(FontObserver* o) const
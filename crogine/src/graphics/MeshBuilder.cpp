@@ -56,6 +56,16 @@ void MeshBuilder::createVBO(Mesh::Data& meshData, const std::vector<float>& vert
     glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
 }
 
+void MeshBuilder::createVBO(Mesh::Data& meshData, const std::vector<std::uint8_t>& packedVertexData)
+{
+    CRO_ASSERT(packedVertexData.size() == meshData.packedVertexSize * meshData.vertexCount, "");
+
+    glCheck(glGenBuffers(1, &meshData.vbo));
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
+    glCheck(glBufferData(GL_ARRAY_BUFFER, packedVertexData.size(), packedVertexData.data(), GL_STATIC_DRAW));
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+}
+
 void MeshBuilder::createIBO(Mesh::Data& meshData, const void* idxData, std::size_t idx, std::int32_t dataSize)
 {
     glCheck(glGenBuffers(1, &meshData.indexData[idx].ibo));
@@ -28,9 +28,12 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include <crogine/graphics/MeshData.hpp>
+#include <crogine/detail/Assert.hpp>
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/CompactVertex.hpp"
 
+#include <algorithm>
 #include <type_traits>
 
 /*
@@ -42,6 +45,23 @@ using namespace cro::Mesh;
 
 namespace
 {
+    //converts the index buffer if it's stored in a different format
+    //from the one requested, eg compact model binaries use uint16
+    template <typename Src, typename Dst>
+    void readIndices(std::uint32_t count, std::vector<Dst>& dst)
+    {
+        if constexpr (std::is_same<Src, Dst>::value)
+        {
+            glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, count * sizeof(Dst), dst.data()));
+        }
+        else
+        {
+            std::vector<Src> temp(count);
+            glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, count * sizeof(Src), temp.data()));
+            std::transform(temp.begin(), temp.end(), dst.begin(), [](Src s) {return static_cast<Dst>(s); });
+        }
+    }
+
     template <typename T>
     void read(const Data& meshData, std::vector<float>& destVerts, std::vector<std::vector<T>>& destIndices)
     {
@@ -50,9 +70,18 @@ namespace
             || std::is_same<T, std::uint32_t>::value, "must be uint8, uint16 or uint32");
 
         destVerts.clear();
-        destVerts.resize(meshData.vertexCount * (meshData.vertexSize / sizeof(float)));
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
-        glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, meshData.vertexCount * meshData.vertexSize, destVerts.data()));
+        if (meshData.packedVertexSize != 0)
+        {
+            std::vector<std::uint8_t> temp(meshData.vertexCount * meshData.packedVertexSize);
+            glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, temp.size(), temp.data()));
+            cro::Detail::CompactVertex::unpack(temp.data(), temp.size(), meshData, destVerts);
+        }
+        else
+        {
+            destVerts.resize(meshData.vertexCount * (meshData.vertexSize / sizeof(float)));
+            glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, meshData.vertexCount * meshData.vertexSize, destVerts.data()));
+        }
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
 
         destIndices.clear();
@@ -62,12 +91,67 @@ namespace
         {
             destIndices[i].resize(meshData.indexData[i].indexCount);
             glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.indexData[i].ibo));
-            glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, meshData.indexData[i].indexCount * sizeof(T), destIndices[i].data()));
+            switch (meshData.indexData[i].format)
+            {
+            default:
+            case GL_UNSIGNED_INT:
+                readIndices<std::uint32_t>(meshData.indexData[i].indexCount, destIndices[i]);
+                break;
+            case GL_UNSIGNED_SHORT:
+                readIndices<std::uint16_t>(meshData.indexData[i].indexCount, destIndices[i]);
+                break;
+            case GL_UNSIGNED_BYTE:
+                readIndices<std::uint8_t>(meshData.indexData[i].indexCount, destIndices[i]);
+                break;
+            }
         }
         glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
     }
 }
 
+std::size_t cro::Mesh::getVertexStride(const Data& meshData)
+{
+    return meshData.packedVertexSize != 0 ? meshData.packedVertexSize : meshData.vertexSize;
+}
+
+std::size_t cro::Mesh::getAttributeSize(const Data& meshData, std::int32_t attribute)
+{
+    std::size_t componentSize = sizeof(float);
+    switch (meshData.attributeFormats[attribute].type)
+    {
+    default: break;
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE:
+        componentSize = 1;
+        break;
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_HALF_FLOAT:
+        componentSize = 2;
+        break;
+    }
+
+    //packed attributes are aligned to 4 bytes
+    return ((meshData.attributes[attribute] * componentSize) + 3) & ~std::size_t(3);
+}
+
+void cro::Mesh::writeVertexData(const Data& meshData, const std::vector<float>& vertexData)
+{
+    CRO_ASSERT(vertexData.size() == meshData.vertexCount * (meshData.vertexSize / sizeof(float)), "");
+
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
+    if (meshData.packedVertexSize != 0)
+    {
+        std::vector<std::uint8_t> temp;
+        cro::Detail::CompactVertex::pack(vertexData, meshData, temp);
+        glCheck(glBufferData(GL_ARRAY_BUFFER, temp.size(), temp.data(), GL_STATIC_DRAW));
+    }
+    else
+    {
+        glCheck(glBufferData(GL_ARRAY_BUFFER, meshData.vertexCount * meshData.vertexSize, vertexData.data(), GL_STATIC_DRAW));
+    }
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+}
 
 void cro::Mesh::readVertexData(const Data& meshData, std::vector<float>& destVerts, std::vector<std::vector<std::uint8_t>>& destIndices)
 {
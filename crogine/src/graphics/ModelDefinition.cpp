@@ -310,6 +310,25 @@ bool ModelDefinition::loadFromFile(const std::string& inPath, bool instanced, bo
         m_skeleton = skel;
     }
 
+    //start decoding all the textures on worker threads so they're
+    //decoded in parallel while the materials and shaders are created
+    for (const auto& mat : materials)
+    {
+        for (const auto& p : mat.getProperties())
+        {
+            const auto& name = Util::String::toLower(p.getName());
+            if (name == "diffuse"
+                || name == "mask"
+                || name == "normal"
+                || name == "lightmap")
+            {
+                auto filepath = p.getValue<std::string>();
+                updateLocalPath(filepath);
+                m_resources.textures.preload(filepath);
+            }
+        }
+    }
+
     for (auto& mat : materials)
     {
         ShaderResource::BuiltIn shaderType = useDeferredShaders ? ShaderResource::UnlitDeferred : ShaderResource::Unlit;
@@ -77,40 +77,45 @@ namespace
 
     std::string vendorDef;
     std::string vendorInfo;
-}
 
-Shader::Shader()
-    : m_handle  (0),
-    m_attribMap ({})
-{
-    if (vendorDef.empty())
+    //queried when the first shader is compiled rather than on
+    //construction so that a Shader may be created without a GL context
+    void detectVendor()
     {
-        //crude but covers most cases
-        std::string vendor = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
-        vendor += " - ";
-        vendor += reinterpret_cast<const char*>(glGetString(GL_RENDERER));
-        vendorInfo = vendor;
-        
-        vendor = Util::String::toLower(vendor);
-        if (vendor.find("amd") != std::string::npos)
-        {
-            vendorDef = "#define GPU_AMD\n";
-        }
-        else if (vendor.find("nvidia") != std::string::npos)
-        {
-            vendorDef = "#define GPU_NVIDIA\n";
-        }
-        else if (vendor.find("intel") != std::string::npos)
+        if (vendorDef.empty())
         {
-            vendorDef = "#define GPU_INTEL\n";
-        }
-        else
-        {
-            vendorDef = "#define GPU_UNKNOWN\n";
+            //crude but covers most cases
+            std::string vendor = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
+            vendor += " - ";
+            vendor += reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+            vendorInfo = vendor;
+        
+            vendor = Util::String::toLower(vendor);
+            if (vendor.find("amd") != std::string::npos)
+            {
+                vendorDef = "#define GPU_AMD\n";
+            }
+            else if (vendor.find("nvidia") != std::string::npos)
+            {
+                vendorDef = "#define GPU_NVIDIA\n";
+            }
+            else if (vendor.find("intel") != std::string::npos)
+            {
+                vendorDef = "#define GPU_INTEL\n";
+            }
+            else
+            {
+                vendorDef = "#define GPU_UNKNOWN\n";
+            }
+            LOG("Shader " + vendorDef, Logger::Type::Info);
         }
-        LOG("Shader " + vendorDef, Logger::Type::Info);
     }
+}
 
+Shader::Shader()
+    : m_handle  (0),
+    m_attribMap ({})
+{
     resetAttribMap();
 }
 
@@ -251,6 +256,8 @@ bool Shader::loadFromSource(const char* vertex, const char* geometry, const char
         resetUniformMap();
     }
 
+    detectVendor();
+
     //compile vert shader
     GLuint vertID = glCreateShader(GL_VERTEX_SHADER);
 
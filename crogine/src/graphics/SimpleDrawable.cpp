@@ -28,6 +28,7 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include "../detail/GLCheck.hpp"
+#include "shaders/Sprite.hpp"
 
 #include <crogine/core/App.hpp>
 
@@ -44,9 +45,11 @@ namespace
 {
     std::int32_t activeTextureShader = 0;
     std::int32_t activeColourShader = 0;
+    std::int32_t activeSDFShader = 0;
 
     std::unique_ptr<Shader> textureShader;
     std::unique_ptr<Shader> colourShader;
+    std::unique_ptr<Shader> sdfShader;
 
     const std::string ShaderVertex =
         R"(
@@ -133,6 +136,26 @@ namespace
         }
     }
 
+    void increaseSDFShader()
+    {
+        if (activeSDFShader == 0)
+        {
+            sdfShader = std::make_unique<Shader>();
+            sdfShader->loadFromString(ShaderVertex, Shaders::Text::SDFFragment);
+        }
+        activeSDFShader++;
+    }
+
+    void decreaseSDFShader()
+    {
+        activeSDFShader--;
+
+        if (activeSDFShader == 0)
+        {
+            sdfShader.reset();
+        }
+    }
+
     //TODO move this to its own header as it is shared/duplicated in RenderSystem2D
     glm::ivec2 mapCoordsToPixel(glm::vec2 coord, const glm::mat4& viewProjectionMatrix, IntRect viewport)
     {
@@ -187,6 +210,11 @@ SimpleDrawable::~SimpleDrawable()
     {
         decreaseColourShader();
     }
+    else if (sdfShader &&
+        m_uniforms.shaderID == sdfShader->getGLHandle())
+    {
+        decreaseSDFShader();
+    }
 }
 
 //public
@@ -219,6 +247,11 @@ bool SimpleDrawable::setShader(const Shader& shader)
     {
         decreaseColourShader();
     }
+    else if (sdfShader &&
+        m_uniforms.shaderID == sdfShader->getGLHandle())
+    {
+        decreaseSDFShader();
+    }
 
 
 
@@ -300,6 +333,25 @@ void SimpleDrawable::setTexture(TextureID texture)
     }
 }
 
+void SimpleDrawable::setSDFShader(bool enabled)
+{
+    if (enabled)
+    {
+        if ((textureShader && m_uniforms.shaderID == textureShader->getGLHandle())
+            || (colourShader && m_uniforms.shaderID == colourShader->getGLHandle()))
+        {
+            increaseSDFShader();
+            setShader(*sdfShader);
+        }
+    }
+    else if (sdfShader &&
+        m_uniforms.shaderID == sdfShader->getGLHandle())
+    {
+        increaseTextureShader();
+        setShader(*textureShader);
+    }
+}
+
 void SimpleDrawable::setPrimitiveType(std::uint32_t primitiveType)
 {
     CRO_ASSERT(primitiveType >= GL_POINTS && primitiveType <= GL_TRIANGLE_FAN, "");
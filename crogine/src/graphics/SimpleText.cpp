@@ -251,6 +251,7 @@ void SimpleText::updateVertices()
         //resize the texture and we want to know about it :)
         m_fontTexture = &m_context.font->getTexture(m_context.charSize);
         setTexture(*m_fontTexture);
+        setSDFShader(m_context.font->isSDF());
 
         std::vector<Vertex2D> verts;
         m_localBounds = Detail::Text::updateVertices(verts, m_context);
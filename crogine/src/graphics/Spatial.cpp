@@ -28,6 +28,7 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include <crogine/core/Log.hpp>
+#include <crogine/detail/Assert.hpp>
 
 #include <crogine/graphics/Spatial.hpp>
 
@@ -35,6 +36,19 @@ source distribution.
 #include <crogine/detail/glm/geometric.hpp>
 #include <crogine/detail/glm/gtx/norm.hpp>
 
+#include <algorithm>
+
+#if defined(__AVX__)
+#define CRO_CULL_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CRO_CULL_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CRO_CULL_NEON
+#include <arm_neon.h>
+#endif
+
 using namespace cro;
 
 Sphere::Sphere()
@@ -89,8 +103,116 @@ bool Sphere::contains(glm::vec3 point) const
     return pointLen < (radius * radius);
 }
 
+void SphereBatch::clear()
+{
+    x.clear();
+    y.clear();
+    z.clear();
+    radius.clear();
+}
+
+void SphereBatch::reserve(std::size_t count)
+{
+    x.reserve(count);
+    y.reserve(count);
+    z.reserve(count);
+    radius.reserve(count);
+}
+
+void SphereBatch::push_back(const Sphere& sphere)
+{
+    x.push_back(sphere.centre.x);
+    y.push_back(sphere.centre.y);
+    z.push_back(sphere.centre.z);
+    radius.push_back(sphere.radius);
+}
+
 namespace
 {
+    //number of set bits in each nibble value
+    constexpr std::array<std::uint32_t, 16u> BitCount =
+    {
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+    };
+
+    //returns a mask with the bit set for each sphere
+    //which is not entirely behind one of the planes
+#if defined(CRO_CULL_AVX)
+    constexpr std::size_t BlockSize = 8;
+    inline std::uint32_t cullBlock(const Frustum& frustum, const SphereBatch& spheres, std::size_t i)
+    {
+        const auto x = _mm256_loadu_ps(&spheres.x[i]);
+        const auto y = _mm256_loadu_ps(&spheres.y[i]);
+        const auto z = _mm256_loadu_ps(&spheres.z[i]);
+        const auto r = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&spheres.radius[i]));
+
+        auto result = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const auto& p : frustum)
+        {
+            auto d = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(p.x)), _mm256_mul_ps(y, _mm256_set1_ps(p.y)));
+            d = _mm256_add_ps(_mm256_add_ps(d, _mm256_mul_ps(z, _mm256_set1_ps(p.z))), _mm256_set1_ps(p.w));
+            result = _mm256_and_ps(result, _mm256_cmp_ps(d, r, _CMP_GE_OQ));
+        }
+        return static_cast<std::uint32_t>(_mm256_movemask_ps(result));
+    }
+#elif defined(CRO_CULL_SSE)
+    constexpr std::size_t BlockSize = 4;
+    inline std::uint32_t cullBlock(const Frustum& frustum, const SphereBatch& spheres, std::size_t i)
+    {
+        const auto x = _mm_loadu_ps(&spheres.x[i]);
+        const auto y = _mm_loadu_ps(&spheres.y[i]);
+        const auto z = _mm_loadu_ps(&spheres.z[i]);
+        const auto r = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&spheres.radius[i]));
+
+        auto result = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const auto& p : frustum)
+        {
+            auto d = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(p.x)), _mm_mul_ps(y, _mm_set1_ps(p.y)));
+            d = _mm_add_ps(_mm_add_ps(d, _mm_mul_ps(z, _mm_set1_ps(p.z))), _mm_set1_ps(p.w));
+            result = _mm_and_ps(result, _mm_cmpge_ps(d, r));
+        }
+        return static_cast<std::uint32_t>(_mm_movemask_ps(result));
+    }
+#elif defined(CRO_CULL_NEON)
+    constexpr std::size_t BlockSize = 4;
+    inline std::uint32_t cullBlock(const Frustum& frustum, const SphereBatch& spheres, std::size_t i)
+    {
+        const auto x = vld1q_f32(&spheres.x[i]);
+        const auto y = vld1q_f32(&spheres.y[i]);
+        const auto z = vld1q_f32(&spheres.z[i]);
+        const auto r = vnegq_f32(vld1q_f32(&spheres.radius[i]));
+
+        auto result = vdupq_n_u32(0xffffffff);
+        for (const auto& p : frustum)
+        {
+            auto d = vaddq_f32(vmulq_f32(x, vdupq_n_f32(p.x)), vmulq_f32(y, vdupq_n_f32(p.y)));
+            d = vaddq_f32(vaddq_f32(d, vmulq_f32(z, vdupq_n_f32(p.z))), vdupq_n_f32(p.w));
+            result = vandq_u32(result, vcgeq_f32(d, r));
+        }
+        return (vgetq_lane_u32(result, 0) & 1)
+            | (vgetq_lane_u32(result, 1) & 2)
+            | (vgetq_lane_u32(result, 2) & 4)
+            | (vgetq_lane_u32(result, 3) & 8);
+    }
+#else
+    constexpr std::size_t BlockSize = 0;
+    inline std::uint32_t cullBlock(const Frustum&, const SphereBatch&, std::size_t) { return 0; }
+#endif
+
+    inline bool cullSphere(const Frustum& frustum, const SphereBatch& spheres, std::size_t i)
+    {
+        for (const auto& p : frustum)
+        {
+            //same order of operations as the vector path
+            const float d = ((p.x * spheres.x[i] + p.y * spheres.y[i]) + p.z * spheres.z[i]) + p.w;
+            if (!(d >= -spheres.radius[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     //used to calculate the AABB for a frustum.
     constexpr std::array ClipPoints =
     {
@@ -237,4 +359,37 @@ Box Spatial::updateFrustum(std::array<Plane, 6u>& frustum, glm::mat4 viewProj)
         });
 
     return { glm::vec3(minX->x, minY->y, minZ->z), glm::vec3(maxX->x, maxY->y, maxZ->z) };
-}
\ No newline at end of file
+}
+std::size_t Spatial::intersects(const Frustum& frustum, const SphereBatch& spheres, std::vector<std::uint32_t>& visibility)
+{
+    const auto count = spheres.size();
+    CRO_ASSERT(spheres.x.size() == count && spheres.y.size() == count && spheres.z.size() == count, "");
+
+    visibility.resize((count + 31) / 32);
+    std::fill(visibility.begin(), visibility.end(), 0u);
+
+    std::size_t visibleCount = 0;
+    std::size_t i = 0;
+
+    if constexpr (BlockSize != 0)
+    {
+        //blocks are a factor of 32 so never straddle an element of the mask
+        for (; i + BlockSize <= count; i += BlockSize)
+        {
+            const auto bits = cullBlock(frustum, spheres, i);
+            visibility[i / 32] |= bits << (i % 32);
+            visibleCount += BitCount[bits & 0xf] + BitCount[(bits >> 4) & 0xf];
+        }
+    }
+
+    for (; i < count; ++i)
+    {
+        if (cullSphere(frustum, spheres, i))
+        {
+            visibility[i / 32] |= (1u << (i % 32));
+            visibleCount++;
+        }
+    }
+
+    return visibleCount;
+}
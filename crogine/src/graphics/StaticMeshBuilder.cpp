@@ -28,9 +28,12 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include "../detail/StaticMeshFile.hpp"
+#include "../detail/CompactVertex.hpp"
 
 #include <crogine/graphics/StaticMeshBuilder.hpp>
+#include <crogine/core/Log.hpp>
 #include <crogine/detail/OpenGL.hpp>
+#include <crogine/detail/ModelBinary.hpp>
 
 #include <crogine/detail/glm/geometric.hpp>
 
@@ -46,6 +49,31 @@ StaticMeshBuilder::StaticMeshBuilder(const std::string& path)
     m_uid = hashAttack(path);
 }
 
+//public
+bool StaticMeshBuilder::write(const Mesh::Data& meshData, const std::string& path, bool compact)
+{
+    const auto flags = static_cast<std::uint8_t>(meshData.attributeFlags);
+    const auto layout = Detail::getCMFLayout(flags);
+    if (meshData.attributes != layout.attributes
+        || meshData.attributeFlags > 0xff)
+    {
+        LogE << path << ": mesh vertex layout cannot be stored in a static mesh" << std::endl;
+        return false;
+    }
+
+    if (meshData.submeshCount > std::numeric_limits<std::uint8_t>::max())
+    {
+        LogE << path << ": too many sub-meshes" << std::endl;
+        return false;
+    }
+
+    Detail::MeshFile meshFile;
+    meshFile.flags = flags;
+    meshFile.arrayCount = static_cast<std::uint8_t>(meshData.submeshCount);
+    Mesh::readVertexData(meshData, meshFile.vboData, meshFile.indexArrays);
+
+    return Detail::writeCMF(path, meshFile, compact);
+}
 
 //private
 Mesh::Data StaticMeshBuilder::build() const
@@ -55,52 +83,38 @@ Mesh::Data StaticMeshBuilder::build() const
     {
         CRO_ASSERT(meshFile.flags && (meshFile.flags & VertexProperty::Position), "Invalid flag value");
 
-        Mesh::Data meshData;
-        meshData.attributes[Mesh::Position] = 3;
-        meshData.attributeFlags = VertexProperty::Position;
-        if (meshFile.flags & VertexProperty::Colour)
-        {
-            meshData.attributes[Mesh::Colour] = 3;
-            meshData.attributeFlags |= VertexProperty::Colour;
-        }
-
-        if (meshFile.flags & VertexProperty::Normal)
-        {
-            meshData.attributes[Mesh::Normal] = 3;
-            meshData.attributeFlags |= VertexProperty::Normal;
-        }
-
-        if (meshFile.flags & (VertexProperty::Tangent | VertexProperty::Bitangent))
-        {
-            meshData.attributes[Mesh::Tangent] = 3;
-            meshData.attributes[Mesh::Bitangent] = 3;
-            meshData.attributeFlags |= VertexProperty::Tangent | VertexProperty::Bitangent;
-        }
+        auto meshData = Detail::getCMFLayout(meshFile.flags);
+        meshData.primitiveType = GL_TRIANGLES;
+        meshData.vertexCount = meshFile.vboData.size() / (meshData.vertexSize / sizeof(float));
 
-        if (meshFile.flags & VertexProperty::UV0)
+        //compact files are uploaded as they are stored
+        if (!meshFile.packedData.empty())
         {
-            meshData.attributes[Mesh::UV0] = 2;
-            meshData.attributeFlags |= VertexProperty::UV0;
+            Detail::CompactVertex::setPackedFormat(meshData, meshFile.vertexEncoding);
+            createVBO(meshData, meshFile.packedData);
         }
-        if (meshFile.flags & VertexProperty::UV1)
+        else
         {
-            meshData.attributes[Mesh::UV1] = 2;
-            meshData.attributeFlags |= VertexProperty::UV1;
+            createVBO(meshData, meshFile.vboData);
         }
 
-        meshData.primitiveType = GL_TRIANGLES;       
-        meshData.vertexSize = getVertexSize(meshData.attributes);
-        meshData.vertexCount = meshFile.vboData.size() / (meshData.vertexSize / sizeof(float));
-        createVBO(meshData, meshFile.vboData);
-
         meshData.submeshCount = meshFile.arrayCount;
         for (auto i = 0; i < meshFile.arrayCount; ++i)
         {
-            meshData.indexData[i].format = GL_UNSIGNED_INT;
             meshData.indexData[i].primitiveType = meshData.primitiveType;
             meshData.indexData[i].indexCount = static_cast<std::uint32_t>(meshFile.indexArrays[i].size());
 
-            createIBO(meshData, meshFile.indexArrays[i].data(), i, sizeof(std::uint32_t));
+            if (meshFile.vertexEncoding & Detail::ModelBinary::CompactIndices)
+            {
+                std::vector<std::uint16_t> indices(meshFile.indexArrays[i].begin(), meshFile.indexArrays[i].end());
+                meshData.indexData[i].format = GL_UNSIGNED_SHORT;
+                createIBO(meshData, indices.data(), i, sizeof(std::uint16_t));
+            }
+            else
+            {
+                meshData.indexData[i].format = GL_UNSIGNED_INT;
+                createIBO(meshData, meshFile.indexArrays[i].data(), i, sizeof(std::uint32_t));
+            }
         }
 
         //boundingbox / sphere
@@ -30,22 +30,115 @@ source distribution.
 #include <crogine/graphics/Texture.hpp>
 #include <crogine/graphics/Image.hpp>
 #include <crogine/graphics/ImageArray.hpp>
+#include <crogine/graphics/CompressedImage.hpp>
 #include <crogine/graphics/Colour.hpp>
 #include <crogine/detail/Assert.hpp>
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/ImageDecoder.hpp"
 #include "../detail/stb_image.h"
 #include "../detail/stb_image_write.h"
 #include "../detail/SDLImageRead.hpp"
 #include <SDL_rwops.h>
 
 #include <algorithm>
-#include <filesystem>
+#include <cstring>
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+#ifndef GL_COMPRESSED_RED_RGTC1
+#define GL_COMPRESSED_RED_RGTC1 0x8DBB
+#define GL_COMPRESSED_RG_RGTC2 0x8DBD
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
 
 using namespace cro;
 
 namespace
 {
+    bool hasExtension(const char* name)
+    {
+        GLint count = 0;
+        glCheck(glGetIntegerv(GL_NUM_EXTENSIONS, &count));
+        for (auto i = 0; i < count; ++i)
+        {
+            const auto* ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (ext && std::strcmp(ext, name) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool versionAtLeast(std::int32_t major, std::int32_t minor)
+    {
+        return GLVersion.major > major
+            || (GLVersion.major == major && GLVersion.minor >= minor);
+    }
+
+    //returns 0 if the current context doesn't support the format
+    GLenum getCompressedFormat(CompressedImage::Format format)
+    {
+        //queried once as the extension list is the same for all contexts we create
+        struct FormatSupport final
+        {
+            bool s3tc = false;
+            bool rgtc = false;
+            bool bptc = false;
+            bool etc2 = false;
+
+            FormatSupport()
+            {
+                s3tc = hasExtension("GL_EXT_texture_compression_s3tc");
+#ifdef PLATFORM_DESKTOP
+                rgtc = true; //core since 3.0
+                bptc = versionAtLeast(4, 2) || hasExtension("GL_ARB_texture_compression_bptc");
+                etc2 = versionAtLeast(4, 3) || hasExtension("GL_ARB_ES3_compatibility");
+#else
+                rgtc = hasExtension("GL_EXT_texture_compression_rgtc");
+                bptc = hasExtension("GL_EXT_texture_compression_bptc");
+                etc2 = versionAtLeast(3, 0);
+#endif
+            }
+        };
+        static const FormatSupport support;
+
+        switch (format)
+        {
+        default: return 0;
+        case CompressedImage::Format::BC1:
+            return support.s3tc ? GL_COMPRESSED_RGBA_S3TC_DXT1_EXT : 0;
+        case CompressedImage::Format::BC2:
+            return support.s3tc ? GL_COMPRESSED_RGBA_S3TC_DXT3_EXT : 0;
+        case CompressedImage::Format::BC3:
+            return support.s3tc ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : 0;
+        case CompressedImage::Format::BC4:
+            return support.rgtc ? GL_COMPRESSED_RED_RGTC1 : 0;
+        case CompressedImage::Format::BC5:
+            return support.rgtc ? GL_COMPRESSED_RG_RGTC2 : 0;
+        case CompressedImage::Format::BC7:
+            return support.bptc ? GL_COMPRESSED_RGBA_BPTC_UNORM : 0;
+        case CompressedImage::Format::ETC2_RGB:
+            return support.etc2 ? GL_COMPRESSED_RGB8_ETC2 : 0;
+        case CompressedImage::Format::ETC2_RGBA:
+            return support.etc2 ? GL_COMPRESSED_RGBA8_ETC2_EAC : 0;
+        }
+    }
+
     //std::uint32_t ensurePOW2(std::uint32_t size)
     //{
     //    /*std::uint32_t pow2 = 1;
@@ -65,7 +158,8 @@ Texture::Texture()
     m_type          (GL_UNSIGNED_BYTE),
     m_smooth        (false),
     m_repeated      (false),
-    m_hasMipMaps    (false)
+    m_hasMipMaps    (false),
+    m_compressed    (false)
 {
 
 }
@@ -77,7 +171,8 @@ Texture::Texture(Texture&& other) noexcept
     m_type      (other.m_type),
     m_smooth    (other.m_smooth),
     m_repeated  (other.m_repeated),
-    m_hasMipMaps(other.m_hasMipMaps)
+    m_hasMipMaps(other.m_hasMipMaps),
+    m_compressed(other.m_compressed)
 {
     other.m_size = glm::uvec2(0);
     other.m_format = ImageFormat::None;
@@ -86,6 +181,7 @@ Texture::Texture(Texture&& other) noexcept
     other.m_smooth = false;
     other.m_repeated = false;
     other.m_hasMipMaps = false;
+    other.m_compressed = false;
 }
 
 Texture& Texture::operator=(Texture&& other) noexcept
@@ -102,6 +198,7 @@ Texture& Texture::operator=(Texture&& other) noexcept
         m_smooth = other.m_smooth;
         m_repeated = other.m_repeated;
         m_hasMipMaps = other.m_hasMipMaps;
+        m_compressed = other.m_compressed;
 
         other.m_size = glm::uvec2(0);
         other.m_format = ImageFormat::None;
@@ -110,6 +207,7 @@ Texture& Texture::operator=(Texture&& other) noexcept
         other.m_smooth = false;
         other.m_repeated = false;
         other.m_hasMipMaps = false;
+        other.m_compressed = false;
     }
     return *this;
 }
@@ -143,6 +241,7 @@ void Texture::create(std::uint32_t width, std::uint32_t height, ImageFormat::Typ
 
     m_size = { width, height };
     m_format = format;
+    m_compressed = false;
 
     auto wrap = m_repeated ? GL_REPEAT : GL_CLAMP_TO_EDGE;
     auto smooth = m_smooth ? GL_LINEAR : GL_NEAREST;
@@ -179,27 +278,30 @@ void Texture::create(std::uint32_t width, std::uint32_t height, ImageFormat::Typ
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, smooth));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, smooth));
+    //reset in case this was previously loaded from a CompressedImage
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000));
     glCheck(glBindTexture(GL_TEXTURE_2D, 0));
 }
 
 bool Texture::loadFromFile(const std::string& filePath, bool createMipMaps)
 {
-    std::filesystem::path p(filePath);
-    auto path = FileSystem::getResourcePath();
-    //only add resource path if not done so already
-    if (!p.is_absolute() &&
-        filePath.find(path) == std::string::npos)
-    {
-        path += filePath;
-    }
-    else
+    const auto path = Detail::ImageDecoder::resolvePath(filePath);
+
+    //use the result of any background decode, else decode it now
+    std::unique_ptr<Detail::DecodedImage> image;
+    if (!Detail::ImageDecoder::getInstance().take(path, image))
     {
-        path = filePath;
+        image = Detail::ImageDecoder::decode(path);
     }
 
-    ImageArray<std::uint8_t> arr;
-    if (arr.loadFromFile(path, true))
+    if (image)
     {
+        if (image->isCompressed)
+        {
+            return loadFromCompressedImage(image->compressed, createMipMaps);
+        }
+
+        const auto& arr = image->pixels;
         m_type = GL_UNSIGNED_BYTE;
 
         auto size = arr.getDimensions();
@@ -225,6 +327,125 @@ bool Texture::loadFromImage(const Image& image, bool createMipMaps)
     return update(image.getPixelData(), createMipMaps);
 }
 
+bool Texture::loadFromCompressedImage(const CompressedImage& image, bool createMipMaps)
+{
+    if (image.getLevelCount() == 0)
+    {
+        LogE << "Failed creating texture from compressed image: Image is empty." << std::endl;
+        return false;
+    }
+
+    const auto size = image.getSize();
+    if (size.x > getMaxTextureSize() || size.y > getMaxTextureSize())
+    {
+        LogE << "Failed creating texture from compressed image: " << size.x << "x" << size.y << " is too large." << std::endl;
+        return false;
+    }
+
+    //blocks which couldn't be flipped on load are decompressed
+    //instead, as decompress() flips the decoded rows
+    const auto glFormat = getCompressedFormat(image.getFormat());
+    if (glFormat == 0
+        || image.needsRowFlip())
+    {
+        if (!image.canDecompress())
+        {
+            if (glFormat == 0)
+            {
+                LogE << "Failed creating texture from compressed image: format is not supported on this platform." << std::endl;
+            }
+            else
+            {
+                LogE << "Failed creating texture from compressed image: image can't be flipped, store it bottom up instead." << std::endl;
+            }
+            return false;
+        }
+
+        //upload the first level uncompressed and let update() take care of any mips
+        if (glFormat == 0)
+        {
+            LogW << "Compressed texture format not supported, decompressing on the CPU." << std::endl;
+        }
+        else
+        {
+            LogW << "Compressed image can't be flipped, decompressing on the CPU." << std::endl;
+        }
+        const auto pixels = image.decompress();
+
+        create(size.x, size.y, ImageFormat::RGBA);
+        m_type = GL_UNSIGNED_BYTE;
+        if (image.getLevelCount() == 1)
+        {
+            return update(pixels.data(), createMipMaps);
+        }
+
+        if (!update(pixels.data(), false))
+        {
+            return false;
+        }
+
+        glCheck(glBindTexture(GL_TEXTURE_2D, m_handle));
+        for (auto i = 1u; i < image.getLevelCount(); ++i)
+        {
+            const auto levelSize = image.getLevelSize(i);
+            const auto levelPixels = image.decompress(i);
+            glCheck(glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA, levelSize.x, levelSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, levelPixels.data()));
+        }
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.getLevelCount() - 1)));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_smooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST));
+        glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+        m_hasMipMaps = true;
+
+        return true;
+    }
+
+    if (!image.isBottomUp())
+    {
+        LogW << "Compressed image is stored top-down and will appear upside down." << std::endl;
+    }
+
+    if (!m_handle)
+    {
+        GLuint handle;
+        glCheck(glGenTextures(1, &handle));
+        m_handle = handle;
+    }
+
+    m_size = size;
+    m_format = image.getFormat() == CompressedImage::Format::BC1
+        || image.getFormat() == CompressedImage::Format::ETC2_RGB ? ImageFormat::RGB : ImageFormat::RGBA;
+    m_type = GL_UNSIGNED_BYTE;
+    m_compressed = true;
+
+    const auto levelCount = static_cast<GLint>(image.getLevelCount());
+    m_hasMipMaps = levelCount > 1;
+
+    const auto wrap = m_repeated ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+    const auto smooth = m_smooth ? GL_LINEAR : GL_NEAREST;
+    const auto minFilter = m_hasMipMaps ? (m_smooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST) : smooth;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_handle));
+    for (auto i = 0; i < levelCount; ++i)
+    {
+        const auto levelSize = image.getLevelSize(i);
+        glCheck(glCompressedTexImage2D(GL_TEXTURE_2D, i, glFormat, levelSize.x, levelSize.y, 0,
+            static_cast<GLsizei>(image.getLevelByteCount(i)), image.getLevelData(i)));
+    }
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, smooth));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
+    glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+
+    if (createMipMaps && !m_hasMipMaps)
+    {
+        LogW << "Mip maps can't be generated for compressed textures." << std::endl;
+    }
+
+    return true;
+}
+
 bool Texture::update(const std::uint8_t* pixels, bool createMipMaps, URect area)
 {
     m_type = GL_UNSIGNED_BYTE;
@@ -396,6 +617,7 @@ void Texture::swap(Texture& other)
     std::swap(m_smooth, other.m_smooth);
     std::swap(m_repeated, other.m_repeated);
     std::swap(m_hasMipMaps, other.m_hasMipMaps);
+    std::swap(m_compressed, other.m_compressed);
 }
 
 FloatRect Texture::getNormalisedSubrect(FloatRect rect) const
@@ -488,6 +710,12 @@ bool Texture::saveToBuffer(std::vector<float>& dst) const
 //private
 bool Texture::update(const void* pixels, bool createMipMaps, URect area)
 {
+    if (m_compressed)
+    {
+        Logger::log("Failed updating image, compressed textures can't be updated", Logger::Type::Error);
+        return false;
+    }
+
     if (area.left + area.width > m_size.x)
     {
         Logger::log("Failed updating image, source pixels too wide", Logger::Type::Error);
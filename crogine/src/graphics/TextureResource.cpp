@@ -30,6 +30,8 @@ source distribution.
 #include <crogine/graphics/TextureResource.hpp>
 #include <crogine/graphics/Image.hpp>
 
+#include "../detail/ImageDecoder.hpp"
+
 using namespace cro;
 
 namespace
@@ -43,9 +45,26 @@ TextureResource::TextureResource()
 
 }
 
+TextureResource::~TextureResource()
+{
+    //claim any images which were never uploaded so the decoder doesn't hold on to them
+    auto& decoder = Detail::ImageDecoder::getInstance();
+    for (const auto& [id, pending] : m_pendingTextures)
+    {
+        std::unique_ptr<Detail::DecodedImage> image;
+        decoder.take(Detail::ImageDecoder::resolvePath(pending.path), image);
+    }
+}
+
 //public
 bool TextureResource::load(std::uint32_t id, const std::string& path, bool createMipMaps)
 {
+    if (m_pendingTextures.count(id) != 0)
+    {
+        const auto pendingPath = m_pendingTextures.at(id).path;
+        return loadPending(id) && path == pendingPath;
+    }
+
     if (m_textures.count(id) == 0)
     {
         std::unique_ptr<Texture> tex = std::make_unique<Texture>();
@@ -68,8 +87,74 @@ bool TextureResource::load(std::uint32_t id, const std::string& path, bool creat
     return false;
 }
 
+bool TextureResource::loadAsync(std::uint32_t id, const std::string& path, bool createMipMaps)
+{
+    if (m_textures.count(id) != 0)
+    {
+        const auto& currentPath = m_textures.at(id).first;
+        LogI << "Texture ID " << id << " already assigned to " << currentPath << std::endl;
+        return path == currentPath;
+    }
+
+    if (m_pendingTextures.count(id) != 0)
+    {
+        const auto& currentPath = m_pendingTextures.at(id).path;
+        LogI << "Texture ID " << id << " already assigned to " << currentPath << std::endl;
+        return path == currentPath;
+    }
+
+    Detail::ImageDecoder::getInstance().predecode(Detail::ImageDecoder::resolvePath(path));
+    m_pendingTextures.insert(std::make_pair(id, PendingTexture{ path, createMipMaps }));
+    return true;
+}
+
+std::size_t TextureResource::processPending(std::size_t maxCount)
+{
+    const auto& decoder = Detail::ImageDecoder::getInstance();
+
+    std::vector<std::uint32_t> readyIDs;
+    for (const auto& [id, pending] : m_pendingTextures)
+    {
+        if (readyIDs.size() == maxCount)
+        {
+            break;
+        }
+
+        if (decoder.isReady(Detail::ImageDecoder::resolvePath(pending.path)))
+        {
+            readyIDs.push_back(id);
+        }
+    }
+
+    for (auto id : readyIDs)
+    {
+        loadPending(id);
+    }
+
+    return m_pendingTextures.size();
+}
+
+void TextureResource::preload(const std::string& path)
+{
+    auto result = std::find_if(m_textures.begin(), m_textures.end(),
+        [&path](const auto& pair)
+        {
+            return pair.second.first == path;
+        });
+
+    if (result == m_textures.end())
+    {
+        Detail::ImageDecoder::getInstance().predecode(Detail::ImageDecoder::resolvePath(path));
+    }
+}
+
 Texture& TextureResource::get(std::uint32_t id)
 {
+    if (m_pendingTextures.count(id) != 0)
+    {
+        loadPending(id);
+    }
+
     if (m_textures.count(id) == 0)
     {
         //find the fallback
@@ -127,6 +212,16 @@ Colour TextureResource::getFallbackColour() const
 }
 
 //provate
+bool TextureResource::loadPending(std::uint32_t id)
+{
+    //erase first so load() doesn't find this again.
+    //load() takes the decoded image from the ImageDecoder
+    const auto pending = m_pendingTextures.at(id);
+    m_pendingTextures.erase(id);
+
+    return load(id, pending.path, pending.createMipMaps);
+}
+
 Texture& TextureResource::getFallbackTexture()
 {
     if (m_fallbackTextures.count(m_fallbackColour) == 0)
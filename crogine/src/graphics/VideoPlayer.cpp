@@ -37,6 +37,7 @@ source distribution.
 #include <crogine/core/FileSystem.hpp>
 #include <crogine/gui/Gui.hpp>
 
+#include <algorithm>
 #include <string>
 
 namespace
@@ -98,12 +99,25 @@ void main()
 using namespace cro;
 
 //C senor.
-void cro::videoCallback(plm_t* mpg, plm_frame_t* frame, void* user)
+void cro::videoCallback(plm_t*, plm_frame_t* frame, void* user)
 {
     auto* videoPlayer = static_cast<VideoPlayer*>(user);
-    videoPlayer->updateTexture(videoPlayer->m_y.getGLHandle(), &frame->y);
-    videoPlayer->updateTexture(videoPlayer->m_cb.getGLHandle(), &frame->cb);
-    videoPlayer->updateTexture(videoPlayer->m_cr.getGLHandle(), &frame->cr);
+    auto* output = videoPlayer->m_decodeFrame;
+    if (output)
+    {
+        //the planes are always the same size for a given file
+        //so the storage is only allocated for the first frame
+        const auto copyPlane = [](VideoPlayer::Frame::Plane& dst, const plm_plane_t& src)
+        {
+            dst.width = src.width;
+            dst.height = src.height;
+            dst.data.assign(src.data, src.data + (src.width * src.height));
+        };
+        copyPlane(output->y, frame->y);
+        copyPlane(output->cb, frame->cb);
+        copyPlane(output->cr, frame->cr);
+        output->hasImage = true;
+    }
 }
 
 void cro::audioCallback(plm_t*, plm_samples_t* samples, void* user)
@@ -113,11 +127,18 @@ void cro::audioCallback(plm_t*, plm_samples_t* samples, void* user)
 }
 
 VideoPlayer::VideoPlayer()
-    : m_plm				(nullptr),
+    : m_plm             (nullptr),
     m_looped            (false),
-    m_timeAccumulator	(0.f),
-    m_frameTime			(0.f),
-    m_state				(State::Stopped)
+    m_frameTime         (0.f),
+    m_duration          (0.f),
+    m_position          (0.f),
+    m_state             (State::Stopped),
+    m_decodeFrame       (nullptr),
+    m_presentTime       (0.0),
+    m_decodeTime        (0.0),
+    m_generation        (0),
+    m_ended             (false),
+    m_running           (false)
 {
     //TODO we don't really want to create a shader for EVERY instance
     //but on the other hand why would I play a lot of videos at once?
@@ -151,6 +172,7 @@ VideoPlayer::~VideoPlayer()
     if (m_plm)
     {
         stop();
+        stopThread();
 
         plm_destroy(m_plm);
     }
@@ -168,6 +190,7 @@ bool VideoPlayer::loadFromFile(const std::string& path)
     
     if (m_plm)
     {
+        stopThread();
         plm_destroy(m_plm);
         m_plm = nullptr;
     }	
@@ -211,6 +234,8 @@ bool VideoPlayer::loadFromFile(const std::string& path)
 
     
     m_frameTime = 1.f / frameRate;
+    m_duration = static_cast<float>(plm_get_duration(m_plm));
+    m_position = 0.f;
 
     //the plane sizes aren't actually the same
     //but this sets the texture property used
@@ -235,7 +260,10 @@ bool VideoPlayer::loadFromFile(const std::string& path)
         m_audioStream.init(ChannelCount, sampleRate);
         m_audioStream.hasAudio = true;
 
-        plm_set_audio_lead_time(m_plm, static_cast<double>(AudioBufferSize) / sampleRate);
+        //frames are decoded one frame ahead of being displayed
+        //so reduce the lead time to keep the audio in sync
+        const auto leadTime = (static_cast<double>(AudioBufferSize) / sampleRate) - m_frameTime;
+        plm_set_audio_lead_time(m_plm, std::max(0.0, leadTime));
     }
     else
     {
@@ -244,37 +272,41 @@ bool VideoPlayer::loadFromFile(const std::string& path)
 
     plm_set_loop(m_plm, m_looped ? 1 : 0);
 
+    resetQueue();
+    startThread();
+
     return true;
 }
 
 void VideoPlayer::update(float dt)
 {
-    m_timeAccumulator += dt;
-
-    static constexpr float MaxTime = 1.f;
-    if (m_timeAccumulator > MaxTime)
-    {
-        m_timeAccumulator = 0.f;
-    }
-
     if (m_plm)
     {
         CRO_ASSERT(m_frameTime > 0, "");
-        while (m_timeAccumulator > m_frameTime)
-        {
-            m_timeAccumulator -= m_frameTime;
 
+        bool ended = false;
+        {
+            std::scoped_lock lock(m_mutex);
             if (m_state == State::Playing)
             {
-                plm_decode(m_plm, m_frameTime);
-
-                updateBuffer();
-
-                if (plm_has_ended(m_plm))
+                //if we fell a long way behind skip ahead rather than
+                //trying to catch up by decoding every missed frame
+                static constexpr float MaxTime = 1.f;
+                if (dt > MaxTime)
                 {
-                    stop();
+                    m_decodeTime = m_presentTime + dt;
                 }
+                m_presentTime += dt;
             }
+            ended = m_ended;
+        }
+        m_condition.notify_one();
+
+        if (!presentFrame()
+            && ended)
+        {
+            //wait until the last frame has been shown before stopping
+            stop();
         }
     }
 }
@@ -297,8 +329,11 @@ void VideoPlayer::play()
         return;
     }
 
-    m_timeAccumulator = 0.f;
-    m_state = State::Playing;
+    {
+        std::scoped_lock lock(m_mutex);
+        m_state = State::Playing;
+    }
+    m_condition.notify_one();
     
     if (m_audioStream.hasAudio)
     {
@@ -310,6 +345,7 @@ void VideoPlayer::pause()
 {
     if (m_state == State::Playing)
     {
+        std::scoped_lock lock(m_mutex);
         m_state = State::Paused;
         m_audioStream.pause();
     }
@@ -319,13 +355,21 @@ void VideoPlayer::stop()
 {
     if (m_state != State::Stopped)
     {
-        m_state = State::Stopped;
+        {
+            std::scoped_lock lock(m_mutex);
+            m_state = State::Stopped;
+        }
         m_audioStream.stop();
 
         if (m_plm)
         {
             //rewind the file
-            plm_seek(m_plm, 0, FALSE);
+            {
+                std::scoped_lock lock(m_decodeMutex);
+                resetQueue();
+                plm_seek(m_plm, 0, FALSE);
+            }
+            m_position = 0.f;
 
             //clear the buffer else we repeat the last frame
             m_outputBuffer.clear();
@@ -338,31 +382,43 @@ void VideoPlayer::seek(float position)
 {
     if (m_plm)
     {
+        //the seek decodes the frame at the new position which
+        //is then displayed on the next update if we're playing
+        std::scoped_lock decodeLock(m_decodeMutex);
+        resetQueue();
+        {
+            std::scoped_lock lock(m_mutex);
+            m_decodeFrame = &m_frames[0];
+            m_decodeFrame->state = Frame::Decoding;
+        }
+
         plm_seek(m_plm, position, FALSE);
 
+        {
+            std::scoped_lock lock(m_mutex);
+            m_decodeFrame->time = m_presentTime;
+            m_decodeFrame->position = static_cast<float>(plm_get_time(m_plm));
+            m_decodeFrame->state = m_decodeFrame->hasImage ? Frame::Ready : Frame::Free;
+            m_decodeFrame = nullptr;
+            m_decodeTime = m_presentTime + m_frameTime;
+        }
+        m_position = static_cast<float>(plm_get_time(m_plm));
+
         if (m_state != State::Playing)
         {
-            updateBuffer();
+            presentFrame();
         }
     }
 }
 
 float VideoPlayer::getDuration() const
 {
-    if (m_plm)
-    {
-        return static_cast<float>(plm_get_duration(m_plm));
-    }
-    return 0.f;
+    return m_plm ? m_duration : 0.f;
 }
 
 float VideoPlayer::getPosition() const
 {
-    if (m_plm)
-    {
-        return static_cast<float>(plm_get_time(m_plm));
-    }
-    return 0.f;
+    return m_plm ? m_position.load() : 0.f;
 }
 
 void VideoPlayer::setLooped(bool looped)
@@ -371,16 +427,180 @@ void VideoPlayer::setLooped(bool looped)
 
     if (m_plm)
     {
+        std::scoped_lock lock(m_decodeMutex);
         plm_set_loop(m_plm, looped ? 1 : 0);
     }
 }
 
 //private
-void VideoPlayer::updateTexture(std::uint32_t textureID, plm_plane_t* plane)
+void VideoPlayer::startThread()
+{
+    CRO_ASSERT(!m_thread.joinable(), "");
+    m_running = true;
+    m_thread = std::thread(&VideoPlayer::threadFunc, this);
+}
+
+void VideoPlayer::stopThread()
+{
+    {
+        std::scoped_lock lock(m_mutex);
+        m_running = false;
+    }
+    m_condition.notify_one();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void VideoPlayer::threadFunc()
+{
+    while (m_running)
+    {
+        Frame* frame = nullptr;
+        double frameTime = 0.0;
+        std::uint32_t generation = 0;
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [&]() {return !m_running || canDecode(); });
+
+            if (!m_running)
+            {
+                break;
+            }
+
+            frame = &*std::find_if(m_frames.begin(), m_frames.end(), [](const Frame& f) {return f.state == Frame::Free; });
+            frame->state = Frame::Decoding;
+            frame->hasImage = false;
+
+            frameTime = m_decodeTime;
+            m_decodeTime += m_frameTime;
+            generation = m_generation;
+        }
+
+        bool ended = false;
+        float position = 0.f;
+        {
+            std::scoped_lock lock(m_decodeMutex);
+
+            //a seek or stop since the frame was claimed will have reset
+            //the queue, so carry on from the new position instead
+            if (generation != m_generation)
+            {
+                continue;
+            }
+
+            m_decodeFrame = frame;
+            plm_decode(m_plm, m_frameTime);
+            m_decodeFrame = nullptr;
+
+            ended = plm_has_ended(m_plm);
+            position = static_cast<float>(plm_get_time(m_plm));
+        }
+
+        std::scoped_lock lock(m_mutex);
+        if (generation == m_generation)
+        {
+            frame->time = frameTime;
+            frame->position = position;
+            frame->state = frame->hasImage ? Frame::Ready : Frame::Free;
+            m_ended = ended;
+        }
+    }
+}
+
+bool VideoPlayer::canDecode() const
+{
+    //only decode one frame ahead, else the audio gets ahead of the picture
+    return m_state == State::Playing
+        && !m_ended
+        && m_decodeTime < m_presentTime + m_frameTime
+        && std::any_of(m_frames.begin(), m_frames.end(), [](const Frame& f) {return f.state == Frame::Free; });
+}
+
+void VideoPlayer::resetQueue()
+{
+    std::scoped_lock lock(m_mutex);
+    for (auto& frame : m_frames)
+    {
+        frame.state = Frame::Free;
+        frame.hasImage = false;
+    }
+    m_presentTime = 0.0;
+    m_decodeTime = 0.0;
+    m_ended = false;
+    m_generation++;
+}
+
+bool VideoPlayer::presentFrame()
+{
+    //find the most recent frame which is due, and drop any older ones
+    Frame* frame = nullptr;
+    bool pending = false;
+    {
+        std::scoped_lock lock(m_mutex);
+        for (auto& f : m_frames)
+        {
+            if (f.state == Frame::Ready)
+            {
+                if (f.time + m_frameTime <= m_presentTime
+                    || m_state != State::Playing)
+                {
+                    if (frame == nullptr
+                        || frame->time < f.time)
+                    {
+                        if (frame)
+                        {
+                            frame->state = Frame::Free;
+                        }
+                        frame = &f;
+                    }
+                    else
+                    {
+                        f.state = Frame::Free;
+                    }
+                }
+                else
+                {
+                    pending = true;
+                }
+            }
+            else if (f.state == Frame::Decoding)
+            {
+                pending = true;
+            }
+        }
+
+        if (frame)
+        {
+            frame->state = Frame::Presenting;
+        }
+    }
+
+    if (frame)
+    {
+        updateTexture(m_y.getGLHandle(), frame->y);
+        updateTexture(m_cb.getGLHandle(), frame->cb);
+        updateTexture(m_cr.getGLHandle(), frame->cr);
+        updateBuffer();
+        m_position = frame->position;
+
+        {
+            std::scoped_lock lock(m_mutex);
+            frame->state = Frame::Free;
+        }
+        m_condition.notify_one();
+    }
+
+    return frame != nullptr || pending;
+}
+
+void VideoPlayer::updateTexture(std::uint32_t textureID, const Frame::Plane& plane)
 {
     CRO_ASSERT(textureID != 0, "");
     glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, plane->width, plane->height, 0, GL_RED, GL_UNSIGNED_BYTE, plane->data);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, plane.width, plane.height, 0, GL_RED, GL_UNSIGNED_BYTE, plane.data.data());
 }
 
 void VideoPlayer::updateBuffer()
@@ -96,21 +96,23 @@ namespace cro::Shaders::Text
             //FRAG_OUT = v_colour;
         })";
 
+    //expects the distance in the alpha channel, as created by Font in SDF mode
     inline const std::string SDFFragment = R"(
         uniform sampler2D u_texture;
-                
+
         VARYING_IN LOW vec4 v_colour;
-        VARYING_IN MED vec2 v_texCoord0;
+        VARYING_IN MED vec2 v_texCoord;
         OUTPUT
 
-        MED float spread = 4.0;
-        MED float scale = 5.0;
-        MED float smoothing = 1.0 / 16.0;
-
         void main()
         {
-            //smoothing = 0.25 / (spread * scale);
-            MED float value = TEXTURE(u_texture, v_texCoord0).r;
+            MED float value = TEXTURE(u_texture, v_texCoord).a;
+        #if defined(MOBILE)
+            MED float smoothing = 1.0 / 16.0;
+        #else
+            //keeps the edge roughly one screen pixel wide at any scale
+            MED float smoothing = clamp(fwidth(value) * 0.7, 0.001, 0.5);
+        #endif
             MED float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, value);
             FRAG_OUT = vec4(v_colour.rgb, v_colour.a * alpha);
         })";
@@ -34,6 +34,12 @@ using namespace cro;
 
 GuiClient::~GuiClient()
 {
+    //there's nothing to remove from if running headless
+    if (!App::isValid())
+    {
+        return;
+    }
+
     if (m_wantsTabsRemoving)
     {
         App::removeConsoleTab(this);
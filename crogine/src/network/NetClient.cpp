@@ -51,6 +51,8 @@ NetClient::NetClient()
 
 NetClient::~NetClient()
 {
+    releaseBatch();
+
     if (m_peer.m_peer)
     {
         disconnect();
@@ -69,6 +71,7 @@ bool NetClient::create(std::size_t maxChannels, std::size_t maxClients, std::uin
     if (m_client)
     {
         disconnect();
+        releaseBatch();
         enet_host_destroy(m_client);
     }
 
@@ -189,6 +192,12 @@ bool NetClient::pollEvent(NetEvent& evt)
 {
     if (!m_client) return false;
 
+    //finish reading any batch we're part way through
+    if (readBatch(evt))
+    {
+        return true;
+    }
+
     ENetEvent hostEvt;
     if (enet_host_service(m_client, &hostEvt, 0) > 0)
     //if (!m_activeBuffer.empty())
@@ -208,6 +217,23 @@ bool NetClient::pollEvent(NetEvent& evt)
             evt.type = NetEvent::ClientDisconnect;            
             break;
         case ENET_EVENT_TYPE_RECEIVE:
+            if (hostEvt.packet->dataLength != 0
+                && hostEvt.packet->data[0] == NetBatchPacketID)
+            {
+                //hold on to this and return the first of its packets
+                Detail::retainBatch(hostEvt.packet);
+                m_receivedBatch.packet = hostEvt.packet;
+                m_receivedBatch.offset = sizeof(std::uint8_t);
+                m_receivedBatch.channel = hostEvt.channelID;
+
+                if (readBatch(evt))
+                {
+                    return true;
+                }
+                evt.type = NetEvent::None;
+                break;
+            }
+
             evt.type = NetEvent::PacketReceived;
             evt.packet.setPacketData(hostEvt.packet);
             //our event takes ownership
@@ -229,26 +255,22 @@ void NetClient::sendPacket(std::uint8_t id, const void* data, std::size_t size,
 {
     if (m_peer.m_peer)
     {
-        std::int32_t packetFlags = 0;
-        if (flags == NetFlag::Reliable)
-        {
-            packetFlags |= ENET_PACKET_FLAG_RELIABLE;
-        }
-        else if (flags == NetFlag::Unreliable)
-        {
-            packetFlags |= ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT;
-        }
-        else if (flags == NetFlag::Unsequenced)
+        enet_peer_send(m_peer.m_peer, channel, Detail::createPacket(id, data, size, flags));
+    }
+}
+
+void NetClient::sendPacket(NetPacketBuilder&& packet, std::uint8_t channel) const
+{
+    auto* p = packet.release();
+    if (m_peer.m_peer && p)
+    {
+        //enet takes ownership of the packet on success
+        if (enet_peer_send(m_peer.m_peer, channel, p) == 0)
         {
-            packetFlags |= ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT | ENET_PACKET_FLAG_UNSEQUENCED;
+            return;
         }
-        
-        ENetPacket* packet = enet_packet_create(&id, sizeof(std::uint8_t), packetFlags);
-        enet_packet_resize(packet, sizeof(std::uint8_t) + size);
-        std::memcpy(&packet->data[sizeof(std::uint8_t)], data, size);
-
-        enet_peer_send(m_peer.m_peer, channel, packet);
     }
+    enet_packet_destroy(p);
 }
 
 //private
@@ -267,4 +289,30 @@ void NetClient::threadFunc()
 
         std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(50));
     }
-}
\ No newline at end of file
+}
+
+bool NetClient::readBatch(NetEvent& evt)
+{
+    if (m_receivedBatch.packet)
+    {
+        if (evt.packet.readBatch(m_receivedBatch.packet, m_receivedBatch.offset))
+        {
+            evt.type = NetEvent::PacketReceived;
+            evt.peer.m_peer = m_peer.m_peer;
+            evt.channel = m_receivedBatch.channel;
+            return true;
+        }
+        releaseBatch();
+    }
+    return false;
+}
+
+void NetClient::releaseBatch()
+{
+    if (m_receivedBatch.packet)
+    {
+        //packets read from the batch keep it alive until they're destroyed
+        Detail::releaseBatch(m_receivedBatch.packet);
+        m_receivedBatch = {};
+    }
+}
@@ -27,10 +27,15 @@ source distribution.
 
 -----------------------------------------------------------------------*/
 
-#include "NetConf.hpp"
-
+//this should always be included first on windows, to ensure it is
+//included before windows.h (in this case by Log.hpp)
 #include "../detail/enet/enet/enet.h"
+
+#include "NetConf.hpp"
 #include <crogine/core/Log.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include <cstring>
 
 using namespace cro;
 
@@ -55,4 +60,53 @@ NetConf::~NetConf()
     {
         enet_deinitialize();
     }
-}
\ No newline at end of file
+}
+
+std::uint32_t Detail::getPacketFlags(NetFlag flags)
+{
+    std::uint32_t packetFlags = 0;
+    if (flags == NetFlag::Reliable)
+    {
+        packetFlags |= ENET_PACKET_FLAG_RELIABLE;
+    }
+    else if (flags == NetFlag::Unreliable)
+    {
+        packetFlags |= ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT;
+    }
+    else if (flags == NetFlag::Unsequenced)
+    {
+        packetFlags |= ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT | ENET_PACKET_FLAG_UNSEQUENCED;
+    }
+    return packetFlags;
+}
+
+ENetPacket* Detail::createPacket(std::uint8_t id, const void* data, std::size_t size, NetFlag flags)
+{
+    CRO_ASSERT(id != NetBatchPacketID, "This ID is reserved for batched packets");
+
+    //passing nullptr allocates the buffer without copying anything to it
+    ENetPacket* packet = enet_packet_create(nullptr, sizeof(std::uint8_t) + size, getPacketFlags(flags));
+    if (packet)
+    {
+        packet->data[0] = id;
+        if (size)
+        {
+            std::memcpy(&packet->data[sizeof(std::uint8_t)], data, size);
+        }
+    }
+    return packet;
+}
+
+void Detail::retainBatch(ENetPacket* batch)
+{
+    batch->referenceCount++;
+}
+
+void Detail::releaseBatch(ENetPacket* batch)
+{
+    CRO_ASSERT(batch->referenceCount > 0, "");
+    if (--batch->referenceCount == 0)
+    {
+        enet_packet_destroy(batch);
+    }
+}
@@ -30,8 +30,12 @@ source distribution.
 #ifndef CRO_NETCONF_HPP_
 #define CRO_NETCONF_HPP_
 
+#include <crogine/network/NetData.hpp>
+
 #include <memory>
 
+struct _ENetPacket;
+
 namespace cro
 {
     class NetConf final
@@ -48,6 +52,23 @@ namespace cro
 
         bool m_initOK;
     };
+
+    namespace Detail
+    {
+        //converts NetFlag to ENet packet flags
+        std::uint32_t getPacketFlags(NetFlag);
+
+        //creates a packet with a single allocation, prefixed with the packet ID
+        _ENetPacket* createPacket(std::uint8_t id, const void* data, std::size_t size, NetFlag);
+
+        //batches received from a remote host are reference counted as the
+        //packets read from them point directly into the batch data
+        void retainBatch(_ENetPacket*);
+        void releaseBatch(_ENetPacket*);
+
+        //each packet in a batch is prefixed with its size
+        using BatchSize = std::uint16_t;
+    }
 }
 
 #endif //CRO_NETCONF_HPP_
\ No newline at end of file
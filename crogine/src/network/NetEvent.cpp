@@ -29,6 +29,8 @@ source distribution.
 
 #include "../detail/enet/enet/enet.h"
 
+#include "NetConf.hpp"
+
 #include <crogine/network/NetData.hpp>
 
 using namespace cro;
@@ -106,4 +108,45 @@ void NetEvent::Packet::setPacketData(ENetPacket* packet)
     {
         std::memcpy(&m_id, m_packet->data, sizeof(std::uint8_t));
     }
-}
\ No newline at end of file
+}
+
+bool NetEvent::Packet::readBatch(ENetPacket* batch, std::size_t& offset)
+{
+    Detail::BatchSize size = 0;
+    if (offset + sizeof(size) + sizeof(std::uint8_t) > batch->dataLength)
+    {
+        return false;
+    }
+
+    std::memcpy(&size, &batch->data[offset], sizeof(size));
+    offset += sizeof(size);
+
+    //every entry holds at least the packet ID
+    if (size < sizeof(std::uint8_t)
+        || offset + size > batch->dataLength)
+    {
+        //malformed batch
+        offset = batch->dataLength;
+        return false;
+    }
+
+    //rather than copying, the packet points into the batch data
+    //and keeps the batch alive until the packet is destroyed
+    auto* packet = enet_packet_create(&batch->data[offset], size, ENET_PACKET_FLAG_NO_ALLOCATE);
+    if (!packet)
+    {
+        offset = batch->dataLength;
+        return false;
+    }
+    offset += size;
+
+    Detail::retainBatch(batch);
+    packet->userData = batch;
+    packet->freeCallback = [](ENetPacket* p)
+    {
+        Detail::releaseBatch(static_cast<ENetPacket*>(p->userData));
+    };
+
+    setPacketData(packet);
+    return true;
+}
@@ -36,36 +36,19 @@ source distribution.
 #include <crogine/core/Log.hpp>
 #include <crogine/detail/Assert.hpp>
 
+#include <cstring>
+
 using namespace cro;
 
 namespace
 {
-    ENetPacket* createPacket(std::uint8_t id, const void* data, std::size_t size, NetFlag flags)
-    {
-        std::int32_t packetFlags = 0;
-        if (flags == NetFlag::Reliable)
-        {
-            packetFlags |= ENET_PACKET_FLAG_RELIABLE;
-        }
-        else if (flags == NetFlag::Unreliable)
-        {
-            packetFlags |= ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT;
-        }
-        else if (flags == NetFlag::Unsequenced)
-        {
-            packetFlags |= ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT | ENET_PACKET_FLAG_UNSEQUENCED;
-        }
-
-        ENetPacket* packet = enet_packet_create(&id, sizeof(std::uint8_t), packetFlags);
-        enet_packet_resize(packet, sizeof(std::uint8_t) + size);
-        std::memcpy(&packet->data[sizeof(std::uint8_t)], data, size);
-
-        return packet;
-    }
+    //keeps batches within a single datagram at the default MTU
+    constexpr std::size_t MaxBatchSize = 1200;
 }
 
 NetHost::NetHost()
-    : m_host    (nullptr)
+    : m_host        (nullptr),
+    m_channelCount  (0)
 {
     if (!NetConf::instance)
     {
@@ -121,12 +104,30 @@ bool NetHost::start(const std::string& address, std::uint16_t port, std::size_t
 
     enet_host_compress_with_range_coder(m_host);
 
+    m_channelCount = maxChannels;
+    m_queuedBatches.resize(maxClients * maxChannels);
+
     LOG("Created server host on port " + std::to_string(port), Logger::Type::Info);
     return true;
 }
 
 void NetHost::stop()
 {
+    if (m_receivedBatch.packet)
+    {
+        Detail::releaseBatch(m_receivedBatch.packet);
+        m_receivedBatch = {};
+    }
+
+    for (auto& batch : m_queuedBatches)
+    {
+        if (batch.packet)
+        {
+            enet_packet_destroy(batch.packet);
+        }
+    }
+    m_queuedBatches.clear();
+
     if (m_host)
     {
         if (m_host->connectedPeers > 0)
@@ -171,6 +172,14 @@ bool NetHost::pollEvent(NetEvent& evt)
 {
     if (!m_host) return false;
 
+    //finish reading any batch we're part way through
+    if (readBatch(evt))
+    {
+        return true;
+    }
+
+    flushQueuedPackets();
+
     ENetEvent hostEvt;
     if (enet_host_service(m_host, &hostEvt, 0) > 0)
     {
@@ -186,6 +195,24 @@ bool NetHost::pollEvent(NetEvent& evt)
             evt.type = NetEvent::ClientDisconnect;
             break;
         case ENET_EVENT_TYPE_RECEIVE:
+            if (hostEvt.packet->dataLength != 0
+                && hostEvt.packet->data[0] == NetBatchPacketID)
+            {
+                //hold on to this and return the first of its packets
+                Detail::retainBatch(hostEvt.packet);
+                m_receivedBatch.packet = hostEvt.packet;
+                m_receivedBatch.peer = hostEvt.peer;
+                m_receivedBatch.offset = sizeof(std::uint8_t);
+                m_receivedBatch.channel = hostEvt.channelID;
+
+                if (readBatch(evt))
+                {
+                    return true;
+                }
+                evt.type = NetEvent::None;
+                break;
+            }
+
             evt.type = NetEvent::PacketReceived;
             evt.packet.setPacketData(hostEvt.packet);
             //our event takes ownership and promises to clean up the packet
@@ -202,7 +229,7 @@ void NetHost::broadcastPacket(std::uint8_t id, const void* data, std::size_t siz
 {
     if (m_host)
     {
-        enet_host_broadcast(m_host, channel, createPacket(id, data, size, flags));
+        enet_host_broadcast(m_host, channel, Detail::createPacket(id, data, size, flags));
     }
 }
 
@@ -210,7 +237,113 @@ void NetHost::sendPacket(const NetPeer& peer, std::uint8_t id, const void* data,
 {
     if (peer.m_peer)
     {
-        enet_peer_send(peer.m_peer, channel, createPacket(id, data, size, flags));
+        enet_peer_send(peer.m_peer, channel, Detail::createPacket(id, data, size, flags));
+    }
+}
+
+void NetHost::sendPacket(const NetPeer& peer, NetPacketBuilder&& packet, std::uint8_t channel) const
+{
+    auto* p = packet.release();
+    if (peer.m_peer && p)
+    {
+        //enet takes ownership of the packet on success
+        if (enet_peer_send(peer.m_peer, channel, p) == 0)
+        {
+            return;
+        }
+    }
+    enet_packet_destroy(p);
+}
+
+void NetHost::broadcastPacket(NetPacketBuilder&& packet, std::uint8_t channel) const
+{
+    auto* p = packet.release();
+    if (m_host && p)
+    {
+        enet_host_broadcast(m_host, channel, p);
+        return;
+    }
+    enet_packet_destroy(p);
+}
+
+void NetHost::queuePacket(const NetPeer& peer, std::uint8_t id, const void* data, std::size_t size, std::uint8_t channel)
+{
+    CRO_ASSERT(id != NetBatchPacketID, "This ID is reserved for batched packets");
+    CRO_ASSERT(channel < m_channelCount, "Channel out of range");
+
+    if (!m_host || !peer.m_peer
+        || channel >= m_channelCount)
+    {
+        return;
+    }
+
+    const auto entrySize = sizeof(Detail::BatchSize) + sizeof(std::uint8_t) + size;
+    if (sizeof(std::uint8_t) + entrySize > MaxBatchSize)
+    {
+        //too big to batch so send it on its own
+        sendPacket(peer, id, data, size, NetFlag::Unreliable, channel);
+        return;
+    }
+
+    const auto peerIndex = static_cast<std::size_t>(peer.m_peer - m_host->peers);
+    CRO_ASSERT(peerIndex < m_host->peerCount, "");
+
+    auto& batch = m_queuedBatches[(peerIndex * m_channelCount) + channel];
+    if (batch.packet
+        && batch.size + entrySize > MaxBatchSize)
+    {
+        sendBatch(batch, peerIndex, channel);
+    }
+
+    if (!batch.packet)
+    {
+        //allocated once at the max size, then shrunk when sent
+        batch.packet = enet_packet_create(nullptr, MaxBatchSize, Detail::getPacketFlags(NetFlag::Unreliable));
+        if (!batch.packet)
+        {
+            return;
+        }
+        batch.packet->data[0] = NetBatchPacketID;
+        batch.size = sizeof(std::uint8_t);
+    }
+
+    //each entry is the size followed by a regular packet
+    const auto packetSize = static_cast<Detail::BatchSize>(sizeof(std::uint8_t) + size);
+    auto* dst = &batch.packet->data[batch.size];
+    std::memcpy(dst, &packetSize, sizeof(packetSize));
+    dst += sizeof(packetSize);
+    *dst++ = id;
+    if (size)
+    {
+        std::memcpy(dst, data, size);
+    }
+    batch.size += entrySize;
+}
+
+void NetHost::queueBroadcast(std::uint8_t id, const void* data, std::size_t size, std::uint8_t channel)
+{
+    if (m_host)
+    {
+        for (auto i = 0u; i < m_host->peerCount; ++i)
+        {
+            if (m_host->peers[i].state == ENET_PEER_STATE_CONNECTED)
+            {
+                NetPeer peer;
+                peer.m_peer = &m_host->peers[i];
+                queuePacket(peer, id, data, size, channel);
+            }
+        }
+    }
+}
+
+void NetHost::flushQueuedPackets()
+{
+    for (auto i = 0u; i < m_queuedBatches.size(); ++i)
+    {
+        if (m_queuedBatches[i].packet)
+        {
+            sendBatch(m_queuedBatches[i], i / m_channelCount, static_cast<std::uint8_t>(i % m_channelCount));
+        }
     }
 }
 
@@ -230,4 +363,47 @@ void NetHost::disconnectLater(NetPeer& peer)
         enet_peer_disconnect_later(peer.m_peer, 0);
         peer.m_peer = nullptr;
     }
-}
\ No newline at end of file
+}
+
+//private
+bool NetHost::readBatch(NetEvent& evt)
+{
+    if (m_receivedBatch.packet)
+    {
+        if (evt.packet.readBatch(m_receivedBatch.packet, m_receivedBatch.offset))
+        {
+            evt.type = NetEvent::PacketReceived;
+            evt.peer.m_peer = m_receivedBatch.peer;
+            evt.channel = m_receivedBatch.channel;
+            return true;
+        }
+
+        //packets read from the batch keep it alive until they're destroyed
+        Detail::releaseBatch(m_receivedBatch.packet);
+        m_receivedBatch = {};
+    }
+    return false;
+}
+
+void NetHost::sendBatch(QueuedBatch& batch, std::size_t peerIndex, std::uint8_t channel)
+{
+    CRO_ASSERT(batch.packet, "");
+
+    auto* peer = &m_host->peers[peerIndex];
+    if (peer->state == ENET_PEER_STATE_CONNECTED)
+    {
+        //shrinking a packet doesn't reallocate
+        enet_packet_resize(batch.packet, batch.size);
+        if (enet_peer_send(peer, channel, batch.packet) != 0)
+        {
+            enet_packet_destroy(batch.packet);
+        }
+    }
+    else
+    {
+        enet_packet_destroy(batch.packet);
+    }
+
+    batch.packet = nullptr;
+    batch.size = 0;
+}
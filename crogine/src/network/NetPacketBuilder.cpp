@@ -0,0 +1,127 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "../detail/enet/enet/enet.h"
+
+#include "NetConf.hpp"
+
+#include <crogine/network/NetData.hpp>
+#include <crogine/core/Log.hpp>
+
+using namespace cro;
+
+NetPacketBuilder::NetPacketBuilder(std::uint8_t id, std::size_t size, NetFlag flags)
+    : m_packet      (nullptr),
+    m_writePosition (0)
+{
+    CRO_ASSERT(id != NetBatchPacketID, "This ID is reserved for batched packets");
+
+    m_packet = enet_packet_create(nullptr, sizeof(std::uint8_t) + size, Detail::getPacketFlags(flags));
+    if (m_packet)
+    {
+        m_packet->data[0] = id;
+    }
+}
+
+NetPacketBuilder::~NetPacketBuilder()
+{
+    if (m_packet)
+    {
+        enet_packet_destroy(m_packet);
+    }
+}
+
+NetPacketBuilder::NetPacketBuilder(NetPacketBuilder&& other) noexcept
+    : m_packet      (other.m_packet),
+    m_writePosition (other.m_writePosition)
+{
+    other.m_packet = nullptr;
+    other.m_writePosition = 0;
+}
+
+NetPacketBuilder& NetPacketBuilder::operator=(NetPacketBuilder&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_packet)
+        {
+            enet_packet_destroy(m_packet);
+        }
+
+        m_packet = other.m_packet;
+        m_writePosition = other.m_writePosition;
+
+        other.m_packet = nullptr;
+        other.m_writePosition = 0;
+    }
+    return *this;
+}
+
+//public
+void NetPacketBuilder::write(const void* data, std::size_t size)
+{
+    CRO_ASSERT(m_packet, "Packet has already been sent");
+    if (!m_packet)
+    {
+        return;
+    }
+
+    const auto end = sizeof(std::uint8_t) + m_writePosition + size;
+    if (end > m_packet->dataLength)
+    {
+        LOG("Packet builder size exceeded, packet will be reallocated", Logger::Type::Warning);
+        if (enet_packet_resize(m_packet, end) != 0)
+        {
+            return;
+        }
+    }
+
+    std::memcpy(&m_packet->data[sizeof(std::uint8_t) + m_writePosition], data, size);
+    m_writePosition += size;
+}
+
+void* NetPacketBuilder::getData()
+{
+    CRO_ASSERT(m_packet, "Packet has already been sent");
+    return m_packet ? &m_packet->data[sizeof(std::uint8_t)] : nullptr;
+}
+
+std::size_t NetPacketBuilder::getSize() const
+{
+    return m_packet ? m_packet->dataLength - sizeof(std::uint8_t) : 0;
+}
+
+//private
+ENetPacket* NetPacketBuilder::release()
+{
+    auto* packet = m_packet;
+    m_packet = nullptr;
+    m_writePosition = 0;
+    return packet;
+}
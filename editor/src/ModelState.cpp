@@ -92,6 +92,7 @@ ModelState::ModelState(cro::StateStack& stack, cro::State::Context context, Shar
     m_showBakingWindow      (false),
     m_useFreecam            (false),
     m_exportAnimation       (true),
+    m_exportCompact         (false),
     m_skeletonMeshID        (0),
     m_browseGLTF            (false),
     m_showAABB              (false),
@@ -162,6 +162,7 @@ private:
         float scale = 1.f;
     }m_importedTransform;
     bool m_exportAnimation;
+    bool m_exportCompact;
     std::size_t m_skeletonMeshID;
 
     void importModel();
@@ -171,6 +172,7 @@ private:
     void exportModel(bool = false, bool = true);
     void applyImportTransform();
     void flipNormals();
+    void convertToCompact();
     void readBackVertexData(cro::Mesh::Data, std::vector<float>&, std::vector<std::vector<std::uint32_t>>&);
     //-------------------------------------------//
 
@@ -48,6 +48,7 @@ source distribution.
 #include <crogine/graphics/DynamicMeshBuilder.hpp>
 #include <crogine/graphics/BinaryMeshBuilder.hpp>
 #include <crogine/graphics/IqmBuilder.hpp>
+#include <crogine/graphics/StaticMeshBuilder.hpp>
 
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
@@ -1022,7 +1023,7 @@ void ModelState::exportModel(bool modelOnly, bool openOnSave)
 
         //write binary file
         bool animated = m_exportAnimation && m_importedHeader.animated;
-        if (cro::Detail::ModelBinary::write(m_entities[EntityID::ActiveModel], path, animated))
+        if (cro::Detail::ModelBinary::write(m_entities[EntityID::ActiveModel], path, animated, m_exportCompact))
         {
             //create config file and save as cmt
             auto modelName = cro::FileSystem::getFileName(path);
@@ -1192,56 +1193,45 @@ void ModelState::flipNormals()
             verts[i+2] *= -1.f;
         }
 
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
-        glCheck(glBufferData(GL_ARRAY_BUFFER, meshData.vertexCount * meshData.vertexSize, verts.data(), GL_STATIC_DRAW));
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        cro::Mesh::writeVertexData(meshData, verts);
     }
 }
 
-void ModelState::readBackVertexData(cro::Mesh::Data meshData, std::vector<float>& destVerts, std::vector<std::vector<std::uint32_t>>& destIndices)
+void ModelState::convertToCompact()
 {
-    destVerts.clear();
-    destVerts.resize(meshData.vertexCount * (meshData.vertexSize / sizeof(float)));
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
-    glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, meshData.vertexCount * meshData.vertexSize, destVerts.data()));
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    //re-saves the currently open model in the compact format without
+    //touching the model definition, so existing materials are kept.
+    //static meshes are written as cmf, everything else as cmb
+    const bool staticMesh = m_modelProperties.type == ModelProperties::Static;
+    const std::string ext = staticMesh ? "cmf" : "cmb";
 
-    destIndices.clear();
-    destIndices.resize(meshData.submeshCount);
-
-    for (auto i = 0u; i < meshData.submeshCount; ++i)
+    auto path = cro::FileSystem::saveFileDialogue(m_preferences.lastExportDirectory + "/untitled", ext);
+    std::replace(path.begin(), path.end(), '\\', '/');
+    if (!path.empty())
     {
-        destIndices[i].resize(meshData.indexData[i].indexCount);
-        glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.indexData[i].ibo));
-
-        //fudgy kludge for different index types
-        switch (meshData.indexData[i].format)
-        {
-        default: break;
-        case GL_UNSIGNED_BYTE:
+        if (cro::FileSystem::getFileExtension(path) != "." + ext)
         {
-            std::vector<std::uint8_t> temp(meshData.indexData[i].indexCount);
-            glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, meshData.indexData[i].indexCount, temp.data()));
-            for (auto j = 0u; j < meshData.indexData[i].indexCount; ++j)
-            {
-                destIndices[i][j] = temp[j];
-            }
+            path += "." + ext;
         }
-        break;
-        case GL_UNSIGNED_SHORT:
+
+        const auto& model = m_entities[EntityID::ActiveModel];
+        const bool written = staticMesh ?
+            cro::StaticMeshBuilder::write(model.getComponent<cro::Model>().getMeshData(), path, true)
+            : cro::Detail::ModelBinary::write(model, path, true, true);
+
+        if (written)
         {
-            std::vector<std::uint16_t> temp(meshData.indexData[i].indexCount);
-            glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, meshData.indexData[i].indexCount * sizeof(std::uint16_t), temp.data()));
-            for (auto j = 0u; j < meshData.indexData[i].indexCount; ++j)
-            {
-                destIndices[i][j] = temp[j];
-            }
+            cro::FileSystem::showMessageBox("Success", "Wrote " + cro::FileSystem::getFileName(path) + "\nUpdate the mesh property of any model definitions to use the new file.");
         }
-        break;
-        case GL_UNSIGNED_INT:
-            glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, meshData.indexData[i].indexCount * sizeof(std::uint32_t), destIndices[i].data()));
-            break;
+        else
+        {
+            cro::FileSystem::showMessageBox("Error", "Failed to write compact mesh file", cro::FileSystem::OK, cro::FileSystem::Error);
         }
     }
-    glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+}
+
+void ModelState::readBackVertexData(cro::Mesh::Data meshData, std::vector<float>& destVerts, std::vector<std::vector<std::uint32_t>>& destIndices)
+{
+    //this also unpacks vertex data loaded from compact model binaries
+    cro::Mesh::readVertexData(meshData, destVerts, destIndices);
 }
\ No newline at end of file
@@ -413,6 +413,11 @@ void ModelState::buildUI()
                         exportModel();
                     }
 
+                    if (ImGui::MenuItem("Convert To Compact Binary", nullptr, nullptr, m_entities[EntityID::ActiveModel].isValid() && m_importedVBO.empty()))
+                    {
+                        convertToCompact();
+                    }
+
                     ImGui::Separator();
 
                     if (getStateCount() > 1)
@@ -847,6 +852,9 @@ void ModelState::drawInspector()
                     {
                         ImGui::Checkbox("Export Animations", &m_exportAnimation);
                     }
+                    ImGui::Checkbox("Compact Vertex Data", &m_exportCompact);
+                    ImGui::SameLine();
+                    helpMarker("Stores normals, UVs and colours at reduced precision, and uses 16 bit indices where possible.\nThis makes the model file smaller and faster to load, but requires version 3 of the model binary format.");
                     if (ImGui::Button("Convert##01"))
                     {
                         exportModel(modelOnly);
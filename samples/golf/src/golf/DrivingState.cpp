@@ -1883,11 +1883,16 @@ void DrivingState::createFoliage(cro::Entity terrainEnt)
     //render a heightmap from the hole mesh
     //TODO this is lifted from TerrainBuilder and can probably be shared between both with a refactor
     const auto& meshData = terrainEnt.getComponent<cro::Model>().getMeshData();
+    //compact models keep their vertex data packed in the vbo
+    //so take the layout from the mesh rather than assuming floats
     std::size_t normalOffset = 0;
-    for (auto i = 0u; i < cro::Mesh::Normal; ++i)
+    for (auto i = 0; i < cro::Mesh::Normal; ++i)
     {
-        normalOffset += meshData.attributes[i];
+        normalOffset += cro::Mesh::getAttributeSize(meshData, i);
     }
+    const auto stride = static_cast<GLsizei>(cro::Mesh::getVertexStride(meshData));
+    const auto& positionFormat = meshData.attributeFormats[cro::Mesh::Position];
+    const auto& normalFormat = meshData.attributeFormats[cro::Mesh::Normal];
 
     cro::Shader normalShader;
     normalShader.loadFromString(NormalMapVertexShader, NormalMapFragmentShader);
@@ -1908,9 +1913,11 @@ void DrivingState::createFoliage(cro::Entity terrainEnt)
         glCheck(glBindVertexArray(vaos[i]));
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
         glCheck(glEnableVertexAttribArray(attribs[cro::Mesh::Position]));
-        glCheck(glVertexAttribPointer(attribs[cro::Mesh::Position], 3, GL_FLOAT, GL_FALSE, static_cast<std::int32_t>(meshData.vertexSize), 0));
+        glCheck(glVertexAttribPointer(attribs[cro::Mesh::Position], 3, positionFormat.type == 0 ? GL_FLOAT : positionFormat.type,
+            positionFormat.normalised ? GL_TRUE : GL_FALSE, stride, 0));
         glCheck(glEnableVertexAttribArray(attribs[cro::Mesh::Normal]));
-        glCheck(glVertexAttribPointer(attribs[cro::Mesh::Normal], 3, GL_FLOAT, GL_FALSE, static_cast<std::int32_t>(meshData.vertexSize), (void*)(normalOffset * sizeof(float))));
+        glCheck(glVertexAttribPointer(attribs[cro::Mesh::Normal], 3, normalFormat.type == 0 ? GL_FLOAT : normalFormat.type,
+            normalFormat.normalised ? GL_TRUE : GL_FALSE, stride, (void*)normalOffset));
         glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.indexData[i].ibo));
     }
 
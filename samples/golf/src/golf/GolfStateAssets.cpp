@@ -72,6 +72,10 @@ namespace
 
 void GolfState::loadAssets()
 {
+    //these are decoded in the background while the reflection map and shaders load
+    m_resources.textures.preload("assets/golf/images/wind.png");
+    m_resources.textures.preload("assets/golf/images/shale.png");
+
     if (m_sharedData.nightTime)
     {
         m_lightVolumeDefinition.loadFromFile("assets/golf/models/light_sphere.cmt");
@@ -1362,11 +1362,16 @@ void TerrainBuilder::renderNormalMap(bool forceUpdate)
 
     //hmmm is there some of this we can pre-process to save doing it here?
     const auto& meshData = m_holeData[m_currentHole].modelEntity.getComponent<cro::Model>().getMeshData();
+    //compact models keep their vertex data packed in the vbo
+    //so take the layout from the mesh rather than assuming floats
     std::size_t normalOffset = 0;
-    for (auto i = 0u; i < cro::Mesh::Normal; ++i)
+    for (auto i = 0; i < cro::Mesh::Normal; ++i)
     {
-        normalOffset += meshData.attributes[i];
+        normalOffset += cro::Mesh::getAttributeSize(meshData, i);
     }
+    const auto stride = static_cast<GLsizei>(cro::Mesh::getVertexStride(meshData));
+    const auto& positionFormat = meshData.attributeFormats[cro::Mesh::Position];
+    const auto& normalFormat = meshData.attributeFormats[cro::Mesh::Normal];
 
     const auto& attribs = m_normalShader.getAttribMap();
     auto vaoCount = static_cast<std::int32_t>(meshData.submeshCount);
@@ -1379,9 +1384,11 @@ void TerrainBuilder::renderNormalMap(bool forceUpdate)
         glCheck(glBindVertexArray(vaos[i]));
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
         glCheck(glEnableVertexAttribArray(attribs[cro::Mesh::Position]));
-        glCheck(glVertexAttribPointer(attribs[cro::Mesh::Position], 3, GL_FLOAT, GL_FALSE, static_cast<std::int32_t>(meshData.vertexSize), 0));
+        glCheck(glVertexAttribPointer(attribs[cro::Mesh::Position], 3, positionFormat.type == 0 ? GL_FLOAT : positionFormat.type,
+            positionFormat.normalised ? GL_TRUE : GL_FALSE, stride, 0));
         glCheck(glEnableVertexAttribArray(attribs[cro::Mesh::Normal]));
-        glCheck(glVertexAttribPointer(attribs[cro::Mesh::Normal], 3, GL_FLOAT, GL_FALSE, static_cast<std::int32_t>(meshData.vertexSize), (void*)(normalOffset * sizeof(float))));
+        glCheck(glVertexAttribPointer(attribs[cro::Mesh::Normal], 3, normalFormat.type == 0 ? GL_FLOAT : normalFormat.type,
+            normalFormat.normalised ? GL_TRUE : GL_FALSE, stride, (void*)normalOffset));
         glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.indexData[i].ibo));
     }
     
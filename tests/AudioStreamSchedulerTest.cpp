@@ -0,0 +1,237 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include "audio/AudioStreamScheduler.hpp"
+#include "audio/NullImpl.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+Checks the AudioStreamScheduler runs tasks in deadline order, can wake
+and remove tasks safely while they are running, and that streams are
+still serviced while the NullImpl audio backend is active, so none of
+these tests need an audio device.
+*/
+
+namespace
+{
+    using cro::Detail::AudioStreamScheduler;
+    using namespace std::chrono_literals;
+
+    //waits up to a second for the given condition
+    template <typename T>
+    bool waitFor(T&& condition)
+    {
+        const auto end = std::chrono::steady_clock::now() + 1s;
+        while (!condition())
+        {
+            if (std::chrono::steady_clock::now() > end)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+
+    void testDeadlineOrder()
+    {
+        AudioStreamScheduler scheduler;
+
+        std::mutex mutex;
+        std::vector<std::int32_t> order;
+        const auto addTask = [&](std::int32_t id, AudioStreamScheduler::Duration delay)
+        {
+            scheduler.addTask([&, id]()
+                {
+                    std::scoped_lock lock(mutex);
+                    order.push_back(id);
+                    return AudioStreamScheduler::Finished;
+                }, delay);
+        };
+        addTask(2, 60ms);
+        addTask(0, 20ms);
+        addTask(1, 40ms);
+
+        CHECK(waitFor([&]() { std::scoped_lock lock(mutex); return order.size() == 3; }));
+
+        std::scoped_lock lock(mutex);
+        CHECK(order == std::vector<std::int32_t>({ 0, 1, 2 }));
+        CHECK(scheduler.getMetrics().services == 3);
+    }
+
+    void testRescheduleAndWake()
+    {
+        AudioStreamScheduler scheduler;
+
+        std::atomic<std::int32_t> count = 0;
+        const auto handle = scheduler.addTask([&]()
+            {
+                count++;
+                return AudioStreamScheduler::Duration(10s);
+            });
+
+        //runs once immediately then waits for its deadline
+        CHECK(waitFor([&]() { return count == 1; }));
+        std::this_thread::sleep_for(20ms);
+        CHECK(count == 1);
+
+        scheduler.wake(handle);
+        CHECK(waitFor([&]() { return count == 2; }));
+
+        scheduler.removeTask(handle);
+        scheduler.wake(handle); //safe on a removed task
+        std::this_thread::sleep_for(20ms);
+        CHECK(count == 2);
+    }
+
+    void testRemoveWhileRunning()
+    {
+        AudioStreamScheduler scheduler;
+
+        std::atomic_bool started = false;
+        std::atomic_bool finished = false;
+        std::atomic<std::int32_t> count = 0;
+        const auto handle = scheduler.addTask([&]()
+            {
+                count++;
+                started = true;
+                std::this_thread::sleep_for(50ms);
+                finished = true;
+                return AudioStreamScheduler::Duration(0);
+            });
+
+        CHECK(waitFor([&]() { return started.load(); }));
+
+        //must block until the running task returns
+        scheduler.removeTask(handle);
+        CHECK(finished);
+
+        const auto runCount = count.load();
+        std::this_thread::sleep_for(20ms);
+        CHECK(count == runCount);
+    }
+
+    void testRemoveSelf()
+    {
+        AudioStreamScheduler scheduler;
+
+        std::atomic<std::int32_t> count = 0;
+        std::atomic<std::int32_t> handle = -1;
+        handle = scheduler.addTask([&]()
+            {
+                count++;
+                scheduler.removeTask(handle);
+                return AudioStreamScheduler::Duration(0);
+            }, 10ms);
+
+        CHECK(waitFor([&]() { return count == 1; }));
+        std::this_thread::sleep_for(20ms);
+        CHECK(count == 1);
+    }
+
+    void testAddWhileRunning()
+    {
+        AudioStreamScheduler scheduler;
+
+        //adding enough tasks to rehash the task map while a task is
+        //running mustn't affect the task when it's rescheduled
+        std::atomic<std::int32_t> count = 0;
+        std::atomic<std::int32_t> added = 0;
+        scheduler.addTask([&]()
+            {
+                if (count++ == 0)
+                {
+                    for (auto i = 0; i < 1000; ++i)
+                    {
+                        scheduler.addTask([&]() { added++; return AudioStreamScheduler::Finished; }, 10s);
+                    }
+                }
+                return count < 3 ? AudioStreamScheduler::Duration(1ms) : AudioStreamScheduler::Finished;
+            });
+
+        CHECK(waitFor([&]() { return count == 3; }));
+        CHECK(added == 0);
+    }
+
+    void testNullImplStream()
+    {
+        cro::Detail::NullImpl audio;
+        CHECK(audio.init());
+
+        AudioStreamScheduler scheduler;
+
+        //a stream which refills its buffers until its file runs out, only
+        //reporting an underrun if it runs dry before the end of the file
+        constexpr std::int32_t ChunkCount = 5;
+        std::atomic<std::int32_t> chunksRead = 0;
+        std::atomic_bool stopped = false;
+        const auto source = audio.requestAudioSource(audio.requestNewStream("music.ogg"), true);
+
+        scheduler.addTask([&]()
+            {
+                audio.getSourceState(source);
+                if (chunksRead < ChunkCount)
+                {
+                    chunksRead++;
+                    return AudioStreamScheduler::Duration(1ms);
+                }
+
+                stopped = true;
+                return AudioStreamScheduler::Finished;
+            });
+
+        CHECK(waitFor([&]() { return stopped.load(); }));
+        CHECK(chunksRead == ChunkCount);
+        CHECK(scheduler.getMetrics().services == ChunkCount + 1);
+        CHECK(scheduler.getMetrics().underruns == 0);
+
+        scheduler.reportUnderrun();
+        CHECK(scheduler.getMetrics().underruns == 1);
+
+        audio.shutdown();
+    }
+}
+
+int main()
+{
+    testDeadlineOrder();
+    testRescheduleAndWake();
+    testRemoveWhileRunning();
+    testRemoveSelf();
+    testAddWhileRunning();
+    testNullImplStream();
+
+    return test::result("audio_stream_scheduler_test");
+}
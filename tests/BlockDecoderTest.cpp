@@ -0,0 +1,318 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include "detail/BlockDecoder.hpp"
+
+#include <array>
+#include <cstdint>
+
+/*
+Decodes hand built blocks of each format and compares the texels
+with values worked out from the format specifications, including
+the BC1 punch through mode, both BC3/BC4 alpha interpolation modes,
+the ETC1 individual and differential modes, the ETC2 T mode and
+EAC alpha.
+*/
+
+namespace
+{
+    namespace BlockDecoder = cro::Detail::BlockDecoder;
+    using Texels = std::array<std::uint8_t, 64>;
+    using Colour = std::array<std::uint8_t, 4>;
+
+    bool texelEquals(const Texels& texels, std::uint32_t x, std::uint32_t y, Colour colour)
+    {
+        const auto* texel = &texels[((y * 4) + x) * 4];
+        return texel[0] == colour[0] && texel[1] == colour[1]
+            && texel[2] == colour[2] && texel[3] == colour[3];
+    }
+
+    //BC1-5 indices are packed from the top left, least significant bits first
+    template <std::size_t Size>
+    void packAlphaIndices(std::array<std::uint8_t, Size>& block, std::size_t offset)
+    {
+        std::uint64_t bits = 0;
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            bits |= static_cast<std::uint64_t>(i % 8) << (i * 3);
+        }
+        for (auto i = 0u; i < 6u; ++i)
+        {
+            block[offset + 2 + i] = static_cast<std::uint8_t>((bits >> (i * 8)) & 0xff);
+        }
+    }
+
+    void testBC1()
+    {
+        //red and blue in 4 colour mode, index = column
+        const std::array<std::uint8_t, 8> block = { 0x00, 0xf8, 0x1f, 0x00, 0xe4, 0xe4, 0xe4, 0xe4 };
+        const std::array<Colour, 4> expected =
+        { {
+            { 255, 0, 0, 255 }, { 0, 0, 255, 255 }, { 170, 0, 85, 255 }, { 85, 0, 170, 255 }
+        } };
+
+        Texels texels = {};
+        BlockDecoder::decodeBC1(block.data(), texels.data());
+        bool matches = true;
+        for (auto y = 0u; y < 4u; ++y)
+        {
+            for (auto x = 0u; x < 4u; ++x)
+            {
+                matches = matches && texelEquals(texels, x, y, expected[x]);
+            }
+        }
+        CHECK(matches);
+
+        //c0 <= c1 selects 3 colours and transparent black.
+        //0x8410 is 16, 32, 16 which expands to 132, 130, 132
+        const std::array<std::uint8_t, 8> punchThrough = { 0x00, 0x00, 0x10, 0x84, 0xe4, 0xe4, 0xe4, 0xe4 };
+        const std::array<Colour, 4> expectedPunchThrough =
+        { {
+            { 0, 0, 0, 255 }, { 132, 130, 132, 255 }, { 66, 65, 66, 255 }, { 0, 0, 0, 0 }
+        } };
+
+        BlockDecoder::decodeBC1(punchThrough.data(), texels.data());
+        matches = true;
+        for (auto y = 0u; y < 4u; ++y)
+        {
+            for (auto x = 0u; x < 4u; ++x)
+            {
+                matches = matches && texelEquals(texels, x, y, expectedPunchThrough[x]);
+            }
+        }
+        CHECK(matches);
+    }
+
+    void testBC2()
+    {
+        //alpha is i * 17 for texel i. The colour block has c0 < c1
+        //but BC2 always uses 4 colours, so index 2 is 2/3 blue 1/3 red
+        const std::array<std::uint8_t, 16> block =
+        {
+            0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+            0x1f, 0x00, 0x00, 0xf8, 0xaa, 0xaa, 0xaa, 0xaa
+        };
+
+        Texels texels = {};
+        BlockDecoder::decodeBC2(block.data(), texels.data());
+        bool matches = true;
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            matches = matches && texelEquals(texels, i % 4, i / 4, { 85, 0, 170, static_cast<std::uint8_t>(i * 17) });
+        }
+        CHECK(matches);
+    }
+
+    void testBC3()
+    {
+        //a0 > a1 interpolates 6 values between 70 and 0, index = texel % 8
+        std::array<std::uint8_t, 16> block =
+        {
+            70, 0, 0, 0, 0, 0, 0, 0,
+            0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00
+        };
+        packAlphaIndices(block, 0);
+        constexpr std::array<std::uint8_t, 8> Alpha = { 70, 0, 60, 50, 40, 30, 20, 10 };
+
+        Texels texels = {};
+        BlockDecoder::decodeBC3(block.data(), texels.data());
+        bool matches = true;
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            matches = matches && texelEquals(texels, i % 4, i / 4, { 255, 255, 255, Alpha[i % 8] });
+        }
+        CHECK(matches);
+    }
+
+    void testBC4()
+    {
+        //a0 <= a1 interpolates 4 values between 0 and 50, then 0 and 255
+        std::array<std::uint8_t, 8> block = { 0, 50 };
+        packAlphaIndices(block, 0);
+        constexpr std::array<std::uint8_t, 8> Red = { 0, 50, 10, 20, 30, 40, 0, 255 };
+
+        Texels texels = {};
+        BlockDecoder::decodeBC4(block.data(), texels.data());
+        bool matches = true;
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            matches = matches && texelEquals(texels, i % 4, i / 4, { Red[i % 8], 0, 0, 255 });
+        }
+        CHECK(matches);
+    }
+
+    void testBC5()
+    {
+        //red uses the 8 value mode and green the 6 value mode
+        std::array<std::uint8_t, 16> block = { 70, 0, 0, 0, 0, 0, 0, 0, 0, 50 };
+        packAlphaIndices(block, 0);
+        packAlphaIndices(block, 8);
+        constexpr std::array<std::uint8_t, 8> Red = { 70, 0, 60, 50, 40, 30, 20, 10 };
+        constexpr std::array<std::uint8_t, 8> Green = { 0, 50, 10, 20, 30, 40, 0, 255 };
+
+        Texels texels = {};
+        BlockDecoder::decodeBC5(block.data(), texels.data());
+        bool matches = true;
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            matches = matches && texelEquals(texels, i % 4, i / 4, { Red[i % 8], Green[i % 8], 0, 255 });
+        }
+        CHECK(matches);
+    }
+
+    //ETC indices are stored per column: the most significant bits of
+    //texels 15-0 then the least significant bits. 0xcccc/0xaaaa selects
+    //index y for every texel, ie modifiers +a, +b, -a, -b by row
+    constexpr std::uint8_t RowIndices[] = { 0xcc, 0xcc, 0xaa, 0xaa };
+
+    void testETC2Individual()
+    {
+        //left half 8, 4, 2 with table 0, right half 12, 12, 12 with table 1
+        const std::array<std::uint8_t, 8> block = { 0x8c, 0x4c, 0x2c, 0x04, RowIndices[0], RowIndices[1], RowIndices[2], RowIndices[3] };
+        constexpr std::array<std::int32_t, 4> LeftModifiers = { 2, 8, -2, -8 };
+        constexpr std::array<std::int32_t, 4> RightModifiers = { 5, 17, -5, -17 };
+
+        Texels texels = {};
+        BlockDecoder::decodeETC2RGB(block.data(), texels.data());
+        bool matches = true;
+        for (auto y = 0u; y < 4u; ++y)
+        {
+            const auto left = LeftModifiers[y];
+            const auto right = static_cast<std::uint8_t>(204 + RightModifiers[y]);
+            for (auto x = 0u; x < 2u; ++x)
+            {
+                matches = matches && texelEquals(texels, x, y,
+                    { static_cast<std::uint8_t>(136 + left), static_cast<std::uint8_t>(68 + left), static_cast<std::uint8_t>(34 + left), 255 });
+            }
+            for (auto x = 2u; x < 4u; ++x)
+            {
+                matches = matches && texelEquals(texels, x, y, { right, right, right, 255 });
+            }
+        }
+        CHECK(matches);
+    }
+
+    void testETC2Differential()
+    {
+        //flipped, so the sub blocks are the top and bottom halves.
+        //16, 8, 31 with table 2 on top, +1, -1, +0 (140, 57, 255) with table 7 below.
+        //All indices are 0 so the modifiers are +9 and +47, blue saturates
+        const std::array<std::uint8_t, 8> block = { 0x81, 0x47, 0xf8, 0x5f, 0x00, 0x00, 0x00, 0x00 };
+
+        Texels texels = {};
+        BlockDecoder::decodeETC2RGB(block.data(), texels.data());
+        bool matches = true;
+        for (auto y = 0u; y < 4u; ++y)
+        {
+            for (auto x = 0u; x < 4u; ++x)
+            {
+                matches = matches && texelEquals(texels, x, y, y < 2 ? Colour({ 141, 75, 255, 255 }) : Colour({ 187, 104, 255, 255 }));
+            }
+        }
+        CHECK(matches);
+    }
+
+    void testETC2TMode()
+    {
+        //red 31 + 1 overflows, selecting T mode. Colour 1 is 13, 4, 2 and
+        //colour 2 is 8, 8, 8 with distance index 2 (11), so the paint
+        //colours are (221, 68, 34), 136 + 11, 136 and 136 - 11
+        const std::array<std::uint8_t, 8> block = { 0xf9, 0x42, 0x88, 0x86, RowIndices[0], RowIndices[1], RowIndices[2], RowIndices[3] };
+        const std::array<Colour, 4> expected =
+        { {
+            { 221, 68, 34, 255 }, { 147, 147, 147, 255 }, { 136, 136, 136, 255 }, { 125, 125, 125, 255 }
+        } };
+
+        Texels texels = {};
+        BlockDecoder::decodeETC2RGB(block.data(), texels.data());
+        bool matches = true;
+        for (auto y = 0u; y < 4u; ++y)
+        {
+            for (auto x = 0u; x < 4u; ++x)
+            {
+                matches = matches && texelEquals(texels, x, y, expected[y]);
+            }
+        }
+        CHECK(matches);
+    }
+
+    void testETC2Alpha()
+    {
+        //EAC base 128, multiplier 1, table 0. Indices are 3 bits per
+        //texel, column by column, most significant bits first
+        std::array<std::uint8_t, 16> block =
+        {
+            128, 0x10, 0, 0, 0, 0, 0, 0,
+            0x8c, 0x4c, 0x2c, 0x04, RowIndices[0], RowIndices[1], RowIndices[2], RowIndices[3]
+        };
+        std::uint64_t bits = 0;
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            bits = (bits << 3) | (i % 8);
+        }
+        for (auto i = 0u; i < 6u; ++i)
+        {
+            block[2 + i] = static_cast<std::uint8_t>((bits >> ((5 - i) * 8)) & 0xff);
+        }
+        constexpr std::array<std::int32_t, 8> Modifiers = { -3, -6, -9, -15, 2, 5, 8, 14 };
+
+        Texels texels = {};
+        BlockDecoder::decodeETC2RGBA(block.data(), texels.data());
+        bool matches = true;
+        for (auto y = 0u; y < 4u; ++y)
+        {
+            for (auto x = 0u; x < 4u; ++x)
+            {
+                //colour is the same as the individual mode block
+                const auto alpha = static_cast<std::uint8_t>(128 + Modifiers[((x * 4) + y) % 8]);
+                const auto colour = x < 2 ? 136 + std::array<std::int32_t, 4>({ 2, 8, -2, -8 })[y] : 204 + std::array<std::int32_t, 4>({ 5, 17, -5, -17 })[y];
+                matches = matches && texels[((y * 4) + x) * 4] == colour
+                    && texels[((y * 4) + x) * 4 + 3] == alpha;
+            }
+        }
+        CHECK(matches);
+    }
+}
+
+int main()
+{
+    testBC1();
+    testBC2();
+    testBC3();
+    testBC4();
+    testBC5();
+    testETC2Individual();
+    testETC2Differential();
+    testETC2TMode();
+    testETC2Alpha();
+
+    return test::result("block_decoder_test");
+}
@@ -0,0 +1,73 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <cstdio>
+
+/*
+Minimal helpers shared by the test executables. Each test is a
+stand alone program which returns non-zero if any check failed,
+so that it can be run by ctest.
+*/
+
+namespace test
+{
+    inline int& failureCount()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    inline bool check(bool result, const char* expression, const char* file, int line)
+    {
+        if (!result)
+        {
+            std::printf("%s(%d): check failed: %s\n", file, line, expression);
+            failureCount()++;
+        }
+        return result;
+    }
+
+    /*!
+    \brief Prints a summary and returns the exit code for main()
+    */
+    inline int result(const char* name)
+    {
+        if (failureCount())
+        {
+            std::printf("%s: %d check(s) failed\n", name, failureCount());
+            return 1;
+        }
+        std::printf("%s: passed\n", name);
+        return 0;
+    }
+}
+
+#define CHECK(x) test::check(static_cast<bool>(x), #x, __FILE__, __LINE__)
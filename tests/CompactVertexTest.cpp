@@ -0,0 +1,471 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include "detail/CompactVertex.hpp"
+#include "detail/StaticMeshFile.hpp"
+
+#include <crogine/detail/ModelBinary.hpp>
+#include <crogine/graphics/MeshBuilder.hpp>
+
+#include <crogine/detail/glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+/*
+Round trips random vertices through the compact model binary encoding,
+the packed GPU layout and version 3 static mesh files, checking that
+the error stays within the bounds quoted for the compact format:
+normals and tangents within 0.040 degrees, UVs within 0.00098,
+colours within 0.0020 and positions, tangent signs and blend indices
+exact. Attributes out of the quantisable range must be kept as float.
+*/
+
+namespace
+{
+    namespace CompactVertex = cro::Detail::CompactVertex;
+    namespace ModelBinary = cro::Detail::ModelBinary;
+
+    constexpr std::size_t VertexCount = 100000;
+    constexpr float MaxAngleError = 0.040f; //degrees
+    constexpr float MaxUVError = 0.00098f;
+    constexpr float MaxColourError = 0.0020f;
+
+    std::mt19937 rng(1234);
+
+    glm::vec3 randomDirection()
+    {
+        std::normal_distribution<float> dist;
+        glm::vec3 v(0.f);
+        while (glm::length(v) < 0.0001f)
+        {
+            v = { dist(rng), dist(rng), dist(rng) };
+        }
+        return glm::normalize(v);
+    }
+
+    //acos() loses too much precision for angles this small
+    float angleBetween(glm::vec3 a, glm::vec3 b)
+    {
+        return glm::degrees(std::atan2(glm::length(glm::cross(a, b)), glm::dot(a, b)));
+    }
+
+    void push(std::vector<float>& dst, glm::vec3 v)
+    {
+        dst.push_back(v.x);
+        dst.push_back(v.y);
+        dst.push_back(v.z);
+    }
+
+    struct Errors final
+    {
+        float normal = 0.f;
+        float tangent = 0.f;
+        float uv = 0.f;
+        float colour = 0.f;
+        float position = 0.f;
+        float blendWeight = 0.f;
+        bool signsMatch = true;
+        bool indicesMatch = true;
+    };
+
+    //uses the same layout as version 2 model binaries
+    constexpr std::uint16_t ModelFlags = cro::VertexProperty::Position | cro::VertexProperty::Colour
+        | cro::VertexProperty::Normal | cro::VertexProperty::Tangent
+        | cro::VertexProperty::UV0 | cro::VertexProperty::UV1
+        | cro::VertexProperty::BlendIndices | cro::VertexProperty::BlendWeights;
+    constexpr std::size_t ModelStride = 3 + 4 + 3 + 4 + 2 + 2 + 4 + 4;
+
+    std::vector<float> createModelVertices(float uvRange)
+    {
+        std::uniform_real_distribution<float> position(-500.f, 500.f);
+        std::uniform_real_distribution<float> unit(0.f, 1.f);
+        std::uniform_real_distribution<float> uv(-uvRange, uvRange);
+        std::uniform_int_distribution<std::int32_t> index(0, 255);
+
+        std::vector<float> verts;
+        verts.reserve(VertexCount * ModelStride);
+        for (auto i = 0u; i < VertexCount; ++i)
+        {
+            push(verts, { position(rng), position(rng), position(rng) });
+            for (auto j = 0; j < 4; ++j)
+            {
+                verts.push_back(unit(rng));
+            }
+
+            const auto normal = randomDirection();
+            push(verts, normal);
+            push(verts, glm::normalize(glm::cross(normal, randomDirection())));
+            verts.push_back(unit(rng) < 0.5f ? -1.f : 1.f);
+
+            for (auto j = 0; j < 4; ++j)
+            {
+                verts.push_back(uv(rng));
+            }
+            for (auto j = 0; j < 4; ++j)
+            {
+                verts.push_back(static_cast<float>(index(rng)));
+            }
+
+            glm::vec4 weights(unit(rng), unit(rng), unit(rng), unit(rng));
+            weights /= (weights.x + weights.y + weights.z + weights.w);
+            for (auto j = 0; j < 4; ++j)
+            {
+                verts.push_back(weights[j]);
+            }
+        }
+        return verts;
+    }
+
+    Errors compareModelVertices(const std::vector<float>& a, const std::vector<float>& b)
+    {
+        Errors errors;
+        for (auto i = 0u; i < a.size(); i += ModelStride)
+        {
+            const auto* src = &a[i];
+            const auto* dst = &b[i];
+            for (auto j = 0; j < 3; ++j)
+            {
+                errors.position = std::max(errors.position, std::abs(src[j] - dst[j]));
+            }
+            for (auto j = 3; j < 7; ++j)
+            {
+                errors.colour = std::max(errors.colour, std::abs(src[j] - dst[j]));
+            }
+            errors.normal = std::max(errors.normal, angleBetween({ src[7], src[8], src[9] }, { dst[7], dst[8], dst[9] }));
+            errors.tangent = std::max(errors.tangent, angleBetween({ src[10], src[11], src[12] }, { dst[10], dst[11], dst[12] }));
+            errors.signsMatch = errors.signsMatch && src[13] == dst[13];
+            for (auto j = 14; j < 18; ++j)
+            {
+                errors.uv = std::max(errors.uv, std::abs(src[j] - dst[j]));
+            }
+            for (auto j = 18; j < 22; ++j)
+            {
+                errors.indicesMatch = errors.indicesMatch && src[j] == dst[j];
+            }
+            for (auto j = 22; j < 26; ++j)
+            {
+                errors.blendWeight = std::max(errors.blendWeight, std::abs(src[j] - dst[j]));
+            }
+        }
+        return errors;
+    }
+
+    void testOctEncoding()
+    {
+        //axis aligned vectors, including the folded lower hemisphere, decode exactly
+        const glm::vec3 axes[] =
+        {
+            { 1.f, 0.f, 0.f }, { -1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f },
+            { 0.f, -1.f, 0.f }, { 0.f, 0.f, 1.f }, { 0.f, 0.f, -1.f }
+        };
+
+        bool exact = true;
+        for (const auto& axis : axes)
+        {
+            exact = exact && CompactVertex::octDecode(CompactVertex::octEncode(axis)) == axis;
+        }
+        CHECK(exact);
+    }
+
+    void testModelBinary()
+    {
+        const auto verts = createModelVertices(4.f);
+
+        std::vector<std::uint8_t> encoded;
+        const auto encoding = CompactVertex::encode(verts, ModelFlags, encoded);
+        CHECK(encoding == (ModelBinary::CompactColour | ModelBinary::CompactNormal | ModelBinary::CompactTangent
+            | ModelBinary::CompactUV0 | ModelBinary::CompactUV1
+            | ModelBinary::CompactBlendIndices | ModelBinary::CompactBlendWeights));
+        CHECK(encoded.size() == VertexCount * CompactVertex::getVertexSize(ModelFlags, encoding));
+
+        //should be less than half the size of the float data
+        CHECK(encoded.size() * 2 < verts.size() * sizeof(float));
+
+        std::vector<float> decoded;
+        CHECK(CompactVertex::decode(encoded.data(), encoded.size(), ModelFlags, encoding, decoded));
+        CHECK(decoded.size() == verts.size());
+        if (decoded.size() != verts.size())
+        {
+            return;
+        }
+
+        const auto errors = compareModelVertices(verts, decoded);
+        CHECK(errors.position == 0.f);
+        CHECK(errors.colour <= MaxColourError);
+        CHECK(errors.normal <= MaxAngleError);
+        CHECK(errors.tangent <= MaxAngleError);
+        CHECK(errors.signsMatch);
+        CHECK(errors.uv <= MaxUVError);
+        CHECK(errors.indicesMatch);
+        CHECK(errors.blendWeight <= 1.f / 65535.f);
+
+        std::printf("model binary: %zu -> %zu bytes, normal %.4f deg, tangent %.4f deg, uv %.5f, colour %.5f\n",
+            verts.size() * sizeof(float), encoded.size(), errors.normal, errors.tangent, errors.uv, errors.colour);
+
+        //a truncated buffer is rejected
+        CHECK(!CompactVertex::decode(encoded.data(), encoded.size() - 1, ModelFlags, encoding, decoded));
+    }
+
+    void testOutOfRange()
+    {
+        //UVs used for tiling don't fit in a half float precisely
+        //enough so are left as floats and come back unchanged
+        const auto verts = createModelVertices(40.f);
+
+        std::vector<std::uint8_t> encoded;
+        const auto encoding = CompactVertex::encode(verts, ModelFlags, encoded);
+        CHECK((encoding & (ModelBinary::CompactUV0 | ModelBinary::CompactUV1)) == 0);
+        CHECK((encoding & ModelBinary::CompactNormal) != 0);
+
+        std::vector<float> decoded;
+        CHECK(CompactVertex::decode(encoded.data(), encoded.size(), ModelFlags, encoding, decoded));
+        CHECK(decoded.size() == verts.size());
+        if (decoded.size() == verts.size())
+        {
+            const auto errors = compareModelVertices(verts, decoded);
+            CHECK(errors.uv == 0.f);
+            CHECK(errors.normal <= MaxAngleError);
+        }
+    }
+
+    //the layout created by the BinaryMeshBuilder, with bitangents
+    //in place of the tangent sign, and uploaded to the GPU packed
+    cro::Mesh::Data createMeshLayout()
+    {
+        cro::Mesh::Data meshData;
+        meshData.attributes[cro::Mesh::Position] = 3;
+        meshData.attributes[cro::Mesh::Colour] = 4;
+        meshData.attributes[cro::Mesh::Normal] = 3;
+        meshData.attributes[cro::Mesh::Tangent] = 3;
+        meshData.attributes[cro::Mesh::Bitangent] = 3;
+        meshData.attributes[cro::Mesh::UV0] = 2;
+        meshData.vertexSize = 18 * sizeof(float);
+        return meshData;
+    }
+
+    void testPackedLayout()
+    {
+        auto meshData = createMeshLayout();
+        CompactVertex::setPackedFormat(meshData, ModelBinary::CompactColour | ModelBinary::CompactNormal
+            | ModelBinary::CompactTangent | ModelBinary::CompactUV0);
+
+        //int16 vectors are padded to 8 bytes so that each attribute is 4 byte aligned
+        CHECK(cro::Mesh::getAttributeSize(meshData, cro::Mesh::Position) == 12);
+        CHECK(cro::Mesh::getAttributeSize(meshData, cro::Mesh::Colour) == 4);
+        CHECK(cro::Mesh::getAttributeSize(meshData, cro::Mesh::Normal) == 8);
+        CHECK(cro::Mesh::getAttributeSize(meshData, cro::Mesh::Tangent) == 8);
+        CHECK(cro::Mesh::getAttributeSize(meshData, cro::Mesh::Bitangent) == 8);
+        CHECK(cro::Mesh::getAttributeSize(meshData, cro::Mesh::UV0) == 4);
+        CHECK(meshData.packedVertexSize == 44);
+        CHECK(cro::Mesh::getVertexStride(meshData) == 44);
+        CHECK(meshData.attributeFormats[cro::Mesh::Position].type == 0);
+        CHECK(meshData.attributeFormats[cro::Mesh::Colour].normalised);
+        CHECK(meshData.attributeFormats[cro::Mesh::Normal].normalised);
+        CHECK(!meshData.attributeFormats[cro::Mesh::UV0].normalised);
+
+        std::uniform_real_distribution<float> position(-500.f, 500.f);
+        std::uniform_real_distribution<float> unit(0.f, 1.f);
+        std::uniform_real_distribution<float> uv(-4.f, 4.f);
+
+        std::vector<float> verts;
+        for (auto i = 0u; i < VertexCount; ++i)
+        {
+            push(verts, { position(rng), position(rng), position(rng) });
+            for (auto j = 0; j < 4; ++j)
+            {
+                verts.push_back(unit(rng));
+            }
+            const auto normal = randomDirection();
+            const auto tangent = glm::normalize(glm::cross(normal, randomDirection()));
+            push(verts, normal);
+            push(verts, tangent);
+            push(verts, glm::cross(normal, tangent));
+            verts.push_back(uv(rng));
+            verts.push_back(uv(rng));
+        }
+
+        std::vector<std::uint8_t> packed;
+        CompactVertex::pack(verts, meshData, packed);
+        CHECK(packed.size() == VertexCount * meshData.packedVertexSize);
+
+        std::vector<float> unpacked;
+        CHECK(CompactVertex::unpack(packed.data(), packed.size(), meshData, unpacked));
+        CHECK(unpacked.size() == verts.size());
+        if (unpacked.size() != verts.size())
+        {
+            return;
+        }
+
+        Errors errors;
+        for (auto i = 0u; i < verts.size(); i += 18)
+        {
+            const auto* src = &verts[i];
+            const auto* dst = &unpacked[i];
+            for (auto j = 0; j < 3; ++j)
+            {
+                errors.position = std::max(errors.position, std::abs(src[j] - dst[j]));
+            }
+            for (auto j = 3; j < 7; ++j)
+            {
+                errors.colour = std::max(errors.colour, std::abs(src[j] - dst[j]));
+            }
+            errors.normal = std::max(errors.normal, angleBetween({ src[7], src[8], src[9] }, { dst[7], dst[8], dst[9] }));
+            errors.tangent = std::max(errors.tangent, angleBetween({ src[10], src[11], src[12] }, { dst[10], dst[11], dst[12] }));
+            errors.tangent = std::max(errors.tangent, angleBetween({ src[13], src[14], src[15] }, { dst[13], dst[14], dst[15] }));
+            for (auto j = 16; j < 18; ++j)
+            {
+                errors.uv = std::max(errors.uv, std::abs(src[j] - dst[j]));
+            }
+        }
+
+        CHECK(errors.position == 0.f);
+        CHECK(errors.colour <= MaxColourError);
+        CHECK(errors.normal <= MaxAngleError);
+        CHECK(errors.tangent <= MaxAngleError);
+        CHECK(errors.uv <= MaxUVError);
+
+        std::printf("packed vbo: %zu -> %zu bytes, normal %.4f deg, tangent %.4f deg, uv %.5f, colour %.5f\n",
+            verts.size() * sizeof(float), packed.size(), errors.normal, errors.tangent, errors.uv, errors.colour);
+    }
+
+    void testStaticMesh()
+    {
+        cro::Detail::MeshFile meshFile;
+        meshFile.flags = cro::VertexProperty::Position | cro::VertexProperty::Colour | cro::VertexProperty::Normal
+            | cro::VertexProperty::Tangent | cro::VertexProperty::Bitangent | cro::VertexProperty::UV0 | cro::VertexProperty::UV1;
+        meshFile.arrayCount = 2;
+        meshFile.indexArrays.resize(2);
+
+        const auto layout = cro::Detail::getCMFLayout(meshFile.flags);
+        const auto stride = layout.vertexSize / sizeof(float);
+        CHECK(stride == 3 + 3 + 3 + 3 + 3 + 2 + 2);
+
+        std::uniform_real_distribution<float> position(-500.f, 500.f);
+        std::uniform_real_distribution<float> unit(0.f, 1.f);
+        constexpr std::uint32_t MeshVertexCount = 5000;
+        for (auto i = 0u; i < MeshVertexCount; ++i)
+        {
+            push(meshFile.vboData, { position(rng), position(rng), position(rng) });
+            push(meshFile.vboData, { unit(rng), unit(rng), unit(rng) });
+            const auto normal = randomDirection();
+            const auto tangent = glm::normalize(glm::cross(normal, randomDirection()));
+            push(meshFile.vboData, normal);
+            push(meshFile.vboData, tangent);
+            push(meshFile.vboData, glm::cross(normal, tangent));
+            for (auto j = 0; j < 4; ++j)
+            {
+                meshFile.vboData.push_back(unit(rng));
+            }
+
+            meshFile.indexArrays[i % 2].push_back(i);
+        }
+
+        const auto directory = std::filesystem::temp_directory_path();
+        const auto floatPath = (directory / "compact_vertex_test_v2.cmf").string();
+        const auto compactPath = (directory / "compact_vertex_test_v3.cmf").string();
+
+        CHECK(cro::Detail::writeCMF(floatPath, meshFile, false));
+        CHECK(cro::Detail::writeCMF(compactPath, meshFile, true));
+
+        //version 2 files are unchanged
+        cro::Detail::MeshFile floatFile;
+        CHECK(cro::Detail::readCMF(floatPath, floatFile));
+        CHECK(floatFile.flags == meshFile.flags);
+        CHECK(floatFile.vertexEncoding == 0);
+        CHECK(floatFile.packedData.empty());
+        CHECK(floatFile.vboData == meshFile.vboData);
+        CHECK(floatFile.indexArrays == meshFile.indexArrays);
+
+        cro::Detail::MeshFile compactFile;
+        CHECK(cro::Detail::readCMF(compactPath, compactFile));
+        CHECK(compactFile.flags == meshFile.flags);
+        CHECK((compactFile.vertexEncoding & ModelBinary::CompactIndices) != 0);
+        CHECK(compactFile.indexArrays == meshFile.indexArrays);
+        CHECK(compactFile.vboData.size() == meshFile.vboData.size());
+
+        //the packed data is stored ready to upload to a VBO
+        auto packedLayout = layout;
+        CompactVertex::setPackedFormat(packedLayout, compactFile.vertexEncoding);
+        CHECK(compactFile.packedData.size() == MeshVertexCount * packedLayout.packedVertexSize);
+
+        const auto floatSize = std::filesystem::file_size(floatPath);
+        const auto compactSize = std::filesystem::file_size(compactPath);
+        CHECK(compactSize * 10 < floatSize * 7);
+        std::printf("static mesh: %zu -> %zu bytes\n", static_cast<std::size_t>(floatSize), static_cast<std::size_t>(compactSize));
+
+        if (compactFile.vboData.size() == meshFile.vboData.size())
+        {
+            Errors errors;
+            for (auto i = 0u; i < meshFile.vboData.size(); i += stride)
+            {
+                const auto* src = &meshFile.vboData[i];
+                const auto* dst = &compactFile.vboData[i];
+                for (auto j = 0; j < 3; ++j)
+                {
+                    errors.position = std::max(errors.position, std::abs(src[j] - dst[j]));
+                    errors.colour = std::max(errors.colour, std::abs(src[j + 3] - dst[j + 3]));
+                }
+                errors.normal = std::max(errors.normal, angleBetween({ src[6], src[7], src[8] }, { dst[6], dst[7], dst[8] }));
+                errors.tangent = std::max(errors.tangent, angleBetween({ src[9], src[10], src[11] }, { dst[9], dst[10], dst[11] }));
+                errors.tangent = std::max(errors.tangent, angleBetween({ src[12], src[13], src[14] }, { dst[12], dst[13], dst[14] }));
+                for (auto j = 15; j < 19; ++j)
+                {
+                    errors.uv = std::max(errors.uv, std::abs(src[j] - dst[j]));
+                }
+            }
+            CHECK(errors.position == 0.f);
+            CHECK(errors.colour <= MaxColourError);
+            CHECK(errors.normal <= MaxAngleError);
+            CHECK(errors.tangent <= MaxAngleError);
+            CHECK(errors.uv <= MaxUVError);
+        }
+
+        std::filesystem::remove(floatPath);
+        std::filesystem::remove(compactPath);
+    }
+}
+
+int main()
+{
+    testOctEncoding();
+    testModelBinary();
+    testOutOfRange();
+    testPackedLayout();
+    testStaticMesh();
+
+    return test::result("compact_vertex_test");
+}
@@ -0,0 +1,353 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include <crogine/graphics/CompressedImage.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/*
+Parses small DDS and KTX2 files embedded below, checking the format,
+level sizes and decoded colours, flipping on load, and that files with
+too many mip levels, oversized dimensions or truncated data are rejected.
+*/
+
+namespace
+{
+    using cro::CompressedImage;
+    using Colour = std::array<std::uint8_t, 4>;
+
+    //8x8 DXT1 with 4 mip levels. The base level has red, green,
+    //blue and white blocks, followed by yellow, cyan and magenta levels
+    const std::uint8_t DDSBC1[] =
+    {
+        0x44, 0x44, 0x53, 0x20, 0x7c, 0x00, 0x00, 0x00, 0x07, 0x10, 0x0a, 0x00, 0x08, 0x00, 0x00, 0x00,
+        0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+        0x04, 0x00, 0x00, 0x00, 0x44, 0x58, 0x54, 0x31, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x10, 0x40, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xe0, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x1f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+
+    //4x4 BC7 with a DX10 header
+    const std::uint8_t DDSBC7[] =
+    {
+        0x44, 0x44, 0x53, 0x20, 0x7c, 0x00, 0x00, 0x00, 0x07, 0x10, 0x08, 0x00, 0x04, 0x00, 0x00, 0x00,
+        0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+        0x04, 0x00, 0x00, 0x00, 0x44, 0x58, 0x31, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x62, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+        0x0c, 0x0d, 0x0e, 0x0f
+    };
+
+    //8x4 BC4 with 2 levels and the orientation 'ru'. The base
+    //level is red 200 on the left and 50 on the right, the second level is 128
+    const std::uint8_t KTX2BC4[] =
+    {
+        0xab, 0x4b, 0x54, 0x58, 0x20, 0x32, 0x30, 0xbb, 0x0d, 0x0a, 0x1a, 0x0a, 0x8b, 0x00, 0x00, 0x00,
+        0x01, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xb0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x12, 0x00, 0x00, 0x00, 0x4b, 0x54, 0x58, 0x6f, 0x72, 0x69, 0x65, 0x6e, 0x74, 0x61, 0x74, 0x69,
+        0x6f, 0x6e, 0x00, 0x72, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xc8, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x32, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+
+    //4x8 ETC2 RGB stored top down. The top block is an individual
+    //mode block, the bottom block a differential mode block
+    const std::uint8_t KTX2ETC2[] =
+    {
+        0xab, 0x4b, 0x54, 0x58, 0x20, 0x32, 0x30, 0xbb, 0x0d, 0x0a, 0x1a, 0x0a, 0x93, 0x00, 0x00, 0x00,
+        0x01, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x8c, 0x4c, 0x2c, 0x04, 0xcc, 0xcc, 0xaa, 0xaa, 0x81, 0x47, 0xf8, 0x5f, 0x00, 0x00, 0x00, 0x00
+    };
+
+    bool texelEquals(const std::vector<std::uint8_t>& pixels, glm::uvec2 size, std::uint32_t x, std::uint32_t y, Colour colour)
+    {
+        const auto* texel = &pixels[((y * size.x) + x) * 4];
+        return texel[0] == colour[0] && texel[1] == colour[1]
+            && texel[2] == colour[2] && texel[3] == colour[3];
+    }
+
+    bool isMirrored(const std::vector<std::uint8_t>& a, const std::vector<std::uint8_t>& b, glm::uvec2 size)
+    {
+        if (a.size() != b.size()
+            || a.size() != size.x * size.y * 4)
+        {
+            return false;
+        }
+
+        const auto rowSize = size.x * 4;
+        for (auto y = 0u; y < size.y; ++y)
+        {
+            if (!std::equal(a.begin() + (y * rowSize), a.begin() + ((y + 1) * rowSize), b.begin() + ((size.y - 1 - y) * rowSize)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void testDDS()
+    {
+        CompressedImage image;
+        CHECK(image.loadFromMemory(DDSBC1, sizeof(DDSBC1)));
+        CHECK(image.getFormat() == CompressedImage::Format::BC1);
+        CHECK(image.getSize() == glm::uvec2(8u));
+        CHECK(!image.isBottomUp());
+        CHECK(!image.needsRowFlip());
+
+        constexpr std::array<std::uint32_t, 4> Sizes = { 8, 4, 2, 1 };
+        constexpr std::array<std::size_t, 4> ByteCounts = { 32, 8, 8, 8 };
+        CHECK(image.getLevelCount() == Sizes.size());
+        for (auto i = 0u; i < image.getLevelCount() && i < Sizes.size(); ++i)
+        {
+            CHECK(image.getLevelSize(i) == glm::uvec2(Sizes[i]));
+            CHECK(image.getLevelByteCount(i) == ByteCounts[i]);
+        }
+
+        const auto base = image.decompress();
+        CHECK(base.size() == 8 * 8 * 4);
+        CHECK(texelEquals(base, image.getSize(), 0, 0, { 255, 0, 0, 255 }));
+        CHECK(texelEquals(base, image.getSize(), 7, 0, { 0, 255, 0, 255 }));
+        CHECK(texelEquals(base, image.getSize(), 0, 7, { 0, 0, 255, 255 }));
+        CHECK(texelEquals(base, image.getSize(), 7, 7, { 255, 255, 255, 255 }));
+
+        const auto level1 = image.decompress(1);
+        CHECK(level1.size() == 4 * 4 * 4);
+        CHECK(texelEquals(level1, glm::uvec2(4u), 3, 3, { 255, 255, 0, 255 }));
+
+        const auto level3 = image.decompress(3);
+        CHECK(level3.size() == 4);
+        CHECK(texelEquals(level3, glm::uvec2(1u), 0, 0, { 255, 0, 255, 255 }));
+
+        CHECK(image.decompress(4).empty());
+    }
+
+    void testDDSFlip()
+    {
+        //vary the rows of the red block so flipping the rows
+        //inside a block is checked as well as the block order
+        std::vector<std::uint8_t> data(std::begin(DDSBC1), std::end(DDSBC1));
+        data[132] = 0x00;
+        data[133] = 0x55;
+        data[134] = 0xaa;
+        data[135] = 0xff;
+
+        CompressedImage topDown;
+        CompressedImage bottomUp;
+        CHECK(topDown.loadFromMemory(data.data(), data.size()));
+        CHECK(bottomUp.loadFromMemory(data.data(), data.size(), true));
+        CHECK(bottomUp.isBottomUp());
+        CHECK(!bottomUp.needsRowFlip());
+
+        for (auto i = 0u; i < topDown.getLevelCount(); ++i)
+        {
+            CHECK(isMirrored(topDown.decompress(i), bottomUp.decompress(i), topDown.getLevelSize(i)));
+        }
+
+        const auto pixels = bottomUp.decompress();
+        CHECK(texelEquals(pixels, bottomUp.getSize(), 0, 0, { 0, 0, 255, 255 }));
+        CHECK(texelEquals(pixels, bottomUp.getSize(), 0, 4, { 85, 0, 0, 255 }));
+        CHECK(texelEquals(pixels, bottomUp.getSize(), 0, 6, { 0, 0, 0, 255 }));
+        CHECK(texelEquals(pixels, bottomUp.getSize(), 0, 7, { 255, 0, 0, 255 }));
+    }
+
+    void testDX10()
+    {
+        CompressedImage image;
+        CHECK(image.loadFromMemory(DDSBC7, sizeof(DDSBC7), true));
+        CHECK(image.getFormat() == CompressedImage::Format::BC7);
+        CHECK(image.getLevelCount() == 1);
+        CHECK(image.getLevelByteCount(0) == 16);
+
+        //BC7 can't be flipped or decoded on the CPU
+        CHECK(!image.canDecompress());
+        CHECK(image.needsRowFlip());
+        CHECK(image.decompress().empty());
+    }
+
+    void testKTX2()
+    {
+        //stored bottom up, so nothing is flipped on load
+        CompressedImage image;
+        CHECK(image.loadFromMemory(KTX2BC4, sizeof(KTX2BC4), true));
+        CHECK(image.getFormat() == CompressedImage::Format::BC4);
+        CHECK(image.getSize() == glm::uvec2(8u, 4u));
+        CHECK(image.isBottomUp());
+        CHECK(!image.needsRowFlip());
+        CHECK(image.getLevelCount() == 2);
+
+        if (image.getLevelCount() == 2)
+        {
+            CHECK(image.getLevelSize(1) == glm::uvec2(4u, 2u));
+
+            const auto base = image.decompress();
+            CHECK(texelEquals(base, image.getSize(), 0, 0, { 200, 0, 0, 255 }));
+            CHECK(texelEquals(base, image.getSize(), 7, 3, { 50, 0, 0, 255 }));
+
+            const auto level1 = image.decompress(1);
+            CHECK(level1.size() == 4 * 2 * 4);
+            CHECK(texelEquals(level1, image.getLevelSize(1), 3, 1, { 128, 0, 0, 255 }));
+        }
+    }
+
+    void testKTX2RowFlip()
+    {
+        CompressedImage topDown;
+        CompressedImage flipped;
+        CHECK(topDown.loadFromMemory(KTX2ETC2, sizeof(KTX2ETC2)));
+        CHECK(flipped.loadFromMemory(KTX2ETC2, sizeof(KTX2ETC2), true));
+        CHECK(topDown.getFormat() == CompressedImage::Format::ETC2_RGB);
+        CHECK(topDown.getSize() == glm::uvec2(4u, 8u));
+
+        //ETC2 blocks can't be reordered, so decompress() flips the rows
+        CHECK(!topDown.needsRowFlip());
+        CHECK(!flipped.isBottomUp());
+        CHECK(flipped.needsRowFlip());
+        CHECK(std::equal(topDown.getLevelData(0), topDown.getLevelData(0) + topDown.getLevelByteCount(0), flipped.getLevelData(0)));
+        CHECK(isMirrored(topDown.decompress(), flipped.decompress(), topDown.getSize()));
+
+        //top left of the individual mode block
+        CHECK(texelEquals(topDown.decompress(), topDown.getSize(), 0, 0, { 138, 70, 36, 255 }));
+    }
+
+    void testMipLimits()
+    {
+        //an 8x8 image has at most 4 levels. Add a 5th 1x1 level
+        //so the only problem with the file is the level count
+        std::vector<std::uint8_t> data(std::begin(DDSBC1), std::end(DDSBC1));
+        data.insert(data.end(), DDSBC1 + sizeof(DDSBC1) - 8, DDSBC1 + sizeof(DDSBC1));
+        data[28] = 5;
+
+        CompressedImage image;
+        CHECK(!image.loadFromMemory(data.data(), data.size()));
+        CHECK(image.getLevelCount() == 0);
+
+        data[28] = 0xff;
+        data[31] = 0xff;
+        CHECK(!image.loadFromMemory(data.data(), data.size()));
+
+        //8x4 has at most 4 levels
+        std::vector<std::uint8_t> ktx(std::begin(KTX2BC4), std::end(KTX2BC4));
+        ktx[40] = 5;
+        CHECK(!image.loadFromMemory(ktx.data(), ktx.size()));
+
+        ktx[40] = 0xff;
+        ktx[43] = 0xff;
+        CHECK(!image.loadFromMemory(ktx.data(), ktx.size()));
+    }
+
+    void testInvalid()
+    {
+        CompressedImage image;
+        CHECK(!image.loadFromMemory(DDSBC1, sizeof(DDSBC1) - 1));
+        CHECK(!image.loadFromMemory(DDSBC1, 100));
+        CHECK(!image.loadFromMemory(KTX2BC4, sizeof(KTX2BC4) - 1));
+        CHECK(!image.loadFromMemory(KTX2BC4, 60));
+        CHECK(image.getFormat() == CompressedImage::Format::None);
+
+        const std::array<std::uint8_t, 128> zeros = {};
+        CHECK(!image.loadFromMemory(zeros.data(), zeros.size()));
+
+        //an unsupported vkFormat (R8G8B8A8_UNORM)
+        std::vector<std::uint8_t> ktx(std::begin(KTX2BC4), std::end(KTX2BC4));
+        ktx[12] = 37;
+        CHECK(!image.loadFromMemory(ktx.data(), ktx.size()));
+    }
+
+    void testSizeLimits()
+    {
+        //0xfffffffd wide would wrap the block count to 0
+        //if it were calculated in 32 bits
+        std::vector<std::uint8_t> dds(std::begin(DDSBC1), std::end(DDSBC1));
+        dds[16] = 0xfd;
+        dds[17] = dds[18] = dds[19] = 0xff;
+        dds[28] = 1;
+
+        CompressedImage image;
+        CHECK(!image.loadFromMemory(dds.data(), dds.size()));
+        CHECK(image.getLevelCount() == 0);
+
+        //16385 is one texel too many
+        dds[16] = 0x01;
+        dds[17] = 0x40;
+        dds[18] = dds[19] = 0;
+        CHECK(!image.loadFromMemory(dds.data(), dds.size()));
+
+        std::vector<std::uint8_t> ktx(std::begin(KTX2BC4), std::end(KTX2BC4));
+        ktx[24] = 0x01;
+        ktx[25] = 0x40;
+        CHECK(!image.loadFromMemory(ktx.data(), ktx.size()));
+
+        ktx[24] = 0xfd;
+        ktx[25] = ktx[26] = ktx[27] = 0xff;
+        CHECK(!image.loadFromMemory(ktx.data(), ktx.size()));
+        CHECK(image.getLevelCount() == 0);
+    }
+}
+
+int main()
+{
+    testDDS();
+    testDDSFlip();
+    testDX10();
+    testKTX2();
+    testKTX2RowFlip();
+    testMipLimits();
+    testInvalid();
+    testSizeLimits();
+
+    return test::result("compressed_image_test");
+}
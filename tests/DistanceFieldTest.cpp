@@ -0,0 +1,130 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include "detail/DistanceField.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+/*
+Checks that signed distance fields generated on the shared ThreadPool
+are bit for bit identical to those generated on a single thread, and
+that both match distances measured directly.
+*/
+
+namespace
+{
+    using cro::Detail::DistanceField;
+
+    //large enough to be split across threads
+    constexpr std::int32_t Width = 640;
+    constexpr std::int32_t Height = 480;
+    constexpr float Spread = 8.f;
+
+    std::vector<std::uint8_t> createCoverage()
+    {
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<std::int32_t> xDist(0, Width - 1);
+        std::uniform_int_distribution<std::int32_t> yDist(0, Height - 1);
+        std::uniform_int_distribution<std::int32_t> radiusDist(2, 40);
+
+        std::vector<std::uint8_t> coverage(Width * Height, 0);
+        for (auto i = 0; i < 50; ++i)
+        {
+            const auto cx = xDist(rng);
+            const auto cy = yDist(rng);
+            const auto r = radiusDist(rng);
+            for (auto y = std::max(0, cy - r); y < std::min(Height, cy + r); ++y)
+            {
+                for (auto x = std::max(0, cx - r); x < std::min(Width, cx + r); ++x)
+                {
+                    if ((x - cx) * (x - cx) + (y - cy) * (y - cy) < r * r)
+                    {
+                        coverage[y * Width + x] = 255;
+                    }
+                }
+            }
+        }
+        return coverage;
+    }
+
+    void testThreadedMatchesSerial()
+    {
+        const auto coverage = createCoverage();
+
+        DistanceField::setMultithreaded(false);
+        const auto serial = DistanceField::toSDF(coverage, Width, Height, Spread);
+
+        DistanceField::setMultithreaded(true);
+        const auto threaded = DistanceField::toSDF(coverage, Width, Height, Spread);
+
+        CHECK(serial.size() == coverage.size());
+        CHECK(serial == threaded);
+    }
+
+    void testKnownDistances()
+    {
+        //a single inside pixel, so the distance to any other pixel is known
+        constexpr std::int32_t cx = 300;
+        constexpr std::int32_t cy = 200;
+        std::vector<std::uint8_t> coverage(Width * Height, 0);
+        coverage[cy * Width + cx] = 255;
+
+        for (auto enabled : { false, true })
+        {
+            DistanceField::setMultithreaded(enabled);
+            const auto sdf = DistanceField::toSDF(coverage, Width, Height, Spread);
+
+            bool matches = true;
+            for (auto y = cy - 20; y < cy + 20; ++y)
+            {
+                for (auto x = cx - 20; x < cx + 20; ++x)
+                {
+                    //the inside pixel is 1 pixel from the nearest outside pixel
+                    const auto distance = (x == cx && y == cy) ? -1.f : std::sqrt(static_cast<float>((x - cx) * (x - cx) + (y - cy) * (y - cy)));
+                    const auto value = std::clamp(0.5f - (distance / (2.f * Spread)), 0.f, 1.f);
+                    matches = matches && (sdf[y * Width + x] == static_cast<std::uint8_t>(std::round(value * 255.f)));
+                }
+            }
+            CHECK(matches);
+        }
+    }
+}
+
+int main()
+{
+    testThreadedMatchesSerial();
+    testKnownDistances();
+
+    return test::result("distance_field_test");
+}
@@ -0,0 +1,98 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include "detail/IBLConvolution.hpp"
+
+#include <random>
+#include <vector>
+
+/*
+Checks that the IBL convolution gives bit for bit identical results
+when the texels of each level are split across the shared ThreadPool
+and when they're processed on a single thread.
+*/
+
+namespace
+{
+    using cro::Detail::IBLConvolution;
+
+    constexpr std::int32_t Width = 256;
+    constexpr std::int32_t Height = 128;
+    constexpr std::int32_t Channels = 3;
+
+    struct Output final
+    {
+        IBLConvolution::Cubemap source;
+        IBLConvolution::Cubemap irradiance;
+        IBLConvolution::Cubemap prefiltered;
+    };
+
+    Output convolve(const std::vector<float>& image, bool multithreaded)
+    {
+        IBLConvolution::setMultithreaded(multithreaded);
+
+        Output output;
+        output.source = IBLConvolution::fromEquirectangular(image.data(), Width, Height, Channels, 64);
+        IBLConvolution::generateMipmaps(output.source);
+        output.irradiance = IBLConvolution::convolveIrradiance(output.source, 8);
+        output.prefiltered = IBLConvolution::prefilter(output.source, 16, 3);
+
+        return output;
+    }
+
+    void testThreadedMatchesSerial()
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> dist(0.f, 4.f);
+
+        std::vector<float> image(Width * Height * Channels);
+        for (auto& v : image)
+        {
+            v = dist(rng);
+        }
+
+        const auto serial = convolve(image, false);
+        const auto threaded = convolve(image, true);
+
+        CHECK(serial.source.levels.size() == 7);
+        CHECK(serial.source.levels == threaded.source.levels);
+        CHECK(serial.irradiance.levels == threaded.irradiance.levels);
+        CHECK(serial.prefiltered.levels.size() == 3);
+        CHECK(serial.prefiltered.levels == threaded.prefiltered.levels);
+    }
+}
+
+int main()
+{
+    testThreadedMatchesSerial();
+
+    return test::result("ibl_convolution_test");
+}
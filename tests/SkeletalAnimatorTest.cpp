@@ -0,0 +1,222 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include <crogine/core/MessageBus.hpp>
+#include <crogine/ecs/Scene.hpp>
+#include <crogine/ecs/components/Model.hpp>
+#include <crogine/ecs/components/Skeleton.hpp>
+#include <crogine/ecs/components/Transform.hpp>
+#include <crogine/ecs/systems/SkeletalAnimator.hpp>
+
+#include <crogine/detail/glm/gtx/quaternion.hpp>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+/*
+Checks that updating skeletons on the thread pool gives exactly the
+same result as updating them on one thread, and that skeletons attached
+to other skeletons follow their parent's pose from the current frame.
+*/
+
+namespace
+{
+    constexpr std::size_t SkeletonCount = 500;
+    constexpr std::size_t JointCount = 16;
+    constexpr std::size_t ChainLength = 4;
+    constexpr std::size_t KeyFrameCount = 10;
+    constexpr std::size_t UpdateCount = 30;
+    constexpr float dt = 1.f / 60.f;
+
+    cro::Skeleton createSkeleton(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+
+        cro::Skeleton skeleton;
+        for (auto i = 0u; i < KeyFrameCount; ++i)
+        {
+            std::vector<cro::Joint> frame(JointCount);
+            for (auto j = 0u; j < JointCount; ++j)
+            {
+                frame[j].translation = { dist(rng), 1.f, dist(rng) };
+                frame[j].rotation = glm::normalize(glm::quat(1.f, dist(rng), dist(rng), dist(rng)));
+                frame[j].parent = (j % ChainLength == 0) ? -1 : static_cast<std::int32_t>(j - 1);
+            }
+            skeleton.addFrame(frame);
+        }
+
+        cro::SkeletalAnim anim;
+        anim.name = "idle";
+        anim.frameCount = KeyFrameCount;
+        anim.frameRate = 30.f;
+        anim.looped = true;
+        skeleton.addAnimation(anim);
+        skeleton.play(0);
+
+        //an attachment on the end of each chain depends on every joint in it
+        for (auto j = ChainLength - 1; j < JointCount; j += ChainLength)
+        {
+            cro::Attachment ap;
+            ap.setParent(static_cast<std::int32_t>(j));
+            skeleton.addAttachment(ap);
+        }
+
+        return skeleton;
+    }
+
+    cro::Entity createEntity(cro::Scene& scene, std::mt19937& rng, glm::vec3 position)
+    {
+        auto entity = scene.createEntity();
+        entity.addComponent<cro::Transform>().setPosition(position);
+        entity.addComponent<cro::Model>();
+        entity.addComponent<cro::Skeleton>() = createSkeleton(rng);
+        return entity;
+    }
+
+    void testMultithreadedMatchesSerial()
+    {
+        cro::MessageBus mb;
+
+        std::mt19937 serialRng(1234);
+        cro::Scene serialScene(mb);
+        serialScene.addSystem<cro::SkeletalAnimator>(mb)->setMultithreaded(false);
+
+        std::mt19937 threadedRng(1234);
+        cro::Scene threadedScene(mb);
+        threadedScene.addSystem<cro::SkeletalAnimator>(mb)->setMultithreaded(true);
+
+        //the default camera looks down -z, so place the skeletons in
+        //front of it so that they're all close enough to be interpolated
+        std::vector<cro::Entity> serialEntities;
+        std::vector<cro::Entity> threadedEntities;
+        for (auto i = 0u; i < SkeletonCount; ++i)
+        {
+            const glm::vec3 position(static_cast<float>(i % 25) - 12.f, 0.f, -5.f - static_cast<float>(i / 25));
+            serialEntities.push_back(createEntity(serialScene, serialRng, position));
+            threadedEntities.push_back(createEntity(threadedScene, threadedRng, position));
+        }
+
+        bool identical = true;
+        for (auto i = 0u; i < UpdateCount && identical; ++i)
+        {
+            serialScene.simulate(dt);
+            threadedScene.simulate(dt);
+
+            for (auto j = 0u; j < SkeletonCount && identical; ++j)
+            {
+                const auto& serialSkel = serialEntities[j].getComponent<cro::Skeleton>();
+                const auto& threadedSkel = threadedEntities[j].getComponent<cro::Skeleton>();
+                for (auto k = 0u; k < serialSkel.getAttachments().size(); ++k)
+                {
+                    const auto a = serialSkel.getAttachmentTransform(k);
+                    const auto b = threadedSkel.getAttachmentTransform(k);
+                    identical = identical && (std::memcmp(&a, &b, sizeof(glm::mat4)) == 0);
+                }
+                identical = identical && (serialSkel.getCurrentFrame() == threadedSkel.getCurrentFrame());
+            }
+        }
+        CHECK(identical);
+    }
+
+    bool nearlyEqual(const glm::mat4& a, const glm::mat4& b)
+    {
+        for (auto i = 0; i < 4; ++i)
+        {
+            const auto diff = glm::abs(a[i] - b[i]);
+            if (diff.x > 0.0001f || diff.y > 0.0001f || diff.z > 0.0001f || diff.w > 0.0001f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void testAttachmentChain()
+    {
+        cro::MessageBus mb;
+        std::mt19937 rng(5678);
+
+        cro::Scene scene(mb);
+        scene.addSystem<cro::SkeletalAnimator>(mb);
+
+        //created in reverse so that entity order is the
+        //opposite of the order in which they depend on each other
+        auto c = createEntity(scene, rng, glm::vec3(0.f));
+        auto b = createEntity(scene, rng, glm::vec3(0.f));
+        auto a = createEntity(scene, rng, glm::vec3(1.f, 2.f, -10.f));
+
+        a.getComponent<cro::Skeleton>().getAttachments()[0].setModel(b);
+        b.getComponent<cro::Skeleton>().getAttachments()[0].setModel(c);
+
+        for (auto i = 0u; i < UpdateCount; ++i)
+        {
+            scene.simulate(dt);
+
+            const auto expectedB = a.getComponent<cro::Transform>().getWorldTransform()
+                * a.getComponent<cro::Skeleton>().getAttachmentTransform(0);
+            const auto expectedC = expectedB * b.getComponent<cro::Skeleton>().getAttachmentTransform(0);
+
+            CHECK(nearlyEqual(b.getComponent<cro::Transform>().getWorldTransform(), expectedB));
+            CHECK(nearlyEqual(c.getComponent<cro::Transform>().getWorldTransform(), expectedC));
+        }
+    }
+
+    void testCircularAttachment()
+    {
+        cro::MessageBus mb;
+        std::mt19937 rng(91011);
+
+        cro::Scene scene(mb);
+        scene.addSystem<cro::SkeletalAnimator>(mb);
+
+        auto a = createEntity(scene, rng, glm::vec3(0.f, 0.f, -10.f));
+        auto b = createEntity(scene, rng, glm::vec3(0.f, 0.f, -10.f));
+        a.getComponent<cro::Skeleton>().getAttachments()[0].setModel(b);
+        b.getComponent<cro::Skeleton>().getAttachments()[0].setModel(a);
+
+        //mustn't hang, the result is undefined but should still be updated
+        for (auto i = 0u; i < UpdateCount; ++i)
+        {
+            scene.simulate(dt);
+        }
+        CHECK(a.getComponent<cro::Skeleton>().getCurrentFrame() != 0);
+    }
+}
+
+int main()
+{
+    testMultithreadedMatchesSerial();
+    testAttachmentChain();
+    testCircularAttachment();
+
+    return test::result("skeletal_animator_test");
+}
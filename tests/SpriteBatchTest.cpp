@@ -0,0 +1,251 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include "detail/GLCheck.hpp"
+#include "detail/SpriteBatch.hpp"
+
+#include <crogine/detail/glm/gtc/matrix_transform.hpp>
+
+#include <vector>
+
+/*
+Checks the SpriteBatcher used by the RenderSystem2D converts strips
+and fans to triangle lists with consistent winding, splits batches
+when the render state changes and keeps unbatched drawables in order.
+None of this requires an OpenGL context.
+*/
+
+namespace
+{
+    using cro::Detail::SpriteBatcher;
+    using cro::Detail::SpriteBatchKey;
+
+    //twice the signed area, positive if counter-clockwise
+    float winding(glm::vec2 a, glm::vec2 b, glm::vec2 c)
+    {
+        return ((b.x - a.x) * (c.y - a.y)) - ((c.x - a.x) * (b.y - a.y));
+    }
+
+    std::vector<cro::Vertex2D> createQuad()
+    {
+        return
+        {
+            cro::Vertex2D(glm::vec2(0.f, 1.f)),
+            cro::Vertex2D(glm::vec2(0.f)),
+            cro::Vertex2D(glm::vec2(1.f)),
+            cro::Vertex2D(glm::vec2(1.f, 0.f))
+        };
+    }
+
+    void testTriangles()
+    {
+        SpriteBatcher batcher;
+        std::vector<cro::Vertex2D> vertices =
+        {
+            cro::Vertex2D(glm::vec2(0.f)),
+            cro::Vertex2D(glm::vec2(1.f, 0.f)),
+            cro::Vertex2D(glm::vec2(1.f)),
+            cro::Vertex2D(glm::vec2(2.f)) //incomplete triangle is dropped
+        };
+
+        CHECK(batcher.add({}, vertices, GL_TRIANGLES, glm::translate(glm::mat4(1.f), glm::vec3(10.f, 20.f, 0.f))));
+        CHECK(batcher.getVertices().size() == 3);
+        CHECK(batcher.getVertices()[0].position == glm::vec2(10.f, 20.f));
+        CHECK(batcher.getVertices()[2].position == glm::vec2(11.f, 21.f));
+    }
+
+    void testStrip()
+    {
+        SpriteBatcher batcher;
+
+        //a zig zag strip of 4 triangles, all counter-clockwise as GL draws them
+        std::vector<cro::Vertex2D> vertices;
+        for (auto i = 0; i < 6; ++i)
+        {
+            vertices.emplace_back(glm::vec2(static_cast<float>(i / 2), (i % 2) == 0 ? 1.f : 0.f));
+        }
+
+        CHECK(batcher.add({}, vertices, GL_TRIANGLE_STRIP, glm::mat4(1.f)));
+
+        const auto& output = batcher.getVertices();
+        CHECK(output.size() == 12);
+        for (auto i = 0u; i + 2 < output.size(); i += 3)
+        {
+            CHECK(winding(output[i].position, output[i + 1].position, output[i + 2].position) > 0.f);
+        }
+
+        //each triangle uses the same vertices as the strip
+        CHECK(output[0].position == vertices[0].position);
+        CHECK(output[1].position == vertices[1].position);
+        CHECK(output[2].position == vertices[2].position);
+        CHECK(output[3].position == vertices[2].position);
+        CHECK(output[4].position == vertices[1].position);
+        CHECK(output[5].position == vertices[3].position);
+
+        //quads are usually drawn as strips of 4
+        batcher.clear();
+        CHECK(batcher.add({}, createQuad(), GL_TRIANGLE_STRIP, glm::mat4(1.f)));
+        CHECK(batcher.getVertices().size() == 6);
+        CHECK(winding(output[0].position, output[1].position, output[2].position)
+            == winding(output[3].position, output[4].position, output[5].position));
+    }
+
+    void testFan()
+    {
+        SpriteBatcher batcher;
+        std::vector<cro::Vertex2D> vertices =
+        {
+            cro::Vertex2D(glm::vec2(0.f)),
+            cro::Vertex2D(glm::vec2(1.f, 0.f)),
+            cro::Vertex2D(glm::vec2(1.f)),
+            cro::Vertex2D(glm::vec2(0.f, 1.f)),
+            cro::Vertex2D(glm::vec2(-1.f, 0.f))
+        };
+
+        CHECK(batcher.add({}, vertices, GL_TRIANGLE_FAN, glm::mat4(1.f)));
+
+        const auto& output = batcher.getVertices();
+        CHECK(output.size() == 9);
+        for (auto i = 0u; i + 2 < output.size(); i += 3)
+        {
+            const auto tri = i / 3;
+            CHECK(output[i].position == vertices[0].position);
+            CHECK(output[i + 1].position == vertices[tri + 1].position);
+            CHECK(output[i + 2].position == vertices[tri + 2].position);
+            CHECK(winding(output[i].position, output[i + 1].position, output[i + 2].position) > 0.f);
+        }
+    }
+
+    void testUnsupportedPrimitive()
+    {
+        SpriteBatcher batcher;
+        CHECK(!SpriteBatcher::canBatch(GL_LINE_STRIP));
+        CHECK(!batcher.add({}, createQuad(), GL_LINE_STRIP, glm::mat4(1.f)));
+        CHECK(batcher.getVertices().empty());
+        CHECK(batcher.getBatches().empty());
+    }
+
+    void testKeySplitting()
+    {
+        SpriteBatchKey keyA;
+        keyA.textureID = 1;
+        keyA.shaderID = 2;
+
+        auto keyB = keyA;
+        keyB.textureID = 3;
+
+        auto keyC = keyA;
+        keyC.scissor = cro::IntRect(0, 0, 10, 10);
+
+        auto keyD = keyA;
+        keyD.blendMode = cro::Material::BlendMode::Alpha;
+
+        SpriteBatcher batcher;
+        const auto quad = createQuad();
+        batcher.add(keyA, quad, GL_TRIANGLE_STRIP, glm::mat4(1.f));
+        batcher.add(keyA, quad, GL_TRIANGLE_STRIP, glm::mat4(1.f));
+        batcher.add(keyB, quad, GL_TRIANGLE_STRIP, glm::mat4(1.f));
+        batcher.add(keyC, quad, GL_TRIANGLE_STRIP, glm::mat4(1.f));
+        batcher.add(keyD, quad, GL_TRIANGLE_STRIP, glm::mat4(1.f));
+        batcher.add(keyA, quad, GL_TRIANGLE_STRIP, glm::mat4(1.f)); //batches are never reordered
+
+        //empty drawables neither add a batch nor break the current one
+        batcher.add(keyB, {}, GL_TRIANGLE_STRIP, glm::mat4(1.f));
+        batcher.add(keyA, quad, GL_TRIANGLE_STRIP, glm::mat4(1.f));
+
+        const auto& batches = batcher.getBatches();
+        CHECK(batches.size() == 5);
+        if (batches.size() == 5)
+        {
+            CHECK(batches[0].key == keyA);
+            CHECK(batches[0].drawableCount == 2);
+            CHECK(batches[0].firstVertex == 0);
+            CHECK(batches[0].vertexCount == 12);
+
+            CHECK(batches[1].key == keyB);
+            CHECK(batches[2].key == keyC);
+            CHECK(batches[3].key == keyD);
+
+            CHECK(batches[4].key == keyA);
+            CHECK(batches[4].drawableCount == 2);
+            CHECK(batches[4].firstVertex == 30);
+            CHECK(batches[4].vertexCount == 12);
+        }
+        CHECK(batcher.getVertices().size() == 42);
+
+        batcher.clear();
+        CHECK(batcher.getVertices().empty());
+        CHECK(batcher.getBatches().empty());
+    }
+
+    void testUnbatchedOrder()
+    {
+        SpriteBatcher batcher;
+        const auto quad = createQuad();
+
+        batcher.add({}, quad, GL_TRIANGLE_STRIP, glm::mat4(1.f));
+        batcher.addUnbatched(7);
+        batcher.add({}, quad, GL_TRIANGLE_STRIP, glm::mat4(1.f)); //same key but mustn't merge across the unbatched draw
+        batcher.addUnbatched(8);
+        batcher.addUnbatched(9);
+
+        const auto& batches = batcher.getBatches();
+        CHECK(batches.size() == 5);
+        if (batches.size() == 5)
+        {
+            CHECK(batches[0].vertexCount == 6);
+
+            CHECK(batches[1].vertexCount == 0);
+            CHECK(batches[1].drawableIndex == 7);
+            CHECK(batches[1].drawableCount == 1);
+
+            CHECK(batches[2].vertexCount == 6);
+            CHECK(batches[2].firstVertex == 6);
+
+            CHECK(batches[3].vertexCount == 0);
+            CHECK(batches[3].drawableIndex == 8);
+            CHECK(batches[4].vertexCount == 0);
+            CHECK(batches[4].drawableIndex == 9);
+        }
+    }
+}
+
+int main()
+{
+    testTriangles();
+    testStrip();
+    testFan();
+    testUnsupportedPrimitive();
+    testKeySplitting();
+    testUnbatchedOrder();
+
+    return test::result("sprite_batch_test");
+}
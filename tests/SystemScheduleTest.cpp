@@ -0,0 +1,235 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include <crogine/core/MessageBus.hpp>
+#include <crogine/ecs/Scene.hpp>
+#include <crogine/ecs/System.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+/*
+Checks that the SystemManager processes systems with disjoint
+component access in parallel, keeps conflicting systems serial
+and survives a system throwing an exception.
+*/
+
+namespace
+{
+    struct Position final
+    {
+        float value = 0.f;
+    };
+
+    struct Velocity final
+    {
+        float value = 0.f;
+    };
+
+    //counts how many systems are currently inside process()
+    std::atomic<std::int32_t> activeCount = 0;
+    std::atomic<std::int32_t> maxActiveCount = 0;
+    //counts how many systems have entered process() this frame
+    std::atomic<std::int32_t> arrivalCount = 0;
+
+    //blocks until count systems have entered process() or the timeout
+    //expires. Returns true if all of them arrived, which can only happen
+    //if they were processed at the same time.
+    bool rendezvous(std::int32_t count)
+    {
+        const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (arrivalCount < count
+            && std::chrono::steady_clock::now() < timeout)
+        {
+            std::this_thread::yield();
+        }
+        return arrivalCount >= count;
+    }
+
+    void enter()
+    {
+        arrivalCount++;
+        auto count = ++activeCount;
+        auto max = maxActiveCount.load();
+        while (count > max
+            && !maxActiveCount.compare_exchange_weak(max, count)) {}
+    }
+
+    void leave()
+    {
+        activeCount--;
+    }
+
+    void reset()
+    {
+        activeCount = 0;
+        maxActiveCount = 0;
+        arrivalCount = 0;
+    }
+
+    template <typename T>
+    class WriteSystem : public cro::System
+    {
+    public:
+        WriteSystem(cro::MessageBus& mb, cro::UniqueType type)
+            : cro::System(mb, type)
+        {
+            requireComponent<T>();
+            declareWrite<T>();
+        }
+
+        void process(float) override
+        {
+            enter();
+            for (auto entity : getEntities())
+            {
+                entity.template getComponent<T>().value += 1.f;
+            }
+            overlapped = rendezvous(waitCount);
+            processCount++;
+            leave();
+
+            if (throws)
+            {
+                throw std::runtime_error("system failed");
+            }
+        }
+
+        std::int32_t waitCount = 2;
+        std::int32_t processCount = 0;
+        bool overlapped = false;
+        bool throws = false;
+    };
+
+    class PositionSystem final : public WriteSystem<Position>
+    {
+    public:
+        explicit PositionSystem(cro::MessageBus& mb) : WriteSystem(mb, typeid(PositionSystem)) {}
+    };
+
+    class VelocitySystem final : public WriteSystem<Velocity>
+    {
+    public:
+        explicit VelocitySystem(cro::MessageBus& mb) : WriteSystem(mb, typeid(VelocitySystem)) {}
+    };
+
+    class OtherPositionSystem final : public WriteSystem<Position>
+    {
+    public:
+        explicit OtherPositionSystem(cro::MessageBus& mb) : WriteSystem(mb, typeid(OtherPositionSystem)) {}
+    };
+
+    void createEntities(cro::Scene& scene)
+    {
+        for (auto i = 0; i < 10; ++i)
+        {
+            auto entity = scene.createEntity();
+            entity.addComponent<Position>();
+            entity.addComponent<Velocity>();
+        }
+    }
+
+    void testDisjointSystemsOverlap()
+    {
+        reset();
+        cro::MessageBus mb;
+        cro::Scene scene(mb);
+        auto* positionSystem = scene.addSystem<PositionSystem>(mb);
+        auto* velocitySystem = scene.addSystem<VelocitySystem>(mb);
+        createEntities(scene);
+
+        scene.simulate(1.f);
+
+        CHECK(positionSystem->processCount == 1);
+        CHECK(velocitySystem->processCount == 1);
+        CHECK(positionSystem->overlapped);
+        CHECK(velocitySystem->overlapped);
+        CHECK(maxActiveCount == 2);
+    }
+
+    void testConflictingSystemsAreSerial()
+    {
+        reset();
+        cro::MessageBus mb;
+        cro::Scene scene(mb);
+        auto* first = scene.addSystem<PositionSystem>(mb);
+        auto* second = scene.addSystem<OtherPositionSystem>(mb);
+        first->waitCount = second->waitCount = 1;
+        createEntities(scene);
+
+        scene.simulate(1.f);
+
+        CHECK(first->processCount == 1);
+        CHECK(second->processCount == 1);
+        CHECK(maxActiveCount == 1);
+    }
+
+    void testThrowingSystem()
+    {
+        reset();
+        cro::MessageBus mb;
+        cro::Scene scene(mb);
+        auto* positionSystem = scene.addSystem<PositionSystem>(mb);
+        auto* velocitySystem = scene.addSystem<VelocitySystem>(mb);
+        velocitySystem->throws = true;
+        createEntities(scene);
+
+        //the exception should reach the caller without
+        //deadlocking the stage, every frame
+        for (auto i = 0; i < 3; ++i)
+        {
+            reset();
+            bool caught = false;
+            try
+            {
+                scene.simulate(1.f);
+            }
+            catch (const std::runtime_error&)
+            {
+                caught = true;
+            }
+            CHECK(caught);
+        }
+        CHECK(positionSystem->processCount == 3);
+        CHECK(velocitySystem->processCount == 3);
+    }
+}
+
+int main()
+{
+    testDisjointSystemsOverlap();
+    testConflictingSystemsAreSerial();
+    testThrowingSystem();
+
+    return test::result("system_schedule_test");
+}
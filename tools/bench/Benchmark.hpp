@@ -0,0 +1,76 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+/*
+Helpers shared by the benchmark executables. Each benchmark
+is a stand alone program which prints its results to stdout
+so that numbers quoted in commits can be reproduced.
+*/
+
+namespace bench
+{
+    /*!
+    \brief Runs the given function count times and returns the
+    mean time of a single run, in milliseconds.
+    \param warmup Number of untimed runs performed first
+    */
+    template <typename T>
+    double run(std::size_t count, T&& func, std::size_t warmup = 1)
+    {
+        for (auto i = 0u; i < warmup; ++i)
+        {
+            func();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (auto i = 0u; i < count; ++i)
+        {
+            func();
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::milli>(end - start).count() / static_cast<double>(count);
+    }
+
+    /*!
+    \brief Prevents the optimiser from removing a computed value
+    */
+    template <typename T>
+    void consume(const T& value)
+    {
+        static volatile std::uint8_t sink = 0;
+        sink = sink + *reinterpret_cast<const volatile std::uint8_t*>(&value);
+    }
+}
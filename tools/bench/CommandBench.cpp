@@ -0,0 +1,124 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+/*
+Measures sending 500 commands a frame to a scene of 8,000 entities
+with the CommandSystem, which sorts entities into a bucket for each
+CommandTarget flag, compared with testing the ID of every entity for
+every command, which is how commands were previously executed.
+
+Each entity has one or two of 32 flags set, and each command targets
+a single flag, so a typical command is executed on a few hundred entities. 8,000 is
+close to the most entities a Scene can hold at once, as entity IDs are
+recycled once Detail::MinFreeIDs are in use.
+*/
+
+#include "Benchmark.hpp"
+
+#include <crogine/core/MessageBus.hpp>
+#include <crogine/ecs/Scene.hpp>
+#include <crogine/ecs/components/CommandTarget.hpp>
+#include <crogine/ecs/systems/CommandSystem.hpp>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t EntityCount = 8000;
+    constexpr std::size_t CommandCount = 500;
+    constexpr std::size_t UpdateCount = 100;
+    constexpr float dt = 1.f / 60.f;
+}
+
+int main()
+{
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<std::uint32_t> flagDist(0, 31);
+
+    cro::MessageBus mb;
+    cro::Scene scene(mb);
+    auto* commandSystem = scene.addSystem<cro::CommandSystem>(mb);
+
+    std::vector<cro::Entity> entities;
+    for (auto i = 0u; i < EntityCount; ++i)
+    {
+        auto entity = scene.createEntity();
+        auto& target = entity.addComponent<cro::CommandTarget>();
+        target.ID = (1u << flagDist(rng));
+        if (i % 4 == 0)
+        {
+            target.ID |= (1u << flagDist(rng));
+        }
+        entities.push_back(entity);
+    }
+    scene.simulate(dt);
+
+    std::vector<cro::Command> commands(CommandCount);
+    std::size_t executed = 0;
+    for (auto& cmd : commands)
+    {
+        cmd.targetFlags = (1u << flagDist(rng));
+        cmd.action = [&executed](cro::Entity, float)
+        {
+            executed++;
+        };
+    }
+
+    const auto bucketTime = bench::run(UpdateCount, [&]()
+        {
+            for (const auto& cmd : commands)
+            {
+                commandSystem->sendCommand(cmd);
+            }
+            scene.simulate(dt);
+        });
+    const auto bucketExecuted = executed / (UpdateCount + 1);
+
+    executed = 0;
+    const auto scanTime = bench::run(UpdateCount, [&]()
+        {
+            for (const auto& cmd : commands)
+            {
+                for (auto e : entities)
+                {
+                    if (e.getComponent<cro::CommandTarget>().ID & cmd.targetFlags)
+                    {
+                        cmd.action(e, dt);
+                    }
+                }
+            }
+        });
+    const auto scanExecuted = executed / (UpdateCount + 1);
+
+    std::printf("%zu entities, %zu commands/frame\n", EntityCount, CommandCount);
+    std::printf("CommandSystem buckets:   %8.3f ms/frame, %zu actions/frame\n", bucketTime, bucketExecuted);
+    std::printf("test every entity:       %8.3f ms/frame, %zu actions/frame\n", scanTime, scanExecuted);
+
+    return 0;
+}
@@ -0,0 +1,164 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+/*
+Measures iteration over Transform + Model pairs at 1k, 10k and 50k
+entities, comparing the entity-indexed ComponentPool with the sparse
+set storage these components now use. The sparse pool is walked both
+the way systems do it (look up by entity ID from an entity list) and
+linearly with forEach(), as Scene::forEachComponent() does.
+
+To mimic a scene which has been running for a while only half of the
+entity IDs have a model, and some of the entities are removed and
+re-added so that the packed order no longer matches the entity order.
+*/
+
+#include "Benchmark.hpp"
+
+#include <crogine/ecs/components/Transform.hpp>
+#include <crogine/ecs/components/Model.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t IterationCount = 50;
+    constexpr float ChurnFraction = 0.1f;
+
+    float work(const cro::Transform& tx, const cro::Model& model)
+    {
+        const auto sphere = model.getBoundingSphere();
+        const auto centre = tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f);
+        return centre.x + centre.y + centre.z + sphere.radius;
+    }
+
+    template <typename T>
+    std::size_t indexedBytes(std::size_t count)
+    {
+        //move only types reserve MinFreeIDs slots up front
+        if constexpr (!std::is_copy_assignable_v<T>)
+        {
+            count = std::max(count, static_cast<std::size_t>(cro::Detail::MinFreeIDs));
+        }
+        return count * sizeof(T);
+    }
+
+    void runTest(std::size_t entityCount)
+    {
+        //choose which entity IDs have models
+        const auto idCount = entityCount * 2;
+        std::mt19937 rng(static_cast<std::uint32_t>(entityCount));
+        std::vector<std::uint32_t> entities(idCount);
+        for (auto i = 0u; i < idCount; ++i)
+        {
+            entities[i] = i;
+        }
+        std::shuffle(entities.begin(), entities.end(), rng);
+        entities.resize(entityCount);
+        std::sort(entities.begin(), entities.end()); //systems keep entities in the order added
+
+        cro::Detail::ComponentPool<cro::Transform> indexedTransforms(idCount);
+        cro::Detail::ComponentPool<cro::Model> indexedModels(idCount);
+
+        cro::Detail::SparsePool<cro::Transform> sparseTransforms;
+        cro::Detail::SparsePool<cro::Model> sparseModels;
+
+        std::uniform_real_distribution<float> dist(-10.f, 10.f);
+        for (auto id : entities)
+        {
+            const glm::vec3 position(dist(rng), dist(rng), dist(rng));
+            indexedTransforms[id].setPosition(position);
+
+            cro::Transform tx;
+            tx.setPosition(position);
+            sparseTransforms.insert(id, std::move(tx));
+            sparseModels.insert(id, cro::Model());
+        }
+
+        //remove and re-add some entities in a random order
+        std::vector<std::uint32_t> churned(entities.begin(), entities.end());
+        std::shuffle(churned.begin(), churned.end(), rng);
+        churned.resize(static_cast<std::size_t>(entityCount * ChurnFraction));
+        for (auto id : churned)
+        {
+            sparseTransforms.reset(id);
+            sparseModels.reset(id);
+        }
+        for (auto id : churned)
+        {
+            sparseTransforms.insert(id, cro::Transform());
+            sparseModels.insert(id, cro::Model());
+        }
+
+        float result = 0.f;
+        const auto indexedTime = bench::run(IterationCount, [&]()
+            {
+                for (auto id : entities)
+                {
+                    result += work(indexedTransforms[id], indexedModels[id]);
+                }
+            });
+
+        const auto lookupTime = bench::run(IterationCount, [&]()
+            {
+                for (auto id : entities)
+                {
+                    result += work(sparseTransforms.at(id), sparseModels.at(id));
+                }
+            });
+
+        const auto linearTime = bench::run(IterationCount, [&]()
+            {
+                sparseModels.forEach([&](std::uint32_t id, const cro::Model& model)
+                    {
+                        result += work(sparseTransforms.at(id), model);
+                    });
+            });
+        bench::consume(result);
+
+        const auto indexedMem = indexedBytes<cro::Transform>(idCount) + indexedBytes<cro::Model>(idCount);
+        const auto sparseMem = sparseTransforms.capacity() * sizeof(cro::Transform) + sparseModels.capacity() * sizeof(cro::Model);
+
+        std::printf("%6zu entities\n", entityCount);
+        std::printf("  indexed pool:          %8.3f ms  %8zu KiB\n", indexedTime, indexedMem / 1024);
+        std::printf("  sparse, entity lookup: %8.3f ms  %8zu KiB\n", lookupTime, sparseMem / 1024);
+        std::printf("  sparse, linear:        %8.3f ms\n", linearTime);
+    }
+}
+
+int main()
+{
+    for (auto count : { 1000u, 10000u, 50000u })
+    {
+        runTest(count);
+    }
+    return 0;
+}
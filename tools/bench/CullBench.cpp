@@ -0,0 +1,108 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+/*
+Measures culling 100,000 bounding spheres against a camera frustum
+with Spatial::intersects(Frustum, SphereBatch), compared with testing
+each sphere against each plane in turn, as the renderers did previously.
+*/
+
+#include "Benchmark.hpp"
+
+#include <crogine/graphics/Spatial.hpp>
+
+#include <crogine/detail/glm/gtc/matrix_transform.hpp>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t SphereCount = 100000;
+    constexpr std::size_t RunCount = 200;
+}
+
+int main()
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> posDist(-200.f, 200.f);
+    std::uniform_real_distribution<float> radiusDist(0.1f, 5.f);
+
+    std::vector<cro::Sphere> spheres;
+    cro::SphereBatch batch;
+    batch.reserve(SphereCount);
+    for (auto i = 0u; i < SphereCount; ++i)
+    {
+        auto& sphere = spheres.emplace_back(radiusDist(rng), glm::vec3(posDist(rng), posDist(rng), posDist(rng)));
+        batch.push_back(sphere);
+    }
+
+    //a typical perspective camera at the origin looking down -z
+    const auto projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 150.f);
+    cro::Frustum frustum;
+    cro::Spatial::updateFrustum(frustum, projection);
+
+    std::size_t scalarVisible = 0;
+    std::vector<std::uint32_t> scalarMask((SphereCount + 31) / 32);
+    const auto scalarTime = bench::run(RunCount, [&]()
+        {
+            scalarVisible = 0;
+            std::fill(scalarMask.begin(), scalarMask.end(), 0);
+            for (auto i = 0u; i < spheres.size(); ++i)
+            {
+                bool visible = true;
+                std::size_t j = 0;
+                while (visible && j < frustum.size())
+                {
+                    visible = (cro::Spatial::intersects(frustum[j++], spheres[i]) != cro::Planar::Back);
+                }
+
+                if (visible)
+                {
+                    scalarMask[i / 32] |= (1u << (i % 32));
+                    scalarVisible++;
+                }
+            }
+            bench::consume(scalarMask[0]);
+        });
+
+    std::size_t batchVisible = 0;
+    std::vector<std::uint32_t> batchMask;
+    const auto batchTime = bench::run(RunCount, [&]()
+        {
+            batchVisible = cro::Spatial::intersects(frustum, batch, batchMask);
+            bench::consume(batchMask[0]);
+        });
+
+    std::printf("%zu spheres, %zu visible\n", SphereCount, scalarVisible);
+    std::printf("per plane, one sphere at a time: %8.3f ms, %8.1f spheres/us\n", scalarTime, static_cast<double>(SphereCount) / (scalarTime * 1000.0));
+    std::printf("SphereBatch:                     %8.3f ms, %8.1f spheres/us, %s\n", batchTime, static_cast<double>(SphereCount) / (batchTime * 1000.0),
+        (batchVisible == scalarVisible && batchMask == scalarMask) ? "identical" : "DIFFERENT");
+
+    return 0;
+}
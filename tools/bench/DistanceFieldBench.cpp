@@ -0,0 +1,104 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+/*
+Measures generating a 2048x2048 signed distance field, both on a single
+thread and split across the shared ThreadPool.
+*/
+
+#include "Benchmark.hpp"
+
+#include "detail/DistanceField.hpp"
+
+#include <crogine/core/ThreadPool.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::int32_t FieldSize = 2048;
+    constexpr float Spread = 8.f;
+
+    constexpr std::size_t RunCount = 5;
+
+    std::vector<std::uint8_t> createCoverage(std::mt19937& rng)
+    {
+        std::uniform_int_distribution<std::int32_t> posDist(0, FieldSize - 1);
+        std::uniform_int_distribution<std::int32_t> radiusDist(4, 64);
+
+        std::vector<std::uint8_t> coverage(FieldSize * FieldSize, 0);
+        for (auto i = 0; i < 400; ++i)
+        {
+            const auto cx = posDist(rng);
+            const auto cy = posDist(rng);
+            const auto r = radiusDist(rng);
+            for (auto y = std::max(0, cy - r); y < std::min(FieldSize, cy + r); ++y)
+            {
+                for (auto x = std::max(0, cx - r); x < std::min(FieldSize, cx + r); ++x)
+                {
+                    if ((x - cx) * (x - cx) + (y - cy) * (y - cy) < r * r)
+                    {
+                        coverage[y * FieldSize + x] = 255;
+                    }
+                }
+            }
+        }
+        return coverage;
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(1234);
+    const auto coverage = createCoverage(rng);
+
+    std::vector<std::uint8_t> sdf;
+    cro::Detail::DistanceField::setMultithreaded(false);
+    const auto serialSDF = bench::run(RunCount, [&]()
+        {
+            sdf = cro::Detail::DistanceField::toSDF(coverage, FieldSize, FieldSize, Spread);
+            bench::consume(sdf[0]);
+        });
+    const auto serialOutput = sdf;
+
+    cro::Detail::DistanceField::setMultithreaded(true);
+    const auto threadedSDF = bench::run(RunCount, [&]()
+        {
+            sdf = cro::Detail::DistanceField::toSDF(coverage, FieldSize, FieldSize, Spread);
+            bench::consume(sdf[0]);
+        });
+
+    const auto threadCount = cro::ThreadPool::getShared().getThreadCount() + 1;
+    std::printf("signed distance field %dx%d, one thread:  %8.3f ms\n", FieldSize, FieldSize, serialSDF);
+    std::printf("signed distance field %dx%d, %zu threads:  %8.3f ms, %s\n", FieldSize, FieldSize, threadCount, threadedSDF,
+        sdf == serialOutput ? "identical" : "DIFFERENT");
+
+    return 0;
+}
@@ -0,0 +1,276 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+/*
+Measures building and sorting a ModelRenderer draw list using the
+64 bit keys from ModelRenderer::createSortKey(), and counts the state
+changes the render loop would make when drawing the sorted list.
+
+This is compared with the previous draw list, which held one entry per
+visible entity sorted by depth alone, and bound the shader for every
+submesh it drew.
+*/
+
+#include "Benchmark.hpp"
+
+#include <crogine/ecs/systems/ModelRenderer.hpp>
+#include <crogine/graphics/MaterialData.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t EntityCount = 2000;
+    constexpr std::size_t MaxSubmeshes = 3;
+    constexpr std::size_t ShaderCount = 16;
+    constexpr std::size_t TextureSetCount = 64;
+    constexpr float TransparentChance = 0.1f;
+    constexpr std::size_t FrameCount = 200;
+
+    struct TestEntity final
+    {
+        float distance = 0.f;
+        std::vector<std::size_t> materials;
+    };
+
+    //the draw list used before sort keys were introduced
+    struct OldSortData final
+    {
+        std::int64_t flags = 0;
+        std::vector<std::int32_t> matIDs;
+    };
+
+    struct StateChanges final
+    {
+        std::size_t shaders = 0;
+        std::size_t textures = 0;
+    };
+
+    cro::Material::Data createMaterial(std::uint32_t shader, std::uint32_t textureSet, bool transparent)
+    {
+        cro::Material::Data material;
+        material.shader = shader;
+        material.blendMode = transparent ? cro::Material::BlendMode::Alpha : cro::Material::BlendMode::None;
+
+        cro::Material::Property diffuse;
+        diffuse.type = cro::Material::Property::Texture;
+        diffuse.textureID = textureSet * 2 + 1;
+        material.properties.insert(std::make_pair("u_diffuseMap", std::make_pair(0, diffuse)));
+
+        cro::Material::Property mask;
+        mask.type = cro::Material::Property::Texture;
+        mask.textureID = textureSet * 2 + 2;
+        material.properties.insert(std::make_pair("u_maskMap", std::make_pair(1, mask)));
+
+        return material;
+    }
+
+    std::uint32_t textureSet(const cro::Material::Data& material)
+    {
+        return material.properties.at("u_diffuseMap").second.textureID;
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> chance(0.f, 1.f);
+    std::uniform_int_distribution<std::uint32_t> shaderDist(1, ShaderCount);
+    std::uniform_int_distribution<std::uint32_t> textureDist(0, TextureSetCount - 1);
+    std::uniform_int_distribution<std::size_t> submeshDist(1, MaxSubmeshes);
+
+    std::vector<cro::Material::Data> materials;
+    std::vector<TestEntity> entities(EntityCount);
+    std::size_t submeshCount = 0;
+    for (auto& entity : entities)
+    {
+        entity.distance = chance(rng) * 200.f;
+
+        const auto count = submeshDist(rng);
+        for (auto i = 0u; i < count; ++i)
+        {
+            entity.materials.push_back(materials.size());
+            materials.push_back(createMaterial(shaderDist(rng), textureDist(rng), chance(rng) < TransparentChance));
+        }
+        submeshCount += count;
+    }
+
+    //the camera moves slightly each frame so the depths change
+    std::vector<float> offsets(FrameCount);
+    for (auto& o : offsets)
+    {
+        o = chance(rng) * 2.f;
+    }
+
+    //previous method, one entry per entity per blend class sorted by depth
+    std::vector<std::pair<cro::Entity, OldSortData>> oldList;
+    std::size_t frame = 0;
+    const auto oldTime = bench::run(FrameCount, [&]()
+        {
+            oldList.clear();
+            const auto offset = offsets[frame++ % FrameCount];
+
+            for (const auto& entity : entities)
+            {
+                const auto distance = entity.distance + offset;
+                OldSortData opaque;
+                OldSortData transparent;
+                for (auto i = 0u; i < entity.materials.size(); ++i)
+                {
+                    if (materials[entity.materials[i]].blendMode != cro::Material::BlendMode::None)
+                    {
+                        transparent.matIDs.push_back(static_cast<std::int32_t>(i));
+                        transparent.flags = static_cast<std::int64_t>(-distance * 1000000.f);
+                        transparent.flags += 0x0FFF000000000000;
+                    }
+                    else
+                    {
+                        opaque.matIDs.push_back(static_cast<std::int32_t>(i));
+                        opaque.flags = static_cast<std::int64_t>(distance * 1000000.f);
+                    }
+                }
+
+                if (!opaque.matIDs.empty())
+                {
+                    oldList.emplace_back(cro::Entity(), std::move(opaque));
+                }
+                if (!transparent.matIDs.empty())
+                {
+                    oldList.emplace_back(cro::Entity(), std::move(transparent));
+                }
+            }
+
+            std::sort(oldList.begin(), oldList.end(),
+                [](const std::pair<cro::Entity, OldSortData>& a, const std::pair<cro::Entity, OldSortData>& b)
+                {
+                    return a.second.flags < b.second.flags;
+                });
+            bench::consume(oldList[0].second.flags);
+        });
+
+    //sort key method, one entry per submesh
+    std::vector<cro::MaterialPair> newList;
+    frame = 0;
+    const auto newTime = bench::run(FrameCount, [&]()
+        {
+            newList.clear();
+            const auto offset = offsets[frame++ % FrameCount];
+
+            for (auto e = 0u; e < entities.size(); ++e)
+            {
+                const auto distance = entities[e].distance + offset;
+                for (auto i = 0u; i < entities[e].materials.size(); ++i)
+                {
+                    auto& entry = newList.emplace_back(cro::Entity(), cro::SortData());
+                    entry.second.key = cro::ModelRenderer::createSortKey(materials[entities[e].materials[i]], distance);
+
+                    //the renderer stores the submesh index here, we store the
+                    //material index so that the state changes can be counted
+                    entry.second.matID = static_cast<std::int32_t>(entities[e].materials[i]);
+                }
+            }
+
+            std::sort(newList.begin(), newList.end(),
+                [](const cro::MaterialPair& a, const cro::MaterialPair& b)
+                {
+                    return a.second.key < b.second.key;
+                });
+            bench::consume(newList[0].second.key);
+        });
+
+    //count the state changes made drawing each list. The camera offset
+    //is the same for every entity so it doesn't affect the draw order.
+    //The old renderer bound the shader for every submesh it drew, regardless.
+    StateChanges oldChanges;
+    std::uint32_t lastTexture = 0;
+    std::size_t oldDraws = 0;
+    {
+        std::vector<std::pair<float, std::vector<std::size_t>>> entries;
+        for (const auto& entity : entities)
+        {
+            std::vector<std::size_t> opaque, transparent;
+            for (auto m : entity.materials)
+            {
+                (materials[m].blendMode == cro::Material::BlendMode::None ? opaque : transparent).push_back(m);
+            }
+            if (!opaque.empty())
+            {
+                entries.emplace_back(entity.distance, opaque);
+            }
+            if (!transparent.empty())
+            {
+                entries.emplace_back(100000.f - entity.distance, transparent);
+            }
+        }
+        std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {return a.first < b.first; });
+
+        for (const auto& [depth, mats] : entries)
+        {
+            for (auto m : mats)
+            {
+                oldChanges.shaders++;
+                if (textureSet(materials[m]) != lastTexture)
+                {
+                    oldChanges.textures++;
+                    lastTexture = textureSet(materials[m]);
+                }
+                oldDraws++;
+            }
+        }
+    }
+
+    StateChanges newChanges;
+    std::uint32_t lastShader = 0;
+    lastTexture = 0;
+    for (const auto& [entity, data] : newList)
+    {
+        const auto& material = materials[data.matID];
+        if (material.shader != lastShader)
+        {
+            newChanges.shaders++;
+            lastShader = material.shader;
+        }
+        if (textureSet(material) != lastTexture)
+        {
+            newChanges.textures++;
+            lastTexture = textureSet(material);
+        }
+    }
+
+    std::printf("%zu entities, %zu submeshes, %zu shaders, %zu texture sets, %.0f%% transparent\n",
+        EntityCount, submeshCount, ShaderCount, TextureSetCount, TransparentChance * 100.f);
+    std::printf("depth sort:  %8.3f ms/frame, %6zu program binds, %6zu texture set changes, %6zu draws\n",
+        oldTime, oldChanges.shaders, oldChanges.textures, oldDraws);
+    std::printf("key sort:    %8.3f ms/frame, %6zu program binds, %6zu texture set changes, %6zu draws\n",
+        newTime, newChanges.shaders, newChanges.textures, newList.size());
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+/*
+Measures the glyph atlas of a Font in its default bitmap mode and in
+signed distance field mode, when the printable ASCII characters are
+requested at the range of sizes a typical UI uses. The atlas memory
+and glyph miss count and cost are taken from Font::getAtlasStats(),
+followed by the time taken to look up every glyph once it's cached.
+
+Textures need a GL context so this runs as an App with a hidden
+window, which exits after the first frame. On machines without a
+display set SDL_VIDEODRIVER=offscreen to run it headless.
+
+By default the VeraMono font from the samples is used, alternatively
+pass the path to a different *.ttf file.
+*/
+
+#include "Benchmark.hpp"
+
+#include <crogine/core/App.hpp>
+#include <crogine/graphics/Font.hpp>
+
+#include <SDL_video.h>
+
+#include <array>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+    constexpr std::array<std::uint32_t, 7u> CharSizes = { 12, 16, 24, 32, 48, 64, 96 };
+    constexpr std::uint32_t FirstChar = 0x20;
+    constexpr std::uint32_t LastChar = 0x7e;
+
+    constexpr std::size_t RunCount = 20;
+
+    struct Result final
+    {
+        cro::Font::AtlasStats stats;
+        double lookupTime = 0.0;
+        bool failed = false;
+    };
+
+    void requestGlyphs(const cro::Font& font)
+    {
+        for (auto size : CharSizes)
+        {
+            for (auto c = FirstChar; c <= LastChar; ++c)
+            {
+                const auto glyph = font.getGlyph(c, size);
+                bench::consume(glyph.advance);
+            }
+        }
+    }
+
+    Result measure(const std::string& path, bool sdf)
+    {
+        Result result;
+
+        cro::Font font;
+        if (!font.loadFromFile(path))
+        {
+            result.failed = true;
+            return result;
+        }
+        font.setSDF(sdf);
+
+        requestGlyphs(font);
+        result.stats = font.getAtlasStats();
+        result.lookupTime = bench::run(RunCount, [&]() { requestGlyphs(font); }, 0);
+
+        return result;
+    }
+
+    void printResult(const char* name, const Result& result)
+    {
+        const auto& stats = result.stats;
+        const auto missTime = stats.glyphMisses == 0 ? 0.f : stats.rasteriseTime / static_cast<float>(stats.glyphMisses);
+        std::printf("%-7s %zu pages, %8.3f MB atlas, %zu glyphs, %zu misses, %8.3f ms rasterising (%6.3f ms/miss), cached lookup %8.3f ms\n",
+            name, stats.pageCount, static_cast<double>(stats.textureBytes) / (1024.0 * 1024.0), stats.glyphCount,
+            stats.glyphMisses, stats.rasteriseTime, missTime, result.lookupTime);
+    }
+}
+
+class FontAtlasBench final : public cro::App
+{
+public:
+    explicit FontAtlasBench(const std::string& path)
+        : cro::App(SDL_WINDOW_HIDDEN),
+        m_path(path)
+    {
+        setApplicationStrings("crogine", "font_atlas_bench");
+    }
+
+private:
+    std::string m_path;
+
+    void handleEvent(const cro::Event&) override {}
+    void handleMessage(const cro::Message&) override {}
+    void simulate(float) override
+    {
+        //everything is measured in initialise()
+        quit();
+    }
+    void render() override {}
+
+    bool initialise() override
+    {
+        const auto bitmap = measure(m_path, false);
+        const auto sdf = measure(m_path, true);
+
+        if (bitmap.failed || sdf.failed)
+        {
+            std::printf("Failed to load %s\n", m_path.c_str());
+            return false;
+        }
+
+        std::printf("%s, %u characters at %zu sizes\n", m_path.c_str(), LastChar - FirstChar + 1, CharSizes.size());
+        printResult("bitmap:", bitmap);
+        printResult("sdf:", sdf);
+
+        return true;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    FontAtlasBench app(argc > 1 ? argv[1] : BENCH_FONT_PATH);
+    app.run();
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+/*
+Measures projecting a 2048x1024 equirectangular environment map on to a
+512x512 cube map, both on a single thread and split across the shared
+ThreadPool.
+*/
+
+#include "Benchmark.hpp"
+
+#include "detail/IBLConvolution.hpp"
+
+#include <crogine/core/ThreadPool.hpp>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::int32_t EnvWidth = 2048;
+    constexpr std::int32_t EnvHeight = 1024;
+    constexpr std::uint32_t CubeSize = 512;
+
+    constexpr std::size_t RunCount = 5;
+}
+
+int main()
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(0.f, 4.f);
+    std::vector<float> environment(EnvWidth * EnvHeight * 3);
+    for (auto& v : environment)
+    {
+        v = dist(rng);
+    }
+
+    cro::Detail::IBLConvolution::setMultithreaded(false);
+    const auto serialIBL = bench::run(RunCount, [&]()
+        {
+            const auto cubemap = cro::Detail::IBLConvolution::fromEquirectangular(environment.data(), EnvWidth, EnvHeight, 3, CubeSize);
+            bench::consume(cubemap.levels[0][0]);
+        });
+
+    cro::Detail::IBLConvolution::setMultithreaded(true);
+    const auto threadedIBL = bench::run(RunCount, [&]()
+        {
+            const auto cubemap = cro::Detail::IBLConvolution::fromEquirectangular(environment.data(), EnvWidth, EnvHeight, 3, CubeSize);
+            bench::consume(cubemap.levels[0][0]);
+        });
+
+    const auto threadCount = cro::ThreadPool::getShared().getThreadCount() + 1;
+    std::printf("equirectangular to %ux%u cube map, one thread: %8.3f ms\n", CubeSize, CubeSize, serialIBL);
+    std::printf("equirectangular to %ux%u cube map, %zu threads: %8.3f ms\n", CubeSize, CubeSize, threadCount, threadedIBL);
+
+    return 0;
+}
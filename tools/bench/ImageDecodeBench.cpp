@@ -0,0 +1,206 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+/*
+Measures decoding a set of textures from disk without a GL context,
+first one at a time on the calling thread, then by queuing them all
+with ImageDecoder::predecode() and claiming them in order with take(),
+as TextureResource does when loading a model's textures.
+
+By default 48 PNG files are generated in the temp directory, 12 each
+of 2048, 1024, 512 and 256 pixels square, and removed again afterwards.
+Alternatively pass a directory, such as the golf sample's assets, and
+every *.png, *.jpg, *.ktx2 and *.dds file found in it is decoded.
+*/
+
+#include "Benchmark.hpp"
+
+#include "detail/ImageDecoder.hpp"
+
+#include <crogine/core/ThreadPool.hpp>
+#include <crogine/graphics/Image.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t ImagesPerSize = 12;
+    constexpr std::size_t RunCount = 3;
+
+    using cro::Detail::ImageDecoder;
+
+    std::vector<std::string> createImages(const std::filesystem::path& directory)
+    {
+        std::filesystem::create_directories(directory);
+
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<std::int32_t> noise(-12, 12);
+
+        std::vector<std::string> retVal;
+        for (auto size : { 2048u, 1024u, 512u, 256u })
+        {
+            for (auto i = 0u; i < ImagesPerSize; ++i)
+            {
+                //gradients with some noise, so that the files are
+                //neither trivially compressible nor incompressible
+                std::vector<std::uint8_t> pixels(size * size * 4);
+                for (auto y = 0u; y < size; ++y)
+                {
+                    for (auto x = 0u; x < size; ++x)
+                    {
+                        auto* pixel = &pixels[((y * size) + x) * 4];
+                        pixel[0] = static_cast<std::uint8_t>(std::clamp(static_cast<std::int32_t>((x * 255) / size) + noise(rng), 0, 255));
+                        pixel[1] = static_cast<std::uint8_t>(std::clamp(static_cast<std::int32_t>((y * 255) / size) + noise(rng), 0, 255));
+                        pixel[2] = static_cast<std::uint8_t>((i * 20) & 0xff);
+                        pixel[3] = 255;
+                    }
+                }
+
+                cro::Image image;
+                image.loadFromMemory(pixels.data(), size, size, cro::ImageFormat::RGBA);
+
+                const auto path = (directory / ("image_" + std::to_string(size) + "_" + std::to_string(i) + ".png")).string();
+                if (image.write(path))
+                {
+                    retVal.push_back(path);
+                }
+            }
+        }
+        return retVal;
+    }
+
+    std::vector<std::string> findImages(const std::filesystem::path& directory)
+    {
+        std::vector<std::string> retVal;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+        {
+            auto ext = entry.path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+            if (entry.is_regular_file()
+                && (ext == ".png" || ext == ".jpg" || ext == ".ktx2" || ext == ".dds"))
+            {
+                retVal.push_back(std::filesystem::absolute(entry.path()).string());
+            }
+        }
+        std::sort(retVal.begin(), retVal.end());
+        return retVal;
+    }
+
+    std::size_t getDecodedSize(const cro::Detail::DecodedImage& image)
+    {
+        if (image.isCompressed)
+        {
+            std::size_t size = 0;
+            for (auto i = 0u; i < image.compressed.getLevelCount(); ++i)
+            {
+                size += image.compressed.getLevelByteCount(i);
+            }
+            return size;
+        }
+        return image.pixels.size();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const auto tempDirectory = std::filesystem::temp_directory_path() / "cro_image_decode_bench";
+
+    std::vector<std::string> paths;
+    if (argc > 1)
+    {
+        paths = findImages(argv[1]);
+    }
+    else
+    {
+        paths = createImages(tempDirectory);
+    }
+
+    if (paths.empty())
+    {
+        std::printf("No images found\n");
+        return 1;
+    }
+
+    std::size_t failedCount = 0;
+    std::size_t decodedBytes = 0;
+    const auto serialTime = bench::run(RunCount, [&]()
+        {
+            failedCount = 0;
+            decodedBytes = 0;
+            for (const auto& path : paths)
+            {
+                auto image = ImageDecoder::decode(path);
+                if (image)
+                {
+                    decodedBytes += getDecodedSize(*image);
+                }
+                else
+                {
+                    failedCount++;
+                }
+            }
+        });
+
+    auto& decoder = ImageDecoder::getInstance();
+    std::size_t backgroundFailedCount = 0;
+    const auto backgroundTime = bench::run(RunCount, [&]()
+        {
+            for (const auto& path : paths)
+            {
+                decoder.predecode(path);
+            }
+
+            backgroundFailedCount = 0;
+            for (const auto& path : paths)
+            {
+                std::unique_ptr<cro::Detail::DecodedImage> image;
+                if (!decoder.take(path, image) || !image)
+                {
+                    backgroundFailedCount++;
+                }
+            }
+        });
+
+    if (argc < 2)
+    {
+        std::filesystem::remove_all(tempDirectory);
+    }
+
+    std::printf("%zu images, %.1f MB decoded, %zu worker threads\n", paths.size(), static_cast<double>(decodedBytes) / (1024.0 * 1024.0),
+        cro::ThreadPool::getShared().getThreadCount());
+    std::printf("calling thread: %8.1f ms, %zu failed\n", serialTime, failedCount);
+    std::printf("shared pool:    %8.1f ms, %zu failed\n", backgroundTime, backgroundFailedCount);
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+/*
+Measures logging to file from 8 threads at once. Messages are queued by
+the Logger and written out by its sink thread, which keeps the log file
+open. This is compared with opening the file, appending the message and
+closing it again for each message, as the Logger did previously, with
+the same timestamp and prefix formatting and a mutex added as the previous Logger wasn't thread safe.
+
+The Logger writes to output.log in the working directory, which is
+removed along with the comparison's log file when the benchmark ends.
+*/
+
+#include "Benchmark.hpp"
+
+#include <crogine/core/Log.hpp>
+#include <crogine/core/SysTime.hpp>
+
+#include <SDL_rwops.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t ThreadCount = 8;
+    constexpr std::size_t MessageCount = 20000; //per thread
+    const std::string LogPath("output.log");
+    const std::string ReopenPath("reopen_bench.log");
+
+    std::string createMessage(std::size_t thread, std::size_t index)
+    {
+        return "Thread " + std::to_string(thread) + " updated actor " + std::to_string(index) + " to position 12.5, 0.0, -3.25";
+    }
+
+    std::size_t countLines(const std::string& path)
+    {
+        std::ifstream file(path);
+        std::size_t count = 0;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            count++;
+        }
+        return count;
+    }
+
+    template <typename T>
+    double runThreads(T&& logMessage)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> threads;
+        for (auto i = 0u; i < ThreadCount; ++i)
+        {
+            threads.emplace_back([&, i]()
+                {
+                    for (auto j = 0u; j < MessageCount; ++j)
+                    {
+                        logMessage(createMessage(i, j));
+                    }
+                });
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main()
+{
+    constexpr auto TotalCount = static_cast<double>(ThreadCount * MessageCount);
+
+    std::remove(LogPath.c_str());
+    const auto queueTime = runThreads([](const std::string& msg)
+        {
+            cro::Logger::log(msg, cro::Logger::Type::Info, cro::Logger::Output::File);
+        });
+    const auto flushStart = std::chrono::steady_clock::now();
+    cro::Logger::flush();
+    const auto sinkTime = queueTime + std::chrono::duration<double>(std::chrono::steady_clock::now() - flushStart).count();
+    const auto sinkLines = countLines(LogPath);
+
+    std::remove(ReopenPath.c_str());
+    std::mutex mutex;
+    const auto reopenTime = runThreads([&](const std::string& msg)
+        {
+            std::scoped_lock lock(mutex);
+            auto* file = SDL_RWFromFile(ReopenPath.c_str(), "a");
+            if (file)
+            {
+                const auto line = "INFO: " + msg + "\n";
+                const auto timeStamp = cro::SysTime::timeString() + " - " + cro::SysTime::dateString() + ": ";
+                SDL_RWwrite(file, timeStamp.data(), 1, timeStamp.size());
+                SDL_RWwrite(file, line.data(), 1, line.size());
+                SDL_RWclose(file);
+            }
+        });
+    const auto reopenLines = countLines(ReopenPath);
+
+    std::remove(LogPath.c_str());
+    std::remove(ReopenPath.c_str());
+
+    std::printf("%zu threads, %zu messages each\n", ThreadCount, MessageCount);
+    std::printf("Logger, calling threads:      %10.0f messages/s\n", TotalCount / queueTime);
+    std::printf("Logger, including flush:      %10.0f messages/s, %zu lines written\n", TotalCount / sinkTime, sinkLines);
+    std::printf("reopen file for each message: %10.0f messages/s, %zu lines written\n", TotalCount / reopenTime, reopenLines);
+
+    return 0;
+}
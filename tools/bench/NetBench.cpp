@@ -0,0 +1,312 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+/*
+Measures sending actor updates from a NetHost to 16 NetClients over
+the loopback interface, similar to the golf server sending actor
+positions each net tick.
+
+First the cost of constructing a packet is compared between the
+previous method, which created a packet with the ID then resized it
+and copied the data, and creating it at its final size. Then the
+same updates are sent as one packet per update, as a single packet
+per tick built in place with a NetPacketBuilder, and queued with
+queueBroadcast() to be batched per client.
+
+Finally a batch containing a zero length entry is sent to each client,
+which should keep the packet before it and drop the rest of the batch.
+*/
+
+#include "Benchmark.hpp"
+
+#include "detail/enet/enet/enet.h"
+
+#include <crogine/network/NetClient.hpp>
+#include <crogine/network/NetHost.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+    constexpr std::uint16_t Port = 21012;
+    constexpr std::size_t ClientCount = 16;
+    constexpr std::size_t ActorCount = 64;
+    constexpr std::size_t TickCount = 200;
+    constexpr std::size_t ConstructionCount = 100000;
+    constexpr std::uint8_t ActorUpdateID = 1;
+
+    //roughly the size of the golf server's ActorInfo
+    struct ActorUpdate final
+    {
+        std::array<float, 3> position = {};
+        std::array<std::int16_t, 4> rotation = {};
+        std::uint32_t serverID = 0;
+        std::int32_t timestamp = 0;
+    };
+
+    struct Result final
+    {
+        double tickTime = 0.0; //ms spent on the host each tick
+        double elapsed = 0.0; //total seconds
+        std::size_t packets = 0; //updates received by all clients
+        std::size_t bytes = 0;
+    };
+
+    //polls the host on another thread while clients connect
+    //or disconnect, as those calls block until the host responds
+    class HostPoller final
+    {
+    public:
+        explicit HostPoller(cro::NetHost& host)
+            : m_running(true),
+            m_thread([&]()
+                {
+                    cro::NetEvent evt;
+                    while (m_running)
+                    {
+                        while (host.pollEvent(evt)) {}
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                })
+        {
+
+        }
+
+        ~HostPoller()
+        {
+            m_running = false;
+            m_thread.join();
+        }
+
+    private:
+        std::atomic_bool m_running;
+        std::thread m_thread;
+    };
+
+    template <typename T>
+    Result runTicks(cro::NetHost& host, std::array<cro::NetClient, ClientCount>& clients, T&& sendTick)
+    {
+        Result result;
+        std::array<ActorUpdate, ActorCount> actors = {};
+
+        const auto start = std::chrono::steady_clock::now();
+        for (auto i = 0u; i < TickCount; ++i)
+        {
+            for (auto j = 0u; j < ActorCount; ++j)
+            {
+                actors[j].serverID = j;
+                actors[j].timestamp = static_cast<std::int32_t>(i);
+                actors[j].position[0] = static_cast<float>(i);
+            }
+
+            const auto tickStart = std::chrono::steady_clock::now();
+            sendTick(actors);
+
+            //pollEvent() sends anything queued on the host
+            cro::NetEvent evt;
+            while (host.pollEvent(evt)) {}
+            result.tickTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tickStart).count();
+
+            for (auto& client : clients)
+            {
+                while (client.pollEvent(evt))
+                {
+                    if (evt.type == cro::NetEvent::PacketReceived)
+                    {
+                        result.packets++;
+                        result.bytes += evt.packet.getSize() + sizeof(std::uint8_t);
+                    }
+                }
+            }
+        }
+
+        //collect anything still in flight
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        for (auto& client : clients)
+        {
+            cro::NetEvent evt;
+            while (client.pollEvent(evt))
+            {
+                if (evt.type == cro::NetEvent::PacketReceived)
+                {
+                    result.packets++;
+                    result.bytes += evt.packet.getSize() + sizeof(std::uint8_t);
+                }
+            }
+        }
+        result.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.tickTime /= static_cast<double>(TickCount);
+
+        return result;
+    }
+
+    void printResult(const char* name, const Result& result)
+    {
+        const auto expected = TickCount * ActorCount * ClientCount;
+        std::printf("%s %8.3f ms/tick on host, %9.0f updates/s, %8.2f MB/s received, %zu/%zu updates\n",
+            name, result.tickTime,
+            static_cast<double>(result.packets) / result.elapsed,
+            static_cast<double>(result.bytes) / result.elapsed / (1024.0 * 1024.0),
+            result.packets, expected);
+    }
+}
+
+int main()
+{
+    //packet construction. The host creates the enet instance
+    cro::NetHost host;
+    if (!host.start("127.0.0.1", Port, ClientCount, 2))
+    {
+        std::printf("failed to start host\n");
+        return 1;
+    }
+
+    const ActorUpdate update;
+    const auto resizeTime = bench::run(ConstructionCount, [&]()
+        {
+            auto* packet = enet_packet_create(&ActorUpdateID, sizeof(std::uint8_t), ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT);
+            enet_packet_resize(packet, sizeof(std::uint8_t) + sizeof(update));
+            std::memcpy(&packet->data[sizeof(std::uint8_t)], &update, sizeof(update));
+            bench::consume(packet->data[1]);
+            enet_packet_destroy(packet);
+        });
+
+    const auto builderTime = bench::run(ConstructionCount, [&]()
+        {
+            cro::NetPacketBuilder packet(ActorUpdateID, sizeof(update), cro::NetFlag::Unreliable);
+            packet.write(update);
+            bench::consume(*static_cast<std::uint8_t*>(packet.getData()));
+        });
+
+    std::printf("packet construction, create and resize: %8.1f ns\n", resizeTime * 1000000.0);
+    std::printf("packet construction, NetPacketBuilder:  %8.1f ns\n", builderTime * 1000000.0);
+
+    //loopback
+    std::array<cro::NetClient, ClientCount> clients;
+    {
+        HostPoller poller(host);
+        for (auto& client : clients)
+        {
+            if (!client.create(2)
+                || !client.connect("127.0.0.1", Port))
+            {
+                std::printf("failed to connect client\n");
+                return 1;
+            }
+        }
+    }
+
+    std::printf("%zu clients, %zu actor updates of %zu bytes per tick, %zu ticks\n", ClientCount, ActorCount, sizeof(ActorUpdate), TickCount);
+
+    const auto perUpdate = runTicks(host, clients, [&](const std::array<ActorUpdate, ActorCount>& actors)
+        {
+            for (const auto& actor : actors)
+            {
+                host.broadcastPacket(ActorUpdateID, actor, cro::NetFlag::Unreliable);
+            }
+        });
+    printResult("broadcastPacket() per update:", perUpdate);
+
+    const auto builder = runTicks(host, clients, [&](const std::array<ActorUpdate, ActorCount>& actors)
+        {
+            cro::NetPacketBuilder packet(ActorUpdateID, sizeof(ActorUpdate) * ActorCount, cro::NetFlag::Unreliable);
+            for (const auto& actor : actors)
+            {
+                packet.write(actor);
+            }
+            host.broadcastPacket(std::move(packet));
+        });
+
+    //each packet carries every actor, so count the updates rather than packets
+    auto builderUpdates = builder;
+    builderUpdates.packets *= ActorCount;
+    printResult("NetPacketBuilder per tick:    ", builderUpdates);
+
+    const auto queued = runTicks(host, clients, [&](const std::array<ActorUpdate, ActorCount>& actors)
+        {
+            for (const auto& actor : actors)
+            {
+                host.queueBroadcast(ActorUpdateID, actor);
+            }
+        });
+    printResult("queueBroadcast() per update:  ", queued);
+
+    //the batch ID is reserved, so build a normal packet and then replace its ID
+    {
+        const std::uint16_t entrySize = sizeof(std::uint8_t) + sizeof(ActorUpdate);
+        const std::uint16_t emptySize = 0;
+
+        cro::NetPacketBuilder packet(ActorUpdateID, (sizeof(entrySize) + entrySize) * 2 + sizeof(emptySize), cro::NetFlag::Reliable);
+        packet.write(entrySize);
+        packet.write(ActorUpdateID);
+        packet.write(update);
+        packet.write(emptySize);
+        packet.write(entrySize);
+        packet.write(ActorUpdateID);
+        packet.write(update);
+        static_cast<std::uint8_t*>(packet.getData())[-1] = cro::NetBatchPacketID;
+        host.broadcastPacket(std::move(packet));
+    }
+
+    std::size_t malformedReceived = 0;
+    const auto malformedStart = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - malformedStart < std::chrono::milliseconds(200))
+    {
+        cro::NetEvent evt;
+        while (host.pollEvent(evt)) {}
+
+        for (auto& client : clients)
+        {
+            while (client.pollEvent(evt))
+            {
+                if (evt.type == cro::NetEvent::PacketReceived
+                    && evt.packet.getID() == ActorUpdateID
+                    && evt.packet.getSize() == sizeof(ActorUpdate))
+                {
+                    malformedReceived++;
+                }
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::printf("batch with a zero length entry: %zu/%zu clients read only the first update, %s\n",
+        malformedReceived, ClientCount, malformedReceived == ClientCount ? "OK" : "FAILED");
+
+    {
+        HostPoller poller(host);
+        for (auto& client : clients)
+        {
+            client.disconnect();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,239 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+/*
+Measures loading the same set of non-streaming audio files several
+times, as happens when a Scene is recreated, with the decoded audio
+cache disabled, with the default budget, and with a budget of half
+the decoded size. The cache statistics returned by
+AudioResource::getCacheStats() are printed after each.
+
+The cache is used directly rather than through an AudioResource, as
+without an audio device AudioBuffers are never decoded.
+
+By default 24 WAV files are generated in the temp directory, 16 bit
+stereo at 44.1KHz and between 1 and 8 seconds long, and removed again
+afterwards. Alternatively pass a directory, such as a sample's audio
+assets, and every *.wav, *.ogg and *.mp3 file found in it is loaded.
+*/
+
+#include "Benchmark.hpp"
+
+#include "audio/PCMCache.hpp"
+
+#include <crogine/audio/AudioResource.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t FileCount = 24;
+    constexpr std::uint32_t SampleRate = 44100;
+    constexpr std::size_t LoadCount = 4;
+
+    template <typename T>
+    void write(std::ofstream& file, T value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    std::vector<std::string> createFiles(const std::filesystem::path& directory)
+    {
+        std::filesystem::create_directories(directory);
+
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<std::int32_t> noise(-2000, 2000);
+
+        std::vector<std::string> retVal;
+        for (auto i = 0u; i < FileCount; ++i)
+        {
+            const auto frameCount = SampleRate * ((i % 8) + 1);
+            const auto dataSize = static_cast<std::uint32_t>(frameCount * 2 * sizeof(std::int16_t));
+
+            const auto path = (directory / ("audio_" + std::to_string(i) + ".wav")).string();
+            std::ofstream file(path, std::ios::binary);
+            if (!file.is_open())
+            {
+                continue;
+            }
+
+            file.write("RIFF", 4);
+            write<std::uint32_t>(file, 36 + dataSize);
+            file.write("WAVEfmt ", 8);
+            write<std::uint32_t>(file, 16);
+            write<std::uint16_t>(file, 1); //PCM
+            write<std::uint16_t>(file, 2);
+            write<std::uint32_t>(file, SampleRate);
+            write<std::uint32_t>(file, SampleRate * 2 * sizeof(std::int16_t));
+            write<std::uint16_t>(file, 2 * sizeof(std::int16_t));
+            write<std::uint16_t>(file, 16);
+            file.write("data", 4);
+            write<std::uint32_t>(file, dataSize);
+
+            std::vector<std::int16_t> samples(frameCount * 2);
+            for (auto j = 0u; j < frameCount; ++j)
+            {
+                const auto tone = static_cast<std::int32_t>(std::sin(static_cast<float>(j) * 0.05f * static_cast<float>(i + 1)) * 12000.f);
+                samples[j * 2] = static_cast<std::int16_t>(tone + noise(rng));
+                samples[j * 2 + 1] = static_cast<std::int16_t>(tone - noise(rng));
+            }
+            file.write(reinterpret_cast<const char*>(samples.data()), samples.size() * sizeof(std::int16_t));
+
+            retVal.push_back(path);
+        }
+        return retVal;
+    }
+
+    std::vector<std::string> findFiles(const std::filesystem::path& directory)
+    {
+        std::vector<std::string> retVal;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+        {
+            auto ext = entry.path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+            if (entry.is_regular_file()
+                && (ext == ".wav" || ext == ".ogg" || ext == ".mp3"))
+            {
+                retVal.push_back(std::filesystem::absolute(entry.path()).string());
+            }
+        }
+        std::sort(retVal.begin(), retVal.end());
+        return retVal;
+    }
+
+    struct Result final
+    {
+        double firstLoad = 0.0; //ms
+        double reload = 0.0; //mean ms of the remaining loads
+        std::size_t failed = 0;
+        cro::AudioResource::CacheStats stats;
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+    };
+
+    Result run(const std::vector<std::string>& paths, std::size_t budget)
+    {
+        auto& cache = cro::Detail::PCMCache::getInstance();
+
+        //empty the cache before setting the budget under test
+        cro::AudioResource::setCacheBudget(0);
+        cro::AudioResource::setCacheBudget(budget);
+        const auto startStats = cro::AudioResource::getCacheStats();
+
+        Result result;
+        for (auto i = 0u; i < LoadCount; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (const auto& path : paths)
+            {
+                //an AudioBuffer copies the samples to the audio device, then releases them
+                auto data = cache.get(path);
+                if (data)
+                {
+                    bench::consume(data->samples[0]);
+                }
+                else if (i == 0)
+                {
+                    result.failed++;
+                }
+            }
+            const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            if (i == 0)
+            {
+                result.firstLoad = elapsed;
+            }
+            else
+            {
+                result.reload += elapsed / static_cast<double>(LoadCount - 1);
+            }
+        }
+
+        result.stats = cro::AudioResource::getCacheStats();
+        result.hits = result.stats.hits - startStats.hits;
+        result.misses = result.stats.misses - startStats.misses;
+
+        return result;
+    }
+
+    void printResult(const std::string& name, const Result& result)
+    {
+        std::printf("%-20s first load %8.3f ms, reload %8.3f ms, %6.1f MB resident in %zu files, %llu hits, %llu misses, %zu failed\n",
+            name.c_str(), result.firstLoad, result.reload,
+            static_cast<double>(result.stats.residentBytes) / (1024.0 * 1024.0), result.stats.fileCount,
+            static_cast<unsigned long long>(result.hits), static_cast<unsigned long long>(result.misses), result.failed);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const auto tempDirectory = std::filesystem::temp_directory_path() / "cro_pcm_cache_bench";
+
+    std::vector<std::string> paths;
+    if (argc > 1)
+    {
+        paths = findFiles(argv[1]);
+    }
+    else
+    {
+        paths = createFiles(tempDirectory);
+    }
+
+    if (paths.empty())
+    {
+        std::printf("No audio files found\n");
+        return 1;
+    }
+
+    const auto defaultBudget = cro::AudioResource::getCacheStats().budget;
+
+    const auto uncached = run(paths, 0);
+    const auto cached = run(paths, defaultBudget);
+    const auto limited = run(paths, cached.stats.residentBytes / 2);
+
+    if (argc < 2)
+    {
+        std::filesystem::remove_all(tempDirectory);
+    }
+
+    std::printf("%zu files, %.1f MB decoded, loaded %zu times\n", paths.size(),
+        static_cast<double>(cached.stats.residentBytes) / (1024.0 * 1024.0), LoadCount);
+    printResult("no cache:", uncached);
+    printResult("budget " + std::to_string(defaultBudget / (1024 * 1024)) + " MB:", cached);
+    printResult("budget " + std::to_string(limited.stats.budget / (1024 * 1024)) + " MB:", limited);
+
+    return 0;
+}
@@ -0,0 +1,193 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+/*
+Measures how many particles can be updated per millisecond, including
+writing their vertex data, using the structure of arrays store and
+SIMD kernels in ParticleKernels.
+
+This is compared with the previous array of structures update, which
+integrated each cro::Particle with scalar code and then packed it into
+an intermediate buffer before it was copied to the VBO.
+
+Particles are given a long lifetime so that the same number are
+updated every frame.
+*/
+
+#include "Benchmark.hpp"
+
+#include "detail/ParticleKernels.hpp"
+
+#include <crogine/ecs/components/ParticleEmitter.hpp>
+#include <crogine/util/Constants.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t EmitterCount = 200;
+    constexpr std::size_t ParticlesPerEmitter = 1000;
+    constexpr std::size_t FrameCount = 100;
+    constexpr float dt = 1.f / 60.f;
+
+    const glm::vec3 Force(0.1f, 0.f, 0.2f);
+    constexpr float RotationSpeed = 10.f;
+    constexpr float ScaleModifier = 0.1f;
+
+    cro::Particle createParticle(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+        cro::Particle p;
+        p.position = { dist(rng), dist(rng), dist(rng) };
+        p.velocity = { dist(rng), dist(rng) + 2.f, dist(rng) };
+        p.gravity = { 0.f, -9.f, 0.f };
+        p.acceleration = 0.99f;
+        p.lifetime = p.maxLifeTime = 100000.f;
+        p.rotation = dist(rng) * 180.f;
+        return p;
+    }
+
+    //the previous update, run on each emitter in turn
+    cro::Sphere updateAoS(std::vector<cro::Particle>& particles, std::vector<float>& dataBuffer, float* vbo)
+    {
+        glm::vec3 minBounds(std::numeric_limits<float>::max());
+        glm::vec3 maxBounds(0.f);
+
+        for (auto& p : particles)
+        {
+            p.velocity *= p.acceleration;
+            p.velocity += p.gravity * dt;
+            p.velocity += Force * dt;
+            p.position += p.velocity * dt;
+
+            p.lifetime -= dt;
+            p.colour.setAlpha(std::min(1.f, std::max(p.lifetime / p.maxLifeTime, 0.f)));
+
+            p.rotation += RotationSpeed * dt;
+            p.scale += ((p.scale * ScaleModifier) * dt);
+
+            minBounds = glm::min(minBounds, p.position);
+            maxBounds = glm::max(maxBounds, p.position);
+        }
+
+        auto idx = 0u;
+        for (const auto& p : particles)
+        {
+            dataBuffer[idx++] = p.position.x;
+            dataBuffer[idx++] = p.position.y;
+            dataBuffer[idx++] = p.position.z;
+
+            dataBuffer[idx++] = p.colour.getRed();
+            dataBuffer[idx++] = p.colour.getGreen();
+            dataBuffer[idx++] = p.colour.getBlue();
+            dataBuffer[idx++] = p.colour.getAlpha();
+
+            dataBuffer[idx++] = p.rotation * cro::Util::Const::degToRad;
+            dataBuffer[idx++] = p.scale;
+            dataBuffer[idx++] = static_cast<float>(p.frameID);
+        }
+        //stands in for glBufferSubData()
+        std::memcpy(vbo, dataBuffer.data(), idx * sizeof(float));
+
+        cro::Sphere bounds;
+        auto dist = (maxBounds - minBounds) / 2.f;
+        bounds.centre = dist + minBounds;
+        bounds.radius = glm::length(dist);
+        return bounds;
+    }
+}
+
+int main()
+{
+    using namespace cro::Detail;
+
+    std::mt19937 rng(1234);
+    std::vector<std::vector<cro::Particle>> aosEmitters(EmitterCount);
+    std::vector<ParticleStore> soaEmitters(EmitterCount);
+
+    for (auto i = 0u; i < EmitterCount; ++i)
+    {
+        soaEmitters[i].resize(ParticlesPerEmitter);
+        for (auto j = 0u; j < ParticlesPerEmitter; ++j)
+        {
+            auto p = createParticle(rng);
+            aosEmitters[i].push_back(p);
+            soaEmitters[i].set(j, p);
+        }
+    }
+
+    //stands in for the mapped VBO of each emitter
+    std::vector<float> vbo(ParticlesPerEmitter * ParticleVertexSize);
+    std::vector<float> dataBuffer(ParticlesPerEmitter * ParticleVertexSize);
+
+    const auto aosTime = bench::run(FrameCount, [&]()
+        {
+            for (auto& particles : aosEmitters)
+            {
+                bench::consume(updateAoS(particles, dataBuffer, vbo.data()));
+            }
+        });
+
+    ParticleUpdateParams params;
+    params.dt = dt;
+    params.force = Force;
+    params.rotation = RotationSpeed * dt;
+    params.scale = 1.f + (ScaleModifier * dt);
+
+    const auto soaTime = bench::run(FrameCount, [&]()
+        {
+            for (auto& particles : soaEmitters)
+            {
+                updateParticles(particles, ParticlesPerEmitter, params);
+                bench::consume(calcParticleBounds(particles, ParticlesPerEmitter));
+                writeParticleVertices(particles, ParticlesPerEmitter, vbo.data());
+            }
+        });
+
+    //make sure both versions agree
+    float maxError = 0.f;
+    const auto* posX = soaEmitters[0].get(ParticleStore::PositionX);
+    for (auto i = 0u; i < ParticlesPerEmitter; ++i)
+    {
+        maxError = std::max(maxError, std::abs(posX[i] - aosEmitters[0][i].position.x));
+    }
+
+    const auto particleCount = EmitterCount * ParticlesPerEmitter;
+    std::printf("%zu emitters, %zu particles each\n", EmitterCount, ParticlesPerEmitter);
+    std::printf("AoS scalar:   %8.3f ms/frame, %10.0f particles/ms\n", aosTime, particleCount / aosTime);
+    std::printf("SoA kernels:  %8.3f ms/frame, %10.0f particles/ms\n", soaTime, particleCount / soaTime);
+    std::printf("max position difference after %zu frames: %g\n", FrameCount + 1, maxError);
+
+    return 0;
+}
@@ -0,0 +1,240 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+/*
+Measures updating 500 animated skeletons with the SkeletalAnimator,
+both on one thread and split into batches on the shared ThreadPool,
+and compares the cost of evaluating the joint hierarchy in a single
+parent first pass, as the SkeletalAnimator does, with walking the
+parent chain of every joint back to the root, which is how it was
+done previously.
+
+Each skeleton has 64 joints arranged as 8 chains of 8 joints, similar
+to the limbs, fingers and spine of a humanoid rig.
+*/
+
+#include "Benchmark.hpp"
+
+#include <crogine/core/MessageBus.hpp>
+#include <crogine/core/ThreadPool.hpp>
+#include <crogine/ecs/Scene.hpp>
+#include <crogine/ecs/components/Model.hpp>
+#include <crogine/ecs/components/Skeleton.hpp>
+#include <crogine/ecs/components/Transform.hpp>
+#include <crogine/ecs/systems/SkeletalAnimator.hpp>
+
+#include <crogine/detail/glm/gtx/quaternion.hpp>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t SkeletonCount = 500;
+    constexpr std::size_t JointCount = 64;
+    constexpr std::size_t ChainLength = 8;
+    constexpr std::size_t KeyFrameCount = 30;
+    constexpr std::size_t UpdateCount = 200;
+    constexpr float dt = 1.f / 60.f;
+
+    std::int32_t getParent(std::size_t joint)
+    {
+        if (joint == 0)
+        {
+            return -1;
+        }
+        //first joint of each chain is attached to the root
+        return (joint % ChainLength == 1) ? 0 : static_cast<std::int32_t>(joint - 1);
+    }
+
+    cro::Skeleton createSkeleton(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+
+        cro::Skeleton skeleton;
+        for (auto i = 0u; i < KeyFrameCount; ++i)
+        {
+            std::vector<cro::Joint> frame(JointCount);
+            for (auto j = 0u; j < JointCount; ++j)
+            {
+                frame[j].translation = { dist(rng), 1.f, dist(rng) };
+                frame[j].rotation = glm::normalize(glm::quat(1.f, dist(rng), dist(rng), dist(rng)));
+                frame[j].parent = getParent(j);
+            }
+            skeleton.addFrame(frame);
+        }
+
+        cro::SkeletalAnim anim;
+        anim.name = "idle";
+        anim.frameCount = KeyFrameCount;
+        anim.frameRate = 30.f;
+        anim.looped = true;
+        skeleton.addAnimation(anim);
+        skeleton.play(0);
+
+        return skeleton;
+    }
+
+    glm::mat4 mixJoint(const cro::Joint& a, const cro::Joint& b, float time)
+    {
+        glm::mat4 result = glm::translate(glm::mat4(1.f), glm::mix(a.translation, b.translation, time));
+        result *= glm::toMat4(glm::slerp(a.rotation, b.rotation, time));
+        return glm::scale(result, glm::mix(a.scale, b.scale, time));
+    }
+
+    //the previous evaluation, which walked the parent chain of each joint
+    void evaluateParentWalk(const cro::Joint* frameA, const cro::Joint* frameB, float time,
+        std::vector<glm::mat4>& mixBuffer, std::vector<glm::mat4>& output, std::size_t& multiplies)
+    {
+        for (auto i = 0u; i < JointCount; ++i)
+        {
+            mixBuffer[i] = mixJoint(frameA[i], frameB[i], time);
+        }
+
+        for (auto i = 0u; i < JointCount; ++i)
+        {
+            glm::mat4 worldMatrix = mixBuffer[i];
+            auto parent = frameA[i].parent;
+            while (parent != -1)
+            {
+                worldMatrix = mixBuffer[parent] * worldMatrix;
+                parent = frameA[parent].parent;
+                multiplies++;
+            }
+            output[i] = worldMatrix;
+        }
+    }
+
+    //evaluates joints parent first, reusing the parent's result. Joints
+    //in these skeletons are already stored parent first.
+    void evaluateParentFirst(const cro::Joint* frameA, const cro::Joint* frameB, float time,
+        std::vector<glm::mat4>& mixBuffer, std::vector<glm::mat4>& output, std::size_t& multiplies)
+    {
+        for (auto i = 0u; i < JointCount; ++i)
+        {
+            mixBuffer[i] = mixJoint(frameA[i], frameB[i], time);
+        }
+
+        for (auto i = 0u; i < JointCount; ++i)
+        {
+            const auto parent = frameA[i].parent;
+            if (parent != -1)
+            {
+                mixBuffer[i] = mixBuffer[parent] * mixBuffer[i];
+                multiplies++;
+            }
+            output[i] = mixBuffer[i];
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(1234);
+
+    cro::MessageBus mb;
+    cro::Scene scene(mb);
+    auto* animator = scene.addSystem<cro::SkeletalAnimator>(mb);
+    animator->setMultithreaded(false);
+
+    //the default camera looks down -z, so place the skeletons in
+    //front of it so that they're all close enough to be interpolated
+    std::vector<cro::Skeleton> skeletons;
+    for (auto i = 0u; i < SkeletonCount; ++i)
+    {
+        auto entity = scene.createEntity();
+        entity.addComponent<cro::Transform>().setPosition({ static_cast<float>(i % 25) - 12.f, 0.f, -5.f - static_cast<float>(i / 25) });
+        entity.addComponent<cro::Model>();
+        entity.addComponent<cro::Skeleton>() = createSkeleton(rng);
+        skeletons.push_back(entity.getComponent<cro::Skeleton>());
+    }
+    scene.simulate(dt);
+
+    const auto animatorTime = bench::run(UpdateCount, [&]()
+        {
+            scene.simulate(dt);
+        });
+
+    animator->setMultithreaded(true);
+    const auto threadedTime = bench::run(UpdateCount, [&]()
+        {
+            scene.simulate(dt);
+        });
+
+    //evaluate the same key frames with both methods
+    std::vector<glm::mat4> mixBuffer(JointCount);
+    std::vector<glm::mat4> walkOutput(JointCount);
+    std::vector<glm::mat4> passOutput(JointCount);
+
+    std::size_t update = 0;
+    std::size_t walkMultiplies = 0;
+    const auto walkTime = bench::run(UpdateCount, [&]()
+        {
+            const auto frame = update++ % (KeyFrameCount - 1);
+            for (const auto& skeleton : skeletons)
+            {
+                const auto* frames = skeleton.getFrames().data();
+                evaluateParentWalk(frames + (frame * JointCount), frames + ((frame + 1) * JointCount), 0.5f, mixBuffer, walkOutput, walkMultiplies);
+                bench::consume(walkOutput[JointCount - 1]);
+            }
+        }, 0);
+
+    update = 0;
+    std::size_t passMultiplies = 0;
+    const auto passTime = bench::run(UpdateCount, [&]()
+        {
+            const auto frame = update++ % (KeyFrameCount - 1);
+            for (const auto& skeleton : skeletons)
+            {
+                const auto* frames = skeleton.getFrames().data();
+                evaluateParentFirst(frames + (frame * JointCount), frames + ((frame + 1) * JointCount), 0.5f, mixBuffer, passOutput, passMultiplies);
+                bench::consume(passOutput[JointCount - 1]);
+            }
+        }, 0);
+
+    //both methods should agree, give or take rounding
+    float maxError = 0.f;
+    for (auto i = 0u; i < JointCount; ++i)
+    {
+        for (auto j = 0; j < 4; ++j)
+        {
+            const auto diff = glm::abs(walkOutput[i][j] - passOutput[i][j]);
+            maxError = std::max(maxError, std::max(std::max(diff.x, diff.y), std::max(diff.z, diff.w)));
+        }
+    }
+
+    std::printf("%zu skeletons, %zu joints each, max depth %zu\n", SkeletonCount, JointCount, ChainLength);
+    std::printf("SkeletalAnimator (one thread): %8.3f ms/frame\n", animatorTime);
+    std::printf("SkeletalAnimator (%2u threads):  %8.3f ms/frame\n", static_cast<std::uint32_t>(cro::ThreadPool::getShared().getThreadCount() + 1), threadedTime);
+    std::printf("hierarchy, parent walk:        %8.3f ms/frame, %8zu matrix multiplies/frame\n", walkTime, walkMultiplies / UpdateCount);
+    std::printf("hierarchy, parent first:       %8.3f ms/frame, %8zu matrix multiplies/frame\n", passTime, passMultiplies / UpdateCount);
+    std::printf("max difference between methods: %g\n", maxError);
+
+    return 0;
+}
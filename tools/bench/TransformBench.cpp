@@ -0,0 +1,192 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+/*
+Compares the cost of reading the world transform of every node in a
+10,000 node scene graph, as the renderers do several times per frame,
+using the cached world matrix in cro::Transform against rebuilding it
+by walking the parent chain, which is how it was done previously.
+
+A small percentage of the nodes are moved each frame so that the cache
+has to be partially invalidated, as it would be in a real scene.
+*/
+
+#include "Benchmark.hpp"
+
+#include <crogine/ecs/components/Transform.hpp>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t NodeCount = 10000;
+    constexpr std::size_t TreeSize = 100; //nodes per root - makes trees ~7 deep
+    constexpr std::size_t ReadsPerFrame = 3; //eg model renderer, shadow map renderer, particles
+    constexpr float MovedFraction = 0.05f;
+    constexpr std::size_t FrameCount = 200;
+
+    struct SceneGraph final
+    {
+        std::vector<cro::Transform> transforms;
+        std::vector<std::int32_t> parents;
+        std::vector<std::vector<std::size_t>> children;
+        std::vector<std::size_t> depths;
+
+        SceneGraph()
+        {
+            transforms.resize(NodeCount);
+            parents.resize(NodeCount, -1);
+            children.resize(NodeCount);
+            depths.resize(NodeCount, 0);
+
+            std::mt19937 rng(1234);
+            std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+            for (auto i = 0u; i < NodeCount; ++i)
+            {
+                transforms[i].setPosition({ dist(rng), dist(rng), dist(rng) });
+                transforms[i].setRotation(cro::Transform::Y_AXIS, dist(rng));
+
+                //binary tree within each group of TreeSize nodes
+                const auto local = i % TreeSize;
+                if (local != 0)
+                {
+                    const auto parent = (i - local) + ((local - 1) / 2);
+                    transforms[parent].addChild(transforms[i]);
+                    parents[i] = static_cast<std::int32_t>(parent);
+                    children[parent].push_back(i);
+                    depths[i] = depths[parent] + 1;
+                }
+            }
+        }
+
+        //returns the number of nodes whose world transform
+        //is invalidated when the given node is moved
+        std::size_t countInvalidated(std::size_t idx, std::vector<std::uint8_t>& visited) const
+        {
+            if (visited[idx])
+            {
+                return 0;
+            }
+            visited[idx] = 1;
+
+            std::size_t retVal = parents[idx] == -1 ? 0 : 1; //roots need no multiply
+            for (auto c : children[idx])
+            {
+                retVal += countInvalidated(c, visited);
+            }
+            return retVal;
+        }
+    };
+
+    //the previous implementation of getWorldTransform()
+    glm::mat4 uncachedWorld(const SceneGraph& graph, std::size_t idx, std::size_t& multiplies)
+    {
+        if (graph.parents[idx] != -1)
+        {
+            multiplies++;
+            return uncachedWorld(graph, graph.parents[idx], multiplies) * graph.transforms[idx].getLocalTransform();
+        }
+        return graph.transforms[idx].getLocalTransform();
+    }
+}
+
+int main()
+{
+    SceneGraph graph;
+
+    std::size_t maxDepth = 0;
+    for (auto d : graph.depths)
+    {
+        maxDepth = std::max(maxDepth, d);
+    }
+
+    //pre-generate the moved nodes for each frame so both
+    //runs do identical work
+    std::mt19937 rng(5678);
+    std::uniform_int_distribution<std::size_t> nodeDist(0, NodeCount - 1);
+    const auto movedCount = static_cast<std::size_t>(NodeCount * MovedFraction);
+    std::vector<std::vector<std::size_t>> moved(FrameCount);
+    for (auto& frame : moved)
+    {
+        for (auto i = 0u; i < movedCount; ++i)
+        {
+            frame.push_back(nodeDist(rng));
+        }
+    }
+
+    std::size_t frame = 0;
+    std::size_t uncachedMultiplies = 0;
+    const auto uncachedTime = bench::run(FrameCount, [&]()
+        {
+            for (auto idx : moved[frame % FrameCount])
+            {
+                graph.transforms[idx].move({ 0.01f, 0.f, 0.f });
+            }
+
+            for (auto r = 0u; r < ReadsPerFrame; ++r)
+            {
+                for (auto i = 0u; i < NodeCount; ++i)
+                {
+                    bench::consume(uncachedWorld(graph, i, uncachedMultiplies));
+                }
+            }
+            frame++;
+        }, 0);
+
+    frame = 0;
+    std::size_t cachedMultiplies = 0;
+    std::vector<std::uint8_t> visited(NodeCount);
+    const auto cachedTime = bench::run(FrameCount, [&]()
+        {
+            std::fill(visited.begin(), visited.end(), 0);
+            for (auto idx : moved[frame % FrameCount])
+            {
+                graph.transforms[idx].move({ 0.01f, 0.f, 0.f });
+                cachedMultiplies += graph.countInvalidated(idx, visited);
+            }
+
+            for (auto r = 0u; r < ReadsPerFrame; ++r)
+            {
+                for (auto i = 0u; i < NodeCount; ++i)
+                {
+                    bench::consume(graph.transforms[i].getWorldTransform());
+                }
+            }
+            frame++;
+        }, 0);
+
+    std::printf("%zu nodes, max depth %zu, %zu moved and %zu world reads per node per frame\n",
+        NodeCount, maxDepth, movedCount, ReadsPerFrame);
+    std::printf("parent walk:  %8.3f ms/frame, %9zu matrix multiplies/frame\n", uncachedTime, uncachedMultiplies / FrameCount);
+    std::printf("cached:       %8.3f ms/frame, %9zu matrix multiplies/frame\n", cachedTime, cachedMultiplies / FrameCount);
+
+    return 0;
+}
@@ -0,0 +1,184 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+/*
+Measures updating the draw lists of a ModelRenderer for two cameras
+each frame, in a Scene of 50,000 static Models and 2,000 Models which
+move every frame. The default path, which tests every Model against
+each camera's frustum, is compared with tree culling enabled, which
+refits the moved Models in a BalancedTree and then queries it.
+
+A Scene holds at most Detail::MinFreeIDs (8191) entities, so the Models
+are split evenly across 8 Scenes, each with its own ModelRenderer and
+pair of cameras. A frame is the time taken to simulate all 8.
+
+The Models have no vertex data so no GL context is needed. They are
+given a submesh after they are created so that visible Models still
+add an entry to the draw list, which is never drawn.
+*/
+
+#include "Benchmark.hpp"
+
+#include <crogine/core/MessageBus.hpp>
+#include <crogine/ecs/Scene.hpp>
+#include <crogine/ecs/components/Camera.hpp>
+#include <crogine/ecs/components/Model.hpp>
+#include <crogine/ecs/components/Transform.hpp>
+#include <crogine/ecs/systems/CameraSystem.hpp>
+#include <crogine/ecs/systems/ModelRenderer.hpp>
+#include <crogine/util/Constants.hpp>
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t StaticCount = 50000;
+    constexpr std::size_t MovingCount = 2000;
+    constexpr float WorldSize = 400.f;
+    constexpr std::size_t SceneCount = 8;
+    constexpr std::size_t FrameCount = 100;
+
+    struct Result final
+    {
+        double setupTime = 0.0; //ms to add the Models and run the first frame
+        double frameTime = 0.0; //mean ms per frame
+        std::size_t visible = 0; //draw list entries for both cameras on the last frame
+    };
+
+    struct TestScene final
+    {
+        explicit TestScene(cro::MessageBus& mb) : scene(mb) {}
+
+        cro::Scene scene;
+        cro::ModelRenderer* renderer = nullptr;
+        std::array<cro::Entity, 2> cameras = {};
+        std::vector<cro::Entity> moving;
+        std::vector<glm::vec3> movingOrigins;
+    };
+
+    void createScene(TestScene& testScene, bool useTree, std::mt19937& rng)
+    {
+        auto& scene = testScene.scene;
+        scene.addSystem<cro::CameraSystem>(scene.getMessageBus());
+        testScene.renderer = scene.addSystem<cro::ModelRenderer>(scene.getMessageBus());
+        testScene.renderer->setTreeCullingEnabled(useTree);
+
+        //the default camera looks down -z, the second looks down +z
+        testScene.cameras[0] = scene.getDefaultCamera();
+        testScene.cameras[0].getComponent<cro::Camera>().setPerspective(60.f * cro::Util::Const::degToRad, 16.f / 9.f, 0.1f, 150.f);
+
+        testScene.cameras[1] = scene.createEntity();
+        testScene.cameras[1].addComponent<cro::Transform>().setRotation(cro::Transform::Y_AXIS, cro::Util::Const::PI);
+        testScene.cameras[1].addComponent<cro::Camera>().setPerspective(60.f * cro::Util::Const::degToRad, 16.f / 9.f, 0.1f, 150.f);
+
+        cro::Mesh::Data meshData;
+        meshData.boundingBox = cro::Box(glm::vec3(-0.5f), glm::vec3(0.5f));
+        meshData.boundingSphere = meshData.boundingBox;
+
+        std::uniform_real_distribution<float> posDist(-WorldSize / 2.f, WorldSize / 2.f);
+        std::uniform_real_distribution<float> heightDist(-5.f, 5.f);
+
+        constexpr auto StaticPerScene = StaticCount / SceneCount;
+        constexpr auto MovingPerScene = MovingCount / SceneCount;
+        for (auto i = 0u; i < StaticPerScene + MovingPerScene; ++i)
+        {
+            const glm::vec3 position(posDist(rng), heightDist(rng), posDist(rng));
+
+            auto entity = scene.createEntity();
+            entity.addComponent<cro::Transform>().setPosition(position);
+            entity.addComponent<cro::Model>(meshData, cro::Material::Data()).getMeshData().submeshCount = 1;
+
+            if (i >= StaticPerScene)
+            {
+                testScene.moving.push_back(entity);
+                testScene.movingOrigins.push_back(position);
+            }
+        }
+        scene.simulate(1.f / 60.f);
+    }
+
+    Result run(bool useTree)
+    {
+        Result result;
+
+        cro::MessageBus mb;
+        std::mt19937 rng(1234);
+        std::vector<std::unique_ptr<TestScene>> scenes;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (auto i = 0u; i < SceneCount; ++i)
+        {
+            createScene(*scenes.emplace_back(std::make_unique<TestScene>(mb)), useTree, rng);
+        }
+        result.setupTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::size_t frame = 0;
+        result.frameTime = bench::run(FrameCount, [&]()
+            {
+                const auto t = static_cast<float>(frame++) / 60.f;
+                result.visible = 0;
+
+                for (auto& testScene : scenes)
+                {
+                    for (auto i = 0u; i < testScene->moving.size(); ++i)
+                    {
+                        const auto offset = static_cast<float>(i);
+                        testScene->moving[i].getComponent<cro::Transform>().setPosition(testScene->movingOrigins[i]
+                            + glm::vec3(std::sin(t + offset) * 10.f, 0.f, std::cos(t + offset) * 10.f));
+                    }
+                    testScene->scene.simulate(1.f / 60.f);
+
+                    for (auto camera : testScene->cameras)
+                    {
+                        result.visible += testScene->renderer->getVisibleCount(camera.getComponent<cro::Camera>().getDrawListIndex());
+                    }
+                }
+                bench::consume(result.visible);
+            }, 0);
+
+        return result;
+    }
+}
+
+int main()
+{
+    const auto linear = run(false);
+    const auto tree = run(true);
+
+    std::printf("%zu static and %zu moving models in %zu scenes, 2 cameras each, %zu frames\n", StaticCount, MovingCount, SceneCount, FrameCount);
+    std::printf("linear culling: setup %9.3f ms, %8.3f ms/frame, %zu visible\n", linear.setupTime, linear.frameTime, linear.visible);
+    std::printf("tree culling:   setup %9.3f ms, %8.3f ms/frame, %zu visible, %s\n", tree.setupTime, tree.frameTime, tree.visible,
+        tree.visible == linear.visible ? "same as linear" : "DIFFERENT");
+
+    return 0;
+}
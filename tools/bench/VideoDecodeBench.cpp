@@ -0,0 +1,428 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+/*
+Measures pl_mpeg video decode throughput without a window or GL context.
+By default a 1280x720 MPEG-1 stream is generated in memory: one intra
+picture followed by 11 predicted pictures per group, with half pel
+motion vectors and coded residuals on a quarter of the predicted
+macroblocks. Alternatively pass the path to an .mpg file to decode
+that instead.
+
+Decoding is timed on its own, then with the decoded planes copied
+out as the VideoPlayer worker thread does for each queued frame.
+*/
+
+#include "Benchmark.hpp"
+
+#include "graphics/pl_mpeg.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr std::int32_t Width = 1280;
+    constexpr std::int32_t Height = 720;
+    constexpr std::int32_t MBWidth = Width / 16;
+    constexpr std::int32_t MBHeight = Height / 16;
+    constexpr std::int32_t FrameCount = 240;
+    constexpr std::int32_t GroupSize = 12;
+
+    constexpr std::size_t RunCount = 5;
+
+    enum PictureType
+    {
+        Intra = 1, Predicted = 2
+    };
+
+    class BitWriter final
+    {
+    public:
+        void write(std::uint32_t value, std::uint32_t bitCount)
+        {
+            for (auto i = bitCount; i > 0; --i)
+            {
+                m_current = static_cast<std::uint8_t>((m_current << 1) | ((value >> (i - 1)) & 1));
+                if (++m_bitCount == 8)
+                {
+                    m_bytes.push_back(m_current);
+                    m_current = 0;
+                    m_bitCount = 0;
+                }
+            }
+        }
+
+        //pads to the next byte boundary with zeros
+        void startCode(std::uint8_t code)
+        {
+            if (m_bitCount != 0)
+            {
+                write(0, 8 - m_bitCount);
+            }
+            write(0x000001, 24);
+            write(code, 8);
+        }
+
+        std::vector<std::uint8_t>& getBytes()
+        {
+            return m_bytes;
+        }
+
+    private:
+        std::vector<std::uint8_t> m_bytes;
+        std::uint8_t m_current = 0;
+        std::uint32_t m_bitCount = 0;
+    };
+
+    //cheap repeatable values so the stream is the same on every run
+    std::uint32_t nextRandom(std::uint32_t& state)
+    {
+        state = state * 1664525u + 1013904223u;
+        return state >> 16;
+    }
+
+    std::uint32_t bitsRequired(std::int32_t value)
+    {
+        std::uint32_t count = 0;
+        while (value != 0)
+        {
+            value >>= 1;
+            count++;
+        }
+        return count;
+    }
+
+    void writeDCSize(BitWriter& writer, std::uint32_t size, bool luma)
+    {
+        //code, length
+        static constexpr std::uint32_t LumaCodes[][2] =
+        {
+            {0b100, 3}, {0b00, 2}, {0b01, 2}, {0b101, 3}, {0b110, 3},
+            {0b1110, 4}, {0b11110, 5}, {0b111110, 6}, {0b1111110, 7}
+        };
+        static constexpr std::uint32_t ChromaCodes[][2] =
+        {
+            {0b00, 2}, {0b01, 2}, {0b10, 2}, {0b110, 3}, {0b1110, 4},
+            {0b11110, 5}, {0b111110, 6}, {0b1111110, 7}, {0b11111110, 8}
+        };
+        const auto& code = luma ? LumaCodes[size] : ChromaCodes[size];
+        writer.write(code[0], code[1]);
+    }
+
+    void writeMotionCode(BitWriter& writer, std::int32_t delta)
+    {
+        //code without the sign bit, length
+        static constexpr std::uint32_t Codes[][2] =
+        {
+            {0b1, 1}, {0b01, 2}, {0b001, 3}
+        };
+        const auto magnitude = delta < 0 ? -delta : delta;
+        writer.write(Codes[magnitude][0], Codes[magnitude][1]);
+        if (magnitude != 0)
+        {
+            writer.write(delta < 0 ? 1 : 0, 1);
+        }
+    }
+
+    //every coefficient is written with the escape code so
+    //no run/level table is needed, then end of block
+    void writeCoefficients(BitWriter& writer, std::uint32_t& random, std::int32_t count)
+    {
+        for (auto i = 0; i < count; ++i)
+        {
+            const auto run = nextRandom(random) % 4;
+            auto level = static_cast<std::int32_t>(nextRandom(random) % 9) - 4;
+            if (level == 0)
+            {
+                level = 1;
+            }
+
+            writer.write(0b000001, 6);
+            writer.write(run, 6);
+            writer.write(static_cast<std::uint32_t>(level) & 0xff, 8);
+        }
+        writer.write(0b10, 2);
+    }
+
+    void writeIntraMacroblock(BitWriter& writer, std::uint32_t& random, std::int32_t(&predictors)[3])
+    {
+        writer.write(0b1, 1); //address increment 1
+        writer.write(0b1, 1); //intra
+
+        for (auto block = 0; block < 6; ++block)
+        {
+            const auto plane = block > 3 ? block - 3 : 0;
+            const auto dc = 88 + static_cast<std::int32_t>(nextRandom(random) % 80);
+            const auto diff = dc - predictors[plane];
+            predictors[plane] = dc;
+
+            const auto size = bitsRequired(diff < 0 ? -diff : diff);
+            writeDCSize(writer, size, plane == 0);
+            if (size != 0)
+            {
+                writer.write(diff < 0 ? diff + (1 << size) - 1 : diff, size);
+            }
+            writeCoefficients(writer, random, 6);
+        }
+    }
+
+    void writePredictedMacroblock(BitWriter& writer, std::uint32_t& random, std::int32_t col, std::int32_t row, std::int32_t(&motion)[2])
+    {
+        writer.write(0b1, 1); //address increment 1
+
+        //half pel vectors which never point outside the reference picture
+        std::int32_t target[2] =
+        {
+            col == 0 ? 1 : col == MBWidth - 1 ? -1 : static_cast<std::int32_t>(nextRandom(random) % 3) - 1,
+            row == 0 ? 1 : row == MBHeight - 1 ? -1 : static_cast<std::int32_t>(nextRandom(random) % 3) - 1
+        };
+
+        const bool coded = (nextRandom(random) % 4) == 0;
+        writer.write(coded ? 0b1 : 0b001, coded ? 1 : 3); //motion compensated, with or without residual
+
+        for (auto i = 0; i < 2; ++i)
+        {
+            writeMotionCode(writer, target[i] - motion[i]);
+            motion[i] = target[i];
+        }
+
+        if (coded)
+        {
+            writer.write(0b111, 3); //pattern 60, luminance blocks only
+            for (auto block = 0; block < 4; ++block)
+            {
+                writeCoefficients(writer, random, 4);
+            }
+        }
+    }
+
+    std::vector<std::uint8_t> createStream()
+    {
+        BitWriter writer;
+
+        writer.startCode(0xb3); //sequence header
+        writer.write(Width, 12);
+        writer.write(Height, 12);
+        writer.write(1, 4); //square pixels
+        writer.write(3, 4); //25 fps
+        writer.write(0x3ffff, 18); //variable bit rate
+        writer.write(1, 1);
+        writer.write(0, 10);
+        writer.write(0, 1);
+        writer.write(0, 1); //default quant matrices
+        writer.write(0, 1);
+
+        std::uint32_t random = 1;
+        for (auto frame = 0; frame < FrameCount; ++frame)
+        {
+            const auto temporalRef = frame % GroupSize;
+            const auto type = temporalRef == 0 ? Intra : Predicted;
+
+            if (type == Intra)
+            {
+                writer.startCode(0xb8); //group of pictures
+                writer.write(0, 25);
+                writer.write(1, 1); //closed
+                writer.write(0, 1);
+            }
+
+            writer.startCode(0x00); //picture
+            writer.write(temporalRef, 10);
+            writer.write(type, 3);
+            writer.write(0xffff, 16);
+            if (type == Predicted)
+            {
+                writer.write(0, 1); //half pel
+                writer.write(1, 3); //f_code
+            }
+            writer.write(0, 1);
+
+            for (auto row = 0; row < MBHeight; ++row)
+            {
+                writer.startCode(static_cast<std::uint8_t>(row + 1)); //slice
+                writer.write(type == Intra ? 8 : 12, 5); //quantiser scale
+                writer.write(0, 1);
+
+                std::int32_t predictors[3] = { 128, 128, 128 };
+                std::int32_t motion[2] = { 0, 0 };
+                for (auto col = 0; col < MBWidth; ++col)
+                {
+                    if (type == Intra)
+                    {
+                        writeIntraMacroblock(writer, random, predictors);
+                    }
+                    else
+                    {
+                        writePredictedMacroblock(writer, random, col, row, motion);
+                    }
+                }
+            }
+        }
+        writer.startCode(0xb7); //sequence end
+
+        return std::move(writer.getBytes());
+    }
+
+    //pl_mpeg memmoves the remainder of fixed memory buffers after every
+    //picture, so the stream is fed in chunks like a file is instead
+    struct MemorySource final
+    {
+        std::vector<std::uint8_t> bytes;
+        std::size_t position = 0;
+    };
+
+    void loadCallback(plm_buffer_t* buffer, void* user)
+    {
+        constexpr std::size_t ChunkSize = 128 * 1024;
+
+        auto* source = static_cast<MemorySource*>(user);
+        if (source->position == source->bytes.size())
+        {
+            plm_buffer_signal_end(buffer);
+            return;
+        }
+
+        const auto size = std::min(ChunkSize, source->bytes.size() - source->position);
+        plm_buffer_write(buffer, source->bytes.data() + source->position, size);
+        source->position += size;
+    }
+
+    struct Plane final
+    {
+        std::vector<std::uint8_t> data;
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+    };
+
+    void copyPlane(Plane& dst, const plm_plane_t& src)
+    {
+        dst.width = src.width;
+        dst.height = src.height;
+        dst.data.assign(src.data, src.data + (src.width * src.height));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    MemorySource source;
+    plm_t* plm = nullptr;
+    plm_video_t* video = nullptr;
+
+    if (argc > 1)
+    {
+        plm = plm_create_with_filename(argv[1]);
+        if (!plm || plm_get_width(plm) == 0 || plm_get_height(plm) == 0)
+        {
+            std::printf("Failed to open %s\n", argv[1]);
+            if (plm)
+            {
+                plm_destroy(plm);
+            }
+            return 1;
+        }
+        plm_set_audio_enabled(plm, 0);
+        std::printf("%s, %dx%d\n", argv[1], plm_get_width(plm), plm_get_height(plm));
+    }
+    else
+    {
+        source.bytes = createStream();
+        auto* buffer = plm_buffer_create_with_capacity(PLM_BUFFER_DEFAULT_SIZE);
+        plm_buffer_set_load_callback(buffer, loadCallback, &source);
+        video = plm_video_create_with_buffer(buffer, 1);
+        std::printf("Generated stream, %dx%d, %d frames, %zu KB\n", Width, Height, FrameCount, source.bytes.size() / 1024);
+    }
+
+    const auto decodeNext = [&]()
+    {
+        return plm ? plm_decode_video(plm) : plm_video_decode(video);
+    };
+
+    const auto rewind = [&]()
+    {
+        if (plm)
+        {
+            plm_rewind(plm);
+        }
+        else
+        {
+            source.position = 0;
+            plm_video_rewind(video);
+        }
+    };
+
+    std::size_t frameCount = 0;
+    const auto decodeTime = bench::run(RunCount, [&]()
+        {
+            rewind();
+            frameCount = 0;
+            while (auto* frame = decodeNext())
+            {
+                bench::consume(frame->y.data[frame->y.width * 8 + 8]);
+                frameCount++;
+            }
+        });
+
+    Plane y, cb, cr;
+    const auto copyTime = bench::run(RunCount, [&]()
+        {
+            rewind();
+            while (auto* frame = decodeNext())
+            {
+                copyPlane(y, frame->y);
+                copyPlane(cb, frame->cb);
+                copyPlane(cr, frame->cr);
+                bench::consume(y.data[y.width * 8 + 8]);
+            }
+        });
+
+    if (plm)
+    {
+        plm_destroy(plm);
+    }
+    else
+    {
+        plm_video_destroy(video);
+    }
+
+    if (frameCount == 0)
+    {
+        std::printf("No frames were decoded\n");
+        return 1;
+    }
+
+    const auto frames = static_cast<double>(frameCount);
+    std::printf("%zu frames decoded per run\n", frameCount);
+    std::printf("decode:              %7.3f ms/frame, %8.1f frames/s\n", decodeTime / frames, frames * 1000.0 / decodeTime);
+    std::printf("decode, copy planes: %7.3f ms/frame, %8.1f frames/s\n", copyTime / frames, frames * 1000.0 / copyTime);
+
+    return 0;
+}